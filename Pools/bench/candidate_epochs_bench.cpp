@@ -0,0 +1,262 @@
+/*
+  candidate_epochs_bench.cpp
+  - Host-side check of CrossedSince and CatchUpCandidate against a reference
+    model that keeps the generations unpacked (plain counters, no wrap)
+  - Stamps are taken on both sides of the 8-bit session / table and 16-bit
+    hand wraps (255 -> 256, 65535 -> 65536); every crossing shorter than a
+    full lap must come out exactly as the unpacked counters say. A full lap
+    (256 session or table bumps, 65536 hands between two reads) aliases to
+    "nothing crossed" by design; that is printed, not failed
+  - CatchUpCandidate on random rows is compared with the decay rules written
+    out again here (session restart, table halving, per-hand mismatch decay),
+    and a second catch-up at the same stamp must change nothing
+  - Then the cost of catching a 100k-candidate store up across one hand
+  - Exits non-zero on the first disagreement
+
+  Build (from Pools/):
+    g++ -std=c++20 -O2 -I. bench/candidate_epochs_bench.cpp candidate_epochs.cpp money_store.cpp -o candidate_epochs_bench
+*/
+
+#include "candidate_epochs.h"
+#include "step_correlation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static const int kCases = 200000;
+
+static int gFailures = 0;
+
+static void Fail(const char* what, int c)
+{
+    if (gFailures++ == 0)
+        printf("MISMATCH case %d: %s\n", c, what);
+}
+
+static CandidateEpochs Epochs(uint32_t session, uint32_t table, uint32_t hand)
+{
+    CandidateEpochs e;
+    e.gen[EPOCH_SESSION] = session;
+    e.gen[EPOCH_TABLE] = table;
+    e.gen[EPOCH_HAND] = hand;
+    return e;
+}
+
+// Generations near a wrap of their packed width half the time.
+static uint32_t PickGen(std::mt19937& rng, uint32_t width)
+{
+    if (rng() & 1)
+        return width * (1 + rng() % 4) - 1 - rng() % 3;
+    return rng() % (width * 4);
+}
+
+static void CheckCrossings()
+{
+    std::mt19937 rng(11);
+    int aliased = 0;
+    for (int c = 0; c < kCases && gFailures == 0; c++)
+    {
+        uint32_t s0 = PickGen(rng, 256), t0 = PickGen(rng, 256), h0 = PickGen(rng, 65536);
+        // Mostly short gaps; now and then exactly one full lap.
+        uint32_t ds = (rng() % 8 == 0) ? (uint32_t)(rng() % 256) : (uint32_t)(rng() % 3);
+        uint32_t dt = (rng() % 8 == 0) ? (uint32_t)(rng() % 256) : (uint32_t)(rng() % 3);
+        uint32_t dh = (rng() % 4 == 0) ? (uint32_t)(rng() % 65536) : (uint32_t)(rng() % 20);
+        bool lap = rng() % 50 == 0;
+        if (lap)
+        {
+            int which = (int)(rng() % 3);
+            ds = (which == 0) ? 256 : ds;
+            dt = (which == 1) ? 256 : dt;
+            dh = (which == 2) ? 65536 : dh;
+        }
+        uint32_t from = Epochs(s0, t0, h0).Stamp();
+        uint32_t now = Epochs(s0 + ds, t0 + dt, h0 + dh).Stamp();
+        EpochCrossing x = CrossedSince(from, now);
+
+        bool wantSession = (ds % 256) != 0;
+        bool wantTable = (dt % 256) != 0;
+        int wantHands = (int)(dh % 65536);
+        if (x.session != wantSession || x.table != wantTable || x.hands != wantHands)
+            Fail("CrossedSince", c);
+        if (lap && (ds == 256 || dt == 256 || dh == 65536))
+            aliased++;
+        if (CrossedSince(now, now).Any())
+            Fail("CrossedSince(now, now) crossed something", c);
+    }
+
+    // The wraps themselves, one bump each.
+    struct Wrap { uint32_t s, t, h; int kind; };
+    const Wrap wraps[] = {
+        { 255, 0, 0, EPOCH_SESSION }, { 511, 7, 9, EPOCH_SESSION },
+        { 0, 255, 0, EPOCH_TABLE }, { 3, 767, 1, EPOCH_TABLE },
+        { 0, 0, 65535, EPOCH_HAND }, { 9, 9, 131071, EPOCH_HAND },
+    };
+    for (const Wrap& w : wraps)
+    {
+        CandidateEpochs e = Epochs(w.s, w.t, w.h);
+        uint32_t from = e.Stamp();
+        e.Bump(w.kind);
+        EpochCrossing x = CrossedSince(from, e.Stamp());
+        bool ok = x.session == (w.kind == EPOCH_SESSION) && x.table == (w.kind == EPOCH_TABLE) &&
+            x.hands == ((w.kind == EPOCH_HAND) ? 1 : 0);
+        if (!ok)
+        {
+            printf("wrap of %s at %u/%u/%u missed\n", CandidateEpochName(w.kind), w.s, w.t, w.h);
+            gFailures++;
+        }
+    }
+    printf("CrossedSince: %d cases + %d wraps, %s; %d full laps aliased to no crossing (by design)\n",
+        kCases, (int)(sizeof(wraps) / sizeof(wraps[0])), gFailures ? "FAILED" : "ok", aliased);
+}
+
+static MoneyCandidate RandomRow(std::mt19937& rng, int idx)
+{
+    MoneyCandidate c;
+    c.idx = idx;
+    c.last = (int)(rng() % 500000);
+    c.lastDelta = (int)(rng() % 200) - 100;
+    c.changes = (int)(rng() % 40);
+    c.betStepMatches = (int)(rng() % 30);
+    c.betStepMismatches = (int)(rng() % 30);
+    c.ocrAnyMatches = (int)(rng() % 20);
+    c.ocrPotMatches = (int)(rng() % 20);
+    c.ocrPlayerMatches = (int)(rng() % 20);
+    c.ocrNpcMatches = (int)(rng() % 20);
+    c.lastOcrAnySampleId = (int)(rng() % 100);
+    c.lastOcrPotSampleId = (int)(rng() % 100);
+    c.firstSeenMs = 1000 + rng() % 1000;
+    c.lastChangeMs = 2000 + rng() % 1000;
+    c.lastOcrMatchMs = 3000 + rng() % 1000;
+    c.stepAligned = rng();
+    c.stepMissed = rng() & 0x0F0F0F0Fu;
+    return c;
+}
+
+// The decay rules of candidate_epochs.h, spelled out independently.
+static MoneyCandidate RefCatchUp(MoneyCandidate c, const EpochCrossing& x, uint32_t stamp, uint32_t nowMs)
+{
+    c.epoch = stamp;
+    if (x.session)
+    {
+        MoneyCandidate fresh;
+        fresh.idx = c.idx;
+        fresh.last = c.last;
+        fresh.series = c.series;
+        fresh.firstSeenMs = nowMs;
+        fresh.lastSeenMs = c.lastSeenMs;
+        fresh.epoch = stamp;
+        return fresh;
+    }
+    if (x.table)
+    {
+        c.betStepMatches /= 2;
+        c.betStepMismatches /= 2;
+        c.ocrAnyMatches /= 2;
+        c.ocrPotMatches /= 2;
+        c.ocrPlayerMatches /= 2;
+        c.ocrNpcMatches /= 2;
+        uint32_t aligned = 0;
+        for (int lane = 0; lane < 4; lane++)
+            aligned |= (uint32_t)(PackedCount(c.stepAligned, lane) / 2) << (lane * 8);
+        c.stepAligned = aligned;
+        c.stepMissed = 0;
+    }
+    int hands = (std::min)(x.hands, 8);
+    for (int h = 0; h < hands; h++)
+        c.betStepMismatches -= c.betStepMismatches / 4;
+    uint32_t missed = 0;
+    for (int lane = 0; lane < 4; lane++)
+        missed |= (uint32_t)(std::max)(0, PackedCount(c.stepMissed, lane) - hands) << (lane * 8);
+    c.stepMissed = missed;
+    return c;
+}
+
+static bool SameRow(const MoneyCandidate& a, const MoneyCandidate& b)
+{
+    return a.idx == b.idx && a.last == b.last && a.lastDelta == b.lastDelta && a.changes == b.changes &&
+        a.betStepMatches == b.betStepMatches && a.betStepMismatches == b.betStepMismatches &&
+        a.ocrAnyMatches == b.ocrAnyMatches && a.ocrPotMatches == b.ocrPotMatches &&
+        a.ocrPlayerMatches == b.ocrPlayerMatches && a.ocrNpcMatches == b.ocrNpcMatches &&
+        a.lastOcrAnySampleId == b.lastOcrAnySampleId && a.lastOcrPotSampleId == b.lastOcrPotSampleId &&
+        a.lastOcrPlayerSampleId == b.lastOcrPlayerSampleId && a.lastOcrNpcSampleId == b.lastOcrNpcSampleId &&
+        a.firstSeenMs == b.firstSeenMs && a.lastChangeMs == b.lastChangeMs && a.lastOcrMatchMs == b.lastOcrMatchMs &&
+        a.stepAligned == b.stepAligned && a.stepMissed == b.stepMissed && a.epoch == b.epoch;
+}
+
+static void CheckCatchUp()
+{
+    std::mt19937 rng(23);
+    MoneyCandidateStore s;
+    std::vector<MoneyCandidate> rows(1);
+    for (int c = 0; c < kCases / 4 && gFailures == 0; c++)
+    {
+        CandidateEpochs e = Epochs(PickGen(rng, 256), PickGen(rng, 256), PickGen(rng, 65536));
+        rows[0] = RandomRow(rng, 5);
+        rows[0].epoch = e.Stamp();
+        s.Clear();
+        s.InsertSorted(rows);
+
+        int bumps = (int)(rng() % 4);
+        for (int b = 0; b < bumps; b++)
+        {
+            unsigned r = rng() % 10;
+            e.Bump(r == 0 ? EPOCH_SESSION : (r < 3 ? EPOCH_TABLE : EPOCH_HAND));
+        }
+        if (rng() % 10 == 0)
+            e.gen[EPOCH_HAND] += 5 + rng() % 20;  // a long absence: many hands at once
+
+        uint32_t stamp = e.Stamp();
+        uint32_t nowMs = 50000 + (uint32_t)c;
+        EpochCrossing x = CrossedSince(rows[0].epoch, stamp);
+        MoneyCandidate want = RefCatchUp(rows[0], x, stamp, nowMs);
+        CatchUpCandidate(s, 0, x, stamp, nowMs);
+        if (!SameRow(s.Row(0), want))
+            Fail("CatchUpCandidate decay", c);
+
+        MoneyCandidate once = s.Row(0);
+        EpochCrossing again = CrossedSince(s.epoch[0], stamp);
+        if (again.Any())
+            Fail("restamped row still crossed something", c);
+        CatchUpCandidate(s, 0, again, stamp, nowMs + 1000);
+        if (!SameRow(s.Row(0), once))
+            Fail("second catch-up at the same stamp changed the row", c);
+    }
+    printf("CatchUpCandidate: %d rows, %s\n", kCases / 4, gFailures ? "FAILED" : "ok");
+}
+
+static void BenchHandCatchUp()
+{
+    const int n = 100000;
+    std::mt19937 rng(5);
+    CandidateEpochs e = Epochs(3, 250, 65530);
+    std::vector<MoneyCandidate> rows((size_t)n);
+    for (int i = 0; i < n; i++)
+    {
+        rows[(size_t)i] = RandomRow(rng, i * 3);
+        rows[(size_t)i].epoch = e.Stamp();
+    }
+    MoneyCandidateStore s;
+    s.InsertSorted(rows);
+    e.Bump(EPOCH_HAND);
+    uint32_t stamp = e.Stamp();
+    auto t0 = std::chrono::steady_clock::now();
+    for (int slot = 0; slot < n; slot++)
+    {
+        if (s.epoch[(size_t)slot] != stamp)
+            CatchUpCandidate(s, slot, CrossedSince(s.epoch[(size_t)slot], stamp), stamp, 60000);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / n;
+    printf("hand catch-up: %.1f ns/candidate (%d candidates)\n", ns, n);
+}
+
+int main()
+{
+    CheckCrossings();
+    if (gFailures == 0)
+        CheckCatchUp();
+    BenchHandCatchUp();
+    return gFailures ? 1 : 0;
+}
@@ -0,0 +1,188 @@
+/*
+  frame_grab_bench.cpp
+  - Host-side benchmark: the per-cycle CPU work around the OCR screen grab
+    at the default region percentages for 1080p and 4K, with a screen-sized
+    buffer standing in for the desktop (BitBlt's cost is not modelled)
+  - "before" is what StartOcrCycle did per region: a fresh bitmap and buffer
+    per grab (BitBlt into the bitmap, GetDIBits out of it), then luma or an OcrImage copy from it, and the
+    tile signatures over those copies
+  - "single"/"per-roi"/"auto" fill one pooled surface laid out by
+    PlanGrabLayout (one copy of the bounding box, or one per region into a
+    stacked surface; auto picks one of the two) and run the stages on
+    PixelViews: luma and tile signatures in place, CopyView for OCR
+  - Every view must match the region cropped straight from the screen, and
+    luma must agree with the per-region result
+
+  Build (from Pools/):
+    g++ -std=c++20 -O2 -I. bench/frame_grab_bench.cpp frame_grab.cpp tile_signature.cpp -o frame_grab_bench
+  Run:
+    frame_grab_bench [cycles]
+*/
+
+#include "frame_grab.h"
+#include "tile_signature.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+struct Screen
+{
+    int w = 0;
+    int h = 0;
+    int stride = 0;
+    std::vector<unsigned char> pixels;
+};
+
+// Stand-in for BitBlt: copies rect of the screen to (dx, dy) of a surface.
+static void Blit(const Screen& s, const GrabRect& r, unsigned char* dst, int dstStride, int dx, int dy)
+{
+    for (int y = 0; y < r.h; y++)
+    {
+        memcpy(dst + (size_t)(dy + y) * (size_t)dstStride + (size_t)dx * 3,
+            s.pixels.data() + (size_t)(r.y + y) * (size_t)s.stride + (size_t)r.x * 3, (size_t)r.w * 3);
+    }
+}
+
+static bool SameAsCrop(const Screen& s, const GrabRect& r, const PixelView& v)
+{
+    if (v.width != r.w || v.height != r.h)
+        return false;
+    for (int y = 0; y < r.h; y++)
+    {
+        if (memcmp(v.pixels + (size_t)y * (size_t)v.stride,
+                s.pixels.data() + (size_t)(r.y + y) * (size_t)s.stride + (size_t)r.x * 3, (size_t)r.w * 3) != 0)
+            return false;
+    }
+    return true;
+}
+
+static double Us(Clock::time_point a, Clock::time_point b)
+{
+    return std::chrono::duration<double, std::micro>(b - a).count();
+}
+
+int main(int argc, char** argv)
+{
+    int cycles = (argc > 1) ? atoi(argv[1]) : 100;
+    int bad = 0;
+    printf("%-6s %-8s %10s %10s %10s %10s %10s %12s %6s\n",
+        "screen", "mode", "grab us", "luma us", "hash us", "copy us", "total us", "surface KB", "check");
+
+    struct Res { const char* name; int w; int h; };
+    for (const Res& res : { Res{ "1080p", 1920, 1080 }, Res{ "4K", 3840, 2160 } })
+    {
+        Screen s;
+        s.w = res.w;
+        s.h = res.h;
+        s.stride = GrabStride(s.w);
+        s.pixels.resize((size_t)s.stride * (size_t)s.h);
+        std::mt19937 rng(5);
+        for (unsigned char& b : s.pixels)
+            b = (unsigned char)(rng() & 0xFF);
+
+        // Default [OCR] percentages: opacity, BottomLeft, TopRight.
+        GrabRect rois[GRAB_ROI_COUNT];
+        GrabRectFromPct(s.w, s.h, 72, 66, 27, 30, rois[GRAB_ROI_OPACITY]);
+        GrabRectFromPct(s.w, s.h, 0, 34, 34, 66, rois[GRAB_ROI_BOTTOM_LEFT]);
+        GrabRectFromPct(s.w, s.h, 72, 0, 28, 30, rois[GRAB_ROI_TOP_RIGHT]);
+
+        float refLuma = 0.0f;
+        OcrImage ocr[2];
+        TileSignature sig[2];
+
+        // Before: one buffer per region per cycle.
+        {
+            double grab = 0.0, luma = 0.0, hash = 0.0, copy = 0.0;
+            size_t peak = 0;
+            for (int c = 0; c < cycles; c++)
+            {
+                for (int i = 0; i < GRAB_ROI_COUNT; i++)
+                {
+                    const GrabRect& r = rois[i];
+                    auto t0 = Clock::now();
+                    std::vector<unsigned char> bmp((size_t)GrabStride(r.w) * (size_t)r.h);
+                    Blit(s, r, bmp.data(), GrabStride(r.w), 0, 0);
+                    std::vector<unsigned char> buf(bmp);
+                    auto t1 = Clock::now();
+                    PixelView v{ buf.data(), r.w, r.h, GrabStride(r.w) };
+                    peak = (std::max)(peak, bmp.size() + buf.size());
+                    if (i == GRAB_ROI_OPACITY)
+                    {
+                        LumaStdDev(v, refLuma);
+                        luma += Us(t1, Clock::now());
+                    }
+                    else
+                    {
+                        CopyView(v, ocr[i - 1]);
+                        auto t2 = Clock::now();
+                        const OcrImage& img = ocr[i - 1];
+                        sig[i - 1].Compute(img.pixels.data(), img.width, img.height, img.stride);
+                        copy += Us(t1, t2);
+                        hash += Us(t2, Clock::now());
+                    }
+                    grab += Us(t0, t1);
+                }
+            }
+            printf("%-6s %-8s %10.1f %10.1f %10.1f %10.1f %10.1f %12zu %6s\n", res.name, "before",
+                grab / cycles, luma / cycles, hash / cycles, copy / cycles, (grab + luma + hash + copy) / cycles, peak / 1024, "-");
+        }
+
+        for (int mode : { GRAB_MODE_SINGLE, GRAB_MODE_PER_ROI, GRAB_MODE_AUTO })
+        {
+            GrabLayout layout;
+            PlanGrabLayout(rois, mode, layout);
+            int stride = GrabStride(layout.width);
+            std::vector<unsigned char> surface((size_t)stride * (size_t)layout.height);
+            double grab = 0.0, luma = 0.0, hash = 0.0, copy = 0.0;
+            bool ok = true;
+            for (int c = 0; c < cycles; c++)
+            {
+                auto t0 = Clock::now();
+                if (layout.single)
+                    Blit(s, layout.box, surface.data(), stride, 0, 0);
+                else
+                    for (int i = 0; i < GRAB_ROI_COUNT; i++)
+                        Blit(s, rois[i], surface.data(), stride, layout.place[i].x, layout.place[i].y);
+                auto t1 = Clock::now();
+                float l = 0.0f;
+                LumaStdDev(GrabView(surface.data(), stride, layout.place[GRAB_ROI_OPACITY]), l);
+                auto t2 = Clock::now();
+                PixelView views[2] = {
+                    GrabView(surface.data(), stride, layout.place[GRAB_ROI_BOTTOM_LEFT]),
+                    GrabView(surface.data(), stride, layout.place[GRAB_ROI_TOP_RIGHT]) };
+                for (int r = 0; r < 2; r++)
+                    sig[r].Compute(views[r].pixels, views[r].width, views[r].height, views[r].stride);
+                auto t3 = Clock::now();
+                for (int r = 0; r < 2; r++)
+                    CopyView(views[r], ocr[r]);
+                auto t4 = Clock::now();
+                grab += Us(t0, t1);
+                luma += Us(t1, t2);
+                hash += Us(t2, t3);
+                copy += Us(t3, t4);
+
+                if (c == 0)
+                {
+                    ok = l == refLuma;
+                    for (int i = 0; i < GRAB_ROI_COUNT; i++)
+                        ok = ok && SameAsCrop(s, rois[i], GrabView(surface.data(), stride, layout.place[i]));
+                    for (int r = 0; r < 2; r++)
+                        ok = ok && SameAsCrop(s, rois[r + 1], PixelView{ ocr[r].pixels.data(), ocr[r].width, ocr[r].height, ocr[r].stride });
+                }
+            }
+            bad += ok ? 0 : 1;
+            const char* name = (mode == GRAB_MODE_SINGLE) ? "single" : (mode == GRAB_MODE_PER_ROI ? "per-roi" :
+                (layout.single ? "auto=1" : "auto=0"));
+            printf("%-6s %-8s %10.1f %10.1f %10.1f %10.1f %10.1f %12zu %6s\n", res.name, name,
+                grab / cycles, luma / cycles, hash / cycles, copy / cycles, (grab + luma + hash + copy) / cycles,
+                surface.size() / 1024, ok ? "ok" : "WRONG");
+        }
+    }
+    return bad == 0 ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+/*
+  memory_budget_bench.cpp
+  - Host-side benchmark: a candidate-cap eviction round the way MoneyScanStep
+    runs it (StepCandidateCap in highstakes.cpp) against one exact pass over
+    the whole store (score every slot, nth_element, compact)
+  - The store is a real MoneyCandidateStore scored with CandidateRankScore;
+    idle times run up to 10 minutes, OCR matches sit on a small fraction of
+    slots and a few slots are pinned (locked globals)
+  - Each step scores the slice ScanScheduler fits in the step's leftover
+    budget, starting at the round's cursor, and queues its victims; the queue
+    is compacted out once, when the round closes (no pruning in this bench)
+  - Prints the exact pass, then per round: steps, worst step (slice plus the
+    opening sample), the closing compaction and how many victims the exact
+    pass would also have picked. Exits non-zero if a round misses 7/8 of the
+    cap, evicts a pinned slot or agrees with the exact choice on fewer than
+    95% of victims
+
+  Build (from Pools/):
+    g++ -std=c++20 -O2 -I. bench/memory_budget_bench.cpp memory_budget.cpp money_store.cpp candidate_rules.cpp ocr_amount_index.cpp scan_scheduler.cpp -o memory_budget_bench
+*/
+
+#include "candidate_rules.h"
+#include "memory_budget.h"
+#include "money_store.h"
+#include "scan_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static const int kPinned = 8;
+static const int kOcrPerMille = 5;
+static const uint32_t kNowMs = 3600000;
+static const int64_t kSliceBudgetUs = 150;   // what a 300us step typically has left after the rescan
+static const int kMinSlice = 1024;
+static const int kMaxSlice = 4096;
+
+using Clock = std::chrono::steady_clock;
+
+static int64_t NowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now().time_since_epoch()).count();
+}
+
+static void FillStore(MoneyCandidateStore& s, int live, std::mt19937& rng)
+{
+    std::vector<MoneyCandidate> rows((size_t)live);
+    for (int i = 0; i < live; i++)
+    {
+        MoneyCandidate& c = rows[(size_t)i];
+        c.idx = i * 3 + (int)(rng() % 3);
+        c.last = 1 + (int)(rng() % 500000);
+        c.changes = (int)(rng() % 8);
+        c.firstSeenMs = kNowMs - 600000;
+        c.lastChangeMs = kNowMs - rng() % 600000;
+        if ((int)(rng() % 1000) < kOcrPerMille)
+        {
+            c.ocrAnyMatches = 1 + (int)(rng() % 4);
+            c.ocrPotMatches = (int)(rng() % 3);
+            c.lastOcrMatchMs = kNowMs - rng() % 60000;
+        }
+        c.betStepMatches = (int)(rng() % 6);
+        c.betStepMismatches = (int)(rng() % 6);
+    }
+    s.Clear();
+    s.InsertSorted(rows);
+}
+
+static float KeepScore(const MoneyCandidateStore& s, int slot, const CandidateRules& rules)
+{
+    static const EvictionWeights weights;
+    size_t k = (size_t)slot;
+    uint32_t lastUseful = (std::max)((std::max)(s.firstSeenMs[k], s.lastChangeMs[k]), s.lastOcrMatchMs[k]);
+    return EvictionKeepScore(CandidateRankScore(s, slot, kNowMs, rules), kNowMs - lastUseful,
+        IsOcrCorrelatedCandidate(s, slot), weights);
+}
+
+int main(int argc, char** argv)
+{
+    int cap = (argc > 1) ? atoi(argv[1]) : 25000;
+    int low = cap - cap / 8;
+    CandidateRules rules;
+    int bad = 0;
+    for (int live : { cap + cap / 16, cap * 3 / 2, cap * 4, cap * 14 })
+    {
+        std::mt19937 rng(7);
+        MoneyCandidateStore store;
+        FillStore(store, live, rng);
+        std::vector<int> pinnedIdx;
+        for (int p = 0; p < kPinned; p++)
+            pinnedIdx.push_back(store.idx[rng() % (uint32_t)live]);
+        auto isPinned = [&](int idx) { return std::find(pinnedIdx.begin(), pinnedIdx.end(), idx) != pinnedIdx.end(); };
+
+        // Exact pass: every slot scored, the lowest live - low unpinned slots chosen, one compaction.
+        std::vector<float> keep((size_t)live);
+        std::vector<int> order;
+        std::vector<unsigned char> exactDead((size_t)live, 0);
+        int64_t t0 = NowUs();
+        for (int slot = 0; slot < live; slot++)
+            keep[(size_t)slot] = KeepScore(store, slot, rules);
+        for (int slot = 0; slot < live; slot++)
+        {
+            if (!isPinned(store.idx[(size_t)slot]))
+                order.push_back(slot);
+        }
+        int exactCount = live - low;
+        std::nth_element(order.begin(), order.begin() + (exactCount - 1), order.end(),
+            [&](int a, int b) { return keep[(size_t)a] < keep[(size_t)b]; });
+        for (int i = 0; i < exactCount; i++)
+            exactDead[(size_t)order[(size_t)i]] = 1;
+        std::vector<int> exactIdx;
+        for (int slot = 0; slot < live; slot++)
+        {
+            if (exactDead[(size_t)slot])
+                exactIdx.push_back(store.idx[(size_t)slot]);
+        }
+        MoneyCandidateStore exactStore = store;
+        int64_t t1 = NowUs();
+        exactStore.Compact(exactDead);
+        int64_t exactUs = NowUs() - t0;
+        int64_t exactCompactUs = NowUs() - t1;
+
+        // Incremental round.
+        CandidateEvictor evictor;
+        ScanScheduler sched;
+        sched.Reset(NowUs());
+        std::vector<int> evictedIdx;
+        std::vector<unsigned char> queued((size_t)live, 0);
+        int cursorIdx = 0;
+        int steps = 0;
+        int64_t worstStepUs = 0;
+        int pinnedEvicted = 0;
+        int n = store.Size();
+        auto keepAt = [&](int slot, float& keep)
+        {
+            if (queued[(size_t)slot] || isPinned(store.idx[(size_t)slot]))
+                return false;
+            keep = KeepScore(store, slot, rules);
+            return true;
+        };
+        while (evictor.Update(n - (int)evictedIdx.size(), cap) > 0 && steps < 100000)
+        {
+            int64_t stepStartUs = NowUs();
+            if (steps++ == 0)
+                evictor.Sample(n, keepAt);
+            int64_t sliceStartUs = NowUs();
+            int slice = sched.EvictScoresForBudget(kSliceBudgetUs, kMinSlice, kMaxSlice);
+            int slot = (int)(std::lower_bound(store.idx.begin(), store.idx.end(), cursorIdx) - store.idx.begin());
+            int scored = 0;
+            bool wrapped = false;
+            while (scored < slice && evictor.Owed() > 0)
+            {
+                if (slot >= n)
+                {
+                    if (wrapped)
+                        break;
+                    wrapped = true;
+                    slot = 0;
+                    evictor.Sample(n, keepAt);
+                    continue;
+                }
+                size_t k = (size_t)slot++;
+                if (queued[k])
+                    continue;
+                scored++;
+                if (evictor.Evicts(KeepScore(store, (int)k, rules)) && !isPinned(store.idx[k]))
+                {
+                    queued[k] = 1;
+                    evictedIdx.push_back(store.idx[k]);
+                    evictor.OnEvicted(1);
+                }
+            }
+            cursorIdx = (slot < n) ? store.idx[(size_t)slot] : 0;
+            int64_t endUs = NowUs();
+            sched.OnEvictScores(scored, endUs - sliceStartUs);
+            worstStepUs = (std::max)(worstStepUs, endUs - stepStartUs);
+        }
+        int64_t compactStartUs = NowUs();
+        store.Compact(queued);
+        int64_t compactUs = NowUs() - compactStartUs;
+        for (int idx : evictedIdx)
+            pinnedEvicted += isPinned(idx) ? 1 : 0;
+
+        std::sort(exactIdx.begin(), exactIdx.end());
+        int agree = 0;
+        for (int idx : evictedIdx)
+            agree += std::binary_search(exactIdx.begin(), exactIdx.end(), idx) ? 1 : 0;
+        double agreePct = evictedIdx.empty() ? 100.0 : 100.0 * agree / (double)evictedIdx.size();
+        bool ok = store.Size() == low && pinnedEvicted == 0 && agreePct >= 95.0;
+        bad += ok ? 0 : 1;
+        printf("live=%-7d cap=%d  exact pass %6.2f ms (compact %5.2f ms)  round: %4d steps, step <= %4lld us, "
+            "compact %5lld us, %.0f ns/cand, agree %.1f%%, left %d %s\n",
+            live, cap, exactUs / 1000.0, exactCompactUs / 1000.0, steps, (long long)worstStepUs,
+            (long long)compactUs, sched.Metrics().evictNsPerCand, agreePct, store.Size(), ok ? "ok" : "WRONG");
+    }
+    return bad == 0 ? 0 : 1;
+}
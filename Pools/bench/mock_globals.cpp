@@ -0,0 +1,357 @@
+#include "mock_globals.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+void MockGlobalMemory::Init(int slotCount)
+{
+    slots.assign((size_t)(std::max)(0, slotCount), 0);
+    faultStart.clear();
+    faultEnd.clear();
+    slotsCopied = 0;
+    faultEvents = 0;
+}
+
+void MockGlobalMemory::AddFaultRange(int start, int end)
+{
+    start = (std::max)(0, start);
+    end = (std::min)(end, Size());
+    if (start >= end)
+        return;
+    std::vector<std::pair<int, int>> ranges;
+    for (size_t i = 0; i < faultStart.size(); i++)
+        ranges.push_back({ faultStart[i], faultEnd[i] });
+    ranges.push_back({ start, end });
+    std::sort(ranges.begin(), ranges.end());
+    faultStart.clear();
+    faultEnd.clear();
+    for (const auto& r : ranges)
+    {
+        if (!faultEnd.empty() && r.first <= faultEnd.back())
+            faultEnd.back() = (std::max)(faultEnd.back(), r.second);
+        else
+        {
+            faultStart.push_back(r.first);
+            faultEnd.push_back(r.second);
+        }
+    }
+}
+
+bool MockGlobalMemory::RangeFaults(int start, int count) const
+{
+    // Last fault range starting before start + count.
+    auto it = std::lower_bound(faultStart.begin(), faultStart.end(), start + count);
+    if (it == faultStart.begin())
+        return false;
+    size_t i = (size_t)(it - faultStart.begin()) - 1;
+    return faultEnd[i] > start;
+}
+
+bool MockGlobalMemory::IsFaulting(int idx) const
+{
+    return RangeFaults(idx, 1);
+}
+
+bool MockGlobalMemory::Resolve(int idx, const uint64_t*& out)
+{
+    out = (idx >= 0 && idx < Size()) ? slots.data() + idx : nullptr;
+    return true;
+}
+
+bool MockGlobalMemory::Copy(const uint64_t* src, int count, uint64_t* out)
+{
+    int idx = (int)(src - slots.data());
+    if (RangeFaults(idx, count))
+        return false;
+    std::memcpy(out, src, (size_t)count * sizeof(uint64_t));
+    slotsCopied += (uint64_t)count;
+    return true;
+}
+
+bool MockGlobalMemory::Copy(const uint64_t* src, int count, int* out)
+{
+    int idx = (int)(src - slots.data());
+    if (RangeFaults(idx, count))
+        return false;
+    for (int k = 0; k < count; k++)
+        out[k] = (int32_t)(uint32_t)src[k];
+    slotsCopied += (uint64_t)count;
+    return true;
+}
+
+// ---------------- MockTable ----------------
+
+bool MockTable::Reserve(int idx)
+{
+    if (idx < 0 || idx >= (int)used.size() || used[(size_t)idx])
+        return false;
+    used[(size_t)idx] = 1;
+    return true;
+}
+
+int MockTable::PickFreeIndex()
+{
+    for (int attempt = 0; attempt < 64; attempt++)
+    {
+        int idx = (int)(rng() % (uint32_t)used.size());
+        if (Reserve(idx))
+            return idx;
+    }
+    return -1;
+}
+
+void MockTable::Init(const MockTableConfig& config, MockGlobalMemory& memory)
+{
+    cfg = config;
+    cfg.seats = (std::max)(2, cfg.seats);
+    cfg.playerSeat = (std::min)((std::max)(0, cfg.playerSeat), cfg.seats - 1);
+    mem = &memory;
+    rng.seed(cfg.seed);
+    mem->Init(cfg.slots);
+    used.assign((size_t)cfg.slots, 0);
+
+    for (int f = 0; f < cfg.faultRanges; f++)
+    {
+        int start = (int)(rng() % (uint32_t)cfg.slots);
+        int end = (std::min)(cfg.slots, start + cfg.faultSpan);
+        mem->AddFaultRange(start, end);
+        std::fill(used.begin() + start, used.begin() + end, 1);
+    }
+
+    // Structural globals first, so the noise never lands on them.
+    potIdx = (cfg.potSeatGap < 0) ? PickFreeIndex() : -1;
+    while (true)
+    {
+        seatStride = 1 + (int)(rng() % 8);
+        seatBase = (int)(rng() % (uint32_t)(cfg.slots - cfg.seats * seatStride));
+        bool free = true;
+        for (int s = 0; s < cfg.seats && free; s++)
+            free = !used[(size_t)StackIdx(s)];
+        if (!free)
+            continue;
+        if (potIdx < 0 && (seatBase - 1 - cfg.potSeatGap < 0 || used[(size_t)(seatBase - 1 - cfg.potSeatGap)]))
+            continue;
+        for (int s = 0; s < cfg.seats; s++)
+            Reserve(StackIdx(s));
+        if (potIdx < 0)
+        {
+            potIdx = seatBase - 1 - cfg.potSeatGap;
+            Reserve(potIdx);
+        }
+        break;
+    }
+    mirrorIdx.clear();
+    for (int m = 0; m < cfg.potMirrors; m++)
+        mirrorIdx.push_back(PickFreeIndex());
+
+    // Noise counts are per 2^20 slots.
+    double scale = (double)cfg.slots / (double)(1 << 20);
+    auto scaled = [scale](int n) { return (int)(n * scale); };
+    counterIdx.clear();
+    walkerIdx.clear();
+    for (int i = 0; i < scaled(cfg.counters); i++)
+    {
+        int idx = PickFreeIndex();
+        if (idx < 0)
+            continue;
+        counterIdx.push_back(idx);
+        mem->Set(idx, (int32_t)(rng() % 2000000));
+    }
+    for (int i = 0; i < scaled(cfg.walkers); i++)
+    {
+        int idx = PickFreeIndex();
+        if (idx < 0)
+            continue;
+        walkerIdx.push_back(idx);
+        mem->Set(idx, (int32_t)(500 * (1 + rng() % 400)));
+    }
+    for (int i = 0; i < scaled(cfg.smallInts); i++)
+    {
+        int idx = PickFreeIndex();
+        if (idx >= 0)
+            mem->Set(idx, (int32_t)(1 + rng() % 64));
+    }
+    for (int i = 0; i < scaled(cfg.largeInts); i++)
+    {
+        int idx = PickFreeIndex();
+        if (idx >= 0)
+            mem->Set(idx, (int32_t)(1 + rng() % (uint32_t)cfg.valueMax));
+    }
+    for (int i = 0; i < scaled(cfg.outOfRange); i++)
+    {
+        int idx = PickFreeIndex();
+        if (idx >= 0)
+            mem->SetRaw(idx, ((uint64_t)rng() << 32) | (uint32_t)(cfg.valueMax + 1 + rng() % 0x7F000000u));
+    }
+
+    stacks.assign((size_t)cfg.seats, cfg.startStackCents);
+    folded.assign((size_t)cfg.seats, 0);
+    streetBet.assign((size_t)cfg.seats, 0);
+    potHistory.clear();
+    hands = 0;
+    dealer = 0;
+    nowMs = 0;
+    lastAdvanceMs = 0;
+    ocr = MockOcrSample();
+    ocr.npcCents.assign((size_t)cfg.seats - 1, 0);
+    StartHand();
+    nextOcrMs = cfg.ocrPeriodMs;
+    WriteTable();
+}
+
+void MockTable::StartHand()
+{
+    hands++;
+    pot = 0;
+    street = 0;
+    inPayout = false;
+    dealer = (dealer + 1) % cfg.seats;
+    for (int s = 0; s < cfg.seats; s++)
+    {
+        folded[(size_t)s] = 0;
+        streetBet[(size_t)s] = 0;
+        if (stacks[(size_t)s] < cfg.bigBlindCents * 2)
+            stacks[(size_t)s] = cfg.startStackCents;  // rebuy
+    }
+    auto post = [this](int seat, int amount)
+    {
+        amount = (std::min)(amount, stacks[(size_t)seat]);
+        stacks[(size_t)seat] -= amount;
+        streetBet[(size_t)seat] += amount;
+        pot += amount;
+    };
+    post((dealer + 1) % cfg.seats, cfg.bigBlindCents / 2);
+    post((dealer + 2) % cfg.seats, cfg.bigBlindCents);
+    toCall = cfg.bigBlindCents;
+    actor = (dealer + 3) % cfg.seats;
+    actionsLeft = cfg.seats;
+    nextActionMs = nowMs + cfg.actionMs;
+}
+
+void MockTable::Act()
+{
+    int active = 0;
+    for (unsigned char f : folded)
+        active += f ? 0 : 1;
+    while (folded[(size_t)actor])
+        actor = (actor + 1) % cfg.seats;
+
+    size_t a = (size_t)actor;
+    int owe = toCall - streetBet[a];
+    uint32_t r = rng() % 100;
+    int amount = 0;
+    if (owe > 0 && r < 15)
+    {
+        folded[a] = 1;
+        active--;
+    }
+    else if (r < 80)
+    {
+        amount = owe;
+    }
+    else
+    {
+        amount = owe + cfg.bigBlindCents * (1 + (int)(rng() % 4));
+        actionsLeft = active;  // everyone answers the raise
+    }
+    amount = (std::min)(amount, stacks[a]);
+    stacks[a] -= amount;
+    streetBet[a] += amount;
+    pot += amount;
+    toCall = (std::max)(toCall, streetBet[a]);
+    actor = (actor + 1) % cfg.seats;
+
+    if (--actionsLeft > 0 && active > 1)
+        return;
+    street++;
+    std::fill(streetBet.begin(), streetBet.end(), 0);
+    toCall = 0;
+    actionsLeft = active;
+    if (street >= 4 || active <= 1)
+        inPayout = true;
+}
+
+void MockTable::Payout()
+{
+    std::vector<int> live;
+    for (int s = 0; s < cfg.seats; s++)
+    {
+        if (!folded[(size_t)s])
+            live.push_back(s);
+    }
+    int winner = live[rng() % (uint32_t)live.size()];
+    stacks[(size_t)winner] += pot;
+    pot = 0;
+}
+
+void MockTable::WriteTable()
+{
+    mem->Set(potIdx, pot);
+    for (int s = 0; s < cfg.seats; s++)
+        mem->Set(StackIdx(s), stacks[(size_t)s]);
+
+    if (potHistory.empty() || potHistory.back().pot != pot)
+        potHistory.push_back({ nowMs, pot });
+    uint32_t lagged = (nowMs > cfg.mirrorLagMs) ? nowMs - cfg.mirrorLagMs : 0;
+    size_t keep = 0;
+    while (keep + 1 < potHistory.size() && potHistory[keep + 1].ms <= lagged)
+        keep++;
+    potHistory.erase(potHistory.begin(), potHistory.begin() + (std::ptrdiff_t)keep);
+    int mirror = (potHistory.front().ms <= lagged) ? potHistory.front().pot : 0;
+    for (int idx : mirrorIdx)
+        mem->Set(idx, mirror);
+}
+
+void MockTable::Advance(uint32_t now)
+{
+    while (nextActionMs <= now)
+    {
+        nowMs = nextActionMs;
+        if (inPayout)
+        {
+            Payout();
+            WriteTable();
+            nowMs += cfg.actionMs;  // table pause before the next deal
+            StartHand();
+        }
+        else
+        {
+            Act();
+            if (inPayout)
+                nextActionMs = nowMs + cfg.payoutMs;
+            else
+                nextActionMs = nowMs + cfg.actionMs;
+        }
+        WriteTable();
+    }
+    nowMs = now;
+
+    uint32_t elapsed = now - lastAdvanceMs;
+    lastAdvanceMs = now;
+    for (int idx : counterIdx)
+        mem->Set(idx, mem->Get(idx) + (int32_t)elapsed);
+    for (int idx : walkerIdx)
+    {
+        if (rng() % 2000 != 0)
+            continue;
+        int v = mem->Get(idx) + ((rng() & 1) ? 500 : -500) * (1 + (int)(rng() % 4));
+        mem->Set(idx, (std::max)(500, v));
+    }
+    WriteTable();
+
+    while (nextOcrMs <= now)
+    {
+        nextOcrMs += cfg.ocrPeriodMs;
+        ocr.sampleId++;
+        ocr.potCents = ((int)(rng() % 100) < cfg.ocrMissPct) ? 0 : pot;
+        ocr.playerCents = stacks[(size_t)cfg.playerSeat];
+        size_t n = 0;
+        for (int s = 0; s < cfg.seats; s++)
+        {
+            if (s != cfg.playerSeat)
+                ocr.npcCents[n++] = stacks[(size_t)s];
+        }
+    }
+}
@@ -0,0 +1,152 @@
+/*
+  mock_globals.h
+  - Synthetic GlobalMemory provider for the host-side benchmarks
+  - MockGlobalMemory is one flat slot array (so every 2^18 block is
+    contiguous, like the game's) plus sorted fault ranges; a copy touching a
+    fault range fails the way an SEH-guarded read does in the plugin
+  - MockTable lays a poker table out in it (pot, a strided seat-stack array,
+    noise globals, lagging decoys of the pot) and drives it from a seeded
+    hand script: blinds, bets, calls, folds, showdown payout, rebuys
+  - The OCR view of the table is sampled on its own period, as the plugin's
+    OCR pass would see it
+*/
+
+#pragma once
+
+#include "global_memory.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+class MockGlobalMemory final : public GlobalMemory
+{
+public:
+    // slots zeroed, every index readable.
+    void Init(int slotCount);
+    void AddFaultRange(int start, int end);
+    bool IsFaulting(int idx) const;
+    void SetReady(bool ready) { isReady = ready; }
+
+    int Size() const { return (int)slots.size(); }
+    void Set(int idx, int32_t value) { slots[(size_t)idx] = (slots[(size_t)idx] & ~0xFFFFFFFFull) | (uint32_t)value; }
+    void SetRaw(int idx, uint64_t raw) { slots[(size_t)idx] = raw; }
+    int32_t Get(int idx) const { return (int32_t)(uint32_t)slots[(size_t)idx]; }
+
+    bool Ready() const override { return isReady; }
+    bool Resolve(int idx, const uint64_t*& out) override;
+    bool Copy(const uint64_t* src, int count, uint64_t* out) override;
+    bool Copy(const uint64_t* src, int count, int* out) override;
+    void OnFault(int idx) override { (void)idx; faultEvents++; }
+
+    uint64_t SlotsCopied() const { return slotsCopied; }
+    uint64_t FaultEvents() const { return faultEvents; }
+
+private:
+    bool RangeFaults(int start, int count) const;
+
+    std::vector<uint64_t> slots;
+    std::vector<int> faultStart;  // sorted, disjoint [faultStart[i], faultEnd[i])
+    std::vector<int> faultEnd;
+    bool isReady = true;
+    uint64_t slotsCopied = 0;
+    uint64_t faultEvents = 0;
+};
+
+struct MockTableConfig
+{
+    uint32_t seed = 1;
+    int slots = 1 << 20;          // global index space
+    int seats = 6;
+    int playerSeat = 0;
+    int startStackCents = 50000;
+    int bigBlindCents = 1000;     // bets are whole multiples of $5
+    uint32_t actionMs = 1200;     // time between two seat actions
+    uint32_t payoutMs = 2500;     // showdown to pot cleared
+    uint32_t ocrPeriodMs = 700;
+    int ocrMissPct = 5;           // a sample that fails to read the pot
+    int valueMax = 500000;        // the plugin's ValueMin..ValueMax scan window
+
+    int counters = 2000;          // frame timers: change every Advance
+    int walkers = 4000;           // in-range values stepping on the bet grid now and then
+    int smallInts = 250000;       // constant flags / enums (1..64)
+    int largeInts = 100000;       // constant in-range values
+    int outOfRange = 200000;      // pointers, hashes
+    int potSeatGap = -1;          // >= 0: the pot sits this many slots before the seat array, as
+                                  // members of one script struct; -1: anywhere
+    int potMirrors = 2;           // copies of the pot that trail it by mirrorLagMs
+    uint32_t mirrorLagMs = 2500;
+    int faultRanges = 6;
+    int faultSpan = 4096;
+};
+
+struct MockOcrSample
+{
+    int sampleId = 0;             // bumps every ocrPeriodMs
+    int potCents = 0;             // 0 = not read this sample
+    int playerCents = 0;
+    std::vector<int> npcCents;    // other seats
+};
+
+class MockTable
+{
+public:
+    void Init(const MockTableConfig& cfg, MockGlobalMemory& mem);
+
+    // Runs the hand script up to nowMs and writes every changed global.
+    void Advance(uint32_t nowMs);
+
+    const MockOcrSample& Ocr() const { return ocr; }
+    int PotIdx() const { return potIdx; }
+    int StackIdx(int seat) const { return seatBase + seat * seatStride; }
+    int PlayerIdx() const { return StackIdx(cfg.playerSeat); }
+    int SeatStride() const { return seatStride; }
+    const std::vector<int>& MirrorIdx() const { return mirrorIdx; }
+    int Hands() const { return hands; }
+    int Pot() const { return pot; }
+
+private:
+    int PickFreeIndex();
+    bool Reserve(int idx);
+    void StartHand();
+    void Act();
+    void Payout();
+    void WriteTable();
+
+    MockTableConfig cfg;
+    MockGlobalMemory* mem = nullptr;
+    std::mt19937 rng;
+    std::vector<unsigned char> used;
+
+    int potIdx = -1;
+    int seatBase = -1;
+    int seatStride = 1;
+    std::vector<int> mirrorIdx;
+    std::vector<int> counterIdx;
+    std::vector<int> walkerIdx;
+
+    std::vector<int> stacks;
+    std::vector<unsigned char> folded;
+    std::vector<int> streetBet;   // per seat, this street
+    int pot = 0;
+    int toCall = 0;
+    int street = 0;
+    int actor = 0;
+    int actionsLeft = 0;          // on this street
+    int dealer = 0;
+    int hands = 0;
+    bool inPayout = false;
+
+    struct PotHistory
+    {
+        uint32_t ms = 0;
+        int pot = 0;
+    };
+    std::vector<PotHistory> potHistory;  // pot changes, trimmed to mirrorLagMs
+
+    uint32_t nowMs = 0;
+    uint32_t nextActionMs = 0;
+    uint32_t nextOcrMs = 0;
+    uint32_t lastAdvanceMs = 0;
+    MockOcrSample ocr;
+};
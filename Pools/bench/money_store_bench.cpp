@@ -0,0 +1,217 @@
+/*
+  money_store_bench.cpp
+  - Host-side benchmark: candidate rescan cost per 10k candidates
+  - "legacy" is the old std::unordered_map<int, MoneyCandidate> layout with one
+    read per candidate; "store" is MoneyCandidateStore with the same per-slot
+    reads; "store+bulk" adds the coalesced span reads used by RescanExistingCandidates
+  - The global table is simulated as a block-paged array, like the game's
+
+  Build (from Pools/):
+    g++ -std=c++20 -O2 -I. bench/money_store_bench.cpp money_store.cpp -o money_store_bench
+*/
+
+#include "money_store.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+static const int kBlockShift = 18;
+static const int kGlobalCount = 4 << kBlockShift;
+static const int kSparseMaxGap = 32;
+
+static std::vector<std::vector<uint64_t>> gBlocks;
+static std::vector<uint64_t*> gBlockTable;
+
+static void InitGlobals(std::mt19937& rng)
+{
+    gBlocks.resize((size_t)(kGlobalCount >> kBlockShift));
+    gBlockTable.resize(gBlocks.size());
+    for (size_t b = 0; b < gBlocks.size(); b++)
+    {
+        gBlocks[b].resize((size_t)1 << kBlockShift);
+        for (uint64_t& v : gBlocks[b])
+            v = rng() % 120000;
+        gBlockTable[b] = gBlocks[b].data();
+    }
+}
+
+// Mirrors getGlobalPtr + a protected single-slot read.
+static __attribute__((noinline)) bool ReadOne(int idx, int& out)
+{
+    uint64_t* block = gBlockTable[(size_t)(idx >> kBlockShift)];
+    if (!block)
+        return false;
+    out = (int)(uint32_t)block[idx & ((1 << kBlockShift) - 1)];
+    return true;
+}
+
+// Mirrors ReadGlobalIndices: neighbouring indices share one span copy.
+static void ReadIndices(const int* idx, int n, int* outVals, unsigned char* outOk)
+{
+    int i = 0;
+    while (i < n)
+    {
+        int j = i;
+        while (j + 1 < n && idx[j + 1] - idx[j] <= kSparseMaxGap &&
+            (idx[j + 1] >> kBlockShift) == (idx[i] >> kBlockShift))
+            j++;
+        const uint64_t* block = gBlockTable[(size_t)(idx[i] >> kBlockShift)];
+        int base = idx[i] & ((1 << kBlockShift) - 1);
+        for (int k = i; k <= j; k++)
+        {
+            outVals[k] = (int)(uint32_t)block[base + (idx[k] - idx[i])];
+            outOk[k] = 1;
+        }
+        i = j + 1;
+    }
+}
+
+static void MutateGlobals(std::mt19937& rng, int count)
+{
+    for (int k = 0; k < count; k++)
+    {
+        int i = (int)(rng() % (uint32_t)kGlobalCount);
+        gBlockTable[(size_t)(i >> kBlockShift)][i & ((1 << kBlockShift) - 1)] = rng() % 151000;
+    }
+}
+
+static inline void ApplyChange(int val, int& last, int& lastDelta, int& changes, int& stepOk, int& stepBad, uint32_t& lastChangeMs, uint32_t now)
+{
+    if (val == last)
+        return;
+    int delta = val - last;
+    changes++;
+    lastDelta = delta;
+    if (((delta < 0) ? -delta : delta) % 500 == 0)
+        stepOk++;
+    else
+        stepBad++;
+    last = val;
+    lastChangeMs = now;
+}
+
+static double RescanLegacy(std::unordered_map<int, MoneyCandidate>& cands, uint32_t now)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<int> toRemove;
+    for (auto& kv : cands)
+    {
+        MoneyCandidate& c = kv.second;
+        int val = 0;
+        if (!ReadOne(c.idx, val) || val > 150000)
+        {
+            toRemove.push_back(kv.first);
+            continue;
+        }
+        c.lastSeenMs = now;
+        ApplyChange(val, c.last, c.lastDelta, c.changes, c.betStepMatches, c.betStepMismatches, c.lastChangeMs, now);
+    }
+    for (int idx : toRemove)
+        cands.erase(idx);
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count();
+}
+
+static double RescanStore(MoneyCandidateStore& s, uint32_t now, bool bulk)
+{
+    static std::vector<int> vals;
+    static std::vector<unsigned char> ok;
+    static std::vector<unsigned char> dead;
+
+    auto t0 = std::chrono::steady_clock::now();
+    int n = s.Size();
+    vals.resize((size_t)n);
+    ok.resize((size_t)n);
+    if (bulk)
+        ReadIndices(s.idx.data(), n, vals.data(), ok.data());
+    else
+        for (int k = 0; k < n; k++)
+            ok[(size_t)k] = ReadOne(s.idx[(size_t)k], vals[(size_t)k]) ? 1 : 0;
+
+    dead.assign((size_t)n, 0);
+    bool anyDead = false;
+    for (size_t k = 0; k < (size_t)n; k++)
+    {
+        int val = vals[k];
+        if (!ok[k] || val > 150000)
+        {
+            dead[k] = 1;
+            anyDead = true;
+            continue;
+        }
+        s.lastSeenMs[k] = now;
+        ApplyChange(val, s.last[k], s.lastDelta[k], s.changes[k], s.betStepMatches[k], s.betStepMismatches[k], s.lastChangeMs[k], now);
+    }
+    if (anyDead)
+        s.Compact(dead);
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count();
+}
+
+// Candidates cluster like real money globals: short runs inside a few hot regions.
+static std::vector<int> MakeCandidateIndices(std::mt19937& rng, int count)
+{
+    std::vector<int> out;
+    std::vector<unsigned char> used((size_t)kGlobalCount, 0);
+    while ((int)out.size() < count)
+    {
+        int base = (int)(rng() % (uint32_t)(kGlobalCount - 4096));
+        int run = 4 + (int)(rng() % 60);
+        for (int k = 0; k < run && (int)out.size() < count; k++)
+        {
+            int i = base + k * (1 + (int)(rng() % 4));
+            if (used[(size_t)i])
+                continue;
+            used[(size_t)i] = 1;
+            out.push_back(i);
+        }
+    }
+    return out;
+}
+
+int main(int argc, char** argv)
+{
+    int rounds = (argc > 1) ? atoi(argv[1]) : 50;
+    std::mt19937 rng(1234);
+    InitGlobals(rng);
+
+    printf("%-10s %14s %14s %14s\n", "cands", "legacy us/10k", "store us/10k", "bulk us/10k");
+    for (int count : { 10000, 50000, 100000 })
+    {
+        std::vector<int> indices = MakeCandidateIndices(rng, count);
+
+        std::unordered_map<int, MoneyCandidate> legacy;
+        std::vector<MoneyCandidate> rows;
+        for (int i : indices)
+        {
+            MoneyCandidate mc;
+            mc.idx = i;
+            ReadOne(i, mc.last);
+            legacy[i] = mc;
+            rows.push_back(mc);
+        }
+        std::sort(rows.begin(), rows.end(), [](const MoneyCandidate& a, const MoneyCandidate& b) { return a.idx < b.idx; });
+        MoneyCandidateStore store;
+        MoneyCandidateStore storeBulk;
+        store.InsertSorted(rows);
+        storeBulk.InsertSorted(rows);
+
+        double tLegacy = 0.0, tStore = 0.0, tBulk = 0.0;
+        for (int r = 0; r < rounds; r++)
+        {
+            MutateGlobals(rng, 20000);
+            uint32_t now = 1000u + (uint32_t)r * 16u;
+            tLegacy += RescanLegacy(legacy, now);
+            tStore += RescanStore(store, now, false);
+            tBulk += RescanStore(storeBulk, now, true);
+        }
+        double per10k = 10000.0 / (double)count / (double)rounds;
+        printf("%-10d %14.1f %14.1f %14.1f\n", count, tLegacy * per10k, tStore * per10k, tBulk * per10k);
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*
+  narrowing_bench.cpp
+  - Host-side benchmark: NarrowingSearch step cost and survivor count per hand
+  - 100k simulated globals, one of which tracks a pot. Between OCR samples a
+    share of the noise values drift; each "hand" applies the plugin's auto
+    step pair (changed-by OCR delta, then equals OCR pot)
+  - Prints microseconds per step and survivors after each step; also checks
+    the alive set against a brute-force filter
+
+  Build (from Pools/):
+    g++ -std=c++20 -O2 -I. bench/narrowing_bench.cpp narrowing.cpp -o narrowing_bench
+*/
+
+#include "narrowing.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static const int kCount = 100000;
+static const int kPotSlot = 61234;
+static const int kTol = 6;
+
+static double TimeUs(std::chrono::steady_clock::time_point t0)
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char** argv)
+{
+    int hands = (argc > 1) ? atoi(argv[1]) : 8;
+    std::mt19937 rng(99);
+    std::vector<int> values((size_t)kCount);
+    for (int& v : values)
+        v = (int)(rng() % 200000);
+    std::vector<uint64_t> faults((size_t)((kCount + 63) >> 6), 0);
+    for (int k = 0; k < kCount; k += 4093)
+        faults[(size_t)k >> 6] |= 1ull << (k & 63);
+
+    int potCents = 1500;
+    values[kPotSlot] = potCents;
+
+    NarrowingSearch search;
+    auto t0 = std::chrono::steady_clock::now();
+    search.Begin(0, kCount, values.data(), faults.data(), 1, 500000);
+    printf("%-8s %-12s %10s %10s\n", "hand", "step", "us", "alive");
+    printf("%-8s %-12s %10.1f %10d\n", "-", "begin", TimeUs(t0), search.AliveCount());
+
+    std::vector<int> shadow(values);
+    std::vector<unsigned char> alive((size_t)kCount, 0);
+    for (int k = 0; k < kCount; k++)
+        alive[(size_t)k] = !((faults[(size_t)k >> 6] >> (k & 63)) & 1ull) && values[(size_t)k] >= 1;
+
+    bool ok = true;
+    for (int h = 1; h <= hands; h++)
+    {
+        // Noise drifts; some of it moves by bet-sized amounts too.
+        for (int k = 0; k < kCount; k++)
+        {
+            uint32_t r = rng() % 100;
+            if (r < 30)
+                values[(size_t)k] += (int)(rng() % 2000) - 1000;
+            else if (r < 35)
+                values[(size_t)k] += 500 * (1 + (int)(rng() % 4));
+        }
+        int bet = 500 * (1 + (int)(rng() % 6));
+        potCents += bet;
+        values[kPotSlot] = potCents;
+        int amounts[1] = { potCents };
+
+        NarrowStep delta;
+        delta.pred = NARROW_CHANGED_BY;
+        delta.deltaCents = bet;
+        delta.toleranceCents = kTol;
+        t0 = std::chrono::steady_clock::now();
+        search.Step(delta, values.data(), faults.data());
+        printf("%-8d %-12s %10.1f %10d\n", h, NarrowPredicateName(delta.pred), TimeUs(t0), search.AliveCount());
+
+        NarrowStep equals;
+        equals.pred = NARROW_EQUALS;
+        equals.amountsCents = amounts;
+        equals.amountCount = 1;
+        equals.toleranceCents = kTol;
+        t0 = std::chrono::steady_clock::now();
+        search.Step(equals, values.data(), faults.data());
+        printf("%-8d %-12s %10.1f %10d\n", h, NarrowPredicateName(equals.pred), TimeUs(t0), search.AliveCount());
+
+        // Brute force reference.
+        int expect = 0;
+        for (int k = 0; k < kCount; k++)
+        {
+            if (!alive[(size_t)k])
+                continue;
+            long long d = (long long)values[(size_t)k] - shadow[(size_t)k];
+            long long v = values[(size_t)k];
+            bool keep = (llabs(d - bet) <= kTol || llabs(d * 100 - bet) <= kTol) &&
+                (llabs(v - potCents) <= kTol || llabs(v * 100 - potCents) <= kTol);
+            alive[(size_t)k] = keep;
+            if (keep)
+                shadow[(size_t)k] = values[(size_t)k];
+            expect += keep;
+        }
+        if (expect != search.AliveCount())
+            ok = false;
+    }
+
+    std::vector<int> survivors;
+    search.AliveIndices(survivors, 8);
+    printf("survivors:");
+    for (int idx : survivors)
+        printf(" %d", idx);
+    printf("  (pot slot %d)\n", kPotSlot);
+    printf("brute-force check: %s\n", ok ? "ok" : "MISMATCH");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+/*
+  ocr_amount_index_bench.cpp
+  - Host-side benchmark: matching candidate values against one OCR sample,
+    the per-amount loop ComputeOcrMatchBits used before vs OcrAmountIndex
+  - 50k candidate values (default): mostly unrelated ints, some near an OCR
+    amount as cents, some as dollars, so every match path is exercised
+  - Each row is one OCR sample with N amounts (a fifth of them NPC stacks,
+    plus player and four pot refs, one of them next to the player stack);
+    ns per candidate is the best of several rounds, and every value's bits
+    must agree between the two
+  - Tolerance is OcrMatchToleranceCents' default (6) unless given
+
+  Build (from Pools/):
+    g++ -std=c++20 -O2 -I. bench/ocr_amount_index_bench.cpp ocr_amount_index.cpp -o ocr_amount_index_bench
+  Run:
+    ocr_amount_index_bench [candidates] [tolCents]
+*/
+
+#include "ocr_amount_index.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+struct Sample
+{
+    std::vector<int> amounts;
+    int player = -1;
+    int potRefs[4] = { -1, -1, -1, -1 };
+    std::vector<int> npc;
+};
+
+// The loop ComputeOcrMatchBits ran per candidate.
+static int LinearMatchBits(int value, const Sample& s, int tol)
+{
+    if (s.amounts.empty())
+        return 0;
+    int bits = 0;
+    for (int amount : s.amounts)
+    {
+        if (OcrAmountMatches(value, amount, tol))
+        {
+            bits |= OCR_MATCH_ANY;
+            break;
+        }
+    }
+    bool playerMatch = false;
+    if (s.player > 0 && OcrAmountMatches(value, s.player, tol))
+    {
+        playerMatch = true;
+        bits |= OCR_MATCH_PLAYER;
+    }
+    for (int ref : s.potRefs)
+    {
+        if (ref <= 0)
+            continue;
+        if (s.player > 0 && OcrAmountMatches(ref, s.player, tol) && playerMatch)
+            continue;
+        if (OcrAmountMatches(value, ref, tol))
+        {
+            bits |= OCR_MATCH_POT;
+            break;
+        }
+    }
+    for (int npc : s.npc)
+    {
+        if (OcrAmountMatches(value, npc, tol))
+        {
+            bits |= OCR_MATCH_NPC;
+            break;
+        }
+    }
+    return bits;
+}
+
+static Sample MakeSample(std::mt19937& rng, int n, int tol)
+{
+    Sample s;
+    for (int i = 0; i < n; i++)
+        s.amounts.push_back(100 + (int)(rng() % 2000000));
+    s.player = s.amounts[0];
+    s.potRefs[0] = s.amounts[1 % n];
+    s.potRefs[1] = s.player + tol / 2;  // next to the player stack: pot only if the value is not the player's
+    s.potRefs[2] = (n > 2) ? s.amounts[2] : -1;
+    for (int i = 3; i < n; i += 5)
+        s.npc.push_back(s.amounts[(size_t)i]);
+    return s;
+}
+
+static std::vector<int> MakeValues(std::mt19937& rng, const Sample& s, int count, int tol)
+{
+    std::vector<int> values((size_t)count);
+    for (int& v : values)
+    {
+        int a = s.amounts[rng() % s.amounts.size()];
+        int jitter = (int)(rng() % (uint32_t)(2 * tol + 3)) - tol - 1;  // just inside or outside
+        switch (rng() % 10)
+        {
+        case 0:
+            v = a + jitter;
+            break;
+        case 1:
+            v = a / 100 + (jitter % 2);  // dollar-based global
+            break;
+        default:
+            v = (int)(rng() % 50000000) - 1000;
+            break;
+        }
+    }
+    return values;
+}
+
+template <class F>
+static double BestNsPerValue(int rounds, int count, F&& f)
+{
+    double best = 1e30;
+    for (int r = 0; r < rounds; r++)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        auto t1 = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / (double)count;
+        if (ns < best)
+            best = ns;
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    int count = (argc > 1) ? atoi(argv[1]) : 50000;
+    int tol = (argc > 2) ? atoi(argv[2]) : 6;
+    const int rounds = 7;
+    int bad = 0;
+    printf("candidates=%d tol=%d\n", count, tol);
+    printf("%8s %12s %12s %12s %9s %8s %s\n", "amounts", "linear ns", "index ns", "build us", "speedup", "matches", "check");
+    for (int n : { 4, 16, 64, 256, 1024 })
+    {
+        std::mt19937 rng(1234 + n);
+        Sample s = MakeSample(rng, n, tol);
+        std::vector<int> values = MakeValues(rng, s, count, tol);
+        std::vector<int> linearBits((size_t)count);
+        std::vector<int> indexBits((size_t)count);
+
+        double linearNs = BestNsPerValue(rounds, count, [&]
+        {
+            for (int i = 0; i < count; i++)
+                linearBits[(size_t)i] = LinearMatchBits(values[(size_t)i], s, tol);
+        });
+
+        OcrAmountIndex index;
+        auto b0 = std::chrono::steady_clock::now();
+        index.Build(tol, s.amounts, s.player, s.potRefs, 4, s.npc);
+        double buildUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - b0).count();
+        double indexNs = BestNsPerValue(rounds, count, [&]
+        {
+            for (int i = 0; i < count; i++)
+                indexBits[(size_t)i] = index.Match(values[(size_t)i]);
+        });
+
+        int matches = 0;
+        int wrong = 0;
+        for (int i = 0; i < count; i++)
+        {
+            matches += linearBits[(size_t)i] ? 1 : 0;
+            wrong += (linearBits[(size_t)i] != indexBits[(size_t)i]) ? 1 : 0;
+        }
+        bad += wrong;
+        printf("%8d %12.2f %12.2f %12.1f %8.1fx %8d %s\n", n, linearNs, indexNs, buildUs,
+            linearNs / (indexNs > 0.0 ? indexNs : 1e-9), matches, wrong ? "WRONG" : "ok");
+    }
+    return bad == 0 ? 0 : 1;
+}
@@ -0,0 +1,308 @@
+/*
+  ocr_worker_bench.cpp
+  - Host-side (POSIX) driver for the highstakes_ocr worker built with the stub
+    recognizer: plays the plugin's side of ocr_ipc.h over shm_open memory and
+    the worker's stdin/stdout, one cycle in flight at a time like
+    OcrWorkerBackend
+  - Every cycle plants a few dark "words" on a light background in both
+    regions (sizes of the default BottomLeft/TopRight zones at 1080p) and
+    checks that the RESULT carries exactly those boxes; a fifth of the cycles
+    are abandoned before their result is read, like a timed-out cycle, and
+    their late results must be dropped by request id. As in the plugin, the
+    next cycle waits for the abandoned result
+  - Every 25th cycle names a request id the slot does not carry; the worker
+    must answer with an empty RESULT and still release the slot. Any cycle
+    that finds no free slot is a leak and fails the run
+  - Prints submit-to-result latency percentiles; that is the IPC and
+    threading overhead the worker adds on top of recognition
+
+  Build (from Pools/):
+    g++ -std=c++20 -O2 -I. tools/highstakes_ocr.cpp ocr_ipc.cpp -o highstakes_ocr -pthread
+    g++ -std=c++20 -O2 -I. bench/ocr_worker_bench.cpp ocr_ipc.cpp -o ocr_worker_bench
+  Run:
+    ocr_worker_bench [./highstakes_ocr] [cycles]
+*/
+
+#include "ocr_ipc.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+struct Worker
+{
+    pid_t pid = -1;
+    int toWorker = -1;
+    int fromWorker = -1;
+};
+
+static bool SpawnWorker(const char* exe, const std::string& shm, size_t bytes, Worker& w)
+{
+    int in[2];
+    int out[2];
+    if (pipe(in) != 0 || pipe(out) != 0)
+        return false;
+    std::string bytesArg = std::to_string(bytes);
+    w.pid = fork();
+    if (w.pid < 0)
+        return false;
+    if (w.pid == 0)
+    {
+        dup2(in[0], 0);
+        dup2(out[1], 1);
+        close(in[0]);
+        close(in[1]);
+        close(out[0]);
+        close(out[1]);
+        execl(exe, exe, "--shm", shm.c_str(), "--bytes", bytesArg.c_str(), (char*)nullptr);
+        _exit(127);
+    }
+    close(in[0]);
+    close(out[1]);
+    w.toWorker = in[1];
+    w.fromWorker = out[0];
+    return true;
+}
+
+static bool Send(int fd, const std::string& bytes)
+{
+    size_t done = 0;
+    while (done < bytes.size())
+    {
+        ssize_t n = write(fd, bytes.data() + done, bytes.size() - done);
+        if (n <= 0)
+            return false;
+        done += (size_t)n;
+    }
+    return true;
+}
+
+// Next message, waiting up to timeoutMs. false = timeout, EOF or a broken stream.
+static bool Receive(int fd, OcrIpcDecoder& decoder, OcrIpcMessage& msg, int timeoutMs)
+{
+    char buf[4096];
+    while (!decoder.Next(msg))
+    {
+        if (decoder.Broken())
+            return false;
+        pollfd p{ fd, POLLIN, 0 };
+        if (poll(&p, 1, timeoutMs) <= 0)
+            return false;
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n <= 0)
+            return false;
+        decoder.Feed(buf, (size_t)n);
+    }
+    return true;
+}
+
+static void Plant(OcrImage& img, std::mt19937& rng, std::vector<OcrWord>& words)
+{
+    std::fill(img.pixels.begin(), img.pixels.end(), (unsigned char)220);
+    words.clear();
+    int lineH = 18;
+    for (int y = 10; y + lineH < img.height; y += lineH * 3)
+    {
+        int x = 8 + (int)(rng() % 16);
+        while (true)
+        {
+            int w = 12 + (int)(rng() % 60);
+            if (x + w + 8 >= img.width)
+                break;
+            for (int yy = y; yy < y + lineH; yy++)
+            {
+                unsigned char* row = img.pixels.data() + (size_t)yy * (size_t)img.stride;
+                memset(row + x * 3, 30, (size_t)w * 3);
+            }
+            words.push_back({ std::to_string(w) + "x" + std::to_string(lineH), x, y, w, lineH, 100.0f });
+            x += w + lineH + (int)(rng() % 30);  // gap wider than a third of the line height
+        }
+        if (rng() % 3 == 0)
+            break;  // uneven line counts
+    }
+}
+
+static bool SameBoxes(const std::vector<OcrWord>& a, const std::vector<OcrWord>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (a[i].x != b[i].x || a[i].y != b[i].y || a[i].w != b[i].w || a[i].h != b[i].h || a[i].text != b[i].text)
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    const char* exe = (argc > 1) ? argv[1] : "./highstakes_ocr";
+    int cycles = (argc > 2) ? atoi(argv[2]) : 500;
+    signal(SIGPIPE, SIG_IGN);
+
+    OcrImage rois[OCR_ROI_COUNT];
+    rois[OCR_ROI_BOTTOM_LEFT].Resize(653, 713);
+    rois[OCR_ROI_TOP_RIGHT].Resize(538, 324);
+    const int slots = 3;
+    size_t bytes = OcrIpcRingBytes(slots, OcrIpcSlotBytesFor(rois));
+
+    std::string shm = "/highstakes_ocr_bench_" + std::to_string(getpid());
+    int fd = shm_open(shm.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0 || ftruncate(fd, (off_t)bytes) != 0)
+    {
+        fprintf(stderr, "shm_open failed\n");
+        return 2;
+    }
+    void* view = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    OcrIpcRing ring;
+    if (view == MAP_FAILED || !ring.Create(view, bytes, slots))
+    {
+        fprintf(stderr, "ring setup failed\n");
+        shm_unlink(shm.c_str());
+        return 2;
+    }
+
+    Worker w;
+    OcrIpcDecoder decoder;
+    OcrIpcMessage msg;
+    bool started = SpawnWorker(exe, shm, bytes, w) && Receive(w.fromWorker, decoder, msg, 5000) && msg.type == OCR_IPC_HELLO;
+    shm_unlink(shm.c_str());  // both sides have it mapped (or the worker failed)
+    if (!started)
+    {
+        fprintf(stderr, "worker '%s' did not say hello\n", exe);
+        return 2;
+    }
+    printf("worker=%s recognizer='%s' ring=%zu bytes slots=%d\n", exe, msg.payload.c_str(), bytes, slots);
+
+    std::mt19937 rng(99);
+    std::vector<OcrWord> planted[OCR_ROI_COUNT];
+    std::vector<double> latUs;
+    OcrCycleResult result;
+    std::string out;
+    uint32_t nextId = 0;
+    int wrong = 0;
+    int abandoned = 0;
+    int lateDropped = 0;
+    int noSlot = 0;
+    int mismatched = 0;
+    uint32_t waitFor = 0;  // abandoned request whose result is still owed
+    for (int c = 0; c < cycles; c++)
+    {
+        for (int r = 0; r < OCR_ROI_COUNT; r++)
+            Plant(rois[r], rng, planted[r]);
+
+        // Busy until the abandoned request's result arrives, like OcrWorkerBackend::Busy.
+        while (waitFor && Receive(w.fromWorker, decoder, msg, 5000))
+        {
+            if (msg.type == OCR_IPC_RESULT && msg.requestId == waitFor)
+            {
+                lateDropped++;
+                waitFor = 0;
+            }
+        }
+
+        // Drain anything already here (late results of abandoned cycles) before picking a slot.
+        while (true)
+        {
+            pollfd p{ w.fromWorker, POLLIN, 0 };
+            if (decoder.Next(msg))
+            {
+                lateDropped++;
+                continue;
+            }
+            if (poll(&p, 1, 0) <= 0)
+                break;
+            char buf[4096];
+            ssize_t n = read(w.fromWorker, buf, sizeof(buf));
+            if (n <= 0)
+                break;
+            decoder.Feed(buf, (size_t)n);
+        }
+        int slot = ring.FindFree();
+        if (slot < 0)
+        {
+            noSlot++;
+            usleep(1000);
+            continue;
+        }
+
+        uint32_t id = ++nextId;
+        auto t0 = std::chrono::steady_clock::now();
+        bool mismatch = (c % 25) == 24;
+        ring.Write(slot, mismatch ? id + 0x40000000u : id, 11, rois, kOcrAllRois);
+        out.clear();
+        uint32_t s = (uint32_t)slot;
+        OcrIpcAppendMessage(out, OCR_IPC_SUBMIT, id, &s, sizeof(s));
+        Send(w.toWorker, out);
+        if (mismatch)
+        {
+            mismatched++;
+            bool answered = false;
+            while (Receive(w.fromWorker, decoder, msg, 5000))
+            {
+                if (msg.type == OCR_IPC_RESULT && msg.requestId == id)
+                {
+                    answered = OcrIpcDecodeResult(msg.payload, result) && !result.ok[0] && !result.ok[1];
+                    break;
+                }
+            }
+            if (!answered)
+                wrong++;
+            continue;
+        }
+        if (rng() % 5 == 0)
+        {
+            abandoned++;
+            waitFor = id;
+            continue;
+        }
+
+        bool got = false;
+        while (Receive(w.fromWorker, decoder, msg, 5000))
+        {
+            if (msg.type != OCR_IPC_RESULT)
+                continue;
+            if (msg.requestId != id)
+            {
+                lateDropped++;
+                continue;
+            }
+            got = OcrIpcDecodeResult(msg.payload, result);
+            break;
+        }
+        latUs.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count());
+        if (!got || !result.ok[0] || !result.ok[1] ||
+            !SameBoxes(result.words[0], planted[0]) || !SameBoxes(result.words[1], planted[1]))
+            wrong++;
+    }
+
+    out.clear();
+    OcrIpcAppendMessage(out, OCR_IPC_QUIT, 0, nullptr, 0);
+    Send(w.toWorker, out);
+    close(w.toWorker);
+    int status = 0;
+    waitpid(w.pid, &status, 0);
+    close(w.fromWorker);
+    munmap(view, bytes);
+
+    std::sort(latUs.begin(), latUs.end());
+    auto pct = [&](double p) { return latUs.empty() ? 0.0 : latUs[(size_t)(p * (double)(latUs.size() - 1))]; };
+    printf("cycles=%d measured=%zu abandoned=%d lateDropped=%d mismatched=%d noSlot=%d wrong=%d exit=%d\n",
+        cycles, latUs.size(), abandoned, lateDropped, mismatched, noSlot, wrong,
+        WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+    printf("round trip us: p50=%.0f p95=%.0f p99=%.0f max=%.0f\n", pct(0.50), pct(0.95), pct(0.99), pct(1.0));
+    return (wrong == 0 && noSlot == 0) ? 0 : 1;
+}
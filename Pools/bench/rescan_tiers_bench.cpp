@@ -0,0 +1,125 @@
+/*
+  rescan_tiers_bench.cpp
+  - Host-side benchmark: worst read age per tier for the tiered rescan planner
+    against the old prefix rescan (first ScanMaxReadsPerStep slots only)
+  - 200k candidates, 3 locked watch globals, 512 OCR-correlated candidates,
+    ScanMaxReadsPerStep=16384, a step every 10 ms for 10 s; discovery inserts
+    a few hundred candidates per step throughout
+  - Prints plan cost per step, per-tier max age / lap, and how many candidates
+    the prefix rescan never read
+
+  Build (from Pools/):
+    g++ -std=c++20 -O2 -I. bench/rescan_tiers_bench.cpp rescan_tiers.cpp money_store.cpp -o rescan_tiers_bench
+*/
+
+#include "rescan_tiers.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static const int kRange = 4000000;
+static const int kLocked = 3;
+static const int kHot = 512;
+static const int kMaxReads = 16384;
+static const uint32_t kStepMs = 10;
+static const uint32_t kColdMaxAgeMs = 2000;
+
+static void InsertRandom(MoneyCandidateStore& s, std::mt19937& rng, int count, uint32_t now)
+{
+    std::vector<MoneyCandidate> rows;
+    for (int i = 0; i < count; i++)
+    {
+        int idx = (int)(rng() % kRange);
+        if (s.Contains(idx))
+            continue;
+        MoneyCandidate c;
+        c.idx = idx;
+        c.firstSeenMs = now;
+        c.lastSeenMs = now;
+        rows.push_back(c);
+    }
+    std::sort(rows.begin(), rows.end(), [](const MoneyCandidate& a, const MoneyCandidate& b) { return a.idx < b.idx; });
+    rows.erase(std::unique(rows.begin(), rows.end(),
+        [](const MoneyCandidate& a, const MoneyCandidate& b) { return a.idx == b.idx; }), rows.end());
+    s.InsertSorted(rows);
+}
+
+int main(int argc, char** argv)
+{
+    int cands = (argc > 1) ? atoi(argv[1]) : 200000;
+    std::mt19937 rng(11);
+
+    MoneyCandidateStore tiered;
+    InsertRandom(tiered, rng, cands, 0);
+    MoneyCandidateStore prefix = tiered;
+
+    RescanTiers tiers;
+    tiers.Reset(0);
+    std::vector<int> locked;
+    for (int i = 0; i < kLocked; i++)
+        locked.push_back(tiered.idx[(size_t)(rng() % (uint32_t)tiered.Size())]);
+    tiers.SetLocked(locked);
+    for (int i = 0; i < kHot; i++)
+        tiers.MarkHot(tiered.idx[(size_t)(rng() % (uint32_t)tiered.Size())]);
+
+    RescanBudget budget;
+    budget.maxReads = kMaxReads;
+    budget.stepIntervalMs = kStepMs;
+    budget.coldMaxAgeMs = kColdMaxAgeMs;
+
+    std::vector<int> slots;
+    std::vector<uint8_t> tierOf;
+    uint32_t worst[RESCAN_TIER_COUNT] = {};
+    double planUs = 0.0;
+    int steps = 0;
+    for (uint32_t now = kStepMs; now <= 10000; now += kStepMs)
+    {
+        std::mt19937 insertRng(now);
+        InsertRandom(tiered, insertRng, 300, now);
+        insertRng.seed(now);
+        InsertRandom(prefix, insertRng, 300, now);
+
+        auto t0 = std::chrono::steady_clock::now();
+        tiers.Plan(tiered, budget, now, slots, tierOf);
+        planUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+        steps++;
+        for (size_t i = 0; i < slots.size(); i++)
+        {
+            size_t k = (size_t)slots[i];
+            uint32_t age = now - tiered.lastSeenMs[k];
+            tiers.OnRead(tierOf[i], age);
+            if (now > kColdMaxAgeMs && age > worst[tierOf[i]])
+                worst[tierOf[i]] = age;  // past the first lap, inserts and all
+            tiered.lastSeenMs[k] = now;
+        }
+
+        int n = (std::min)(prefix.Size(), kMaxReads);
+        std::fill(prefix.lastSeenMs.begin(), prefix.lastSeenMs.begin() + n, now);
+    }
+
+    const RescanTierMetrics& m = tiers.Metrics();
+    printf("candidates=%d (after inserts) reads/step=%d step=%ums\n", tiered.Size(), kMaxReads, kStepMs);
+    printf("plan: %.1f us per step\n", planUs / steps);
+    const char* names[RESCAN_TIER_COUNT] = { "locked", "hot", "cold" };
+    for (int t = 0; t < RESCAN_TIER_COUNT; t++)
+    {
+        printf("%-6s count=%d reads=%d maxAge=%ums (run worst %ums) lap=%ums\n",
+            names[t], m.count[t], m.reads[t], m.maxAgeMs[t], worst[t], m.lapMs[t]);
+    }
+
+    int never = 0;
+    uint32_t prefixWorst = 0;
+    for (int k = 0; k < prefix.Size(); k++)
+    {
+        uint32_t age = 10000 - prefix.lastSeenMs[(size_t)k];
+        if (prefix.lastSeenMs[(size_t)k] == prefix.firstSeenMs[(size_t)k])
+            never++;
+        prefixWorst = (std::max)(prefixWorst, age);
+    }
+    printf("prefix rescan: %d/%d candidates never re-read, worst age %ums\n", never, prefix.Size(), prefixWorst);
+    return worst[RESCAN_TIER_COLD] <= kColdMaxAgeMs + kStepMs ? 0 : 1;
+}
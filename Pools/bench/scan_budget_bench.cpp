@@ -0,0 +1,140 @@
+/*
+  scan_budget_bench.cpp
+  - Host-side benchmark: scan step time against ScanBudgetUs with the rescan
+    sized by ScanScheduler::RescansForBudget, next to the old uncapped rescan
+    (min(candidates, ScanMaxReadsPerStep) every step)
+  - Step logic mirrors MoneyScanStep: discovery reserves room for the rescan
+    (at most half the budget) and reads budgeted chunks, then the rescan gets
+    what is left of the step
+  - Costs come from a synthetic model (per read, per rescanned candidate, per
+    step overhead, each with +-25% noise) on a simulated clock, so the run is
+    deterministic; the scheduler only ever sees the measured times
+  - 200k candidates, ScanBudgetUs=300, ScanMaxReadsPerStep=16384. Prints the
+    first steps (the scheduler learning its costs) and the steady state
+
+  Build (from Pools/):
+    g++ -std=c++20 -O2 -I. bench/scan_budget_bench.cpp scan_scheduler.cpp -o scan_budget_bench
+*/
+
+#include "scan_scheduler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static const int kCandidates = 200000;
+static const int kMaxReadsPerStep = 16384;
+static const int kScanBatch = 16384;
+static const int64_t kBudgetUs = 300;
+static const int kSteps = 2000;
+static const int kWarmupSteps = 50;
+static const double kReadNs = 40.0;
+static const double kRescanNs = 150.0;
+static const double kStepOverheadUs = 8.0;
+
+struct SimClock
+{
+    double us = 0.0;
+    std::mt19937 rng{ 42 };
+
+    // Advances by cost +-25% and returns the elapsed whole microseconds, as QPC would report.
+    int64_t Spend(double costUs)
+    {
+        std::uniform_real_distribution<double> noise(0.75, 1.25);
+        int64_t before = (int64_t)us;
+        us += costUs * noise(rng);
+        return (int64_t)us - before;
+    }
+    int64_t Now() const { return (int64_t)us; }
+};
+
+struct StepStats
+{
+    std::vector<int64_t> stepUs;
+    int64_t discoveryReads = 0;
+    int64_t rescanReads = 0;
+};
+
+static StepStats Run(bool capRescan, bool printFirst)
+{
+    SimClock clock;
+    ScanScheduler sched;
+    sched.Reset(0);
+    StepStats stats;
+    for (int step = 0; step < kSteps; step++)
+    {
+        int64_t stepStartUs = clock.Now();
+        clock.Spend(kStepOverheadUs);
+
+        int64_t discoveryBudgetUs = kBudgetUs;
+        int64_t reserveUs = sched.ExpectedRescanUs((std::min)(kCandidates, kMaxReadsPerStep));
+        discoveryBudgetUs -= capRescan ? (std::min)(kBudgetUs / 2, reserveUs) : reserveUs;
+        const int kMinDiscoveryReads = 256;
+        const int kDiscoveryChunk = 4096;
+        int reads = 0;
+        while (reads < kScanBatch)
+        {
+            int64_t spentUs = clock.Now() - stepStartUs;
+            if (reads > 0 && spentUs >= discoveryBudgetUs)
+                break;
+            int chunk = sched.ReadsForBudget(discoveryBudgetUs - spentUs, kMinDiscoveryReads, kDiscoveryChunk);
+            chunk = (std::min)(chunk, kScanBatch - reads);
+            int64_t readStartUs = clock.Now();
+            clock.Spend(chunk * kReadNs / 1000.0);
+            sched.OnReads(chunk, clock.Now() - readStartUs, clock.Now());
+            reads += chunk;
+        }
+
+        int64_t rescanStartUs = clock.Now();
+        int rescan = (std::min)(kCandidates, kMaxReadsPerStep);
+        if (capRescan)
+            rescan = sched.RescansForBudget(kBudgetUs - (rescanStartUs - stepStartUs), 64, rescan);
+        clock.Spend(rescan * kRescanNs / 1000.0);
+        sched.OnRescan(rescan, clock.Now() - rescanStartUs, clock.Now());
+
+        int64_t elapsedUs = clock.Now() - stepStartUs;
+        sched.OnStep(elapsedUs, kBudgetUs);
+        stats.stepUs.push_back(elapsedUs);
+        if (step >= kWarmupSteps)
+        {
+            stats.discoveryReads += reads;
+            stats.rescanReads += rescan;
+        }
+        if (printFirst && step < 10)
+            printf("  step %2d: %5lld us  discovery=%5d rescan=%5d\n", step, (long long)elapsedUs, reads, rescan);
+    }
+    return stats;
+}
+
+static void Summary(const char* name, const StepStats& stats)
+{
+    std::vector<int64_t> steady(stats.stepUs.begin() + kWarmupSteps, stats.stepUs.end());
+    double sum = 0.0;
+    int over = 0;
+    for (int64_t us : steady)
+    {
+        sum += (double)us;
+        if (us > kBudgetUs + kBudgetUs / 10)
+            over++;
+    }
+    std::sort(steady.begin(), steady.end());
+    size_t n = steady.size();
+    printf("%-10s %8.1f %8lld %8lld %9.1f%% %12.0f %12.0f\n", name, sum / (double)n,
+        (long long)steady[n * 99 / 100], (long long)steady[n - 1], 100.0 * over / (double)n,
+        (double)stats.discoveryReads / (double)n, (double)stats.rescanReads / (double)n);
+}
+
+int main()
+{
+    printf("budget=%lldus cands=%d maxReads=%d read=%.0fns rescan=%.0fns/cand\n\n",
+        (long long)kBudgetUs, kCandidates, kMaxReadsPerStep, kReadNs, kRescanNs);
+    printf("capped rescan, first steps:\n");
+    StepStats capped = Run(true, true);
+    StepStats uncapped = Run(false, false);
+    printf("\nsteady state (steps %d..%d):\n", kWarmupSteps, kSteps - 1);
+    printf("%-10s %8s %8s %8s %10s %12s %12s\n", "rescan", "mean us", "p99 us", "max us", ">110%", "disc/step", "rescan/step");
+    Summary("uncapped", uncapped);
+    Summary("capped", capped);
+    return 0;
+}
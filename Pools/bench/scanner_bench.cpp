@@ -0,0 +1,545 @@
+/*
+  scanner_bench.cpp
+  - Host-side benchmark suite for the money scanner, run end to end against
+    MockTable (bench/mock_globals.h) through the GlobalMemory interface
+  - Each run lays out a fresh seeded table and plays it for --seconds of
+    simulated time in 10 ms ticks: discovery every ScanIntervalMs (20 ms),
+    the tiered rescan every half interval, OCR samples every 700 ms
+  - The pipeline follows MoneyScanStep / RescanExistingCandidates with the
+    default INI: fault-map skipping, SlotInt32 value scan, snapshot diff and
+    the tiered rescan. OCR matching (OcrAmountIndex), the bet-grid counters,
+    the pot ranking and the pot auto-lock come from candidate_rules.h, the
+    same code the plugin runs; the step correlation path is left out
+  - Discovery order comes from DiscoveryPlanner; every run is played twice
+    on the same seed, once with the linear sweep (DiscoveryMode=0) and once
+    coarse-to-fine (DiscoveryMode=1, default radii). --seeds picks what the
+    latter starts from: none, hotspot (the hotspot buckets a past session
+    locked the pot and player stack in) or stale (hotspots elsewhere, as after
+    a layout change). --pot-gap N puts the pot N slots before the seat array
+  - Reports per run and overall: discovery wrap time (simulated and CPU),
+    rescan throughput, time until the pot global is a candidate, time to
+    auto-lock, false-lock rate (locked a global other than the table's pot)
+    and runs that never locked
+
+  Build (from Pools/):
+    g++ -std=c++20 -O2 -I. -Ibench bench/scanner_bench.cpp bench/mock_globals.cpp global_memory.cpp money_store.cpp money_diff.cpp fault_map.cpp rescan_tiers.cpp discovery_plan.cpp candidate_rules.cpp ocr_amount_index.cpp -o scanner_bench
+  Run:
+    ./scanner_bench [--runs N] [--seconds S] [--slots N] [--seed N] [--seeds none|hotspot|stale] [--pot-gap N]
+*/
+
+#include "mock_globals.h"
+#include "candidate_rules.h"
+#include "money_store.h"
+#include "money_diff.h"
+#include "fault_map.h"
+#include "rescan_tiers.h"
+#include "discovery_plan.h"
+#include "ocr_amount_index.h"
+#include "top_k.h"
+#include "typed_scanner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using MoneyValueScanner = Scanner<SlotInt32, InRange<SlotInt32>>;
+
+// Defaults from highstakes.ini.
+static const int kValueMin = 1;
+static const int kValueMax = 500000;
+static const int kMaxReadsPerStep = 16384;
+static const uint32_t kScanIntervalMs = 20;
+static const uint32_t kTickMs = 10;
+static const int kRankTopK = 16;       // kRankTopKMin; TopN=10 is below it
+static const uint32_t kColdMaxAgeMs = 2000;
+static const int kFaultRunThreshold = 16;
+static const int kDiscoveryChunk = 4096;
+static const int kAnchorMatches = 2;  // DiscoveryAnchorMatches
+
+static int64_t NowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static const CandidateRules kRules;   // INI defaults
+
+struct RunResult
+{
+    uint32_t firstWrapMs = 0;    // simulated
+    double wrapCpuMs = 0.0;      // discovery CPU per full sweep
+    int wraps = 0;
+    uint64_t rescanReads = 0;
+    double rescanCpuMs = 0.0;
+    int candidates = 0;
+    uint32_t potFoundMs = 0;     // 0 = never a candidate
+    uint32_t lockMs = 0;         // 0 = never locked
+    bool falseLock = false;
+    bool lockedMirror = false;
+};
+
+class ScannerSim
+{
+public:
+    ScannerSim(MockGlobalMemory& mem, const MockTable& table, int scanEnd, const DiscoveryPlanConfig& planCfg,
+        const std::vector<int>& seeds)
+        : mem(mem), table(table), scanEnd(scanEnd), seeds(seeds)
+    {
+        faults.Reset(0, scanEnd);
+        tiers.Reset(0);
+        plan.Reset(0, scanEnd, planCfg);
+        plan.BeginPass(seeds);
+    }
+
+    const DiscoveryPlanMetrics& PlanMetrics() const { return plan.Metrics(); }
+
+    void Step(uint32_t now, RunResult& r)
+    {
+        const MockOcrSample& ocr = table.Ocr();
+        if (now % kScanIntervalMs == 0)
+            Discover(now, ocr, r);
+        Rescan(now, ocr, r);
+        if (r.lockMs == 0 && ocr.sampleId != lockCheckSampleId && passSampleId == ocr.sampleId)
+        {
+            lockCheckSampleId = ocr.sampleId;
+            TryLock(now, ocr, r);
+        }
+    }
+
+private:
+    // ComputeOcrMatchBits: the index is rebuilt once per OCR sample.
+    int OcrMatchBits(int value, const MockOcrSample& ocr)
+    {
+        if (ocr.sampleId <= 0)
+            return 0;
+        if (indexSampleId != ocr.sampleId)
+        {
+            amounts.clear();
+            for (int cents : { ocr.potCents, ocr.playerCents })
+            {
+                if (cents > 0)
+                    amounts.push_back(cents);
+            }
+            amounts.insert(amounts.end(), ocr.npcCents.begin(), ocr.npcCents.end());
+            int potRefs[1] = { ocr.potCents };
+            index.Build(kRules.ocrToleranceCents, amounts, ocr.playerCents, potRefs, 1, ocr.npcCents);
+            indexSampleId = ocr.sampleId;
+        }
+        return index.Match(value);
+    }
+
+    void MatchOcr(int slot, int value, const MockOcrSample& ocr, uint32_t now)
+    {
+        int bits = OcrMatchBits(value, ocr);
+        size_t k = (size_t)slot;
+        if (bits)
+        {
+            BumpOcrMatches(cands, slot, bits, ocr.sampleId, now);
+            tiers.MarkHot(cands.idx[k]);
+        }
+        // As CorrelateRescannedCandidate: every correlation of an anchor re-offers its window.
+        if (cands.changes[k] > 0 && cands.ocrPotMatches[k] + cands.ocrPlayerMatches[k] + cands.ocrNpcMatches[k] >= kAnchorMatches)
+            plan.OnCorrelated(cands.idx[k]);
+    }
+
+    void Discover(uint32_t now, const MockOcrSample& ocr, RunResult& r)
+    {
+        int64_t t0 = NowUs();
+        MoneyValueScanner scanner{ { kValueMin, kValueMax } };
+        discovered.clear();
+        int reads = 0;
+        int consecutiveFaults = 0;
+        bool stepDone = false;
+        bool passDone = false;
+        while (!stepDone && reads < kMaxReadsPerStep)
+        {
+            int spanStart = 0;
+            int spanEnd = 0;
+            int source = 0;
+            if (!plan.Next((std::min)(kMaxReadsPerStep - reads, kDiscoveryChunk), spanStart, spanEnd, source))
+            {
+                passDone = true;
+                break;
+            }
+            int readableFrom = faults.SkipKnownBad(spanStart);
+            if (readableFrom != spanStart)
+            {
+                plan.MarkRead(spanStart, readableFrom);
+                continue;
+            }
+            int chunkStart = spanStart;
+            int chunkLen = (std::min)(spanEnd - chunkStart, faults.NextBadStart(chunkStart) - chunkStart);
+            slots.resize((size_t)chunkLen);
+            faultBits.resize((size_t)((chunkLen + 63) >> 6));
+            mem.ReadRange(chunkStart, chunkLen, slots.data(), faultBits.data());
+            faults.Record(chunkStart, chunkLen, faultBits.data());
+            reads += chunkLen;
+            int readEnd = chunkStart + chunkLen;
+
+            int scanLen = chunkLen;
+            for (int k = 0; k < chunkLen; k++)
+            {
+                if ((k & 63) == 0 && faultBits[(size_t)k >> 6] == 0)
+                {
+                    consecutiveFaults = 0;
+                    k += 63;
+                    continue;
+                }
+                if (!GlobalFaultBitTest(faultBits.data(), k))
+                {
+                    consecutiveFaults = 0;
+                    continue;
+                }
+                if (++consecutiveFaults >= kFaultRunThreshold)
+                {
+                    readEnd = (std::min)(chunkStart + k + 257, scanEnd);
+                    scanLen = k + 1;
+                    stepDone = true;
+                    break;
+                }
+            }
+            plan.MarkRead(chunkStart, readEnd);
+
+            hits.clear();
+            scanner.Scan(chunkStart, slots.data(), scanLen, faultBits.data(), hits);
+            for (const MoneyValueScanner::Hit& hit : hits)
+            {
+                if (cands.Contains(hit.idx))
+                    continue;
+                MoneyCandidate mc;
+                mc.idx = hit.idx;
+                mc.last = hit.value;
+                mc.firstSeenMs = now;
+                mc.lastSeenMs = now;
+                discovered.push_back(mc);
+            }
+        }
+        std::sort(discovered.begin(), discovered.end(),
+            [](const MoneyCandidate& a, const MoneyCandidate& b) { return a.idx < b.idx; });
+        cands.InsertSorted(discovered);
+        for (const MoneyCandidate& mc : discovered)
+        {
+            int slot = cands.Find(mc.idx);
+            MatchOcr(slot, mc.last, ocr, now);
+        }
+        if (!r.potFoundMs && cands.Contains(table.PotIdx()))
+            r.potFoundMs = now;
+
+        wrapCpuUs += NowUs() - t0;
+        if (passDone)
+        {
+            plan.BeginPass(seeds);
+            faults.Rebuild(kFaultRunThreshold);
+            if (r.wraps == 0)
+            {
+                r.firstWrapMs = now;
+                r.wrapCpuMs = wrapCpuUs / 1000.0;
+            }
+            r.wraps++;
+        }
+    }
+
+    void Rescan(uint32_t now, const MockOcrSample& ocr, RunResult& r)
+    {
+        int64_t t0 = NowUs();
+        RescanBudget budget;
+        budget.maxReads = kMaxReadsPerStep;
+        budget.stepIntervalMs = kScanIntervalMs / 2;
+        budget.coldMaxAgeMs = kColdMaxAgeMs;
+        tiers.Plan(cands, budget, now, sel, selTier);
+        int n = (int)sel.size();
+        selIdx.resize((size_t)n);
+        prev.resize((size_t)n);
+        vals.resize((size_t)n);
+        ok.resize((size_t)n);
+        for (int i = 0; i < n; i++)
+        {
+            selIdx[(size_t)i] = cands.idx[(size_t)sel[(size_t)i]];
+            prev[(size_t)i] = cands.last[(size_t)sel[(size_t)i]];
+        }
+        mem.ReadIndices(selIdx.data(), n, vals.data(), ok.data());
+        DiffSnapshot(prev.data(), vals.data(), n, kValueMin, kValueMax, diff);
+
+        dead.assign((size_t)cands.Size(), 0);
+        bool anyDead = false;
+        for (int i = 0; i < n; i++)
+        {
+            size_t k = (size_t)sel[(size_t)i];
+            tiers.OnRead(selTier[(size_t)i], now - cands.lastSeenMs[k]);
+            cands.lastSeenMs[k] = now;
+            if (!ok[(size_t)i] || (diff.outOfRangeCount > 0 && diff.OutOfRange(i)))
+            {
+                dead[k] = 1;
+                anyDead = true;
+            }
+        }
+        moved.clear();
+        for (size_t d = 0; d < diff.slots.size(); d++)
+        {
+            size_t k = (size_t)sel[(size_t)diff.slots[d]];
+            if (dead[k])
+                continue;
+            int delta = diff.deltas[d];
+            cands.changes[k]++;
+            cands.lastDelta[k] = delta;
+            if (MatchesBetGridDelta(delta < 0 ? -delta : delta, kRules))
+                cands.betStepMatches[k]++;
+            else
+                cands.betStepMismatches[k]++;
+            cands.last[k] = vals[(size_t)diff.slots[d]];
+            cands.lastChangeMs[k] = now;
+            moved.push_back((int)k);
+        }
+
+        // A new OCR sample is matched against every candidate, ScanMaxReadsPerStep slots per step.
+        if (ocr.sampleId != passSampleId)
+        {
+            if (ocr.sampleId != passStartedFor)
+            {
+                passStartedFor = ocr.sampleId;
+                passIdx = 0;
+            }
+            int size = cands.Size();
+            int slot = (int)(std::lower_bound(cands.idx.begin(), cands.idx.end(), passIdx) - cands.idx.begin());
+            int passEnd = (std::min)(size, slot + kMaxReadsPerStep);
+            for (; slot < passEnd; slot++)
+            {
+                if (!dead[(size_t)slot])
+                    MatchOcr(slot, cands.last[(size_t)slot], ocr, now);
+            }
+            if (slot >= size)
+                passSampleId = ocr.sampleId;
+            else
+                passIdx = cands.idx[(size_t)slot];
+        }
+        else
+        {
+            for (int slot : moved)
+                MatchOcr(slot, cands.last[(size_t)slot], ocr, now);
+        }
+
+        if (anyDead)
+        {
+            for (int slot = 0; slot < cands.Size(); slot++)
+            {
+                if (dead[(size_t)slot])
+                    tiers.Forget(cands.idx[(size_t)slot]);
+            }
+            cands.Compact(dead);
+        }
+        r.rescanReads += (uint64_t)n;
+        r.rescanCpuMs += (NowUs() - t0) / 1000.0;
+        r.candidates = cands.Size();
+    }
+
+    // TryAutoLockPotGlobal: the first slot of the pot ranking (RebuildRanking's top K) that can lock.
+    void TryLock(uint32_t now, const MockOcrSample& ocr, RunResult& r)
+    {
+        if (ocr.potCents <= 0)
+            return;
+        potTop.Reset(kRankTopK);
+        for (int slot = 0; slot < cands.Size(); slot++)
+        {
+            if (IsOcrCorrelatedCandidate(cands, slot) && IsRankEligible(cands, slot, RANK_CATEGORY_POT, kRules))
+                potTop.Offer(MakeRankKey(cands, slot, CandidateRankScore(cands, slot, now, kRules)));
+        }
+        potTop.Sorted(potKeys);
+        int best = -1;
+        for (const RankKey& key : potKeys)
+        {
+            int slot = cands.Find(key.idx);
+            if (slot >= 0 && CandidateCanLockPot(cands, slot, now, ocr.potCents, kRules))
+            {
+                best = slot;
+                break;
+            }
+        }
+        if (best < 0)
+            return;
+        int idx = cands.idx[(size_t)best];
+        r.lockMs = now;
+        r.falseLock = idx != table.PotIdx();
+        const std::vector<int>& mirrors = table.MirrorIdx();
+        r.lockedMirror = std::find(mirrors.begin(), mirrors.end(), idx) != mirrors.end();
+    }
+
+    MockGlobalMemory& mem;
+    const MockTable& table;
+    int scanEnd;
+    std::vector<int> seeds;
+    MoneyCandidateStore cands;
+    GlobalFaultMap faults;
+    RescanTiers tiers;
+    DiscoveryPlanner plan;
+    int64_t wrapCpuUs = 0;
+    int passSampleId = 0;
+    int passStartedFor = 0;
+    int passIdx = 0;
+    int lockCheckSampleId = 0;
+    OcrAmountIndex index;
+    int indexSampleId = -1;
+    std::vector<int> amounts;
+    TopKHeap potTop;
+    std::vector<RankKey> potKeys;
+
+    std::vector<uint64_t> slots;
+    std::vector<uint64_t> faultBits;
+    std::vector<MoneyValueScanner::Hit> hits;
+    std::vector<MoneyCandidate> discovered;
+    std::vector<int> sel;
+    std::vector<uint8_t> selTier;
+    std::vector<int> selIdx;
+    std::vector<int> prev;
+    std::vector<int> vals;
+    std::vector<unsigned char> ok;
+    std::vector<unsigned char> dead;
+    std::vector<int> moved;
+    SnapshotDiff diff;
+};
+
+struct ModeSummary
+{
+    std::vector<RunResult> results;
+    DiscoveryPlanMetrics plan;
+};
+
+static void PrintSummary(const char* name, const ModeSummary& m, int runs)
+{
+    std::vector<uint32_t> lockTimes;
+    std::vector<uint32_t> foundTimes;
+    int falseLocks = 0;
+    int noLock = 0;
+    double wrapSim = 0.0;
+    double wrapCpu = 0.0;
+    uint64_t rescanReads = 0;
+    double rescanMs = 0.0;
+    for (const RunResult& r : m.results)
+    {
+        wrapSim += r.firstWrapMs;
+        wrapCpu += r.wrapCpuMs;
+        rescanReads += r.rescanReads;
+        rescanMs += r.rescanCpuMs;
+        if (r.potFoundMs)
+            foundTimes.push_back(r.potFoundMs);
+        if (!r.lockMs)
+            noLock++;
+        else if (r.falseLock)
+            falseLocks++;
+        else
+            lockTimes.push_back(r.lockMs);
+    }
+    std::sort(lockTimes.begin(), lockTimes.end());
+    std::sort(foundTimes.begin(), foundTimes.end());
+    int n = (std::max)(1, runs);
+    printf("[%s]\n", name);
+    printf("  discovery wrap: %.0f ms simulated, %.1f ms CPU (mean)\n", wrapSim / n, wrapCpu / n);
+    int64_t total = 0;
+    for (int src = 0; src < DISCOVERY_SOURCE_COUNT; src++)
+        total += m.plan.slots[src];
+    printf("  discovery slots:");
+    for (int src = 0; src < DISCOVERY_SOURCE_COUNT; src++)
+        printf(" %s=%.1f%%", DiscoverySourceName(src), total ? 100.0 * m.plan.slots[src] / total : 0.0);
+    printf("\n  rescan: %.2fM candidate reads/s\n", rescanMs > 0.0 ? rescanReads / rescanMs / 1000.0 : 0.0);
+    if (!foundTimes.empty())
+    {
+        printf("  pot is a candidate: median %.2fs, max %.2fs\n",
+            foundTimes[foundTimes.size() / 2] / 1000.0, foundTimes.back() / 1000.0);
+    }
+    if (!lockTimes.empty())
+    {
+        printf("  time to auto-lock: median %.1fs, max %.1fs (%d correct)\n",
+            lockTimes[lockTimes.size() / 2] / 1000.0, lockTimes.back() / 1000.0, (int)lockTimes.size());
+    }
+    printf("  false-lock rate: %d/%d, never locked: %d/%d\n", falseLocks, runs, noLock, runs);
+}
+
+int main(int argc, char** argv)
+{
+    int runs = 8;
+    int seconds = 60;
+    int slotCount = 1 << 20;
+    uint32_t seed = 1;
+    const char* seedMode = "hotspot";
+    int potGap = -1;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (!strcmp(argv[i], "--runs"))
+            runs = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "--seconds"))
+            seconds = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "--slots"))
+            slotCount = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "--seed"))
+            seed = (uint32_t)atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "--seeds"))
+            seedMode = argv[i + 1];
+        else if (!strcmp(argv[i], "--pot-gap"))
+            potGap = atoi(argv[i + 1]);
+    }
+
+    printf("runs=%d seconds=%d slots=%d reads/step=%d diff=%s seeds=%s pot-gap=%d\n",
+        runs, seconds, slotCount, kMaxReadsPerStep, SnapshotDiffIsaName(), seedMode, potGap);
+    const char* modeNames[2] = { "linear", "coarse-to-fine" };
+    ModeSummary modes[2];
+    for (int run = 0; run < runs; run++)
+    {
+        for (int mode = 0; mode < 2; mode++)
+        {
+            MockTableConfig cfg;
+            cfg.seed = seed + (uint32_t)run;
+            cfg.slots = slotCount;
+            cfg.valueMax = kValueMax;
+            cfg.potSeatGap = potGap;
+            MockGlobalMemory mem;
+            MockTable table;
+            table.Init(cfg, mem);
+
+            DiscoveryPlanConfig planCfg;
+            std::vector<int> seeds;
+            if (mode == 0)
+            {
+                planCfg.seedRadius = 0;
+                planCfg.coarseStride = 0;
+                planCfg.refineRadius = 0;
+            }
+            else
+            {
+                // What DiscoveryHotspots::Peaks returns after past sessions locked these globals.
+                DiscoveryHotspots hotspots;
+                if (!strcmp(seedMode, "hotspot"))
+                {
+                    hotspots.Record(table.PotIdx(), 1.0f);
+                    hotspots.Record(table.PlayerIdx(), 1.0f);
+                }
+                else if (!strcmp(seedMode, "stale"))
+                {
+                    hotspots.Record((table.PotIdx() + slotCount / 3) % slotCount, 1.0f);
+                    hotspots.Record((table.PlayerIdx() + slotCount / 2) % slotCount, 1.0f);
+                }
+                hotspots.Peaks(8, seeds);
+            }
+
+            RunResult r;
+            ScannerSim sim(mem, table, slotCount, planCfg, seeds);
+            for (uint32_t now = kTickMs; now <= (uint32_t)seconds * 1000; now += kTickMs)
+            {
+                table.Advance(now);
+                sim.Step(now, r);
+            }
+            modes[mode].results.push_back(r);
+            for (int src = 0; src < DISCOVERY_SOURCE_COUNT; src++)
+                modes[mode].plan.slots[src] += sim.PlanMetrics().slots[src];
+            printf("run %2d %-14s: wrap %5ums sim %7.1fms cpu | rescan %6.2fM reads/s | cands %6d | hands %3d | pot found %5.2fs | lock %s",
+                run, modeNames[mode], r.firstWrapMs, r.wrapCpuMs, r.rescanCpuMs > 0.0 ? r.rescanReads / r.rescanCpuMs / 1000.0 : 0.0,
+                r.candidates, table.Hands(), r.potFoundMs / 1000.0, r.lockMs ? "" : "none\n");
+            if (r.lockMs)
+                printf("%.1fs %s\n", r.lockMs / 1000.0, r.falseLock ? (r.lockedMirror ? "FALSE (pot mirror)" : "FALSE") : "ok");
+        }
+    }
+    for (int mode = 0; mode < 2; mode++)
+        PrintSummary(modeNames[mode], modes[mode], runs);
+    return 0;
+}
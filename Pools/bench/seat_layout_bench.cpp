@@ -0,0 +1,297 @@
+/*
+  seat_layout_bench.cpp
+  - Host-side check of InferSeatArray on synthetic tables: a seat array at a
+    random base and stride (1..64) with 3..6 seats, the player on one of
+    them, evidence on some of the seats and random noise candidates around
+  - Positive trials must find the array's stride and player seat, and a base
+    that puts every evidenced seat on the array (the true base when the
+    evidence spans every seat or the empty-seat test rules the rest out).
+    Finding nothing is allowed only when the evidenced seats also read as
+    an array at twice or half the stride; those are counted as refused
+  - Noise stays off the array's lattice near the array: a stray value one
+    stride past the last seat is a seat as far as any inference can tell
+  - Negative trials must not lock: fewer seats with evidence than minSeats,
+    two seats that both look like the player, or a known player global off
+    the lattice
+  - Then the cost of one inference with 512 evidence rows (the plugin's cap)
+  - Exits non-zero on the first wrong answer
+
+  Build (from Pools/):
+    g++ -std=c++20 -O2 -I. bench/seat_layout_bench.cpp seat_layout.cpp -o seat_layout_bench
+*/
+
+#include "seat_layout.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <vector>
+
+static const int kTrials = 4000;
+static const int kSpace = 200000;   // global index range the noise is drawn from
+
+struct Table
+{
+    int base = 0;
+    int stride = 0;
+    int seats = 0;
+    int playerSeat = 0;
+    std::set<int> seatIdx;
+};
+
+static Table RandomTable(std::mt19937& rng)
+{
+    Table t;
+    t.seats = 3 + (int)(rng() % 4);
+    t.stride = 1 + (int)(rng() % 64);
+    t.base = 1000 + (int)(rng() % (uint32_t)(kSpace - 2000 - t.seats * t.stride));
+    t.playerSeat = (int)(rng() % (uint32_t)t.seats);
+    for (int s = 0; s < t.seats; s++)
+        t.seatIdx.insert(t.base + s * t.stride);
+    return t;
+}
+
+static SeatEvidence Seat(const Table& t, int seat, std::mt19937& rng, bool knownPlayer)
+{
+    SeatEvidence e;
+    e.idx = t.base + seat * t.stride;
+    e.value = 100 + (int)(rng() % 100000);
+    if (seat == t.playerSeat)
+    {
+        e.playerScore = 3 + (int)(rng() % 8);
+        e.npcScore = (int)(rng() % 2);
+        e.isPlayer = knownPlayer;
+    }
+    else
+    {
+        e.npcScore = 2 + (int)(rng() % 8);
+        e.playerScore = (int)(rng() % 2);
+        e.matchesNpcNow = (rng() % 2) != 0;
+    }
+    return e;
+}
+
+// Noise: weak NPC-ish evidence anywhere except on the array's lattice within a few array
+// lengths of it (a stray value right past the last seat is indistinguishable from a seat).
+static void AddNoise(const Table& t, int count, std::mt19937& rng, std::vector<SeatEvidence>& out)
+{
+    std::set<int> used(t.seatIdx);
+    for (int s = -2 * t.seats; s < 3 * t.seats; s++)
+        used.insert(t.base + s * t.stride);
+    for (const SeatEvidence& e : out)
+        used.insert(e.idx);
+    while (count > 0)
+    {
+        int idx = (int)(rng() % kSpace);
+        if (used.count(idx))
+            continue;
+        used.insert(idx);
+        SeatEvidence e;
+        e.idx = idx;
+        e.value = (int)(rng() % 500000);
+        e.npcScore = 2 + (int)(rng() % 3);
+        out.push_back(e);
+        count--;
+    }
+}
+
+static int gFailures = 0;
+
+static void Fail(int trial, const char* what, const Table& t, const SeatArrayFit& fit)
+{
+    if (gFailures++ < 5)
+        printf("WRONG trial %d (%s): table base=%d stride=%d seats=%d player=%d; fit found=%d base=%d stride=%d player=%d members=%d\n",
+            trial, what, t.base, t.stride, t.seats, t.playerSeat, fit.found ? 1 : 0, fit.base, fit.stride, fit.playerSeat, fit.members);
+}
+
+// The evidenced seats read the same at twice or half the stride: every other seat of the
+// array, or close enough together to sit on every other seat of a half-stride array.
+static bool StrideAmbiguous(const Table& t, const std::vector<SeatEvidence>& evidence)
+{
+    int lo = t.seats;
+    int hi = -1;
+    bool allEven = true;
+    std::vector<int> seats;
+    for (const SeatEvidence& e : evidence)
+    {
+        if (!t.seatIdx.count(e.idx))
+            continue;
+        int seat = (e.idx - t.base) / t.stride;
+        seats.push_back(seat);
+        lo = (std::min)(lo, seat);
+        hi = (std::max)(hi, seat);
+    }
+    for (int seat : seats)
+        allEven &= ((seat - lo) % 2) == 0;
+    bool halfFits = (t.stride % 2) == 0 && 2 * (hi - lo) <= t.seats - 1;
+    return allEven || halfFits;
+}
+
+static void RunPositive(int& exactBase, int& ambiguous, int& refused)
+{
+    std::mt19937 rng(101);
+    for (int trial = 0; trial < kTrials; trial++)
+    {
+        Table t = RandomTable(rng);
+        SeatArrayParams params;
+        params.seats = t.seats;
+        params.maxStride = 64;
+        params.minSeats = (std::min)(3, t.seats);
+
+        // Evidence on the player plus enough NPC seats; the rest are empty seats.
+        bool knownPlayer = (rng() % 2) != 0;
+        std::vector<int> order;
+        for (int s = 0; s < t.seats; s++)
+        {
+            if (s != t.playerSeat)
+                order.push_back(s);
+        }
+        std::shuffle(order.begin(), order.end(), rng);
+        int npcSeats = params.minSeats - 1 + (int)(rng() % (uint32_t)(t.seats - params.minSeats + 1));
+        std::vector<SeatEvidence> evidence;
+        evidence.push_back(Seat(t, t.playerSeat, rng, knownPlayer));
+        for (int i = 0; i < npcSeats; i++)
+            evidence.push_back(Seat(t, order[(size_t)i], rng, false));
+        AddNoise(t, (int)(rng() % 300), rng, evidence);
+        std::shuffle(evidence.begin(), evidence.end(), rng);
+
+        // Empty seats read as 0 or a stack; most other globals do not.
+        SeatArrayFit fit = InferSeatArray(evidence, params, [&](int idx)
+        {
+            if (t.seatIdx.count(idx))
+                return true;
+            return ((unsigned)idx * 2654435761u >> 28) < 3;  // ~20% of other globals look like a stack
+        });
+
+        if (!fit.found && StrideAmbiguous(t, evidence))
+        {
+            refused++;
+            continue;
+        }
+        if (!fit.found || fit.stride != t.stride || fit.seats != t.seats)
+        {
+            Fail(trial, "missed the array", t, fit);
+            continue;
+        }
+        // Every evidenced seat must land on the fitted lattice, the player on its own seat.
+        bool onLattice = true;
+        for (const SeatEvidence& e : evidence)
+        {
+            if (!t.seatIdx.count(e.idx))
+                continue;
+            int rel = e.idx - fit.base;
+            onLattice &= rel >= 0 && rel % fit.stride == 0 && rel / fit.stride < fit.seats;
+        }
+        int playerIdx = t.base + t.playerSeat * t.stride;
+        if (!onLattice || fit.SeatIndex(fit.playerSeat) != playerIdx)
+        {
+            Fail(trial, "wrong base or player seat", t, fit);
+            continue;
+        }
+        if (fit.base == t.base)
+            exactBase++;
+        else if (!fit.baseAmbiguous)
+            Fail(trial, "shifted base not flagged ambiguous", t, fit);
+        ambiguous += fit.baseAmbiguous ? 1 : 0;
+    }
+}
+
+static void RunNegative(int& falseLocks)
+{
+    std::mt19937 rng(202);
+    for (int trial = 0; trial < kTrials; trial++)
+    {
+        Table t = RandomTable(rng);
+        SeatArrayParams params;
+        params.seats = t.seats;
+        params.maxStride = 64;
+        params.minSeats = 3;
+
+        std::vector<SeatEvidence> evidence;
+        int kind = trial % 3;
+        const char* what = "";
+        if (kind == 0)
+        {
+            // Player plus one NPC: below minSeats.
+            what = "too few seats";
+            evidence.push_back(Seat(t, t.playerSeat, rng, true));
+            evidence.push_back(Seat(t, (t.playerSeat + 1) % t.seats, rng, false));
+        }
+        else if (kind == 1)
+        {
+            // Every seat evidenced, but two of them look like the player.
+            what = "two player seats";
+            for (int s = 0; s < t.seats; s++)
+                evidence.push_back(Seat(t, s, rng, false));
+            SeatEvidence& other = evidence[(size_t)((t.playerSeat + 1) % t.seats)];
+            other.playerScore = other.npcScore + 3;
+        }
+        else
+        {
+            // A full array, but the known player global sits elsewhere.
+            what = "player off the lattice";
+            for (int s = 0; s < t.seats; s++)
+            {
+                if (s != t.playerSeat)
+                    evidence.push_back(Seat(t, s, rng, false));
+            }
+            SeatEvidence player;
+            player.idx = (t.base > 500) ? t.base - 500 - (int)(rng() % 100) : t.base + t.seats * 64 + 7;
+            player.playerScore = 6;
+            player.isPlayer = true;
+            evidence.push_back(player);
+        }
+        AddNoise(t, 20, rng, evidence);
+
+        SeatArrayFit fit = InferSeatArray(evidence, params, [](int) { return true; });
+        if (!fit.found)
+            continue;
+        // Noise can line up by chance; only a fit on the table's own seats is a false lock.
+        int onTable = 0;
+        for (int s = 0; s < fit.seats; s++)
+            onTable += t.seatIdx.count(fit.SeatIndex(s)) ? 1 : 0;
+        if (onTable >= params.minSeats)
+        {
+            falseLocks++;
+            Fail(trial, what, t, fit);
+        }
+    }
+}
+
+static void Bench()
+{
+    std::mt19937 rng(303);
+    Table t = RandomTable(rng);
+    std::vector<SeatEvidence> evidence;
+    for (int s = 0; s < t.seats; s++)
+        evidence.push_back(Seat(t, s, rng, s == t.playerSeat));
+    AddNoise(t, 512 - (int)evidence.size(), rng, evidence);
+    SeatArrayParams params;
+    params.seats = t.seats;
+    const int runs = 50;
+    auto t0 = std::chrono::steady_clock::now();
+    int found = 0;
+    for (int r = 0; r < runs; r++)
+        found += InferSeatArray(evidence, params, [](int) { return true; }).found ? 1 : 0;
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count() / runs;
+    printf("inference: %.2f ms with %d evidence rows, maxStride=%d (%d/%d found)\n",
+        ms, (int)evidence.size(), params.maxStride, found, runs);
+}
+
+int main()
+{
+    int exactBase = 0;
+    int ambiguous = 0;
+    int refused = 0;
+    RunPositive(exactBase, ambiguous, refused);
+    printf("positive: %d tables, %d wrong; true base %d, ambiguous base %d, refused (stride ambiguous) %d\n",
+        kTrials, gFailures, exactBase, ambiguous, refused);
+    int positiveFailures = gFailures;
+    int falseLocks = 0;
+    RunNegative(falseLocks);
+    printf("negative: %d tables, %d false locks\n", kTrials, falseLocks);
+    Bench();
+    return (positiveFailures || falseLocks) ? 1 : 0;
+}
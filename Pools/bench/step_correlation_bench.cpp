@@ -0,0 +1,130 @@
+/*
+  step_correlation_bench.cpp
+  - Host-side benchmark: pooled step rings and SettleStep over simulated hands
+  - 4096 tracked candidates: the real pot (steps with every bet, seen by the
+    rescan up to 700 ms before OCR shows it), "lookalikes" that sat at the pot
+    amount once and then drift, and noise that steps every few hundred ms
+  - Reports settle cost per OCR step and after how many OCR pot steps each
+    kind is rejected (RejectMisses=2 rule from highstakes.cpp)
+
+  Build (from Pools/):
+    g++ -std=c++20 -O2 -I. bench/step_correlation_bench.cpp step_correlation.cpp -o step_correlation_bench
+*/
+
+#include "step_correlation.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static const int kCands = 4096;
+static const int kLookalikes = 64;
+static const int kLagMs = 2500;
+static const int kTol = 6;
+static const int kRejectMisses = 2;
+
+struct Cand
+{
+    int handle = -1;
+    int value = 0;
+    uint32_t aligned = 0;
+    uint32_t missed = 0;
+    int rejectedAtStep = -1;
+};
+
+int main(int argc, char** argv)
+{
+    int hands = (argc > 1) ? atoi(argv[1]) : 4;
+    std::mt19937 rng(7);
+    SeriesPool pool;
+    pool.Init(kCands);
+    SeriesRing ocr;
+    ocr.Reset(0, 0);
+
+    int pot = 1500;
+    std::vector<Cand> cands((size_t)kCands);
+    for (int i = 0; i < kCands; i++)
+    {
+        Cand& c = cands[(size_t)i];
+        c.value = (i == 0 || i <= kLookalikes) ? pot : (int)(rng() % 200000);
+        c.handle = pool.Acquire(0, c.value);
+    }
+
+    uint32_t now = 0;
+    int ocrSteps = 0;
+    double settleUs = 0.0;
+    int settled = 0;
+    for (int h = 0; h < hands; h++)
+    {
+        for (int bet = 0; bet < 4; bet++)
+        {
+            // 3 s between bets; the rescan sees the change before OCR does.
+            for (int t = 0; t < 3000; t += 100)
+            {
+                now += 100;
+                for (int i = 1; i < kCands; i++)
+                {
+                    Cand& c = cands[(size_t)i];
+                    bool noise = i > kLookalikes;
+                    if ((noise && rng() % 4 == 0) || (!noise && rng() % 20 == 0))
+                    {
+                        c.value += (int)(rng() % 2000) - 1000;
+                        pool.Ring(c.handle).Push(now, c.value);
+                    }
+                }
+            }
+            int step = 500 * (1 + (int)(rng() % 4));
+            pot += step;
+            cands[0].value = pot;
+            pool.Ring(cands[0].handle).Push(now, pot);
+            ocr.Push(now + 300 + (uint32_t)(rng() % 400), pot);
+            ocrSteps++;
+
+            // Settle once the lag has passed.
+            const SeriesEvent& e = *ocr.Last();
+            now = e.ms + kLagMs;
+            auto t0 = std::chrono::steady_clock::now();
+            for (Cand& c : cands)
+            {
+                StepOutcome o = SettleStep(pool.Ring(c.handle), e, STEP_MATCH_VALUE, kLagMs, kTol);
+                if (o == STEP_ALIGNED)
+                    PackedIncrement(c.aligned, 0);
+                else if (o == STEP_MISSED)
+                    PackedIncrement(c.missed, 0);
+                int missed = PackedCount(c.missed, 0);
+                if (c.rejectedAtStep < 0 && missed >= kRejectMisses && missed > PackedCount(c.aligned, 0))
+                    c.rejectedAtStep = ocrSteps;
+            }
+            settleUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+            settled++;
+        }
+    }
+
+    int lookRejected = 0;
+    int lookWorst = 0;
+    int noiseRejected = 0;
+    int noiseWorst = 0;
+    for (int i = 1; i < kCands; i++)
+    {
+        const Cand& c = cands[(size_t)i];
+        bool noise = i > kLookalikes;
+        if (c.rejectedAtStep < 0)
+            continue;
+        (noise ? noiseRejected : lookRejected)++;
+        int& worst = noise ? noiseWorst : lookWorst;
+        if (c.rejectedAtStep > worst)
+            worst = c.rejectedAtStep;
+    }
+
+    printf("candidates=%d ring=%zuB pool=%zuKB ocrPotSteps=%d (%d hands x 4 bets)\n",
+        kCands, sizeof(SeriesRing), pool.MemoryBytes() / 1024, ocrSteps, hands);
+    printf("settle: %.1f us per OCR step (%.1f ns per candidate)\n",
+        settleUs / settled, settleUs * 1000.0 / settled / kCands);
+    printf("pot: aligned=%d missed=%d rejected=%s\n",
+        PackedCount(cands[0].aligned, 0), PackedCount(cands[0].missed, 0), cands[0].rejectedAtStep < 0 ? "no" : "YES");
+    printf("lookalikes: %d/%d rejected, all by OCR pot step %d\n", lookRejected, kLookalikes, lookWorst);
+    printf("noise: %d/%d rejected, all by OCR pot step %d\n", noiseRejected, kCands - 1 - kLookalikes, noiseWorst);
+    return cands[0].rejectedAtStep < 0 ? 0 : 1;
+}
@@ -0,0 +1,143 @@
+/*
+  tile_signature_bench.cpp
+  - Host-side benchmark: the per-cycle cost of deciding whether an OCR region
+    changed (TileSignature::Compute on the new capture + Compare against the
+    reference), at the default BottomLeft/TopRight zone sizes for 1080p and 4K
+  - Frames are a dark HUD panel with light text-like glyph blocks; "idle"
+    frames add +-shimmer per byte (compression noise), "changed" frames also
+    add one stroke to the text. Idle frames must come out clean and changed
+    frames dirty in exactly the stroke's tile rows
+  - Noise threshold is DirtyNoise's default (3) unless given
+
+  Build (from Pools/):
+    g++ -std=c++20 -O2 -I. bench/tile_signature_bench.cpp tile_signature.cpp -o tile_signature_bench
+  Run:
+    tile_signature_bench [noise] [shimmer]
+*/
+
+#include "tile_signature.h"
+#include "ocr_backend.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static void DrawPanel(OcrImage& img, std::mt19937& rng)
+{
+    for (int y = 0; y < img.height; y++)
+    {
+        unsigned char* row = img.pixels.data() + (size_t)y * (size_t)img.stride;
+        for (int x = 0; x < img.width * 3; x++)
+            row[x] = (unsigned char)(40 + (x / 3 + y) % 7);  // faint gradient
+    }
+    // Lines of glyph blocks, roughly where text sits in the HUD.
+    for (int y = 12; y + 14 < img.height; y += 26)
+    {
+        for (int x = 10; x + 9 < img.width; x += 11 + (int)(rng() % 6))
+        {
+            if (rng() % 5 == 0)
+                continue;
+            for (int yy = y; yy < y + 14; yy++)
+            {
+                unsigned char* row = img.pixels.data() + (size_t)yy * (size_t)img.stride;
+                for (int xx = x; xx < x + 8; xx++)
+                {
+                    if ((xx + yy) % 3 != 0)  // stroke pattern, not a solid block
+                        row[xx * 3] = row[xx * 3 + 1] = row[xx * 3 + 2] = 230;
+                }
+            }
+        }
+    }
+}
+
+static void Shimmer(const OcrImage& src, OcrImage& dst, std::mt19937& rng, int amount)
+{
+    dst = src;
+    if (amount <= 0)
+        return;
+    for (unsigned char& b : dst.pixels)
+    {
+        int v = (int)b + (int)(rng() % (uint32_t)(2 * amount + 1)) - amount;
+        b = (unsigned char)(v < 0 ? 0 : (v > 255 ? 255 : v));
+    }
+}
+
+// Closes a 2x8 stroke somewhere on a text line (a 3 becoming an 8), on a glyph or next to one.
+static int ChangeGlyph(OcrImage& img, std::mt19937& rng)
+{
+    int x = 10 + (int)(rng() % (uint32_t)(img.width - 30));
+    int y = 12 + 26 * (int)(rng() % (uint32_t)((img.height - 30) / 26));
+    for (int yy = y + 3; yy < y + 11; yy++)
+    {
+        unsigned char* row = img.pixels.data() + (size_t)yy * (size_t)img.stride;
+        for (int xx = x; xx < x + 2; xx++)
+            row[xx * 3] = row[xx * 3 + 1] = row[xx * 3 + 2] = 230;
+    }
+    return y;
+}
+
+int main(int argc, char** argv)
+{
+    int noise = (argc > 1) ? atoi(argv[1]) : 3;
+    int shimmer = (argc > 2) ? atoi(argv[2]) : 2;
+    const int frames = 200;
+    int bad = 0;
+    printf("isa=%s noise=%d shimmer=+-%d tile=%d\n", TileSignatureIsaName(), noise, shimmer, kTileSize);
+    printf("%-14s %10s %10s %10s %10s %10s %6s\n", "region", "compute us", "compare us", "idle max", "dirty/chg", "tiles", "check");
+
+    struct Zone { const char* name; int w; int h; };
+    for (const Zone& z : { Zone{ "1080p BL", 653, 713 }, Zone{ "1080p TR", 538, 324 }, Zone{ "4K BL", 1306, 1426 }, Zone{ "4K TR", 1075, 648 } })
+    {
+        std::mt19937 rng(7);
+        OcrImage base;
+        base.Resize(z.w, z.h);
+        DrawPanel(base, rng);
+
+        TileSignature ref;
+        TileSignature now;
+        ref.Compute(base.pixels.data(), base.width, base.height, base.stride);
+
+        OcrImage frame;
+        double computeUs = 0.0;
+        double compareUs = 0.0;
+        int idleMax = 0;
+        int wrong = 0;
+        int changedDirty = 0;
+        int tiles = 0;
+        for (int f = 0; f < frames; f++)
+        {
+            Shimmer(base, frame, rng, shimmer);
+            bool changed = (f % 4) == 3;
+            int glyphY = changed ? ChangeGlyph(frame, rng) : -1;
+
+            auto t0 = std::chrono::steady_clock::now();
+            now.Compute(frame.pixels.data(), frame.width, frame.height, frame.stride);
+            auto t1 = std::chrono::steady_clock::now();
+            TileDiff d;
+            now.Compare(ref, noise, d);
+            auto t2 = std::chrono::steady_clock::now();
+            computeUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+            compareUs += std::chrono::duration<double, std::micro>(t2 - t1).count();
+            tiles = d.tiles;
+
+            if (!changed)
+            {
+                idleMax = (std::max)(idleMax, d.maxDelta);
+                wrong += d.dirty ? 1 : 0;
+                continue;
+            }
+            // The changed rows (glyphY + 3 .. glyphY + 10) may straddle two tile rows.
+            int firstRow = (glyphY + 3) / kTileSize;
+            int lastRow = (glyphY + 10) / kTileSize;
+            bool ok = d.dirty > 0 && d.firstDirtyRow >= firstRow && d.lastDirtyRow <= lastRow;
+            changedDirty += d.dirty ? 1 : 0;
+            wrong += ok ? 0 : 1;
+        }
+        bad += wrong;
+        printf("%-14s %10.1f %10.2f %10d %6d/%-3d %10d %6s\n", z.name, computeUs / frames, compareUs / frames,
+            idleMax, changedDirty, frames / 4, tiles, wrong ? "WRONG" : "ok");
+    }
+    return bad == 0 ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+/*
+  top_k_bench.cpp
+  - Host-side check: TopKHeap kept incrementally (rebuilding from the full set
+    whenever Offer/Remove asks for it, as the plugin's ranking does) against a
+    brute-force sort of every candidate, after every operation
+  - Random workload over a few thousand candidates: score updates (better and
+    worse), ties on score broken by the tie fields and idx, inserts and removes;
+    several K including 1 and K larger than the candidate count
+  - Prints operations, rebuilds and mismatches per K plus us/op for both; exits
+    non-zero on the first mismatch
+
+  Build (from Pools/):
+    g++ -std=c++20 -O2 -I. bench/top_k_bench.cpp -o top_k_bench
+*/
+
+#include "top_k.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+static const int kCandidates = 2000;
+static const int kOps = 5000;
+
+using Clock = std::chrono::steady_clock;
+
+static RankKey RandomKey(std::mt19937& rng, int idx)
+{
+    // Few distinct scores and tie values so ties are common.
+    RankKey key;
+    key.score = (float)(rng() % 16) * 0.25f;
+    for (int t = 0; t < 5; t++)
+        key.tie[t] = (int)(rng() % 4);
+    key.idx = idx;
+    return key;
+}
+
+static void BruteTopK(const std::unordered_map<int, RankKey>& all, int k, std::vector<RankKey>& out)
+{
+    out.clear();
+    for (const auto& kv : all)
+        out.push_back(kv.second);
+    std::sort(out.begin(), out.end(), RankAhead);
+    if ((int)out.size() > k)
+        out.resize((size_t)k);
+}
+
+static void Rebuild(TopKHeap& heap, int k, const std::unordered_map<int, RankKey>& all)
+{
+    heap.Reset(k);
+    for (const auto& kv : all)
+        heap.Offer(kv.second);
+}
+
+static bool SameKeys(const std::vector<RankKey>& a, const std::vector<RankKey>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (a[i].idx != b[i].idx || a[i].score != b[i].score)
+            return false;
+    }
+    return true;
+}
+
+int main()
+{
+    const int ks[] = { 1, 8, 64, 512, kCandidates * 2 };
+    printf("%-6s %10s %10s %10s %12s %12s\n", "K", "ops", "rebuilds", "mismatch", "heap us/op", "brute us/op");
+    for (int k : ks)
+    {
+        std::mt19937 rng(1234u + (unsigned)k);
+        std::unordered_map<int, RankKey> all;
+        TopKHeap heap;
+        heap.Reset(k);
+        for (int i = 0; i < kCandidates; i++)
+        {
+            RankKey key = RandomKey(rng, i * 7);
+            all[key.idx] = key;
+            heap.Offer(key);
+        }
+
+        int rebuilds = 0;
+        int mismatches = 0;
+        int64_t heapNs = 0;
+        int64_t bruteNs = 0;
+        std::vector<RankKey> got;
+        std::vector<RankKey> want;
+        int nextIdx = kCandidates * 7;
+        for (int op = 0; op < kOps; op++)
+        {
+            unsigned kind = rng() % 10;
+            auto t0 = Clock::now();
+            bool ok = true;
+            if (kind < 7 && !all.empty())
+            {
+                // Update an existing candidate: sometimes a current member.
+                int idx = (kind < 3 && !heap.heap.empty())
+                    ? heap.heap[rng() % heap.heap.size()].idx
+                    : (int)(rng() % (unsigned)nextIdx);
+                auto it = all.find(idx);
+                if (it != all.end())
+                {
+                    it->second = RandomKey(rng, idx);
+                    ok = heap.Offer(it->second);
+                }
+            }
+            else if (kind < 9)
+            {
+                RankKey key = RandomKey(rng, nextIdx);
+                nextIdx += 3;
+                all[key.idx] = key;
+                ok = heap.Offer(key);
+            }
+            else if (!all.empty())
+            {
+                int idx = (!heap.heap.empty() && (rng() & 1))
+                    ? heap.heap[rng() % heap.heap.size()].idx
+                    : all.begin()->first;
+                all.erase(idx);
+                ok = heap.Remove(idx);
+            }
+            if (!ok)
+            {
+                Rebuild(heap, k, all);
+                rebuilds++;
+            }
+            heap.Sorted(got);
+            auto t1 = Clock::now();
+            BruteTopK(all, k, want);
+            auto t2 = Clock::now();
+            heapNs += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+            bruteNs += std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+
+            if (!SameKeys(got, want))
+            {
+                if (mismatches == 0)
+                    printf("K=%d op %d: heap has %d keys, brute force %d\n", k, op, (int)got.size(), (int)want.size());
+                mismatches++;
+            }
+        }
+        printf("%-6d %10d %10d %10d %12.2f %12.2f\n", k, kOps, rebuilds, mismatches,
+            heapNs / 1000.0 / kOps, bruteNs / 1000.0 / kOps);
+        if (mismatches > 0)
+            return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,172 @@
+/*
+  trace_recorder_bench.cpp
+  - Host-side benchmark: TraceWriter cost per sample, allocations on the hot
+    path, bytes per sample, and a round trip through the decoder
+  - 1M samples over 24 channels shaped like the plugin's: watch globals that
+    step by bet sizes, OCR amounts, and a phase channel; ticks advance a few
+    ms per sample. Blocks go to a file plus its .idx like in highstakes.cpp
+  - Flush() runs every kFlushEvery samples, standing in for the plugin's
+    RecordFlushMs timer; Record() time excludes it, and the run reports how
+    many blocks Record() still had to write itself (both buffers full)
+  - Every decoded sample is checked against the recorded one; a seek to the
+    middle of the run is timed through the index
+
+  Build (from Pools/):
+    g++ -std=c++20 -O2 -I. bench/trace_recorder_bench.cpp trace_recorder.cpp -o trace_recorder_bench
+*/
+
+#include "trace_recorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+static size_t gAllocs = 0;
+
+void* operator new(size_t n)
+{
+    gAllocs++;
+    if (void* p = std::malloc(n ? n : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+static const int kChannels = 24;
+static const int kFlushEvery = 2048;
+static const char* kPath = "trace_bench.bin";
+static const char* kIdxPath = "trace_bench.idx";
+
+int main(int argc, char** argv)
+{
+    int count = (argc > 1) ? atoi(argv[1]) : 1000000;
+    std::mt19937 rng(5);
+
+    std::vector<TraceSample> truth;
+    truth.reserve((size_t)count);
+    std::vector<int32_t> value((size_t)kChannels, 0);
+    uint32_t tick = 1000000;
+    for (int i = 0; i < count; i++)
+    {
+        tick += rng() % 4;
+        int id = (int)(rng() % kChannels);
+        int32_t& v = value[(size_t)id];
+        if (id == kChannels - 1)
+            v = (int32_t)(rng() % 8);                         // phase
+        else if (rng() % 8 == 0)
+            v = (int32_t)(rng() % 500000);                    // new hand / OCR jump
+        else
+            v += ((int32_t)(rng() % 20) - 10) * 500;          // bet-sized step
+        truth.push_back(TraceSample{ tick, id, v });
+    }
+
+    FILE* f = std::fopen(kPath, "wb");
+    FILE* fi = std::fopen(kIdxPath, "wb");
+    if (!f || !fi)
+    {
+        std::printf("cannot create %s / %s\n", kPath, kIdxPath);
+        return 1;
+    }
+    uint8_t header[kTraceFileHeaderBytes];
+    WriteTraceFileHeader(header, truth.front().tick);
+    std::fwrite(header, 1, sizeof(header), f);
+    uint8_t idxHeader[kTraceIndexHeaderBytes];
+    WriteTraceIndexHeader(idxHeader);
+    std::fwrite(idxHeader, 1, sizeof(idxHeader), fi);
+
+    TraceWriter w;
+    w.Open(kTraceFileHeaderBytes, 64, 65536, [f, fi](const uint8_t* block, size_t bytes, const TraceIndexEntry& e)
+    {
+        std::fwrite(block, 1, bytes, f);
+        uint8_t entry[kTraceIndexEntryBytes];
+        WriteTraceIndexEntry(entry, e);
+        std::fwrite(entry, 1, sizeof(entry), fi);
+    });
+    for (int id = 0; id < kChannels; id++)
+        w.DefineChannel(id, (id == kChannels - 1) ? std::string("phase") : "ch" + std::to_string(id));
+
+    size_t allocsBefore = gAllocs;
+    double recordNs = 0.0;
+    double flushNs = 0.0;
+    int flushes = 0;
+    for (size_t i = 0; i < truth.size(); i += kFlushEvery)
+    {
+        size_t end = (std::min)(truth.size(), i + kFlushEvery);
+        auto t0 = std::chrono::steady_clock::now();
+        for (size_t j = i; j < end; j++)
+            w.Record(truth[j].tick, truth[j].id, truth[j].value);
+        auto t1 = std::chrono::steady_clock::now();
+        w.Flush();
+        auto t2 = std::chrono::steady_clock::now();
+        recordNs += std::chrono::duration<double, std::nano>(t1 - t0).count();
+        flushNs += std::chrono::duration<double, std::nano>(t2 - t1).count();
+        flushes++;
+    }
+    size_t hotAllocs = gAllocs - allocsBefore;
+    w.Close();
+    std::fclose(f);
+    std::fclose(fi);
+
+    std::printf("samples=%d blocks=%d bytes=%llu (%.2f B/sample, raw 12 B)\n", count, w.Blocks(),
+        (unsigned long long)w.BytesWritten(), (double)w.BytesWritten() / count);
+    std::printf("record: %.1f ns/sample, %d blocks written inside Record(), %zu allocations on the hot path\n",
+        recordNs / count, w.InlineWrites(), hotAllocs);
+    std::printf("flush: %.1f us per periodic Flush() (%d)\n", flushNs / 1000.0 / flushes, flushes);
+
+    // Round trip + indexed seek.
+    std::vector<uint8_t> file;
+    std::vector<uint8_t> idx;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        FILE* in = std::fopen(pass ? kIdxPath : kPath, "rb");
+        std::vector<uint8_t>& out = pass ? idx : file;
+        int c;
+        while ((c = std::fgetc(in)) != EOF)
+            out.push_back((uint8_t)c);
+        std::fclose(in);
+    }
+    std::vector<TraceIndexEntry> index;
+    ParseTraceIndex(idx.data(), idx.size(), index);
+    std::vector<std::string> names;
+    size_t k = 0;
+    bool match = true;
+    auto t2 = std::chrono::steady_clock::now();
+    for (const TraceIndexEntry& e : index)
+    {
+        TraceBlockHeader h;
+        ParseTraceBlockHeader(file.data() + e.offset, file.size() - (size_t)e.offset, h);
+        DecodeTraceBlock(h, file.data() + e.offset + kTraceBlockHeaderBytes, names, [&](const TraceSample& s)
+        {
+            const TraceSample& t = truth[k++];
+            match &= s.tick == t.tick && s.id == t.id && s.value == t.value;
+        });
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    match &= k == truth.size();
+    std::printf("decode: %.1f ns/sample, round trip %s (%zu samples)\n",
+        std::chrono::duration<double, std::nano>(t3 - t2).count() / count, match ? "OK" : "MISMATCH", k);
+
+    uint32_t target = truth[truth.size() / 2].tick;
+    auto t4 = std::chrono::steady_clock::now();
+    size_t b = FindTraceBlock(index, target);
+    TraceBlockHeader h;
+    ParseTraceBlockHeader(file.data() + index[b].offset, file.size() - (size_t)index[b].offset, h);
+    bool found = false;
+    DecodeTraceBlock(h, file.data() + index[b].offset + kTraceBlockHeaderBytes, names, [&](const TraceSample& s)
+    {
+        found |= s.tick >= target;
+    });
+    auto t5 = std::chrono::steady_clock::now();
+    std::printf("seek to mid-run tick: block %zu/%zu, %.1f us, %s\n", b, index.size(),
+        std::chrono::duration<double, std::micro>(t5 - t4).count(), found ? "found" : "MISSED");
+    std::remove(kPath);
+    std::remove(kIdxPath);
+    return (match && found && hotAllocs == 0 && w.InlineWrites() == 0) ? 0 : 1;
+}
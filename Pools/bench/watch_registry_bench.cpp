@@ -0,0 +1,259 @@
+/*
+  watch_registry_bench.cpp
+  - Host-side check of WatchRegistry against a plain reference model: each
+    frame the reference decides which watches are due from their periods,
+    reads the same fake globals and tracks value / fresh / change history;
+    the registry must agree on Due(), Value(), every change callback (first,
+    prev, value) and the history ring after every frame
+  - Random watches (periods 0..250 ms, raw/cents/dollars, small history rings),
+    random read faults, occasional Bind to another global and MarkStale
+  - ParseWatchSpec on good and malformed lines
+  - Then the cost of Due + Apply per frame for 7 and 23 watches
+  - Exits non-zero on the first disagreement
+
+  Build (from Pools/):
+    g++ -std=c++20 -O2 -I. bench/watch_registry_bench.cpp watch_registry.cpp -o watch_registry_bench
+*/
+
+#include "watch_registry.h"
+
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <vector>
+
+static const int kGlobals = 64;
+static const int kFrames = 20000;
+static const uint32_t kFrameMs = 16;
+
+struct RefWatch
+{
+    WatchSpec spec;
+    uint32_t nextDueMs = 0;
+    bool valid = false;
+    bool ok = false;
+    int32_t value = 0;
+    std::deque<WatchSample> history;
+};
+
+static int gFailures = 0;
+
+static void Fail(const char* what, int frame, int id)
+{
+    if (gFailures++ == 0)
+        printf("MISMATCH frame %d watch %d: %s\n", frame, id, what);
+}
+
+static int32_t RefTransform(WatchUnit unit, int raw)
+{
+    return (unit == WATCH_UNIT_DOLLARS) ? (int32_t)((int64_t)raw * 100) : raw;
+}
+
+static bool CheckParse()
+{
+    struct Case { const char* text; bool ok; int idx; uint32_t period; WatchUnit unit; };
+    const Case cases[] = {
+        { "Pot,123", true, 123, 0, WATCH_UNIT_CENTS },
+        { " BigBlind , 41234 , 250 , Dollars ", true, 41234, 250, WATCH_UNIT_DOLLARS },
+        { "Raw,7,0,raw", true, 7, 0, WATCH_UNIT_RAW },
+        { "NoIndex", false, 0, 0, WATCH_UNIT_CENTS },
+        { ",5", false, 0, 0, WATCH_UNIT_CENTS },
+        { "Neg,-1", false, 0, 0, WATCH_UNIT_CENTS },
+        { "Junk,12x", false, 0, 0, WATCH_UNIT_CENTS },
+        { "Unit,1,0,euros", false, 0, 0, WATCH_UNIT_CENTS },
+        { "Many,1,2,cents,extra", false, 0, 0, WATCH_UNIT_CENTS },
+    };
+    bool good = true;
+    for (const Case& c : cases)
+    {
+        WatchSpec spec;
+        bool ok = ParseWatchSpec(c.text, spec);
+        if (ok != c.ok || (ok && (spec.idx != c.idx || spec.periodMs != c.period || spec.unit != c.unit)))
+        {
+            printf("ParseWatchSpec('%s') wrong\n", c.text);
+            good = false;
+        }
+    }
+    return good;
+}
+
+static void CheckModel(unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<int> globals((size_t)kGlobals);
+    for (int& g : globals)
+        g = (int)(rng() % 1000);
+
+    WatchRegistry reg;
+    std::vector<RefWatch> ref;
+    const uint32_t periods[] = { 0, 0, 16, 50, 250 };
+    for (int i = 0; i < 12; i++)
+    {
+        WatchSpec spec;
+        spec.name = "W" + std::to_string(i);
+        spec.idx = (i == 11) ? -1 : (int)(rng() % kGlobals);
+        spec.periodMs = periods[rng() % 5];
+        spec.unit = (WatchUnit)(rng() % 3);
+        spec.history = 1 + (int)(rng() % 6);
+        reg.Add(spec);
+        RefWatch w;
+        w.spec = spec;
+        ref.push_back(w);
+    }
+
+    std::vector<WatchChange> seen;
+    reg.Subscribe(-1, [&](const WatchChange& c) { seen.push_back(c); });
+
+    std::vector<int> raw;
+    std::vector<unsigned char> ok;
+    uint32_t now = 1000;
+    for (int frame = 0; frame < kFrames && gFailures == 0; frame++, now += kFrameMs)
+    {
+        // Globals drift; a value sometimes returns to what it was.
+        for (int& g : globals)
+        {
+            if (rng() % 8 == 0)
+                g = (int)(rng() % 1000);
+        }
+        if (rng() % 500 == 0)
+        {
+            int id = (int)(rng() % ref.size());
+            int idx = (int)(rng() % kGlobals);
+            reg.Bind(id, idx);
+            RefWatch& w = ref[(size_t)id];
+            if (w.spec.idx != idx)
+            {
+                w.spec.idx = idx;
+                w.nextDueMs = 0;
+                w.valid = false;
+                w.ok = false;
+                w.history.clear();
+            }
+        }
+        if (rng() % 700 == 0)
+        {
+            reg.MarkStale();
+            for (RefWatch& w : ref)
+                w.ok = false;
+        }
+
+        std::vector<int> wantIds;
+        for (size_t i = 0; i < ref.size(); i++)
+        {
+            RefWatch& w = ref[i];
+            if (w.spec.idx < 0 || (w.nextDueMs != 0 && now < w.nextDueMs))
+                continue;
+            w.nextDueMs = now + w.spec.periodMs;
+            if (w.nextDueMs == 0)
+                w.nextDueMs = 1;
+            wantIds.push_back((int)i);
+        }
+        const std::vector<int>& due = reg.Due(now);
+        if (due.size() != wantIds.size())
+        {
+            Fail("due count", frame, -1);
+            break;
+        }
+        raw.resize(due.size());
+        ok.resize(due.size());
+        for (size_t i = 0; i < due.size(); i++)
+        {
+            if (due[i] != ref[(size_t)wantIds[i]].spec.idx)
+                Fail("due index", frame, wantIds[i]);
+            raw[i] = globals[(size_t)due[i]];
+            ok[i] = (rng() % 20) != 0;
+        }
+
+        seen.clear();
+        reg.Apply(now, raw.data(), ok.data());
+        size_t change = 0;
+        for (size_t i = 0; i < wantIds.size(); i++)
+        {
+            int id = wantIds[i];
+            RefWatch& w = ref[(size_t)id];
+            w.ok = ok[i] != 0;
+            if (!w.ok)
+                continue;
+            int32_t value = RefTransform(w.spec.unit, raw[i]);
+            if (w.valid && value == w.value)
+                continue;
+            if (change >= seen.size())
+            {
+                Fail("missing change callback", frame, id);
+                break;
+            }
+            const WatchChange& c = seen[change++];
+            if (c.id != id || c.first != !w.valid || c.value != value || (w.valid && c.prev != w.value) || c.ms != now)
+                Fail("change callback", frame, id);
+            w.valid = true;
+            w.value = value;
+            w.history.push_back({ now, value });
+            if ((int)w.history.size() > w.spec.history)
+                w.history.pop_front();
+        }
+        if (change != seen.size())
+            Fail("extra change callback", frame, -1);
+
+        for (size_t id = 0; id < ref.size(); id++)
+        {
+            const RefWatch& w = ref[id];
+            int32_t v = 0;
+            bool fresh = false;
+            bool has = reg.Value((int)id, v, &fresh);
+            if (has != w.valid || (has && v != w.value) || fresh != w.ok)
+                Fail("value/fresh", frame, (int)id);
+            if (reg.HistoryCount((int)id) != (int)w.history.size())
+            {
+                Fail("history count", frame, (int)id);
+                continue;
+            }
+            for (int h = 0; h < (int)w.history.size(); h++)
+            {
+                const WatchSample& s = reg.HistoryAt((int)id, h);
+                if (s.ms != w.history[(size_t)h].ms || s.value != w.history[(size_t)h].value)
+                    Fail("history sample", frame, (int)id);
+            }
+        }
+    }
+}
+
+static void Bench(int watches)
+{
+    WatchRegistry reg;
+    for (int i = 0; i < watches; i++)
+    {
+        WatchSpec spec;
+        spec.name = "W" + std::to_string(i);
+        spec.idx = i * 37;
+        spec.periodMs = (i < 7) ? 0 : 250;
+        reg.Add(spec);
+    }
+    int changes = 0;
+    reg.Subscribe(-1, [&](const WatchChange&) { changes++; });
+
+    std::vector<int> raw((size_t)watches);
+    std::vector<unsigned char> ok((size_t)watches, 1);
+    const int frames = 200000;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; f++)
+    {
+        const std::vector<int>& due = reg.Due((uint32_t)(f * kFrameMs + 1));
+        for (size_t i = 0; i < due.size(); i++)
+            raw[i] = due[i] + (f >> 4);
+        reg.Apply((uint32_t)(f * kFrameMs + 1), raw.data(), ok.data());
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / frames;
+    printf("%2d watches: %.0f ns/frame (Due + Apply), %d changes\n", watches, ns, changes);
+}
+
+int main()
+{
+    bool parseOk = CheckParse();
+    for (unsigned seed = 1; seed <= 8 && gFailures == 0; seed++)
+        CheckModel(seed);
+    printf("model: %d frames x 8 seeds, %s; parse: %s\n", kFrames, gFailures ? "FAILED" : "ok", parseOk ? "ok" : "FAILED");
+    Bench(7);
+    Bench(23);
+    return (gFailures || !parseOk) ? 1 : 0;
+}
@@ -0,0 +1,104 @@
+#include "candidate_epochs.h"
+
+#include "step_correlation.h"
+
+#include <algorithm>
+
+namespace
+{
+    constexpr int kHandDecayMax = 8;  // after this many hands the mismatch counts are ~0 anyway
+
+    uint32_t HalveLanes(uint32_t packed)
+    {
+        return (packed >> 1) & 0x7F7F7F7Fu;
+    }
+
+    // Each 8-bit lane drops by n, floored at zero.
+    uint32_t SubtractLanes(uint32_t packed, int n)
+    {
+        uint32_t out = 0;
+        for (int lane = 0; lane < 4; lane++)
+        {
+            int v = (std::max)(0, PackedCount(packed, lane) - n);
+            out |= (uint32_t)v << (lane * 8);
+        }
+        return out;
+    }
+}
+
+const char* CandidateEpochName(int kind)
+{
+    switch (kind)
+    {
+    case EPOCH_SESSION: return "session";
+    case EPOCH_TABLE: return "table";
+    case EPOCH_HAND: return "hand";
+    default: return "?";
+    }
+}
+
+uint32_t CandidateEpochs::Stamp() const
+{
+    return ((gen[EPOCH_SESSION] & 0xFFu) << 24) | ((gen[EPOCH_TABLE] & 0xFFu) << 16) | (gen[EPOCH_HAND] & 0xFFFFu);
+}
+
+EpochCrossing CrossedSince(uint32_t from, uint32_t now)
+{
+    EpochCrossing x;
+    if (from == now)
+        return x;
+    x.session = ((from ^ now) & 0xFF000000u) != 0;
+    x.table = ((from ^ now) & 0x00FF0000u) != 0;
+    x.hands = (int)((now - from) & 0xFFFFu);
+    return x;
+}
+
+void CatchUpCandidate(MoneyCandidateStore& s, int slot, const EpochCrossing& x, uint32_t stamp, uint32_t nowMs)
+{
+    size_t k = (size_t)slot;
+    s.epoch[k] = stamp;
+    if (x.session)
+    {
+        // As if just discovered, minus the rediscovery.
+        s.lastDelta[k] = 0;
+        s.changes[k] = 0;
+        s.betStepMatches[k] = 0;
+        s.betStepMismatches[k] = 0;
+        s.ocrAnyMatches[k] = 0;
+        s.ocrPotMatches[k] = 0;
+        s.ocrPlayerMatches[k] = 0;
+        s.ocrNpcMatches[k] = 0;
+        s.lastOcrAnySampleId[k] = -1;
+        s.lastOcrPotSampleId[k] = -1;
+        s.lastOcrPlayerSampleId[k] = -1;
+        s.lastOcrNpcSampleId[k] = -1;
+        s.firstSeenMs[k] = nowMs;
+        s.lastChangeMs[k] = 0;
+        s.lastOcrMatchMs[k] = 0;
+        s.stepAligned[k] = 0;
+        s.stepMissed[k] = 0;
+        return;
+    }
+
+    if (x.table)
+    {
+        // The same global usually holds the same thing at the next table: keep half the evidence,
+        // so a few samples at the new table outweigh it either way. The change rate is the
+        // global's own and carries over whole.
+        s.betStepMatches[k] >>= 1;
+        s.betStepMismatches[k] >>= 1;
+        s.ocrAnyMatches[k] >>= 1;
+        s.ocrPotMatches[k] >>= 1;
+        s.ocrPlayerMatches[k] >>= 1;
+        s.ocrNpcMatches[k] >>= 1;
+        s.stepAligned[k] = HalveLanes(s.stepAligned[k]);
+        s.stepMissed[k] = 0;  // the OCR series restart with the table
+    }
+
+    // A hand of bad steps (an animation, a split pot) is forgiven over the next few.
+    int hands = (std::min)(x.hands, kHandDecayMax);
+    for (int h = 0; h < hands; h++)
+        s.betStepMismatches[k] -= s.betStepMismatches[k] >> 2;
+    if (hands > 0)
+        s.stepMissed[k] = SubtractLanes(s.stepMissed[k], hands);
+}
@@ -0,0 +1,58 @@
+/*
+  candidate_epochs.h
+  - Session / table / hand generations for the candidate store
+  - A soft reset bumps one generation and nothing else; each candidate
+    carries the packed generations it was last brought up to date with
+    (MoneyCandidateStore::epoch) and catches up the next time the scanner
+    reads it, so a bump costs O(1) however many candidates there are
+  - Catching up decays evidence rather than clearing it:
+    session: every counter restarts, the slot and its value are kept
+    table:   match counters halve, step misses are forgotten
+    hand:    mismatch counters shrink a little per hand
+  - The packed stamp keeps 8 bits of the session and table generations and
+    16 of the hand one; the rescan reads every candidate within a cold lap,
+    far more often than those wrap
+  - Reads and writes MoneyCandidateStore columns only, on the scanner's
+    thread; bench/candidate_epochs_bench.cpp checks the wraps and the decay
+    rules against an unpacked reference
+*/
+
+#pragma once
+
+#include "money_store.h"
+
+#include <cstdint>
+
+enum CandidateEpochKind
+{
+    EPOCH_SESSION = 0,  // END key
+    EPOCH_TABLE = 1,    // table joined
+    EPOCH_HAND = 2,     // payout settled
+    EPOCH_KIND_COUNT = 3
+};
+
+const char* CandidateEpochName(int kind);
+
+struct CandidateEpochs
+{
+    uint32_t gen[EPOCH_KIND_COUNT] = {};
+
+    void Bump(int kind) { gen[kind]++; }
+    uint32_t Stamp() const;
+};
+
+// What a candidate stamped with from has missed by now.
+struct EpochCrossing
+{
+    bool session = false;
+    bool table = false;
+    int hands = 0;
+
+    bool Any() const { return session || table || hands > 0; }
+};
+
+EpochCrossing CrossedSince(uint32_t from, uint32_t now);
+
+// Applies the decay for x to slot and restamps it. The caller resets or releases the slot's
+// step ring: a session crossing invalidates it, a table crossing restarts it.
+void CatchUpCandidate(MoneyCandidateStore& s, int slot, const EpochCrossing& x, uint32_t stamp, uint32_t nowMs);
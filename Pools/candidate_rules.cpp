@@ -0,0 +1,265 @@
+#include "candidate_rules.h"
+
+#include "ocr_amount_index.h"
+#include "step_correlation.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Counts at most one match per OCR sample.
+    void BumpCounter(int& matches, int& lastSampleId, uint32_t& lastOcrMatchMs, int sampleId, uint32_t now)
+    {
+        if (lastSampleId == sampleId)
+            return;
+        matches++;
+        lastSampleId = sampleId;
+        lastOcrMatchMs = now;
+    }
+
+    bool MatchesBetGridUnits(int absDelta, int minUnit, int stepUnit)
+    {
+        if (absDelta <= 0 || minUnit <= 0 || stepUnit <= 0)
+            return false;
+        if (absDelta < minUnit)
+            return false;
+        return (absDelta % stepUnit) == 0;
+    }
+}
+
+void BumpOcrMatches(MoneyCandidate& c, int bits, int sampleId, uint32_t now)
+{
+    if (bits & OCR_MATCH_ANY)
+        BumpCounter(c.ocrAnyMatches, c.lastOcrAnySampleId, c.lastOcrMatchMs, sampleId, now);
+    if (bits & OCR_MATCH_PLAYER)
+        BumpCounter(c.ocrPlayerMatches, c.lastOcrPlayerSampleId, c.lastOcrMatchMs, sampleId, now);
+    if (bits & OCR_MATCH_POT)
+        BumpCounter(c.ocrPotMatches, c.lastOcrPotSampleId, c.lastOcrMatchMs, sampleId, now);
+    if (bits & OCR_MATCH_NPC)
+        BumpCounter(c.ocrNpcMatches, c.lastOcrNpcSampleId, c.lastOcrMatchMs, sampleId, now);
+}
+
+void BumpOcrMatches(MoneyCandidateStore& s, int slot, int bits, int sampleId, uint32_t now)
+{
+    if (!bits)
+        return;
+    size_t k = (size_t)slot;
+    if (bits & OCR_MATCH_ANY)
+        BumpCounter(s.ocrAnyMatches[k], s.lastOcrAnySampleId[k], s.lastOcrMatchMs[k], sampleId, now);
+    if (bits & OCR_MATCH_PLAYER)
+        BumpCounter(s.ocrPlayerMatches[k], s.lastOcrPlayerSampleId[k], s.lastOcrMatchMs[k], sampleId, now);
+    if (bits & OCR_MATCH_POT)
+        BumpCounter(s.ocrPotMatches[k], s.lastOcrPotSampleId[k], s.lastOcrMatchMs[k], sampleId, now);
+    if (bits & OCR_MATCH_NPC)
+        BumpCounter(s.ocrNpcMatches[k], s.lastOcrNpcSampleId[k], s.lastOcrMatchMs[k], sampleId, now);
+}
+
+bool MatchesBetGridDelta(int absDelta, const CandidateRules& rules)
+{
+    int stepDollars = rules.betStepDollars;
+    int minDollars = rules.betMinDollars;
+    if (stepDollars <= 0)
+        return false;
+    if (minDollars < stepDollars)
+        minDollars = stepDollars;
+
+    bool dollarsMatch = MatchesBetGridUnits(absDelta, minDollars, stepDollars);
+    bool centsMatch = MatchesBetGridUnits(absDelta, minDollars * 100, stepDollars * 100);
+    return dollarsMatch || centsMatch;
+}
+
+float CandidateBetStepRatio(const MoneyCandidateStore& s, int slot)
+{
+    size_t k = (size_t)slot;
+    int total = s.betStepMatches[k] + s.betStepMismatches[k];
+    if (total <= 0)
+        return -1.0f;
+    return (float)s.betStepMatches[k] / (float)total;
+}
+
+float CandidateChangesPerSec(const MoneyCandidateStore& s, int slot, uint32_t now)
+{
+    uint32_t firstSeenMs = s.firstSeenMs[(size_t)slot];
+    if (now <= firstSeenMs)
+        return 0.0f;
+    float ageSec = (float)(now - firstSeenMs) / 1000.0f;
+    if (ageSec <= 0.0f)
+        return 0.0f;
+    return (float)s.changes[(size_t)slot] / ageSec;
+}
+
+int StepAlignedCount(const MoneyCandidateStore& s, int slot, int field)
+{
+    return PackedCount(s.stepAligned[(size_t)slot], field);
+}
+
+int StepMissedCount(const MoneyCandidateStore& s, int slot, int field)
+{
+    return PackedCount(s.stepMissed[(size_t)slot], field);
+}
+
+bool IsStepRejected(const MoneyCandidateStore& s, int slot, int field, const CandidateRules& rules)
+{
+    if (rules.corrRejectMisses <= 0)
+        return false;
+    int missed = StepMissedCount(s, slot, field);
+    return missed >= rules.corrRejectMisses && missed > StepAlignedCount(s, slot, field);
+}
+
+bool IsStepConfirmed(const MoneyCandidateStore& s, int slot, int field, const CandidateRules& rules)
+{
+    return rules.corrLockSteps > 0 &&
+        StepAlignedCount(s, slot, field) >= rules.corrLockSteps &&
+        StepMissedCount(s, slot, field) == 0;
+}
+
+bool IsLikelyMoneyCandidate(const MoneyCandidateStore& s, int slot, uint32_t now, const CandidateRules& rules)
+{
+    size_t k = (size_t)slot;
+    if (s.changes[k] <= 0)
+        return false;
+
+    float maxCps = rules.likelyMaxChangesPerSec;
+    if (maxCps > 0.0f && CandidateChangesPerSec(s, slot, now) > maxCps)
+        return false;
+
+    if (rules.betStepFilter)
+    {
+        int totalBetDeltas = s.betStepMatches[k] + s.betStepMismatches[k];
+        if (totalBetDeltas >= 5 && s.betStepMatches[k] * 2 < totalBetDeltas)
+            return false;
+    }
+
+    return true;
+}
+
+bool IsOcrCorrelatedCandidate(const MoneyCandidateStore& s, int slot)
+{
+    size_t k = (size_t)slot;
+    return s.ocrAnyMatches[k] > 0 || s.ocrPotMatches[k] > 0 || s.ocrPlayerMatches[k] > 0 || s.ocrNpcMatches[k] > 0;
+}
+
+bool HasRecentOcrMatch(const MoneyCandidateStore& s, int slot, uint32_t now)
+{
+    uint32_t lastOcrMatchMs = s.lastOcrMatchMs[(size_t)slot];
+    return lastOcrMatchMs != 0 && (now - lastOcrMatchMs) <= kOcrMatchRecentMs;
+}
+
+float CandidateRankScore(const MoneyCandidateStore& s, int slot, uint32_t now, const CandidateRules& rules)
+{
+    size_t k = (size_t)slot;
+    float score = 0.0f;
+    score += (float)s.ocrPotMatches[k] * 18.0f;
+    score += (float)StepAlignedCount(s, slot, OCR_SERIES_POT) * 12.0f;
+    score += (float)StepAlignedCount(s, slot, OCR_SERIES_NPC) * 4.0f;
+    score += (float)StepAlignedCount(s, slot, OCR_SERIES_WINS) * 2.0f;
+    score += (float)s.ocrPlayerMatches[k] * 3.0f;
+    score += (float)s.ocrNpcMatches[k] * 4.5f;
+    score += (float)s.ocrAnyMatches[k] * 1.2f;
+    if (s.ocrPlayerMatches[k] > s.ocrPotMatches[k] * 2)
+        score -= 6.0f;
+    if (IsLikelyMoneyCandidate(s, slot, now, rules))
+        score += 3.0f;
+    score += (float)((std::min)(s.changes[k], 64)) * 0.08f;
+    if (rules.betStepFilter)
+    {
+        score += (float)((std::min)(s.betStepMatches[k], 48)) * 0.35f;
+        score -= (float)((std::min)(s.betStepMismatches[k], 48)) * 0.28f;
+        float ratio = CandidateBetStepRatio(s, slot);
+        if (ratio >= 0.0f)
+            score += (ratio - 0.5f) * 8.0f;
+    }
+    uint32_t lastOcrMatchMs = s.lastOcrMatchMs[k];
+    if (lastOcrMatchMs > 0 && now > lastOcrMatchMs)
+    {
+        uint32_t ageMs = now - lastOcrMatchMs;
+        if (ageMs <= kOcrMatchRecentMs)
+            score += 2.0f;
+    }
+    return score;
+}
+
+float PlayerStackScore(const MoneyCandidateStore& s, int slot)
+{
+    size_t k = (size_t)slot;
+    return (float)s.ocrPlayerMatches[k] * 12.0f
+        - (float)s.ocrPotMatches[k] * 7.0f
+        - (float)s.ocrNpcMatches[k] * 2.5f
+        + (float)s.ocrAnyMatches[k] * 0.5f
+        + (float)StepAlignedCount(s, slot, OCR_SERIES_PLAYER) * 10.0f
+        + (float)StepAlignedCount(s, slot, OCR_SERIES_WINS) * 3.0f;
+}
+
+bool IsRankEligible(const MoneyCandidateStore& s, int slot, int category, const CandidateRules& rules)
+{
+    size_t k = (size_t)slot;
+    switch (category)
+    {
+    case RANK_CATEGORY_POT:
+        return s.ocrPotMatches[k] > 0 && !IsStepRejected(s, slot, OCR_SERIES_POT, rules);
+    case RANK_CATEGORY_PLAYER:
+        return s.ocrPlayerMatches[k] > 0 && !IsStepRejected(s, slot, OCR_SERIES_PLAYER, rules);
+    default:
+        return s.ocrNpcMatches[k] > 0 &&
+            s.ocrPotMatches[k] <= s.ocrNpcMatches[k] * 2 &&
+            s.ocrPlayerMatches[k] <= s.ocrNpcMatches[k] * 2;
+    }
+}
+
+RankKey MakeRankKey(const MoneyCandidateStore& s, int slot, float score)
+{
+    size_t k = (size_t)slot;
+    RankKey key;
+    key.score = score;
+    key.tie[0] = s.ocrPotMatches[k];
+    key.tie[1] = s.ocrPlayerMatches[k];
+    key.tie[2] = s.ocrNpcMatches[k];
+    key.tie[3] = s.ocrAnyMatches[k];
+    key.tie[4] = s.changes[k];
+    key.idx = s.idx[k];
+    return key;
+}
+
+bool CandidatePassesPotAutoLockChecks(const MoneyCandidateStore& s, int slot, uint32_t now, const CandidateRules& rules)
+{
+    size_t k = (size_t)slot;
+    // A value that followed every OCR pot step so far can lock before the coincidence count.
+    if (s.ocrPotMatches[k] < rules.autoLockPotMinMatches && !IsStepConfirmed(s, slot, OCR_SERIES_POT, rules))
+        return false;
+    if (IsStepRejected(s, slot, OCR_SERIES_POT, rules))
+        return false;
+    if (s.changes[k] < 2)
+        return false;
+    if (!IsLikelyMoneyCandidate(s, slot, now, rules))
+        return false;
+    if (s.ocrPlayerMatches[k] * 2 > s.ocrPotMatches[k])
+        return false;
+    if (s.ocrAnyMatches[k] > 0 && s.ocrPotMatches[k] * 2 < s.ocrAnyMatches[k])
+        return false;
+    if (rules.betStepFilter)
+    {
+        int totalBet = s.betStepMatches[k] + s.betStepMismatches[k];
+        if (totalBet >= 4 && s.betStepMatches[k] * 2 < totalBet)
+            return false;
+    }
+    return true;
+}
+
+bool CandidateCanLockPot(const MoneyCandidateStore& s, int slot, uint32_t now, int potCents, const CandidateRules& rules)
+{
+    if (!CandidatePassesPotAutoLockChecks(s, slot, now, rules))
+        return false;
+    if (potCents > 0 && !OcrAmountMatches(s.last[(size_t)slot], potCents, rules.ocrToleranceCents))
+        return false;
+    return HasRecentOcrMatch(s, slot, now);
+}
+
+bool CandidateCanLockPlayer(const MoneyCandidateStore& s, int slot, uint32_t now, const CandidateRules& rules)
+{
+    size_t k = (size_t)slot;
+    if (s.ocrPlayerMatches[k] < rules.autoLockPlayerMinMatches && !IsStepConfirmed(s, slot, OCR_SERIES_PLAYER, rules))
+        return false;
+    if (IsStepRejected(s, slot, OCR_SERIES_PLAYER, rules))
+        return false;
+    return HasRecentOcrMatch(s, slot, now);
+}
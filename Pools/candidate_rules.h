@@ -0,0 +1,85 @@
+/*
+  candidate_rules.h
+  - Per-candidate rules of the money scanner over MoneyCandidateStore
+    columns: OCR match counters, the bet-grid test for value deltas, the
+    likely-money filter, step-correlation verdicts, rank scores per category
+    and the pot / player auto-lock predicates
+  - Settings arrive in CandidateRules (the [Money] keys they mirror are named
+    next to each field); the functions read nothing else, so the plugin and
+    bench/scanner_bench.cpp decide matches, ranks and locks with the same code
+*/
+
+#pragma once
+
+#include "money_store.h"
+#include "top_k.h"
+
+#include <cstdint>
+
+enum RankCategory
+{
+    RANK_CATEGORY_POT = 0,
+    RANK_CATEGORY_PLAYER = 1,
+    RANK_CATEGORY_NPC = 2,
+    RANK_CATEGORY_COUNT = 3
+};
+
+// OCR fields with a step series (lanes of MoneyCandidateStore::stepAligned / stepMissed).
+enum OcrSeriesField
+{
+    OCR_SERIES_POT = 0,
+    OCR_SERIES_WINS = 1,
+    OCR_SERIES_PLAYER = 2,
+    OCR_SERIES_NPC = 3,
+    OCR_SERIES_COUNT = 4
+};
+
+constexpr uint32_t kOcrMatchRecentMs = 12000;  // an OCR match this recent still backs a rank bonus or a lock
+
+struct CandidateRules
+{
+    float likelyMaxChangesPerSec = 1.5f;  // LikelyMaxChangesPerSec (0 = off)
+    bool betStepFilter = true;            // BetStepFilterEnable
+    int betStepDollars = 5;               // BetStepDollars
+    int betMinDollars = 10;               // BetMinDollars
+    int corrRejectMisses = 2;             // CorrRejectMisses (0 = off)
+    int corrLockSteps = 3;                // CorrLockSteps (0 = off)
+    int autoLockPotMinMatches = 10;       // AutoLockPotMinMatches
+    int autoLockPlayerMinMatches = 8;     // AutoLockPlayerMinMatches
+    int ocrToleranceCents = 6;            // OcrMatchToleranceCents
+};
+
+// Counts the OcrMatchBits of one sample, at most once per sample and field.
+void BumpOcrMatches(MoneyCandidate& c, int bits, int sampleId, uint32_t now);
+void BumpOcrMatches(MoneyCandidateStore& s, int slot, int bits, int sampleId, uint32_t now);
+
+// |delta| is a legal bet change, in dollars or in cents.
+bool MatchesBetGridDelta(int absDelta, const CandidateRules& rules);
+// betStepMatches / all graded deltas; -1 = none graded yet.
+float CandidateBetStepRatio(const MoneyCandidateStore& s, int slot);
+float CandidateChangesPerSec(const MoneyCandidateStore& s, int slot, uint32_t now);
+
+int StepAlignedCount(const MoneyCandidateStore& s, int slot, int field);
+int StepMissedCount(const MoneyCandidateStore& s, int slot, int field);
+// The OCR field stepped at least CorrRejectMisses times without this value following.
+bool IsStepRejected(const MoneyCandidateStore& s, int slot, int field, const CandidateRules& rules);
+// Followed at least CorrLockSteps steps of the field and missed none.
+bool IsStepConfirmed(const MoneyCandidateStore& s, int slot, int field, const CandidateRules& rules);
+
+// Changes, but not faster than a table does, and (with the filter) mostly by legal bets.
+bool IsLikelyMoneyCandidate(const MoneyCandidateStore& s, int slot, uint32_t now, const CandidateRules& rules);
+bool IsOcrCorrelatedCandidate(const MoneyCandidateStore& s, int slot);
+bool HasRecentOcrMatch(const MoneyCandidateStore& s, int slot, uint32_t now);
+
+// Pot and NPC category score.
+float CandidateRankScore(const MoneyCandidateStore& s, int slot, uint32_t now, const CandidateRules& rules);
+// Player category score: rewards player OCR hits, penalizes pot/NPC contamination.
+float PlayerStackScore(const MoneyCandidateStore& s, int slot);
+bool IsRankEligible(const MoneyCandidateStore& s, int slot, int category, const CandidateRules& rules);
+RankKey MakeRankKey(const MoneyCandidateStore& s, int slot, float score);
+
+// Evidence that the slot is the pot, independent of the current OCR pot.
+bool CandidatePassesPotAutoLockChecks(const MoneyCandidateStore& s, int slot, uint32_t now, const CandidateRules& rules);
+// Everything the pot auto-lock asks of a slot; potCents <= 0 skips the value check.
+bool CandidateCanLockPot(const MoneyCandidateStore& s, int slot, uint32_t now, int potCents, const CandidateRules& rules);
+bool CandidateCanLockPlayer(const MoneyCandidateStore& s, int slot, uint32_t now, const CandidateRules& rules);
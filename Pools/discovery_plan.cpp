@@ -0,0 +1,314 @@
+#include "discovery_plan.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+
+namespace
+{
+    constexpr int kSeedRing0 = 256;          // innermost seed window is +-kSeedRing0
+    constexpr float kHotspotFloor = 0.05f;   // decayed below this: forgotten
+}
+
+const char* DiscoverySourceName(int source)
+{
+    switch (source)
+    {
+    case DISCOVERY_REFINE: return "refine";
+    case DISCOVERY_SEED: return "seed";
+    case DISCOVERY_COARSE: return "coarse";
+    case DISCOVERY_SWEEP: return "sweep";
+    default: return "?";
+    }
+}
+
+void DiscoveryPlanner::Reset(int start, int end, const DiscoveryPlanConfig& config)
+{
+    cfg = config;
+    rangeStart = start;
+    rangeEnd = (std::max)(start, end);
+    metrics = DiscoveryPlanMetrics();
+    BeginPass({});
+}
+
+void DiscoveryPlanner::BeginPass(const std::vector<int>& seedIdx)
+{
+    read.assign((size_t)((rangeEnd - rangeStart + 63) >> 6), 0);
+    seeds.clear();
+    if (cfg.seedRadius > 0)
+    {
+        for (int idx : seedIdx)
+        {
+            if (idx >= rangeStart && idx < rangeEnd)
+                seeds.push_back(idx);
+        }
+        std::sort(seeds.begin(), seeds.end());
+        seeds.erase(std::unique(seeds.begin(), seeds.end()), seeds.end());
+    }
+    refine.clear();
+    refined.clear();
+    refineHead = 0;
+    seedPos = 0;
+    coarseNext = rangeStart;
+    sweepCursor = rangeStart;
+    metrics.refines = 0;
+}
+
+void DiscoveryPlanner::OnCorrelated(int idx)
+{
+    if (cfg.refineRadius <= 0 || idx < rangeStart || idx >= rangeEnd)
+        return;
+    if ((int)refined.size() >= cfg.refineMax)
+        return;
+    for (int c : refined)
+    {
+        if (c > idx - cfg.refineRadius && c < idx + cfg.refineRadius)
+            return;  // that window already covers most of this one
+    }
+    refined.push_back(idx);
+    refine.push_back({ idx - cfg.refineRadius, idx + cfg.refineRadius });
+    metrics.refines++;
+}
+
+// pos = (ring * seeds + seed) * 2 + side. Ring 0 is one window centred on the seed; ring r > 0
+// is the band kSeedRing0 << (r - 1) .. kSeedRing0 << r out, right side first.
+bool DiscoveryPlanner::SeedWindow(int pos, Window& w) const
+{
+    if (seeds.empty())
+        return false;
+    int perRing = (int)seeds.size() * 2;
+    int ring = pos / perRing;
+    int seed = seeds[(size_t)((pos % perRing) >> 1)];
+    int side = pos & 1;
+    int inner = ring ? (kSeedRing0 << (ring - 1)) : 0;
+    if (inner >= cfg.seedRadius || ring > 24)
+        return false;
+    int outer = (std::min)(kSeedRing0 << ring, cfg.seedRadius);
+    if (ring == 0)
+        w = side ? Window{ seed, seed } : Window{ seed - outer, seed + outer };
+    else
+        w = side ? Window{ seed - outer, seed - inner } : Window{ seed + inner, seed + outer };
+    return true;
+}
+
+bool DiscoveryPlanner::NextIn(int lo, int hi, int maxLen, int& start, int& end) const
+{
+    lo = (std::max)(lo, rangeStart);
+    hi = (std::min)(hi, rangeEnd);
+    if (lo >= hi || maxLen <= 0)
+        return false;
+    int n = hi - rangeStart;
+
+    // First unread slot at or after lo.
+    int i = lo - rangeStart;
+    size_t w = (size_t)i >> 6;
+    uint64_t bits = ~read[w] & (~0ull << (i & 63));
+    while (!bits)
+    {
+        w++;
+        if ((int)(w << 6) >= n)
+            return false;
+        bits = ~read[w];
+    }
+    int first = (int)(w << 6) + std::countr_zero(bits);
+    if (first >= n)
+        return false;
+
+    // Run of unread slots from there.
+    int limit = (std::min)(n, first + maxLen);
+    int stop = limit;
+    w = (size_t)first >> 6;
+    bits = read[w] & (~0ull << (first & 63));
+    while (true)
+    {
+        if (bits)
+        {
+            stop = (std::min)(stop, (int)(w << 6) + std::countr_zero(bits));
+            break;
+        }
+        w++;
+        if ((int)(w << 6) >= limit)
+            break;
+        bits = read[w];
+    }
+    start = rangeStart + first;
+    end = rangeStart + stop;
+    return true;
+}
+
+bool DiscoveryPlanner::Next(int maxLen, int& start, int& end, int& source)
+{
+    for (; refineHead < refine.size(); refineHead++)
+    {
+        const Window& w = refine[refineHead];
+        if (NextIn(w.lo, w.hi, maxLen, start, end))
+        {
+            source = lastSource = DISCOVERY_REFINE;
+            return true;
+        }
+    }
+
+    Window w;
+    for (; SeedWindow(seedPos, w); seedPos++)
+    {
+        if (NextIn(w.lo, w.hi, maxLen, start, end))
+        {
+            source = lastSource = DISCOVERY_SEED;
+            return true;
+        }
+    }
+
+    if (cfg.coarseStride > 0)
+    {
+        for (; coarseNext < rangeEnd; coarseNext += cfg.coarseStride)
+        {
+            if (NextIn(coarseNext, coarseNext + cfg.coarseProbe, maxLen, start, end))
+            {
+                source = lastSource = DISCOVERY_COARSE;
+                return true;
+            }
+        }
+    }
+
+    if (NextIn(sweepCursor, rangeEnd, maxLen, start, end))
+    {
+        sweepCursor = start;
+        source = lastSource = DISCOVERY_SWEEP;
+        return true;
+    }
+    sweepCursor = rangeEnd;
+    metrics.passes++;
+    return false;
+}
+
+void DiscoveryPlanner::MarkRead(int start, int end)
+{
+    start = (std::max)(start, rangeStart);
+    end = (std::min)(end, rangeEnd);
+    if (start >= end)
+        return;
+    metrics.slots[lastSource] += end - start;
+    int i = start - rangeStart;
+    int n = end - rangeStart;
+    while (i < n)
+    {
+        int bit = i & 63;
+        int take = (std::min)(64 - bit, n - i);
+        uint64_t mask = (take == 64) ? ~0ull : (((1ull << take) - 1) << bit);
+        read[(size_t)i >> 6] |= mask;
+        i += take;
+    }
+}
+
+size_t DiscoveryPlanner::MemoryBytes() const
+{
+    return read.capacity() * sizeof(uint64_t) + seeds.capacity() * sizeof(int) +
+        refine.capacity() * sizeof(Window) + refined.capacity() * sizeof(int);
+}
+
+// ---------------- DiscoveryHotspots ----------------
+
+void DiscoveryHotspots::Record(int idx, float weight)
+{
+    if (idx < 0)
+        return;
+    int b = idx >> kBucketShift;
+    auto it = std::lower_bound(buckets.begin(), buckets.end(), b,
+        [](const Bucket& x, int key) { return x.bucket < key; });
+    if (it != buckets.end() && it->bucket == b)
+        it->weight += weight;
+    else
+        buckets.insert(it, { b, weight });
+}
+
+void DiscoveryHotspots::Decay(float factor)
+{
+    size_t kept = 0;
+    for (const Bucket& b : buckets)
+    {
+        float w = b.weight * factor;
+        if (w >= kHotspotFloor)
+            buckets[kept++] = { b.bucket, w };
+    }
+    buckets.resize(kept);
+}
+
+void DiscoveryHotspots::Peaks(int n, std::vector<int>& out) const
+{
+    out.clear();
+    std::vector<Bucket> order(buckets);
+    std::sort(order.begin(), order.end(), [](const Bucket& a, const Bucket& b)
+    {
+        return a.weight != b.weight ? a.weight > b.weight : a.bucket < b.bucket;
+    });
+    for (size_t i = 0; i < order.size() && (int)i < n; i++)
+        out.push_back((order[i].bucket << kBucketShift) + (1 << (kBucketShift - 1)));
+}
+
+std::string DiscoveryHotspots::Serialize(const std::string& buildKey) const
+{
+    std::string out = "; highstakes discovery hotspots (locked pot/stack globals per 1024-global bucket; delete to relearn)\n";
+    char line[96];
+    snprintf(line, sizeof(line), "build=%s\n", buildKey.c_str());
+    out += line;
+    for (const Bucket& b : buckets)
+    {
+        snprintf(line, sizeof(line), "%d %.3f\n", b.bucket, b.weight);
+        out += line;
+    }
+    return out;
+}
+
+bool DiscoveryHotspots::Deserialize(const std::string& text, const std::string& buildKey, std::string& why)
+{
+    std::vector<Bucket> loaded;
+    bool buildOk = false;
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        size_t eol = text.find('\n', pos);
+        if (eol == std::string::npos)
+            eol = text.size();
+        std::string line = text.substr(pos, eol - pos);
+        pos = eol + 1;
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' '))
+            line.pop_back();
+        if (line.empty() || line[0] == ';')
+            continue;
+
+        if (line.compare(0, 6, "build=") == 0)
+        {
+            if (line.substr(6) != buildKey)
+            {
+                why = "saved for build " + line.substr(6);
+                return false;
+            }
+            buildOk = true;
+            continue;
+        }
+
+        int b = 0;
+        float w = 0.0f;
+        if (sscanf(line.c_str(), "%d %f", &b, &w) != 2 || b < 0 || !(w > 0.0f))
+        {
+            why = "bad line '" + line + "'";
+            return false;
+        }
+        loaded.push_back({ b, w });
+    }
+    if (!buildOk)
+    {
+        why = "no build key";
+        return false;
+    }
+    std::sort(loaded.begin(), loaded.end(), [](const Bucket& a, const Bucket& b) { return a.bucket < b.bucket; });
+    buckets.clear();
+    for (const Bucket& b : loaded)
+    {
+        if (!buckets.empty() && buckets.back().bucket == b.bucket)
+            buckets.back().weight += b.weight;
+        else
+            buckets.push_back(b);
+    }
+    return true;
+}
@@ -0,0 +1,132 @@
+/*
+  discovery_plan.h
+  - Order in which discovery reads the global index space during one pass
+  - Work comes from four sources, highest priority first:
+    refine: dense windows around candidates that have tracked an OCR amount
+            (script structs keep the pot next to the seat stacks)
+    seed:   windows spiralling out from seed indices (locked globals, warm
+            start entries, hotspots from past sessions); every seed's inner
+            ring is read before any seed's outer one
+    coarse: one probe every stride across the range, so the candidates that
+            feed refine turn up long before a sweep would reach them
+    sweep:  linear over whatever is still unread; the pass (a scan "wrap")
+            ends when it reaches the end of the range
+  - A per-slot bitmap of what the pass has read makes overlapping windows
+    free; the caller marks known-bad ranges it skips as read too
+  - With every radius and the stride at 0 only the sweep is left, which is
+    the plain linear scan
+  - DiscoveryHotspots is the learned histogram of where locked pot / stack
+    globals sat: one weight per bucket, decayed once per session, saved as a
+    small text file keyed by game build
+  - The planner only hands out spans: reading, fault skipping and the
+    hotspot file's IO are the caller's. bench/scanner_bench.cpp plays it
+    against the linear sweep on MockTable
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum DiscoverySource
+{
+    DISCOVERY_REFINE = 0,
+    DISCOVERY_SEED = 1,
+    DISCOVERY_COARSE = 2,
+    DISCOVERY_SWEEP = 3,
+    DISCOVERY_SOURCE_COUNT = 4
+};
+
+const char* DiscoverySourceName(int source);
+
+struct DiscoveryPlanConfig
+{
+    int seedRadius = 8192;     // 0 = no seed windows
+    int coarseStride = 4096;   // 0 = no coarse probes
+    int coarseProbe = 256;     // slots per probe
+    int refineRadius = 1024;   // 0 = no refine windows
+    int refineMax = 32;        // refine windows per pass
+
+    bool operator==(const DiscoveryPlanConfig&) const = default;
+};
+
+struct DiscoveryPlanMetrics
+{
+    int64_t slots[DISCOVERY_SOURCE_COUNT] = {};  // marked read, all passes
+    int passes = 0;                              // completed
+    int refines = 0;                             // this pass
+};
+
+class DiscoveryPlanner
+{
+public:
+    // Tracks [start, end) and starts the first pass without seeds.
+    void Reset(int start, int end, const DiscoveryPlanConfig& cfg);
+    // Starts a new pass. Seeds outside the range or repeated are ignored.
+    void BeginPass(const std::vector<int>& seeds);
+
+    // Queues a dense window around idx, once per pass and region.
+    void OnCorrelated(int idx);
+
+    // First unread span [start, end), at most maxLen slots, from the highest-priority source
+    // with work left. false = the pass is complete.
+    bool Next(int maxLen, int& start, int& end, int& source);
+    void MarkRead(int start, int end);
+
+    int RangeStart() const { return rangeStart; }
+    int RangeEnd() const { return rangeEnd; }
+    const DiscoveryPlanConfig& Config() const { return cfg; }
+    const DiscoveryPlanMetrics& Metrics() const { return metrics; }
+    size_t MemoryBytes() const;
+
+private:
+    struct Window
+    {
+        int lo;
+        int hi;
+    };
+
+    bool NextIn(int lo, int hi, int maxLen, int& start, int& end) const;
+    bool SeedWindow(int pos, Window& w) const;
+
+    DiscoveryPlanConfig cfg;
+    int rangeStart = 0;
+    int rangeEnd = 0;
+    std::vector<uint64_t> read;  // bit i = rangeStart + i read this pass
+    std::vector<int> seeds;      // sorted, unique, in range
+    std::vector<Window> refine;  // pending, oldest first from refineHead
+    std::vector<int> refined;    // centres queued this pass
+    size_t refineHead = 0;
+    int seedPos = 0;             // ring * 2 * seeds + side, see SeedWindow
+    int coarseNext = 0;          // next probe start
+    int sweepCursor = 0;
+    int lastSource = DISCOVERY_SWEEP;
+    DiscoveryPlanMetrics metrics;
+};
+
+class DiscoveryHotspots
+{
+public:
+    static const int kBucketShift = 10;  // 1024 globals per bucket
+
+    void Record(int idx, float weight);
+    // Scales every weight; buckets that fade below a floor are dropped.
+    void Decay(float factor);
+    // Centres of the n heaviest buckets, heaviest first.
+    void Peaks(int n, std::vector<int>& out) const;
+    int BucketCount() const { return (int)buckets.size(); }
+
+    std::string Serialize(const std::string& buildKey) const;
+    // On mismatch or parse error leaves the histogram untouched and fills why.
+    bool Deserialize(const std::string& text, const std::string& buildKey, std::string& why);
+
+private:
+    struct Bucket
+    {
+        int bucket;
+        float weight;
+    };
+    std::vector<Bucket> buckets;  // sorted by bucket
+};
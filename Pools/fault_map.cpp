@@ -0,0 +1,265 @@
+#include "fault_map.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+void GlobalFaultMap::Reset(int start, int end)
+{
+    rangeStart = start;
+    rangeEnd = (end - start > kMaxTrackedSlots) ? start + kMaxTrackedSlots : end;
+    if (rangeEnd < rangeStart)
+        rangeEnd = rangeStart;
+    size_t words = (size_t)((rangeEnd - rangeStart + 63) >> 6);
+    faulted.assign(words, 0);
+    readable.assign(words, 0);
+    intervals.clear();
+    unconfirmed.clear();
+    probeInterval = 0;
+    probeAt = 0;
+    probeConfirmed = 0;
+    probeDropped = 0;
+}
+
+void GlobalFaultMap::SetBit(std::vector<uint64_t>& bits, int idx)
+{
+    int off = idx - rangeStart;
+    bits[(size_t)off >> 6] |= 1ull << (off & 63);
+}
+
+void GlobalFaultMap::Record(int start, int count, const uint64_t* faultBits)
+{
+    for (int k = 0; k < count; k++)
+    {
+        int idx = start + k;
+        if (!InRange(idx))
+            continue;
+        bool fault = ((faultBits[(size_t)k >> 6] >> (k & 63)) & 1ull) != 0;
+        SetBit(fault ? faulted : readable, idx);
+    }
+}
+
+bool GlobalFaultMap::Rebuild(int minFaults)
+{
+    std::vector<FaultInterval> next;
+    int runStart = -1;     // first faulted slot of the open run
+    int runLastFault = -1; // last faulted slot of the open run
+    int runFaults = 0;
+
+    auto closeRun = [&]()
+    {
+        if (runStart >= 0 && runFaults >= minFaults)
+            next.push_back({ runStart, runLastFault + 1 });
+        runStart = -1;
+        runFaults = 0;
+    };
+
+    int n = rangeEnd - rangeStart;
+    for (int w = 0; w < (int)faulted.size(); w++)
+    {
+        uint64_t f = faulted[(size_t)w];
+        uint64_t r = readable[(size_t)w];
+        if (f == 0 && r == 0)
+            continue;  // nothing probed: an open run bridges the gap
+        if (f == 0 && runStart < 0)
+            continue;  // only readable slots, nothing open
+
+        for (int b = 0; b < 64; b++)
+        {
+            int off = (w << 6) + b;
+            if (off >= n)
+                break;
+            uint64_t bit = 1ull << b;
+            if (r & bit)
+                closeRun();
+            else if (f & bit)
+            {
+                if (runStart < 0)
+                    runStart = rangeStart + off;
+                runLastFault = rangeStart + off;
+                runFaults++;
+            }
+        }
+    }
+    closeRun();
+
+    bool changed = next.size() != intervals.size();
+    for (size_t i = 0; !changed && i < next.size(); i++)
+        changed = next[i].start != intervals[i].start || next[i].end != intervals[i].end;
+    intervals.swap(next);
+    return changed;
+}
+
+int GlobalFaultMap::SkipKnownBad(int idx) const
+{
+    // Last interval starting at or before idx.
+    auto it = std::upper_bound(intervals.begin(), intervals.end(), idx,
+        [](int v, const FaultInterval& iv) { return v < iv.start; });
+    if (it == intervals.begin())
+        return idx;
+    --it;
+    return (idx < it->end) ? it->end : idx;
+}
+
+int GlobalFaultMap::NextBadStart(int idx) const
+{
+    auto it = std::upper_bound(intervals.begin(), intervals.end(), idx,
+        [](int v, const FaultInterval& iv) { return v < iv.start; });
+    return (it == intervals.end()) ? INT_MAX : it->start;
+}
+
+int GlobalFaultMap::BadSlotCount() const
+{
+    int total = 0;
+    for (const FaultInterval& iv : intervals)
+        total += iv.end - iv.start;
+    return total;
+}
+
+std::string GlobalFaultMap::Serialize(const std::string& buildKey) const
+{
+    std::string out = "; highstakes global fault map (regenerated at each scan wrap; delete to relearn)\n";
+    char line[96];
+    snprintf(line, sizeof(line), "build=%s\n", buildKey.c_str());
+    out += line;
+    snprintf(line, sizeof(line), "range=%d %d\n", rangeStart, rangeEnd);
+    out += line;
+    for (const FaultInterval& iv : intervals)
+    {
+        snprintf(line, sizeof(line), "%d %d\n", iv.start, iv.end);
+        out += line;
+    }
+    // Loaded intervals still waiting for their probes are kept as they were.
+    for (size_t i = probeInterval; i < unconfirmed.size(); i++)
+    {
+        snprintf(line, sizeof(line), "%d %d\n", unconfirmed[i].start, unconfirmed[i].end);
+        out += line;
+    }
+    return out;
+}
+
+bool GlobalFaultMap::Deserialize(const std::string& text, const std::string& buildKey, std::string& why)
+{
+    std::vector<FaultInterval> loaded;
+    bool buildOk = false;
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        size_t eol = text.find('\n', pos);
+        if (eol == std::string::npos)
+            eol = text.size();
+        std::string line = text.substr(pos, eol - pos);
+        pos = eol + 1;
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' '))
+            line.pop_back();
+        if (line.empty() || line[0] == ';')
+            continue;
+
+        if (line.compare(0, 6, "build=") == 0)
+        {
+            if (line.substr(6) != buildKey)
+            {
+                why = "saved for build " + line.substr(6);
+                return false;
+            }
+            buildOk = true;
+            continue;
+        }
+        if (line.compare(0, 6, "range=") == 0)
+            continue;  // informational; intervals are clipped to the current range below
+
+        int a = 0, b = 0;
+        if (sscanf(line.c_str(), "%d %d", &a, &b) != 2 || b <= a)
+        {
+            why = "bad line '" + line + "'";
+            return false;
+        }
+        loaded.push_back({ a, b });
+    }
+    if (!buildOk)
+    {
+        why = "no build key";
+        return false;
+    }
+
+    std::sort(loaded.begin(), loaded.end(),
+        [](const FaultInterval& a, const FaultInterval& b) { return a.start < b.start; });
+    unconfirmed.clear();
+    for (const FaultInterval& iv : loaded)
+    {
+        int a = (std::max)(iv.start, rangeStart);
+        int b = (std::min)(iv.end, rangeEnd);
+        if (b > a)
+            unconfirmed.push_back({ a, b });
+    }
+    probeInterval = 0;
+    probeAt = unconfirmed.empty() ? 0 : unconfirmed[0].start;
+    probeConfirmed = 0;
+    probeDropped = 0;
+    return true;
+}
+
+bool GlobalFaultMap::NextProbe(int& idx) const
+{
+    if (!Probing())
+        return false;
+    idx = probeAt;
+    return true;
+}
+
+void GlobalFaultMap::RecordProbe(int idx, bool fault)
+{
+    if (!Probing() || idx != probeAt)
+        return;
+    const FaultInterval iv = unconfirmed[probeInterval];
+    bool settled = true;
+    if (!fault)
+    {
+        // Something inside became readable: discovery relearns the whole range.
+        SetBit(readable, idx);
+        probeDropped++;
+    }
+    else if (idx < iv.end - 1)
+    {
+        SetBit(faulted, idx);
+        probeAt = (std::min)(idx + kProbeStride, iv.end - 1);
+        settled = false;
+    }
+    else
+    {
+        for (int i = iv.start; i < iv.end; i++)
+            SetBit(faulted, i);
+        // A wrap may already have learned part of it; merge so intervals stay disjoint.
+        FaultInterval merged = iv;
+        std::vector<FaultInterval> next;
+        next.reserve(intervals.size() + 1);
+        for (const FaultInterval& x : intervals)
+        {
+            if (x.end < merged.start || x.start > merged.end)
+                next.push_back(x);
+            else
+            {
+                merged.start = (std::min)(merged.start, x.start);
+                merged.end = (std::max)(merged.end, x.end);
+            }
+        }
+        auto at = std::upper_bound(next.begin(), next.end(), merged.start,
+            [](int v, const FaultInterval& x) { return v < x.start; });
+        next.insert(at, merged);
+        intervals.swap(next);
+        probeConfirmed++;
+    }
+    if (!settled)
+        return;
+    probeInterval++;
+    if (Probing())
+        probeAt = unconfirmed[probeInterval].start;
+}
+
+size_t GlobalFaultMap::MemoryBytes() const
+{
+    return (faulted.capacity() + readable.capacity()) * sizeof(uint64_t) +
+        (intervals.capacity() + unconfirmed.capacity()) * sizeof(FaultInterval);
+}
@@ -0,0 +1,85 @@
+/*
+  fault_map.h
+  - Readable/faulting map of the global index space, learned by discovery
+  - Two sticky bitmaps over the tracked range (ever faulted, ever readable) are
+    folded into merged "known bad" intervals at each scan wrap
+  - Intervals are disjoint and sorted, so containment / next-bad queries are a
+    binary search (same bounds as an interval tree, no node storage)
+  - Serialized as a small text file keyed by game build. Saved intervals are
+    not trusted blindly: each is re-probed at a few sample slots once per
+    session and only those still faulting everywhere are skipped again, so a
+    range that became readable (or a stale file) is relearned
+  - Serialize / Deserialize work on strings; the file IO is the caller's.
+    bench/scanner_bench.cpp runs the skip path over MockTable's fault ranges
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct FaultInterval
+{
+    int start;  // first bad index
+    int end;    // one past the last bad index
+};
+
+struct GlobalFaultMap
+{
+    static const int kMaxTrackedSlots = 1 << 24;  // 2 MB per bitmap
+
+    // Clears everything and tracks [start, end) (capped to kMaxTrackedSlots).
+    void Reset(int start, int end);
+
+    // Folds one bulk read into the bitmaps. faultBits bit k = slot start+k faulted.
+    void Record(int start, int count, const uint64_t* faultBits);
+
+    // Re-derives intervals. A bad interval spans faulted slots (and unprobed gaps
+    // between them) with no readable slot inside, holding at least minFaults faults.
+    // Returns true if the interval set changed.
+    bool Rebuild(int minFaults);
+
+    // idx itself if it is not known bad, else the end of its bad interval.
+    int SkipKnownBad(int idx) const;
+    // Start of the first bad interval beginning after idx, or INT_MAX.
+    int NextBadStart(int idx) const;
+
+    int BadSlotCount() const;
+    const std::vector<FaultInterval>& Intervals() const { return intervals; }
+    size_t MemoryBytes() const;
+
+    std::string Serialize(const std::string& buildKey) const;
+    // Loads intervals saved for buildKey as unconfirmed: none is skipped until
+    // the probes below settle it. On mismatch or parse error leaves the map
+    // untouched and fills why.
+    bool Deserialize(const std::string& text, const std::string& buildKey, std::string& why);
+
+    // Next slot of an unconfirmed interval to read; false once all are settled.
+    // Probes cover the first and last slot and every kProbeStride-th in between.
+    static const int kProbeStride = 4096;
+    bool NextProbe(int& idx) const;
+    // Outcome of reading the slot NextProbe returned. A readable slot drops its
+    // interval; the last probe faulting confirms it as known bad.
+    void RecordProbe(int idx, bool fault);
+    bool Probing() const { return probeInterval < unconfirmed.size(); }
+    int ProbeConfirmed() const { return probeConfirmed; }
+    int ProbeDropped() const { return probeDropped; }
+
+private:
+    bool InRange(int idx) const { return idx >= rangeStart && idx < rangeEnd; }
+    void SetBit(std::vector<uint64_t>& bits, int idx);
+
+    int rangeStart = 0;
+    int rangeEnd = 0;
+    std::vector<uint64_t> faulted;   // sticky: faulted at least once
+    std::vector<uint64_t> readable;  // sticky: read at least once
+    std::vector<FaultInterval> intervals;
+
+    std::vector<FaultInterval> unconfirmed;  // loaded from disk, not yet re-probed
+    size_t probeInterval = 0;
+    int probeAt = 0;
+    int probeConfirmed = 0;
+    int probeDropped = 0;
+};
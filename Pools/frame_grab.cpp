@@ -0,0 +1,157 @@
+#include "frame_grab.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+    int Clamp(int v, int lo, int hi)
+    {
+        return (std::max)(lo, (std::min)(v, hi));
+    }
+}
+
+bool GrabRectFromPct(int clientW, int clientH, int xPct, int yPct, int wPct, int hPct, GrabRect& out)
+{
+    out = GrabRect{};
+    if (clientW <= 0 || clientH <= 0)
+        return false;
+
+    int x = (clientW * Clamp(xPct, 0, 100)) / 100;
+    int y = (clientH * Clamp(yPct, 0, 100)) / 100;
+    int w = (clientW * Clamp(wPct, 1, 100)) / 100;
+    int h = (clientH * Clamp(hPct, 1, 100)) / 100;
+    if (x + w > clientW) w = clientW - x;
+    if (y + h > clientH) h = clientH - y;
+    if (w <= 0 || h <= 0)
+        return false;
+
+    out = { x, y, w, h };
+    return true;
+}
+
+GrabRect GrabUnion(const GrabRect* rects, int count)
+{
+    int x0 = 0;
+    int y0 = 0;
+    int x1 = 0;
+    int y1 = 0;
+    bool any = false;
+    for (int i = 0; i < count; i++)
+    {
+        const GrabRect& r = rects[i];
+        if (r.Empty())
+            continue;
+        if (!any)
+        {
+            x0 = r.x;
+            y0 = r.y;
+            x1 = r.x + r.w;
+            y1 = r.y + r.h;
+            any = true;
+            continue;
+        }
+        x0 = (std::min)(x0, r.x);
+        y0 = (std::min)(y0, r.y);
+        x1 = (std::max)(x1, r.x + r.w);
+        y1 = (std::max)(y1, r.y + r.h);
+    }
+    return any ? GrabRect{ x0, y0, x1 - x0, y1 - y0 } : GrabRect{};
+}
+
+void PlanGrabLayout(const GrabRect* rois, int mode, GrabLayout& out)
+{
+    out = GrabLayout{};
+    out.box = GrabUnion(rois, GRAB_ROI_COUNT);
+    if (out.box.Empty())
+        return;
+
+    int64_t summed = 0;
+    for (int i = 0; i < GRAB_ROI_COUNT; i++)
+        summed += rois[i].Empty() ? 0 : (int64_t)rois[i].w * rois[i].h;
+    int64_t boxArea = (int64_t)out.box.w * out.box.h;
+    out.single = (mode == GRAB_MODE_SINGLE) ||
+        (mode == GRAB_MODE_AUTO && boxArea * 100 <= summed * kGrabAutoSingleMaxPct);
+
+    if (out.single)
+    {
+        out.width = out.box.w;
+        out.height = out.box.h;
+        for (int i = 0; i < GRAB_ROI_COUNT; i++)
+        {
+            const GrabRect& r = rois[i];
+            if (!r.Empty())
+                out.place[i] = { r.x - out.box.x, r.y - out.box.y, r.w, r.h };
+        }
+        return;
+    }
+    for (int i = 0; i < GRAB_ROI_COUNT; i++)
+    {
+        const GrabRect& r = rois[i];
+        if (r.Empty())
+            continue;
+        out.place[i] = { 0, out.height, r.w, r.h };
+        out.width = (std::max)(out.width, r.w);
+        out.height += r.h;
+    }
+}
+
+PixelView GrabView(const unsigned char* surface, int surfaceStride, const GrabRect& place)
+{
+    PixelView v;
+    if (!surface || place.Empty())
+        return v;
+    v.pixels = surface + (size_t)place.y * (size_t)surfaceStride + (size_t)place.x * 3;
+    v.width = place.w;
+    v.height = place.h;
+    v.stride = surfaceStride;
+    return v;
+}
+
+bool LumaStdDev(const PixelView& view, float& out)
+{
+    out = 0.0f;
+    if (view.Empty())
+        return false;
+
+    double sum = 0.0;
+    double sumSq = 0.0;
+    for (int y = 0; y < view.height; y++)
+    {
+        const unsigned char* row = view.pixels + (size_t)y * (size_t)view.stride;
+        for (int x = 0; x < view.width; x++)
+        {
+            double luma = 0.114 * row[x * 3 + 0] + 0.587 * row[x * 3 + 1] + 0.299 * row[x * 3 + 2];
+            sum += luma;
+            sumSq += luma * luma;
+        }
+    }
+    double count = (double)view.width * (double)view.height;
+    double mean = sum / count;
+    double var = (sumSq / count) - (mean * mean);
+    if (var < 0.0)
+        var = 0.0;
+    out = (float)std::sqrt(var);
+    return true;
+}
+
+void CopyView(const PixelView& view, OcrImage& img)
+{
+    if (view.Empty())
+    {
+        img.Resize(0, 0);
+        return;
+    }
+    img.Resize(view.width, view.height);
+    size_t rowBytes = (size_t)view.width * 3;
+    for (int y = 0; y < view.height; y++)
+    {
+        unsigned char* dst = img.pixels.data() + (size_t)y * (size_t)img.stride;
+        memcpy(dst, view.pixels + (size_t)y * (size_t)view.stride, rowBytes);
+        // Clears the row padding so dumped bitmaps carry no stale bytes.
+        if ((size_t)img.stride > rowBytes)
+            memset(dst + rowBytes, 0, (size_t)img.stride - rowBytes);
+    }
+}
@@ -0,0 +1,95 @@
+/*
+  frame_grab.h
+  - Geometry and pixel views for the per-cycle screen grab: the opacity,
+    bottom-left and top-right regions are given as percent of the game's
+    client area, resolved to pixel rects once per cycle and captured into
+    one surface
+  - Two layouts: one blit of the regions' bounding box into a surface of
+    that size, or one blit per region with the regions stacked top to
+    bottom (a surface of about their summed area). With the default regions
+    in opposite corners the box is most of the screen, so per-region reads
+    and keeps far fewer pixels; auto takes the box only when it is barely
+    larger than the regions themselves
+  - A region's pixels are a PixelView into that surface (no copy); the
+    opacity and change-detection stages read the views directly, OCR copies
+    out only the regions it submits
+  - Surfaces are 24-bit BGR, top-down, rows padded to 4 bytes (a DIB section)
+  - Layout and views only; the BitBlt into the surface stays in
+    highstakes.cpp, so bench/frame_grab_bench.cpp stands a screen-sized
+    buffer in for the desktop
+*/
+
+#pragma once
+
+#include "ocr_backend.h"
+
+enum GrabRoi
+{
+    GRAB_ROI_OPACITY = 0,
+    GRAB_ROI_BOTTOM_LEFT = 1,
+    GRAB_ROI_TOP_RIGHT = 2,
+    GRAB_ROI_COUNT = 3
+};
+
+enum GrabMode
+{
+    GRAB_MODE_PER_ROI = 0,
+    GRAB_MODE_SINGLE = 1,
+    GRAB_MODE_AUTO = 2
+};
+
+// Auto uses one blit while the bounding box is at most this percent of the summed region area.
+constexpr int kGrabAutoSingleMaxPct = 125;
+
+struct GrabRect
+{
+    int x = 0;
+    int y = 0;
+    int w = 0;
+    int h = 0;
+
+    bool Empty() const { return w <= 0 || h <= 0; }
+};
+
+struct PixelView
+{
+    const unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    int stride = 0;
+
+    bool Empty() const { return !pixels || width <= 0 || height <= 0; }
+};
+
+struct GrabLayout
+{
+    bool single = false;              // one blit of box; otherwise one per region
+    int width = 0;                    // surface size
+    int height = 0;
+    GrabRect box;                     // bounding box of the regions, client coords
+    GrabRect place[GRAB_ROI_COUNT];   // each region within the surface; empty = not grabbed
+};
+
+// Bytes per row of a 24-bit surface width pixels wide.
+inline int GrabStride(int width)
+{
+    return (width * 3 + 3) & ~3;
+}
+
+// Percent of a clientW x clientH area (clamped like the [OCR] settings) to pixels. false = empty.
+bool GrabRectFromPct(int clientW, int clientH, int xPct, int yPct, int wPct, int hPct, GrabRect& out);
+
+// Bounding box of the non-empty rects; empty when all are.
+GrabRect GrabUnion(const GrabRect* rects, int count);
+
+// Surface layout for the regions (client coords, empty ones skipped) under mode.
+void PlanGrabLayout(const GrabRect* rois, int mode, GrabLayout& out);
+
+// place inside a surface (a GrabLayout::place entry). place must lie within it.
+PixelView GrabView(const unsigned char* surface, int surfaceStride, const GrabRect& place);
+
+// Standard deviation of BT.601 luma over the view; false = empty view.
+bool LumaStdDev(const PixelView& view, float& out);
+
+// Copies the view into img (keeps img's allocation when the size does not grow).
+void CopyView(const PixelView& view, OcrImage& img);
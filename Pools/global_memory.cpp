@@ -0,0 +1,163 @@
+#include "global_memory.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    inline void StoreSlot(int& dst, uint64_t raw) { dst = (int32_t)(uint32_t)raw; }
+    inline void StoreSlot(uint64_t& dst, uint64_t raw) { dst = raw; }
+}
+
+bool GlobalMemory::ReadSlot(int idx, uint64_t& out, bool* outFaulted)
+{
+    if (outFaulted)
+        *outFaulted = false;
+    if (!Ready() || idx < 0)
+        return false;
+
+    const uint64_t* p = nullptr;
+    if (Resolve(idx, p))
+    {
+        if (!p)
+            return false;
+        if (Copy(p, 1, &out))
+            return true;
+    }
+    if (outFaulted)
+        *outFaulted = true;
+    OnFault(idx);
+    return false;
+}
+
+bool GlobalMemory::ReadInt(int idx, int& out, bool* outFaulted)
+{
+    uint64_t raw = 0;
+    if (!ReadSlot(idx, raw, outFaulted))
+        return false;
+    out = (int32_t)(uint32_t)raw;
+    return true;
+}
+
+template <class Slot>
+int GlobalMemory::ReadRange(int start, int count, Slot* out, uint64_t* faultBits)
+{
+    if (count <= 0)
+        return 0;
+
+    if (faultBits)
+        std::memset(faultBits, 0, (size_t)((count + 63) >> 6) * sizeof(uint64_t));
+    std::memset(out, 0, (size_t)count * sizeof(Slot));
+
+    auto markRange = [&](int from, int to)
+    {
+        if (!faultBits)
+            return;
+        for (int k = from; k < to; k++)
+            GlobalFaultBitSet(faultBits, k);
+    };
+
+    if (!Ready() || start < 0)
+    {
+        markRange(0, count);
+        return 0;
+    }
+
+    int readOk = 0;
+    int k = 0;
+    while (k < count)
+    {
+        int idx = start + k;
+        int blockEnd = ((idx >> kGlobalBlockShift) + 1) << kGlobalBlockShift;
+        int runLen = (std::min)(count - k, blockEnd - idx);
+
+        const uint64_t* first = nullptr;
+        const uint64_t* last = nullptr;
+        bool firstOk = Resolve(idx, first);
+        bool lastOk = Resolve(idx + runLen - 1, last);
+        bool contiguous = firstOk && lastOk && first && last && (last - first) == (runLen - 1);
+
+        if (!contiguous)
+        {
+            // Unexpected layout: resolve slot by slot so nothing is read from a guessed address.
+            for (int j = 0; j < runLen; j++)
+            {
+                uint64_t raw = 0;
+                if (ReadSlot(idx + j, raw))
+                {
+                    StoreSlot(out[k + j], raw);
+                    readOk++;
+                }
+                else
+                {
+                    markRange(k + j, k + j + 1);
+                }
+            }
+            k += runLen;
+            continue;
+        }
+
+        for (int c = 0; c < runLen; c += kGlobalCopyChunk)
+        {
+            int n = (std::min)(kGlobalCopyChunk, runLen - c);
+            if (Copy(first + c, n, out + k + c))
+            {
+                readOk += n;
+                continue;
+            }
+
+            // Narrow the faulting chunk down to individual slots.
+            bool logged = false;
+            for (int j = 0; j < n; j++)
+            {
+                if (Copy(first + c + j, 1, out + k + c + j))
+                {
+                    readOk++;
+                    continue;
+                }
+                out[k + c + j] = 0;
+                markRange(k + c + j, k + c + j + 1);
+                if (!logged)
+                {
+                    OnFault(idx + c + j);
+                    logged = true;
+                }
+            }
+        }
+        k += runLen;
+    }
+    return readOk;
+}
+
+template int GlobalMemory::ReadRange<int>(int, int, int*, uint64_t*);
+template int GlobalMemory::ReadRange<uint64_t>(int, int, uint64_t*, uint64_t*);
+
+void GlobalMemory::ReadIndices(const int* sortedIdx, int n, int* outVals, unsigned char* outOk)
+{
+    // Per thread: the scan worker and the script thread both read through the same provider.
+    thread_local std::vector<int> spanVals;
+    thread_local std::vector<uint64_t> spanFaults;
+
+    int i = 0;
+    while (i < n)
+    {
+        int j = i + 1;
+        while (j < n && sortedIdx[j] - sortedIdx[j - 1] <= kSparseReadMaxGap)
+            j++;
+
+        int spanStart = sortedIdx[i];
+        int spanLen = sortedIdx[j - 1] - spanStart + 1;
+        spanVals.resize((size_t)spanLen);
+        spanFaults.resize((size_t)((spanLen + 63) >> 6));
+        ReadRange(spanStart, spanLen, spanVals.data(), spanFaults.data());
+
+        for (int t = i; t < j; t++)
+        {
+            int off = sortedIdx[t] - spanStart;
+            bool faulted = GlobalFaultBitTest(spanFaults.data(), off);
+            outOk[t] = faulted ? 0 : 1;
+            outVals[t] = faulted ? 0 : spanVals[(size_t)off];
+        }
+        i = j;
+    }
+}
@@ -0,0 +1,70 @@
+/*
+  global_memory.h
+  - Source of script-global slots for every scanner read
+  - A provider only resolves a global index to its backing slot and copies
+    slots out, reporting faults instead of raising them; the plugin's
+    provider wraps ScriptHook's getGlobalPtr under SEH, the host-side
+    benchmarks plug in a synthetic table (bench/mock_globals.h)
+  - Bulk reads (ReadRange / ReadIndices) are built on those two calls here,
+    so the chunking and fault narrowing are the same for every provider
+  - No bench of its own; bench/scanner_bench.cpp drives it through the mock
+    provider
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Script globals are stored in blocks of 2^18 8-byte slots; every index inside
+// one block is backed by the same contiguous array, so a run of indices that
+// does not cross a block boundary needs a single resolve.
+constexpr int kGlobalBlockShift = 18;
+constexpr int kGlobalCopyChunk = 64;     // slots per protected copy (one fault-bitmap word)
+constexpr int kSparseReadMaxGap = 32;    // read through index gaps up to this size
+
+inline bool GlobalFaultBitTest(const uint64_t* bits, int k)
+{
+    return (bits[k >> 6] >> (k & 63)) & 1ull;
+}
+
+inline void GlobalFaultBitSet(uint64_t* bits, int k)
+{
+    bits[k >> 6] |= 1ull << (k & 63);
+}
+
+class GlobalMemory
+{
+public:
+    virtual ~GlobalMemory() = default;
+
+    // False until the provider can resolve globals (the export is found, the table is built).
+    virtual bool Ready() const = 0;
+
+    // Backing slot of idx. false = resolving faulted; out = nullptr = no storage behind idx.
+    virtual bool Resolve(int idx, const uint64_t*& out) = 0;
+
+    // Copies count slots starting at src (a Resolve result). false = a read faulted.
+    // int destinations get the low 32 bits (SlotInt32), uint64_t the raw slot.
+    virtual bool Copy(const uint64_t* src, int count, uint64_t* out) = 0;
+    virtual bool Copy(const uint64_t* src, int count, int* out) = 0;
+
+    // First faulting index of a bulk read or a failed single read (for throttled logging).
+    virtual void OnFault(int idx) { (void)idx; }
+
+    bool ReadSlot(int idx, uint64_t& out, bool* outFaulted = nullptr);
+    bool ReadInt(int idx, int& out, bool* outFaulted = nullptr);
+
+    // Reads globals [start, start+count) into out[] (int or uint64_t slots). faultBits
+    // (optional, (count+63)/64 words) receives one set bit per slot that could not be read;
+    // such out[] entries are left at 0. Returns the number of slots read successfully.
+    template <class Slot>
+    int ReadRange(int start, int count, Slot* out, uint64_t* faultBits = nullptr);
+
+    // Reads an ascending list of indices, coalescing nearby indices into ReadRange
+    // spans. outOk[i] is 1 when outVals[i] holds a fresh value.
+    void ReadIndices(const int* sortedIdx, int n, int* outVals, unsigned char* outOk);
+};
+
+extern template int GlobalMemory::ReadRange<int>(int, int, int*, uint64_t*);
+extern template int GlobalMemory::ReadRange<uint64_t>(int, int, uint64_t*, uint64_t*);
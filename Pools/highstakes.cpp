@@ -8,6 +8,7 @@
   - Hot reload INI: PageUp
   - Toggle DrawMethod: PageDown
   - Money scanner/overlay: Delete toggles, End resets scan
+  - Narrowing search: Numpad0 starts, Numpad1-4 step (equals/delta/unchanged/changed)
 */
 
 // Windows headers define min/max macros unless NOMINMAX is set, which breaks
@@ -22,6 +23,30 @@
 
 #include "script.h"
 #include "global.h"
+#include "money_store.h"
+#include "money_diff.h"
+#include "triple_buffer.h"
+#include "fault_map.h"
+#include "top_k.h"
+#include "candidate_rules.h"
+#include "scan_scheduler.h"
+#include "session_cache.h"
+#include "typed_scanner.h"
+#include "narrowing.h"
+#include "step_correlation.h"
+#include "seat_layout.h"
+#include "rescan_tiers.h"
+#include "watch_registry.h"
+#include "trace_recorder.h"
+#include "global_memory.h"
+#include "memory_budget.h"
+#include "candidate_epochs.h"
+#include "discovery_plan.h"
+#include "ocr_amount_index.h"
+#include "ocr_backend.h"
+#include "ocr_ipc.h"
+#include "tile_signature.h"
+#include "frame_grab.h"
 #include <windows.h>
 #ifdef near
 #undef near
@@ -43,10 +68,11 @@
 #include <array>
 #include <deque>
 #include <unordered_set>
-#include <cmath>
+#include <atomic>
 
 // ---------------- Logging ----------------
 static FILE* gLog = nullptr;
+static SRWLOCK gLogLock = SRWLOCK_INIT;  // the scan worker logs too
 
 static void Log(const char* fmt, ...)
 {
@@ -54,10 +80,12 @@ static void Log(const char* fmt, ...)
         return;
     va_list args;
     va_start(args, fmt);
+    AcquireSRWLockExclusive(&gLogLock);
     vfprintf(gLog, fmt, args);
-    va_end(args);
     fprintf(gLog, "\n");
     fflush(gLog);
+    ReleaseSRWLockExclusive(&gLogLock);
+    va_end(args);
 }
 
 // ---------------- INI helpers ----------------
@@ -157,6 +185,13 @@ struct Settings
     int ocrPayoutOutExtraMs = 5000;    // extra OUT stable time while payout marker grace is active
     std::string ocrPlayerNameHint = "arthur"; // lowercase token used to pick player row amount from OCR
     std::string ocrTesseractPath = "tesseract";
+    int ocrEngine = 1;                 // 0=spawn tesseract.exe per cycle; 1=libtesseract in-process; 2=highstakes_ocr worker process
+    std::string ocrTesseractDll = "";  // libtesseract DLL; empty = look next to the resolved tesseract.exe
+    std::string ocrWorkerPath = "highstakes_ocr\\highstakes_ocr.exe";  // Engine=2; relative = game folder
+    int ocrGrabSingleBlit = 2;         // 1=one BitBlt of the regions' bounding box; 0=one per region; 2=auto
+    int ocrDirtySkip = 1;              // 1=recognize only regions whose tile signature changed
+    int ocrDirtyNoise = 3;             // cell mean delta (0..255) still treated as unchanged
+    int ocrDirtyMaxReuseMs = 5000;     // re-recognize a clean region at least this often
     std::string ocrKeywords = "poker,ante,call,fold,raise,check,bet,pot,blind,cards,community,turn";
 
     // -------- Money sniffing (visual confirmation) --------
@@ -164,14 +199,31 @@ struct Settings
     int moneyScanEnable = 1;            // 1=scan globals for chip-like ints
     int moneyScanStart = 0;             // scan range start (global index)
     int moneyScanEnd = 100000;          // scan range end (exclusive)
-    int moneyScanBatch = 512;           // indices per scan step
+    int moneyScanBatch = 16384;         // indices per scan step
     int moneyScanIntervalMs = 20;       // ms between scan steps
-    int moneyScanMaxReadsPerStep = 512; // hard cap of reads per frame step
-    int moneyScanMaxStepMs = 4;         // soft time budget per frame step
+    int moneyScanMaxReadsPerStep = 16384; // hard cap of reads per scan step (bulk reads are cheap)
+    int moneyDiscoveryMode = 1;         // 0=linear sweep, 1=seeded coarse-to-fine, see discovery_plan.h
+    int moneyDiscoverySeedRadius = 8192;   // globals read around each seed before the coarse probes
+    int moneyDiscoveryCoarseStride = 4096; // one 256-global probe per stride
+    int moneyDiscoveryRefineRadius = 1024; // dense window around candidates that track an OCR amount
+    int moneyRescanColdMaxAgeMs = 2000; // rescan: target time for one pass over candidates that are neither locked nor OCR-correlated
+    int moneyScanMaxStepMs = 4;         // soft time budget per scan step (used when ScanBudgetUs=0)
+    int moneyScanBudgetUs = 300;        // QPC budget per scan step in microseconds (0=use ScanMaxStepMs)
+    int moneyScanWorker = 0;            // 1=discover/rescan on a background thread; the script thread only reads snapshots
+    int moneyTypedScan = 0;             // 1=also match float / high-int32 slots against OCR amounts (logged, not tracked)
+    int moneyNarrowEnable = 1;          // 1=narrowing search hotkeys (Cheat-Engine-style next scan over the scan range)
+    int moneyNarrowAuto = 0;            // 1=start at table join and step on every new OCR sample
+    int moneyNarrowTarget = 0;          // OCR amount narrowed against: 0=pot, 1=player stack
+    int moneyNarrowKeyStart = 0x60;     // VK code: new search (Numpad0)
+    int moneyNarrowKeyEquals = 0x61;    // VK code: keep values equal to the OCR target (Numpad1)
+    int moneyNarrowKeyDelta = 0x62;     // VK code: keep values changed by the OCR target delta (Numpad2)
+    int moneyNarrowKeyUnchanged = 0x63; // VK code: keep unchanged values (Numpad3)
+    int moneyNarrowKeyChanged = 0x64;   // VK code: keep changed values (Numpad4)
     int moneyValueMin = 1;              // candidate int min (>=1 excludes zeros)
     int moneyValueMax = 500000;         // candidate int max
     int moneyTopN = 10;                 // show top N candidates
     int moneyPruneMs = 300000;          // drop candidates not seen recently
+    int moneyCandidateCap = 25000;      // hard cap on candidates (0=none); lowest keep scores are evicted
     int moneyLogEnable = 1;             // 1=write periodic money info to log
     int moneyLogIntervalMs = 3000;      // ms between money log snapshots
     int moneyLogTopN = 5;               // top changing candidates to log
@@ -182,12 +234,26 @@ struct Settings
     int moneyBetMinDollars = 10;        // smallest legal bet change (Saint Denis high-stakes: 10)
     int moneyExceptionLogCooldownMs = 30000; // SEH warning cooldown (0=log once per scan)
     int moneySkipFaultRuns = 1;         // 1=skip ahead after contiguous SEH faults
+    int moneyFaultMapEnable = 1;        // 1=remember faulting global ranges per game build (highstakes_faultmap.txt)
+    int moneySessionCache = 1;          // 1=warm-start candidates at table join from highstakes_session.bin
+    std::string moneySessionCacheScript = "poker"; // poker script name, part of the session cache key
     int moneyOcrMatchToleranceCents = 6; // max abs delta to treat candidate as matching OCR amount
+    int moneyCorrEnable = 1;            // 1=correlate candidate step changes with OCR step changes over time
+    int moneyCorrLagMs = 2500;          // max time between a global's step and the OCR sample that shows it
+    int moneyCorrPoolSize = 4096;       // pooled step rings, one per OCR-correlated candidate
+    int moneyCorrRejectMisses = 2;      // missed pot/player steps (more misses than hits) that reject a candidate (0=off)
+    int moneyCorrLockSteps = 3;         // aligned steps with no miss that allow auto-lock below AutoLock*MinMatches (0=off)
     int moneyNpcTrackMax = 5;           // max OCR-derived NPC amounts tracked per sample
     int moneyAutoLockPot = 1;           // 1=auto-lock pot global from OCR-correlated candidates
     int moneyAutoLockPotMinMatches = 10; // minimum OCR pot matches before auto-locking
     int moneyAutoLockPlayer = 1;        // 1=auto-lock player stack global from OCR-correlated candidates
     int moneyAutoLockPlayerMinMatches = 8; // minimum OCR player matches before auto-locking
+    int moneySeatArrayEnable = 1;       // 1=infer the seat-stack array from NPC/player-matched candidates and lock it with the pot
+    int moneySeatArraySeats = 6;        // seats in the table array (player + up to 5 NPCs)
+    int moneySeatArrayMaxStride = 64;   // largest seat stride (script struct size) tried
+    int moneySeatArrayMinSeats = 4;     // seats with OCR evidence before the array locks (player included)
+    int moneySeatArrayMinMatches = 2;   // OCR matches + aligned steps for a seat to count as evidence
+    int moneySeatArrayStopScan = 1;     // 1=once locked, stop discovery/rescan and read only the pot and seat globals
     float moneyOverlayMultiplier = 2.0f; // multiplier shown in overlay
     int moneyPayoutEnable = 0;          // 1=auto payout bonus during payout phase
     float moneyPayoutMultiplier = 2.0f; // payout multiplier; bonus = src*(multiplier-1)
@@ -204,20 +270,31 @@ struct Settings
     int stackGlobal3 = -1;
     int stackGlobal4 = -1;
     int stackGlobal5 = -1;
+    int moneyWatchPeriodMs = 0;         // read period of the Pot/Stk0-5 watches (0=every frame)
+    int moneyWatchHistory = 32;         // value changes kept per watch
+    int moneyWatchLogChanges = 0;       // 1=log every watch value change ("[WATCH]")
+    std::vector<std::string> moneyWatches; // extra WatchN=name,index[,periodMs[,unit]] lines
+    int moneyRecordEnable = 0;          // 1=record watches, OCR money fields and phase changes to highstakes_rec_*.bin
+    int moneyRecordFlushMs = 1000;      // max time a recorded sample waits in memory before it is written
+    int moneyRecordBlockKB = 64;        // recording block size (one index entry per block)
 };
 
 static Settings gCfg;
 static char gGameDirPath[MAX_PATH]{ 0 };
 static char gIniPath[MAX_PATH]{ 0 };
 static char gLogPath[MAX_PATH]{ 0 };
+static char gFaultMapPath[MAX_PATH]{ 0 };
+static char gSessionCachePath[MAX_PATH]{ 0 };
+static char gHotspotsPath[MAX_PATH]{ 0 };
 
 // ---------------- ScriptHook export: getGlobalPtr ----------------
 // Used for global scanning / watch-list reading.
 using getGlobalPtr_t = uint64_t * (__cdecl*)(int globalIndex);
 static getGlobalPtr_t gGetGlobalPtr = nullptr;
 static bool gTriedResolveGetGlobalPtr = false;
-static bool gGlobalReadSehFaultSeen = false;
-static DWORD gNextGlobalReadFaultLogAt = 0;
+// Read faults are reported from the script thread and the scan worker alike.
+static std::atomic<bool> gGlobalReadSehFaultSeen{ false };
+static std::atomic<DWORD> gNextGlobalReadFaultLogAt{ 0 };
 static DWORD gLastResolveAttemptMs = 0;
 
 static bool ClampIntSetting(const char* key, int& value, int minValue, int maxValue)
@@ -297,73 +374,120 @@ static void ResolveGetGlobalPtrOnce()
         Log("[MONEY] WARNING: getGlobalPtr export not found. Will retry in 5s.");
 }
 
-static bool ReadGlobalInt(int idx, int& out, bool* outSehFault = nullptr)
+static void NoteGlobalReadFault(int idx)
 {
-    if (outSehFault)
-        *outSehFault = false;
+    DWORD cooldownMs = (gCfg.moneyExceptionLogCooldownMs > 0)
+        ? (DWORD)gCfg.moneyExceptionLogCooldownMs
+        : 0;
+    DWORD now = GetTickCount();
 
-    if (!gGetGlobalPtr || idx < 0)
-        return false;
+    if (!gGlobalReadSehFaultSeen.exchange(true))
+    {
+        gNextGlobalReadFaultLogAt.store((cooldownMs > 0) ? (now + cooldownMs) : 0);
+        if (cooldownMs > 0)
+            Log("[MONEY] WARNING: Exception while reading script global (idx=%d). Throttling repeats for %lu ms.", idx, (unsigned long)cooldownMs);
+        else
+            Log("[MONEY] WARNING: Exception while reading script global (idx=%d). Suppressing further.", idx);
+        return;
+    }
+    DWORD due = gNextGlobalReadFaultLogAt.load();
+    // Only the thread that moves the deadline logs.
+    if (cooldownMs > 0 && now >= due && gNextGlobalReadFaultLogAt.compare_exchange_strong(due, now + cooldownMs))
+        Log("[MONEY] WARNING: Exception while reading script global (idx=%d).", idx);
+}
+
+// int destinations get the low 32 bits (same value ReadGlobalInt returns), uint64_t the raw slot.
+static inline void StoreGlobalSlot(int& dst, uint64_t raw) { dst = SlotInt32::Decode(raw); }
+static inline void StoreGlobalSlot(uint64_t& dst, uint64_t raw) { dst = raw; }
+
+template <class Slot>
+static bool CopyGlobalSlotsProtected(const uint64_t* src, int count, Slot* out)
+{
     __try
     {
-        uint64_t* p = gGetGlobalPtr(idx);
-        if (!p)
-            return false;
-        out = *(int*)p;
+        for (int k = 0; k < count; k++)
+            StoreGlobalSlot(out[k], src[k]);
         return true;
     }
     __except (EXCEPTION_EXECUTE_HANDLER)
     {
-        if (outSehFault)
-            *outSehFault = true;
+        return false;
+    }
+}
 
-        DWORD cooldownMs = (gCfg.moneyExceptionLogCooldownMs > 0)
-            ? (DWORD)gCfg.moneyExceptionLogCooldownMs
-            : 0;
-        DWORD now = GetTickCount();
+// The plugin's GlobalMemory provider. Every dereference of a resolved slot runs under SEH;
+// a fault is reported to the caller instead of taking the game down.
+class ScriptHookGlobalMemory final : public GlobalMemory
+{
+public:
+    bool Ready() const override { return gGetGlobalPtr != nullptr; }
 
-        if (!gGlobalReadSehFaultSeen)
+    bool Resolve(int idx, const uint64_t*& out) override
+    {
+        out = nullptr;
+        __try
         {
-            if (cooldownMs > 0)
-                Log("[MONEY] WARNING: Exception while reading script global (idx=%d). Throttling repeats for %lu ms.", idx, (unsigned long)cooldownMs);
-            else
-                Log("[MONEY] WARNING: Exception while reading script global (idx=%d). Suppressing further.", idx);
-
-            gGlobalReadSehFaultSeen = true;
-            gNextGlobalReadFaultLogAt = (cooldownMs > 0) ? (now + cooldownMs) : 0;
+            out = gGetGlobalPtr(idx);
+            return true;
         }
-        else if (cooldownMs > 0 && now >= gNextGlobalReadFaultLogAt)
+        __except (EXCEPTION_EXECUTE_HANDLER)
         {
-            Log("[MONEY] WARNING: Exception while reading script global (idx=%d).", idx);
-            gNextGlobalReadFaultLogAt = now + cooldownMs;
+            return false;
         }
-        return false;
     }
+
+    bool Copy(const uint64_t* src, int count, uint64_t* out) override { return CopyGlobalSlotsProtected(src, count, out); }
+    bool Copy(const uint64_t* src, int count, int* out) override { return CopyGlobalSlotsProtected(src, count, out); }
+    void OnFault(int idx) override { NoteGlobalReadFault(idx); }
+};
+
+static ScriptHookGlobalMemory gScriptHookGlobals;
+static GlobalMemory* gGlobals = &gScriptHookGlobals;  // every scanner read goes through this provider
+
+// Whole 64-bit slot; typed scans decode int32/float/packed fields from it.
+static bool ReadGlobalSlot(int idx, uint64_t& out, bool* outSehFault = nullptr)
+{
+    return gGlobals->ReadSlot(idx, out, outSehFault);
 }
 
-// ---------------- Money scanning state ----------------
-struct MoneyCandidate
+static bool ReadGlobalInt(int idx, int& out, bool* outSehFault = nullptr)
 {
-    int idx = -1;
-    int last = 0;
-    int lastDelta = 0;
-    int changes = 0;
-    int betStepMatches = 0;
-    int betStepMismatches = 0;
-    int ocrAnyMatches = 0;
-    int ocrPotMatches = 0;
-    int ocrPlayerMatches = 0;
-    int ocrNpcMatches = 0;
-    int lastOcrAnySampleId = -1;
-    int lastOcrPotSampleId = -1;
-    int lastOcrPlayerSampleId = -1;
-    int lastOcrNpcSampleId = -1;
-    DWORD firstSeenMs = 0;
-    DWORD lastSeenMs = 0;
-    DWORD lastChangeMs = 0;
-    DWORD lastOcrMatchMs = 0;
-};
+    return gGlobals->ReadInt(idx, out, outSehFault);
+}
+
+// ---------------- Bulk global reads ----------------
+// Chunking and fault narrowing live in GlobalMemory (global_memory.cpp).
+template <class Slot>
+static int ReadGlobalRange(int start, int count, Slot* out, uint64_t* faultBits = nullptr)
+{
+    return gGlobals->ReadRange(start, count, out, faultBits);
+}
+
+static void ReadGlobalIndices(const int* sortedIdx, int n, int* outVals, unsigned char* outOk)
+{
+    gGlobals->ReadIndices(sortedIdx, n, outVals, outOk);
+}
+
+static bool GlobalsReady()
+{
+    return gGlobals->Ready();
+}
+
+// ---------------- High-resolution timing ----------------
+static int64_t QpcNowUs()
+{
+    static LARGE_INTEGER freq{};
+    if (freq.QuadPart == 0)
+        QueryPerformanceFrequency(&freq);
+    LARGE_INTEGER t;
+    QueryPerformanceCounter(&t);
+    return (int64_t)(t.QuadPart / freq.QuadPart) * 1000000
+        + (int64_t)(t.QuadPart % freq.QuadPart) * 1000000 / freq.QuadPart;
+}
+
+static FrameClock gFrameClock;  // script thread, ticked once per WAIT(0)
 
+// ---------------- Money scanning state ----------------
 static bool  gMoneyOverlayRuntime = true;
 static DWORD gNextMoneyScanAt = 0;
 static DWORD gNextMoneyLogAt = 0;
@@ -373,13 +497,132 @@ static DWORD gLastMoneySnapshotLogAt = 0;
 static int   gMoneyScanCursor = 0;
 static bool  gMoneyScanWrapped = false;
 static int   gMoneyScanWrapCount = 0;
+static int   gRescanOcrSampleId = -1;  // OCR sample last correlated against every candidate
+static int   gRescanOcrPassSampleId = -1; // OCR sample whose correlation pass is running
+static int   gRescanOcrPassIdx = 0;    // next global index of that pass
+static RescanTiers gRescanTiers;       // which candidates the rescan reads each step, see rescan_tiers.h
+static std::vector<int> gScanLockedIdx; // locked watch globals, copied in from the script thread
+static int   gScanResetSerial = 0;     // bumped by ResetMoneyScan; snapshots from older serials are ignored
+static CandidateEpochs gEpochRequests;  // script thread: bumped by soft resets and settlements
+static bool  gMoneyScanSeeded = false;  // script thread: a hard reset has run this session
+static CandidateEpochs gScanEpochs;     // scanner-owned: the generations applied so far, see "Epochs"
+static DiscoveryPlanner gDiscovery;     // scanner-owned: read order of the discovery pass, see "Discovery"
+static std::vector<int> gDiscoverySeeds; // scanner-owned: hotspot peaks, locked and warm globals of this session
+static DiscoveryHotspots gHotspots;     // script thread: where past locks sat, saved to gHotspotsPath
+static std::vector<int> gHotspotSeeds;  // script thread: gHotspots peaks, handed to the scanner at reset
+static bool  gScanWorkerStartFailed = false;  // cleared by LoadSettings
 static int   gLastLoggedTopIdx = -1;
 static int   gLastLoggedTopVal = 0;
 static int   gLastLoggedCandCount = -1;
-static std::unordered_map<int, MoneyCandidate> gMoneyCands;
+static bool  gLoggedColdClamped = false;  // RescanColdMaxAgeMs out of reach, already reported
+static MoneyCandidateStore gMoneyCands;  // sorted SoA columns, see money_store.h
+
+constexpr int kRankTopKMin = 16;        // auto-lock depth when TopN is small
+constexpr DWORD kRankRebuildMs = 1000;  // picks up score drift that comes only from time passing
+
+struct CandidateRanking
+{
+    TopKHeap top[RANK_CATEGORY_COUNT];
+    bool stale = true;
+    DWORD nextRebuildAt = 0;
+};
+
+// Best-first slots per category, valid for the store they were exported from.
+struct RankedSlots
+{
+    std::vector<int> slots[RANK_CATEGORY_COUNT];
+};
+
+static CandidateRanking gRanking;  // scanner-owned
+static CandidateRules gCandidateRules;  // from gCfg, refreshed by LoadSettings
+static ScanScheduler gScanSched;   // scanner-owned
+static RankedSlots gRankedSlots;   // scanner-owned export of gRanking
+
 static int   gAutoPotGlobal = -1;
 static int   gAutoPlayerGlobal = -1;
 
+// Warm start: cached candidates handed to the scanner with each reset (main-thread owned).
+static std::vector<SessionCacheEntry> gSessionCacheEntries;
+static DWORD gNextSessionCacheSaveAt = 0;
+
+// A seeded candidate waiting for OCR to agree with its live value.
+struct WarmStartCandidate
+{
+    SessionCacheEntry cached;
+    int confirms = 0;
+    int misses = 0;
+};
+
+static std::vector<SessionCacheEntry> gWarmStartSeeds;  // scanner-owned, inserted once globals resolve
+static std::vector<WarmStartCandidate> gWarmStart;       // scanner-owned
+static int gWarmStartSampleId = -1;                     // scanner-owned: last OCR sample checked
+
+// Float / high-int32 slot that matched OCR amounts (TypedScan=1, see "Typed scan").
+struct TypedMoneyHit
+{
+    int idx = -1;
+    const char* type = "";
+    double value = 0.0;
+    int matches = 0;
+    int lastSampleId = -1;
+};
+
+static std::vector<TypedMoneyHit> gTypedHits;  // scanner-owned
+
+static SeriesPool gSeriesPool;                              // scanner-owned, see "Step correlation"
+static SeriesRing gOcrSeries[OCR_SERIES_COUNT];             // scanner-owned
+static uint32_t gOcrSeriesSettledMs[OCR_SERIES_COUNT]{};    // newest OCR step already settled
+static int gOcrSeriesPrevWins = -1;
+static std::vector<int> gOcrSeriesPrevNpc;
+static bool gSeriesPoolFullLogged = false;
+
+// Candidate cap (scanner-owned, see "Candidate cap"). An evicted index is only re-admitted
+// by discovery when its value matches an OCR amount.
+static CandidateEvictor gEvictor;
+static std::vector<uint64_t> gEvictedBits;   // one bit per global index
+static int gEvictedTotal = 0;
+static std::vector<int> gEvictPendingIdx;    // chosen by the open round, not yet compacted out
+static int gEvictRoundCursorIdx = 0;        // next global index the open round scores
+static int gEvictRoundCount = 0;
+static int gEvictRoundSteps = 0;
+static DWORD gNextEvictLogAt = 0;
+
+static MemoryLedger gMemLedger;              // main-thread owned, see "Memory"
+
+// Manual / auto narrowing search (main-thread owned, see "Narrowing").
+static NarrowingSearch gNarrow;
+static int gNarrowLastTargetCents = -1;  // OCR target at the last step
+static int gNarrowLastSampleId = -1;     // OCR sample the auto mode last stepped on
+
+// Seat-stack array found by structural inference (main-thread owned, see "Seat array").
+constexpr int kSeatArrayMaxSeats = 6;  // Stk0..Stk5
+
+struct SeatArrayLock
+{
+    bool locked = false;
+    SeatArrayFit fit;
+    int potIdx = -1;
+    int stackIdx[kSeatArrayMaxSeats] = { -1, -1, -1, -1, -1, -1 };  // Stk0 (player) .. Stk5
+    bool setAutoPot = false;     // the lock filled gAutoPotGlobal / gAutoPlayerGlobal
+    bool setAutoPlayer = false;
+    int checkedSampleId = -1;    // last OCR sample ValidateSeatArray compared against
+    int potMisses = 0;           // consecutive OCR samples the pot / player / NPC seats missed
+    int playerMisses = 0;
+    int npcMisses = 0;
+    std::vector<int> readIdx;    // pot + seats, ascending
+    std::vector<int> readVals;
+    std::vector<unsigned char> readOk;
+};
+
+static SeatArrayLock gSeatArray;
+static DWORD gNextSeatArrayInferAt = 0;
+
+// Watchpoints (main-thread owned, see "Watchpoints"). Pot and Stk0-5 are always the first seven.
+constexpr int kWatchPot = 0;
+constexpr int kWatchStack0 = 1;
+constexpr int kMaxIniWatches = 16;  // Watch0..Watch15
+static WatchRegistry gWatches;
+
 struct OcrMoneySnapshot
 {
     int sampleId = 0;
@@ -396,6 +639,7 @@ struct OcrMoneySnapshot
 };
 
 static OcrMoneySnapshot gOcrMoney;
+static OcrMoneySnapshot gScanOcr;  // copy the candidate scanner correlates against (scan-thread owned)
 
 static bool IsOcrMoneyFresh(DWORD now, DWORD maxAgeMs = 10000)
 {
@@ -883,367 +1127,757 @@ static void UpdateOcrMoneySnapshot(const std::string& rawText, DWORD now)
 
 static bool CandidateMatchesObservedOcrAmount(int value, int amountCents)
 {
-    if (amountCents <= 0)
-        return false;
-    int tol = (std::max)(0, gCfg.moneyOcrMatchToleranceCents);
-
-    // Primary: global appears to be cent-based (value and OCR amount are both cents).
-    long long diffDirect = (long long)value - (long long)amountCents;
-    if (diffDirect < 0)
-        diffDirect = -diffDirect;
-    if (diffDirect <= (long long)tol)
-        return true;
-
-    // Alternate: some globals may be dollar-based while OCR amount is cents.
-    long long valueAsCents = (long long)value * 100ll;
-    long long diffDollarGlobal = valueAsCents - (long long)amountCents;
-    if (diffDollarGlobal < 0)
-        diffDollarGlobal = -diffDollarGlobal;
-    if (diffDollarGlobal <= (long long)tol)
-        return true;
-
-    return false;
+    // Cent-based globals match the OCR amount directly; dollar-based ones after * 100.
+    return OcrAmountMatches(value, amountCents, gCfg.moneyOcrMatchToleranceCents);
 }
 
-static void UpdateCandidateOcrMatches(MoneyCandidate& c, int currentValue, DWORD now)
-{
-    if (gOcrMoney.sampleId <= 0 || gOcrMoney.amountsCents.empty())
-        return;
+// Which OCR fields (current sample) a global value matches. The index is rebuilt once per
+// gScanOcr sample, so the rescan pays one hash probe per candidate however many amounts OCR read.
+static OcrAmountIndex gScanOcrIndex;    // scan-thread owned, like gScanOcr
+static int gScanOcrIndexSampleId = -1;
+static int gScanOcrIndexTol = -1;
 
-    bool anyMatch = false;
-    for (int amount : gOcrMoney.amountsCents)
-    {
-        if (CandidateMatchesObservedOcrAmount(currentValue, amount))
-        {
-            anyMatch = true;
-            break;
-        }
-    }
+static int ComputeOcrMatchBits(int currentValue)
+{
+    if (gScanOcr.sampleId <= 0 || gScanOcr.amountsCents.empty())
+        return 0;
 
-    if (anyMatch && c.lastOcrAnySampleId != gOcrMoney.sampleId)
+    if (gScanOcrIndexSampleId != gScanOcr.sampleId || gScanOcrIndexTol != gCfg.moneyOcrMatchToleranceCents)
     {
-        c.ocrAnyMatches++;
-        c.lastOcrAnySampleId = gOcrMoney.sampleId;
-        c.lastOcrMatchMs = now;
+        int potRefs[4] = {
+            gScanOcr.potCents,
+            gScanOcr.mainPotCents,
+            gScanOcr.sidePotCents,
+            gScanOcr.genericPotCents
+        };
+        // Pot refs that also match the player stack only count for non-player globals (pot/player contamination).
+        gScanOcrIndex.Build(gCfg.moneyOcrMatchToleranceCents, gScanOcr.amountsCents, gScanOcr.playerCents,
+            potRefs, 4, gScanOcr.npcAmountsCents);
+        gScanOcrIndexSampleId = gScanOcr.sampleId;
+        gScanOcrIndexTol = gCfg.moneyOcrMatchToleranceCents;
     }
+    return gScanOcrIndex.Match(currentValue);
+}
 
-    bool playerMatch = false;
-    if (gOcrMoney.playerCents > 0 &&
-        CandidateMatchesObservedOcrAmount(currentValue, gOcrMoney.playerCents))
-    {
-        playerMatch = true;
-        if (c.lastOcrPlayerSampleId != gOcrMoney.sampleId)
-        {
-            c.ocrPlayerMatches++;
-            c.lastOcrPlayerSampleId = gOcrMoney.sampleId;
-            c.lastOcrMatchMs = now;
-        }
-    }
+static void UpdateCandidateOcrMatches(MoneyCandidate& c, int currentValue, DWORD now)
+{
+    BumpOcrMatches(c, ComputeOcrMatchBits(currentValue), gScanOcr.sampleId, now);
+}
 
-    bool potMatch = false;
-    int potRefs[4] = {
-        gOcrMoney.potCents,
-        gOcrMoney.mainPotCents,
-        gOcrMoney.sidePotCents,
-        gOcrMoney.genericPotCents
-    };
-    for (int ref : potRefs)
-    {
-        if (ref <= 0)
-            continue;
-        // Prevent pot/player contamination when both are close in value.
-        if (gOcrMoney.playerCents > 0 &&
-            CandidateMatchesObservedOcrAmount(ref, gOcrMoney.playerCents) &&
-            playerMatch)
-        {
-            continue;
-        }
-        if (CandidateMatchesObservedOcrAmount(currentValue, ref))
-        {
-            potMatch = true;
-            break;
-        }
-    }
+static void UpdateCandidateOcrMatches(MoneyCandidateStore& s, int slot, int currentValue, DWORD now)
+{
+    BumpOcrMatches(s, slot, ComputeOcrMatchBits(currentValue), gScanOcr.sampleId, now);
+}
 
-    if (potMatch && c.lastOcrPotSampleId != gOcrMoney.sampleId)
-    {
-        c.ocrPotMatches++;
-        c.lastOcrPotSampleId = gOcrMoney.sampleId;
-        c.lastOcrMatchMs = now;
-    }
+// The [Money] settings candidate_rules.h reads; matching, ranking and auto-lock go through it.
+static CandidateRules MakeCandidateRules()
+{
+    CandidateRules rules;
+    rules.likelyMaxChangesPerSec = gCfg.moneyLikelyMaxChangesPerSec;
+    rules.betStepFilter = gCfg.moneyBetStepFilterEnable != 0;
+    rules.betStepDollars = gCfg.moneyBetStepDollars;
+    rules.betMinDollars = gCfg.moneyBetMinDollars;
+    rules.corrRejectMisses = gCfg.moneyCorrRejectMisses;
+    rules.corrLockSteps = gCfg.moneyCorrLockSteps;
+    rules.autoLockPotMinMatches = gCfg.moneyAutoLockPotMinMatches;
+    rules.autoLockPlayerMinMatches = gCfg.moneyAutoLockPlayerMinMatches;
+    rules.ocrToleranceCents = gCfg.moneyOcrMatchToleranceCents;
+    return rules;
+}
 
-    bool npcMatch = false;
-    for (int npc : gOcrMoney.npcAmountsCents)
-    {
-        if (CandidateMatchesObservedOcrAmount(currentValue, npc))
-        {
-            npcMatch = true;
-            break;
-        }
-    }
-    if (npcMatch && c.lastOcrNpcSampleId != gOcrMoney.sampleId)
+// Drops the OCR step history; steps before now are never settled against candidates.
+static void RestartOcrSeries(DWORD now)
+{
+    for (int f = 0; f < OCR_SERIES_COUNT; f++)
     {
-        c.ocrNpcMatches++;
-        c.lastOcrNpcSampleId = gOcrMoney.sampleId;
-        c.lastOcrMatchMs = now;
+        gOcrSeries[f].Reset(now, 0);
+        gOcrSeriesSettledMs[f] = now;
     }
+    gOcrSeriesPrevWins = -1;
+    gOcrSeriesPrevNpc.clear();
 }
 
-static bool IsLikelyMoneyCandidate(const MoneyCandidate& c, DWORD now);
+// ---------------- Discovery ----------------
+// Discovery reads [ScanStart, ScanEnd) in the order DiscoveryPlanner hands out: windows around
+// candidates that already track an OCR amount, then around seeds (hotspots from past sessions,
+// locked and warm-start globals), then coarse probes, then a sweep of the rest. A pass ends when
+// every slot has been read once; that is a scan wrap. DiscoveryMode=0 leaves only the sweep.
+constexpr int kDiscoveryAnchorMatches = 2;  // OCR matches before a changing candidate gets a refine window
 
-static bool MatchesBetGridUnits(int absDelta, int minUnit, int stepUnit)
+static DiscoveryPlanConfig MakeDiscoveryPlanConfig()
 {
-    if (absDelta <= 0 || minUnit <= 0 || stepUnit <= 0)
-        return false;
-    if (absDelta < minUnit)
-        return false;
-    return (absDelta % stepUnit) == 0;
+    DiscoveryPlanConfig cfg;
+    cfg.seedRadius = gCfg.moneyDiscoveryMode ? gCfg.moneyDiscoverySeedRadius : 0;
+    cfg.coarseStride = gCfg.moneyDiscoveryMode ? gCfg.moneyDiscoveryCoarseStride : 0;
+    cfg.refineRadius = gCfg.moneyDiscoveryMode ? gCfg.moneyDiscoveryRefineRadius : 0;
+    return cfg;
 }
 
-static bool MatchesConfiguredBetGridDelta(int absDelta)
+static void BeginDiscoveryPass()
 {
-    int stepDollars = gCfg.moneyBetStepDollars;
-    int minDollars = gCfg.moneyBetMinDollars;
-    if (stepDollars <= 0)
-        return false;
-    if (minDollars < stepDollars)
-        minDollars = stepDollars;
-
-    bool dollarsMatch = MatchesBetGridUnits(absDelta, minDollars, stepDollars);
-    bool centsMatch = MatchesBetGridUnits(absDelta, minDollars * 100, stepDollars * 100);
-    return dollarsMatch || centsMatch;
+    static std::vector<int> seeds;
+    seeds = gDiscoverySeeds;
+    seeds.insert(seeds.end(), gScanLockedIdx.begin(), gScanLockedIdx.end());
+    gDiscovery.BeginPass(seeds);
 }
 
-static float CandidateBetStepRatio(const MoneyCandidate& c)
+// Restarts the plan when a settings reload changed the range or the discovery settings.
+static void SyncDiscoveryPlan()
 {
-    int total = c.betStepMatches + c.betStepMismatches;
-    if (total <= 0)
-        return -1.0f;
-    return (float)c.betStepMatches / (float)total;
+    DiscoveryPlanConfig cfg = MakeDiscoveryPlanConfig();
+    if (gDiscovery.RangeStart() == gCfg.moneyScanStart &&
+        gDiscovery.RangeEnd() == (std::max)(gCfg.moneyScanStart, gCfg.moneyScanEnd) &&
+        gDiscovery.Config() == cfg)
+        return;
+    gDiscovery.Reset(gCfg.moneyScanStart, gCfg.moneyScanEnd, cfg);
+    BeginDiscoveryPass();
 }
 
-static float CandidateRankScore(const MoneyCandidate& c, DWORD now)
+static bool IsScanWorkerRunning();
+static void StopScanWorker();
+// Scanner-owned state. Called by whichever thread runs MoneyScanStep.
+static void ResetMoneyScanState(DWORD now, const std::vector<SessionCacheEntry>& warm, const std::vector<int>& hotspots)
 {
-    float score = 0.0f;
-    score += (float)c.ocrPotMatches * 18.0f;
-    score += (float)c.ocrPlayerMatches * 3.0f;
-    score += (float)c.ocrNpcMatches * 4.5f;
-    score += (float)c.ocrAnyMatches * 1.2f;
-    if (c.ocrPlayerMatches > c.ocrPotMatches * 2)
-        score -= 6.0f;
-    if (IsLikelyMoneyCandidate(c, now))
-        score += 3.0f;
-    score += (float)((std::min)(c.changes, 64)) * 0.08f;
-    if (gCfg.moneyBetStepFilterEnable)
-    {
-        score += (float)((std::min)(c.betStepMatches, 48)) * 0.35f;
-        score -= (float)((std::min)(c.betStepMismatches, 48)) * 0.28f;
-        float ratio = CandidateBetStepRatio(c);
-        if (ratio >= 0.0f)
-            score += (ratio - 0.5f) * 8.0f;
-    }
-    if (c.lastOcrMatchMs > 0 && now > c.lastOcrMatchMs)
-    {
-        DWORD ageMs = now - c.lastOcrMatchMs;
-        if (ageMs <= 12000)
-            score += 2.0f;
-    }
-    return score;
+    gMoneyCands.Clear();
+    gMoneyScanCursor = gCfg.moneyScanStart;
+    gDiscoverySeeds = hotspots;
+    for (const SessionCacheEntry& e : warm)
+        gDiscoverySeeds.push_back(e.idx);
+    gDiscovery.Reset(gCfg.moneyScanStart, gCfg.moneyScanEnd, MakeDiscoveryPlanConfig());
+    BeginDiscoveryPass();
+    gMoneyScanWrapped = false;
+    gMoneyScanWrapCount = 0;
+    gRescanOcrSampleId = -1;
+    gRescanOcrPassSampleId = -1;
+    gRescanOcrPassIdx = 0;
+    gRescanTiers.Reset((uint32_t)now);
+    gRanking.stale = true;
+    gScanSched.Reset(QpcNowUs());
+    gNextMoneyScanAt = now;
+    gNextMoneyRescanAt = now;
+    gNextFaultRunSkipLogAt = now;
+    gWarmStartSeeds = warm;
+    gTypedHits.clear();
+    gWarmStart.clear();
+    gWarmStartSampleId = -1;
+    gSeriesPool.Init(gCfg.moneyCorrEnable ? gCfg.moneyCorrPoolSize : 0);
+    RestartOcrSeries(now);
+    gSeriesPoolFullLogged = false;
+    gEvictedBits.clear();
+    gEvictedTotal = 0;
+    gEvictor.Clear();
+    gEvictPendingIdx.clear();
 }
 
-static void ResetMoneyScan(DWORD now)
+// Script-thread half of every reset: locks, narrowing, OCR snapshot, log throttles.
+static void ResetMoneyOverlayState(DWORD now)
 {
-    gMoneyCands.clear();
     gAutoPotGlobal = -1;
     gAutoPlayerGlobal = -1;
+    gSeatArray = SeatArrayLock{};
+    gNextSeatArrayInferAt = now;
+    gNarrow.End();
+    gNarrowLastTargetCents = -1;
+    gNarrowLastSampleId = -1;
+    // Sample ids keep counting: candidates that survive a soft reset remember the last one they
+    // matched, and the empty sample replaces the old table's amounts in the scanner.
+    int sampleId = gOcrMoney.sampleId;
     gOcrMoney = OcrMoneySnapshot{};
-    gMoneyScanCursor = gCfg.moneyScanStart;
-    gMoneyScanWrapped = false;
-    gMoneyScanWrapCount = 0;
-    gNextMoneyScanAt = now;
-    gNextMoneyRescanAt = now;
+    gOcrMoney.sampleId = sampleId + 1;
     gNextMoneyLogAt = now;
-    gNextFaultRunSkipLogAt = now;
     gLastMoneySnapshotLogAt = 0;
     gLastLoggedTopIdx = -1;
     gLastLoggedTopVal = 0;
     gLastLoggedCandCount = -1;
-    gGlobalReadSehFaultSeen = false;
-    gNextGlobalReadFaultLogAt = 0;
-    Log("[MONEY] Reset scan. Range=[%d..%d) Batch=%d IntervalMs=%d ValueRange=[%d..%d]",
-        gCfg.moneyScanStart, gCfg.moneyScanEnd, gCfg.moneyScanBatch, gCfg.moneyScanIntervalMs,
-        gCfg.moneyValueMin, gCfg.moneyValueMax);
+    gLoggedColdClamped = false;
+    gGlobalReadSehFaultSeen.store(false);
+    gNextGlobalReadFaultLogAt.store(0);
 }
 
-static float CandidateChangesPerSec(const MoneyCandidate& c, DWORD now)
+// Hard reset: clears the candidate store and seeds the warm start from the session cache.
+static void ResetMoneyScan(DWORD now)
 {
-    if (now <= c.firstSeenMs)
-        return 0.0f;
-    float ageSec = (float)(now - c.firstSeenMs) / 1000.0f;
-    if (ageSec <= 0.0f)
-        return 0.0f;
-    return (float)c.changes / ageSec;
+    // The worker picks the new serial up with its next input copy and resets itself.
+    gScanResetSerial++;
+    gMoneyScanSeeded = true;
+    if (!IsScanWorkerRunning())
+        ResetMoneyScanState(now, gSessionCacheEntries, gHotspotSeeds);
+    ResetMoneyOverlayState(now);
+    Log("[MONEY] Reset scan. Range=[%d..%d) Batch=%d IntervalMs=%d ValueRange=[%d..%d] Diff=%s",
+        gCfg.moneyScanStart, gCfg.moneyScanEnd, gCfg.moneyScanBatch, gCfg.moneyScanIntervalMs,
+        gCfg.moneyValueMin, gCfg.moneyValueMax, SnapshotDiffIsaName());
 }
 
-static bool IsLikelyMoneyCandidate(const MoneyCandidate& c, DWORD now)
+// Soft reset: O(1) here and in the scanner, which keeps its candidates and decays their
+// counters as it next reads them (see "Epochs").
+static void SoftResetMoneyScan(int kind, DWORD now)
 {
-    if (c.changes <= 0)
-        return false;
-
-    float maxCps = gCfg.moneyLikelyMaxChangesPerSec;
-    if (maxCps > 0.0f && CandidateChangesPerSec(c, now) > maxCps)
-        return false;
-
-    if (gCfg.moneyBetStepFilterEnable)
-    {
-        int totalBetDeltas = c.betStepMatches + c.betStepMismatches;
-        if (totalBetDeltas >= 5 && c.betStepMatches * 2 < totalBetDeltas)
-            return false;
-    }
-
-    return true;
+    gEpochRequests.Bump(kind);
+    ResetMoneyOverlayState(now);
+    Log("[MONEY] Soft reset: %s epoch %u, candidates kept.", CandidateEpochName(kind), gEpochRequests.gen[kind]);
 }
 
-static bool BuildSortedCandidates(DWORD now, std::vector<const MoneyCandidate*>& sorted)
+// Fills sorted with slots of s, best-ranked first. Scores are computed in one
+// linear sweep; the sort only touches the cached score column.
+static bool BuildSortedCandidates(const MoneyCandidateStore& s, DWORD now, std::vector<int>& sorted)
 {
+    static std::vector<float> scores;
+    int n = s.Size();
     sorted.clear();
-    sorted.reserve(gMoneyCands.size());
+    sorted.reserve((size_t)n);
 
     bool hasOcrCorrelated = false;
-    for (auto& kv : gMoneyCands)
+    for (int slot = 0; slot < n; slot++)
     {
-        bool ocrCorrelated = (kv.second.ocrAnyMatches > 0 || kv.second.ocrPotMatches > 0 || kv.second.ocrPlayerMatches > 0 || kv.second.ocrNpcMatches > 0);
+        bool ocrCorrelated = IsOcrCorrelatedCandidate(s, slot);
         if (ocrCorrelated)
             hasOcrCorrelated = true;
-        if (ocrCorrelated || IsLikelyMoneyCandidate(kv.second, now))
-            sorted.push_back(&kv.second);
+        if (ocrCorrelated || IsLikelyMoneyCandidate(s, slot, now, gCandidateRules))
+            sorted.push_back(slot);
     }
 
     bool usingLikely = !sorted.empty();
     if (!usingLikely)
     {
-        for (auto& kv : gMoneyCands)
-            sorted.push_back(&kv.second);
+        for (int slot = 0; slot < n; slot++)
+            sorted.push_back(slot);
     }
 
-    std::sort(sorted.begin(), sorted.end(), [now](const MoneyCandidate* a, const MoneyCandidate* b) {
-        float sa = CandidateRankScore(*a, now);
-        float sb = CandidateRankScore(*b, now);
+    scores.resize((size_t)n);
+    for (int slot : sorted)
+        scores[(size_t)slot] = CandidateRankScore(s, slot, now, gCandidateRules);
+
+    std::sort(sorted.begin(), sorted.end(), [&s](int a, int b) {
+        float sa = scores[(size_t)a];
+        float sb = scores[(size_t)b];
+        size_t ka = (size_t)a;
+        size_t kb = (size_t)b;
         if (sa != sb) return sa > sb;
-        if (a->ocrPotMatches != b->ocrPotMatches) return a->ocrPotMatches > b->ocrPotMatches;
-        if (a->ocrPlayerMatches != b->ocrPlayerMatches) return a->ocrPlayerMatches > b->ocrPlayerMatches;
-        if (a->ocrNpcMatches != b->ocrNpcMatches) return a->ocrNpcMatches > b->ocrNpcMatches;
-        if (a->ocrAnyMatches != b->ocrAnyMatches) return a->ocrAnyMatches > b->ocrAnyMatches;
-        if (a->changes != b->changes) return a->changes > b->changes;
-        return a->idx < b->idx;
+        if (s.ocrPotMatches[ka] != s.ocrPotMatches[kb]) return s.ocrPotMatches[ka] > s.ocrPotMatches[kb];
+        if (s.ocrPlayerMatches[ka] != s.ocrPlayerMatches[kb]) return s.ocrPlayerMatches[ka] > s.ocrPlayerMatches[kb];
+        if (s.ocrNpcMatches[ka] != s.ocrNpcMatches[kb]) return s.ocrNpcMatches[ka] > s.ocrNpcMatches[kb];
+        if (s.ocrAnyMatches[ka] != s.ocrAnyMatches[kb]) return s.ocrAnyMatches[ka] > s.ocrAnyMatches[kb];
+        if (s.changes[ka] != s.changes[kb]) return s.changes[ka] > s.changes[kb];
+        return s.idx[ka] < s.idx[kb];
     });
 
     return hasOcrCorrelated || usingLikely;
 }
 
-// ---------------- HUD text ----------------
-enum HudUiMode
-{
-    HUD_UI_MODE_LEGACY_TEXT = 0,
-    HUD_UI_MODE_HYBRID_PANEL_TOASTS = 1,
-    HUD_UI_MODE_ROCKSTAR_TOASTS_HYBRID = 2
-};
-
-enum HudToastEventKind
+// ---------------- Step correlation ----------------
+// Match counters only see coincidences at sample time. Every OCR-correlated candidate also keeps
+// a pooled ring of its step changes and each OCR field a ring of its own steps; once an OCR step
+// is older than CorrLagMs it is settled against every tracked candidate. The real pot or stack
+// follows each OCR step, so a lookalike is rejected after a couple of bets instead of dozens of
+// samples. Scanner-owned, like the store.
+static StepMatch OcrSeriesMatch(int field)
 {
-    HUD_TOAST_EVENT_GENERIC = 0,
-    HUD_TOAST_EVENT_ENTER_POKER = 1,
-    HUD_TOAST_EVENT_EXIT_POKER = 2,
-    HUD_TOAST_EVENT_OCR_UNAVAILABLE = 3,
-    HUD_TOAST_EVENT_MONEY_OVERLAY_TOGGLE = 4,
-    HUD_TOAST_EVENT_MONEY_SCAN_RESET = 5
-};
+    // Wins is the payout the winner's stack grows by, not a value any global holds.
+    return (field == OCR_SERIES_WINS) ? STEP_MATCH_DELTA : STEP_MATCH_VALUE;
+}
 
-// DrawMethod:
-// 1 = _BG_DISPLAY_TEXT (often reliable, legacy fallback path)
-// 2 = candidate _DISPLAY_TEXT hash (verify for your build)
-static int gDrawMethod = 1;
-static bool gHudToastNativeFailed = false;
-static bool gHudToastNativeWarned = false;
-static DWORD gHudToastNativeRetryAt = 0;
-static int gHudToastNativeFailCount = 0;
-static std::string gLegacyHudMessage = "~COLOR_GOLD~Mod Online";
-static DWORD gLegacyHudMessageUntil = 0;
-static int gOcrStartFailureStreak = 0;
-static bool gOcrStartFailureWarned = false;
-enum OcrStartFailReason
+static const char* OcrSeriesName(int field)
 {
-    OCR_START_FAIL_NONE = 0,
-    OCR_START_FAIL_NO_FOREGROUND = 1,
-    OCR_START_FAIL_CAPTURE = 2,
-    OCR_START_FAIL_CREATE_PROCESS = 3
-};
-static OcrStartFailReason gLastOcrStartFailReason = OCR_START_FAIL_NONE;
-static DWORD gLastOcrStartWinErr = 0;
-static Hash gHudToastIconHash = 0;
-static Hash gHudToastColorHash = 0;
+    switch (field)
+    {
+    case OCR_SERIES_POT: return "pot";
+    case OCR_SERIES_WINS: return "wins";
+    case OCR_SERIES_PLAYER: return "player";
+    default: return "npc";
+    }
+}
 
-// SET_TEXT_SCALE:        0x4170B650590B3B00
-// SET_TEXT_CENTRE:       0xBE5261939FBECB8C
-// _SET_TEXT_COLOR:       0x50A41AD966910F03
-// _BG_DISPLAY_TEXT:      0x16794E044C9EFB58
-// _DISPLAY_TEXT:         0xD79334A4BB99BAD1 (candidate; may differ per native DB)
-static void DrawTextBasic(const char* msg, float x, float y, bool center, float scale = 0.6f)
+// Appends the steps of a new gScanOcr sample.
+static void RecordOcrSeries()
 {
-    const char* str = MISC::VAR_STRING(10, "LITERAL_STRING", msg);
+    uint32_t ms = (uint32_t)gScanOcr.sampleMs;
+    int potCents = (gScanOcr.potSource == 5) ? -1 : gScanOcr.potCents;  // max-amount fallback is no pot step
+    if (potCents > 0 && potCents != gOcrSeries[OCR_SERIES_POT].lastValue)
+        gOcrSeries[OCR_SERIES_POT].Push(ms, potCents);
+    if (gScanOcr.playerCents > 0 && gScanOcr.playerCents != gOcrSeries[OCR_SERIES_PLAYER].lastValue)
+        gOcrSeries[OCR_SERIES_PLAYER].Push(ms, gScanOcr.playerCents);
 
-    float clampedScale = scale;
-    if (clampedScale < 0.25f) clampedScale = 0.25f;
-    if (clampedScale > 0.85f) clampedScale = 0.85f;
-    invoke<Void>(0x4170B650590B3B00, clampedScale, clampedScale); // SET_TEXT_SCALE
-    invoke<Void>(0xBE5261939FBECB8C, center);              // SET_TEXT_CENTRE
-    invoke<Void>(0x50A41AD966910F03, 255, 255, 255, 255);  // _SET_TEXT_COLOR
+    // "wins $X" stays up for a few samples; a new reading is a new payout.
+    if (gScanOcr.winsCents > 0 && gScanOcr.winsCents != gOcrSeriesPrevWins)
+        gOcrSeries[OCR_SERIES_WINS].Push(ms, gScanOcr.winsCents);
+    gOcrSeriesPrevWins = gScanOcr.winsCents;
 
-    if (gDrawMethod == 2)
-    {
-        invoke<Void>(0xD79334A4BB99BAD1, str, x, y);       // _DISPLAY_TEXT
-    }
-    else
+    // NPC amounts carry no seat identity: an amount absent from the previous sample is a step.
+    for (int amount : gScanOcr.npcAmountsCents)
     {
-        invoke<Void>(0x16794E044C9EFB58, str, x, y);       // _BG_DISPLAY_TEXT
+        if (!std::binary_search(gOcrSeriesPrevNpc.begin(), gOcrSeriesPrevNpc.end(), amount))
+            gOcrSeries[OCR_SERIES_NPC].Push(ms, amount);
     }
+    gOcrSeriesPrevNpc = gScanOcr.npcAmountsCents;
 }
 
-static void DrawCenteredText(const char* msg, float x, float y)
+static bool IsStepRetired(const MoneyCandidateStore& s, int slot)
 {
-    DrawTextBasic(msg, x, y, true, 0.6f);
+    return IsStepRejected(s, slot, OCR_SERIES_POT, gCandidateRules) &&
+        IsStepRejected(s, slot, OCR_SERIES_PLAYER, gCandidateRules) &&
+        StepAlignedCount(s, slot, OCR_SERIES_NPC) == 0 &&
+        StepMissedCount(s, slot, OCR_SERIES_NPC) >= gCfg.moneyCorrRejectMisses;
 }
 
-static void DrawLeftText(const char* msg, float x, float y)
+// Gives an OCR-correlated candidate a ring, starting at its current value.
+static void TrackCandidateSeries(int slot, DWORD now)
 {
-    DrawTextBasic(msg, x, y, false, 0.6f);
+    size_t k = (size_t)slot;
+    if (gMoneyCands.series[k] >= 0 || gSeriesPool.Capacity() == 0)
+        return;
+    if (!IsOcrCorrelatedCandidate(gMoneyCands, slot) || IsStepRetired(gMoneyCands, slot))
+        return;
+    int h = gSeriesPool.Acquire((uint32_t)now, gMoneyCands.last[k]);
+    if (h < 0)
+    {
+        if (!gSeriesPoolFullLogged)
+        {
+            Log("[MONEY] Corr: all %d step rings in use; new OCR-correlated candidates go untracked until some are retired.",
+                gSeriesPool.Capacity());
+            gSeriesPoolFullLogged = true;
+        }
+        return;
+    }
+    gMoneyCands.series[k] = h;
 }
 
-static float ClampFloat(float v, float lo, float hi)
+// Call before the store is compacted with dead: frees step rings and drops hot rescan entries.
+static void ReleaseCompactedCandidates(const std::vector<unsigned char>& dead)
 {
-    if (v < lo) return lo;
-    if (v > hi) return hi;
-    return v;
+    for (int slot = 0; slot < gMoneyCands.Size(); slot++)
+    {
+        size_t k = (size_t)slot;
+        if (!dead[k])
+            continue;
+        gRescanTiers.Forget(gMoneyCands.idx[k]);
+        if (gMoneyCands.series[k] >= 0)
+        {
+            gSeriesPool.Release(gMoneyCands.series[k]);
+            gMoneyCands.series[k] = -1;
+        }
+    }
 }
 
-struct HudPanelCursor
+// Settles every OCR step older than the lag against every tracked candidate. Returns true if
+// any counter changed.
+static bool SettleOcrSeries(DWORD now)
 {
-    float x = 0.72f;
-    float y = 0.35f;
-    float step = 0.022f;
-    float dir = 1.0f;
-    float textScale = 0.45f;
-    int maxChars = 48;
-    int lines = 0;
-    int maxLines = 18;
-    bool clipped = false;
-};
+    int lagMs = gCfg.moneyCorrLagMs;
+    int tol = gCfg.moneyOcrMatchToleranceCents;
+    bool changed = false;
+    for (int f = 0; f < OCR_SERIES_COUNT; f++)
+    {
+        const SeriesRing& ocr = gOcrSeries[f];
+        uint32_t settledBefore = gOcrSeriesSettledMs[f];
+        StepMatch match = OcrSeriesMatch(f);
+        for (int i = 0; i < ocr.Count(); i++)
+        {
+            const SeriesEvent& e = ocr.At(i);
+            if (e.ms <= settledBefore)
+                continue;
+            if ((int64_t)e.ms + lagMs > (int64_t)now)
+                break;
+            gOcrSeriesSettledMs[f] = e.ms;
 
-static HudPanelCursor MakeHudPanelCursor(float yOffsetNorm = 0.0f)
-{
-    HudPanelCursor c;
-    c.x = ClampFloat((float)gCfg.hudPanelX / 100.0f, 0.01f, 0.94f);
-    c.y = ClampFloat((float)gCfg.hudPanelY / 100.0f + yOffsetNorm, 0.02f, 0.98f);
+            int aligned = 0;
+            int missed = 0;
+            for (int slot = 0; slot < gMoneyCands.Size(); slot++)
+            {
+                size_t k = (size_t)slot;
+                int h = gMoneyCands.series[k];
+                if (h < 0)
+                    continue;
+                StepOutcome outcome = SettleStep(gSeriesPool.Ring(h), e, match, lagMs, tol);
+                if (outcome == STEP_ALIGNED)
+                {
+                    PackedIncrement(gMoneyCands.stepAligned[k], f);
+                    aligned++;
+                }
+                else if (outcome == STEP_MISSED)
+                {
+                    PackedIncrement(gMoneyCands.stepMissed[k], f);
+                    missed++;
+                }
+            }
+            changed |= (aligned + missed) > 0;
+            if (f != OCR_SERIES_NPC && (aligned + missed) > 0)
+            {
+                Log("[MONEY] Corr: %s step to %d settled: aligned=%d missed=%d tracked=%d/%d",
+                    OcrSeriesName(f), e.value, aligned, missed, gSeriesPool.InUse(), gSeriesPool.Capacity());
+            }
+        }
+    }
+
+    // Lookalikes of every field give their rings back.
+    if (changed)
+    {
+        for (int slot = 0; slot < gMoneyCands.Size(); slot++)
+        {
+            size_t k = (size_t)slot;
+            if (gMoneyCands.series[k] >= 0 && IsStepRetired(gMoneyCands, slot))
+            {
+                gSeriesPool.Release(gMoneyCands.series[k]);
+                gMoneyCands.series[k] = -1;
+            }
+        }
+    }
+    return changed;
+}
+
+// Re-ranks one slot in every category after its counters changed.
+static void RankCandidate(const MoneyCandidateStore& s, int slot, DWORD now)
+{
+    // OCR counters only grow between epoch catch-ups, which forget the slot first, so a
+    // never-correlated slot was never a member anywhere.
+    if (!IsOcrCorrelatedCandidate(s, slot))
+        return;
+
+    float rankScore = CandidateRankScore(s, slot, now, gCandidateRules);
+    for (int cat = 0; cat < RANK_CATEGORY_COUNT; cat++)
+    {
+        bool ok;
+        if (IsRankEligible(s, slot, cat, gCandidateRules))
+        {
+            float score = (cat == RANK_CATEGORY_PLAYER) ? PlayerStackScore(s, slot) : rankScore;
+            ok = gRanking.top[cat].Offer(MakeRankKey(s, slot, score));
+        }
+        else
+        {
+            ok = gRanking.top[cat].Remove(s.idx[(size_t)slot]);
+        }
+        if (!ok)
+            gRanking.stale = true;
+    }
+}
+
+// Call before the slot is compacted away.
+static void ForgetRankedCandidate(const MoneyCandidateStore& s, int slot)
+{
+    if (!IsOcrCorrelatedCandidate(s, slot))
+        return;
+    int idx = s.idx[(size_t)slot];
+    for (int cat = 0; cat < RANK_CATEGORY_COUNT; cat++)
+    {
+        if (!gRanking.top[cat].Remove(idx))
+            gRanking.stale = true;
+    }
+}
+
+static void RebuildRanking(const MoneyCandidateStore& s, DWORD now)
+{
+    int k = (std::max)(gCfg.moneyTopN, kRankTopKMin);
+    for (int cat = 0; cat < RANK_CATEGORY_COUNT; cat++)
+        gRanking.top[cat].Reset(k);
+    for (int slot = 0; slot < s.Size(); slot++)
+        RankCandidate(s, slot, now);
+    gRanking.stale = false;
+    gRanking.nextRebuildAt = now + kRankRebuildMs;
+}
+
+// Once per scan step: re-score the K members (recency bonuses expire), rebuild only if a
+// member fell, then export slots for the current store layout.
+static void FinishRankingStep(const MoneyCandidateStore& s, DWORD now)
+{
+    static std::vector<int> memberIdx;
+    static std::vector<RankKey> keys;
+
+    if (!gRanking.stale && now < gRanking.nextRebuildAt)
+    {
+        for (int cat = 0; cat < RANK_CATEGORY_COUNT && !gRanking.stale; cat++)
+        {
+            memberIdx.clear();
+            for (const RankKey& key : gRanking.top[cat].heap)
+                memberIdx.push_back(key.idx);
+            for (int idx : memberIdx)
+            {
+                int slot = s.Find(idx);
+                if (slot < 0)
+                {
+                    gRanking.stale = true;
+                    break;
+                }
+                RankCandidate(s, slot, now);
+            }
+        }
+    }
+    if (gRanking.stale || now >= gRanking.nextRebuildAt)
+        RebuildRanking(s, now);
+
+    for (int cat = 0; cat < RANK_CATEGORY_COUNT; cat++)
+    {
+        gRanking.top[cat].Sorted(keys);
+        std::vector<int>& out = gRankedSlots.slots[cat];
+        out.clear();
+        for (const RankKey& key : keys)
+        {
+            int slot = s.Find(key.idx);
+            if (slot >= 0)
+                out.push_back(slot);
+        }
+    }
+}
+
+// ---------------- Warm start ----------------
+// Cached candidates are re-inserted at reset with fresh counters. Their saved statistics only
+// come back once fresh OCR samples agree with the live value, so a stale cache cannot lock.
+constexpr int kWarmStartConfirmSamples = 2;        // 1 for the previously locked global
+constexpr int kWarmStartMaxMisses = 2;
+
+static const char* RankCategoryName(int category)
+{
+    switch (category)
+    {
+    case RANK_CATEGORY_POT: return "pot";
+    case RANK_CATEGORY_PLAYER: return "player";
+    default: return "npc";
+    }
+}
+
+static int RankCategoryOcrBit(int category)
+{
+    switch (category)
+    {
+    case RANK_CATEGORY_POT: return OCR_MATCH_POT;
+    case RANK_CATEGORY_PLAYER: return OCR_MATCH_PLAYER;
+    default: return OCR_MATCH_NPC;
+    }
+}
+
+// True if the current OCR sample read an amount for category, so a non-match counts against it.
+static bool ScanOcrHasCategory(int category)
+{
+    switch (category)
+    {
+    case RANK_CATEGORY_POT:
+        if (gScanOcr.potSource == 5)
+            return false; // max-amount fallback, too ambiguous to reject on
+        return gScanOcr.potCents > 0 || gScanOcr.mainPotCents > 0 ||
+            gScanOcr.sidePotCents > 0 || gScanOcr.genericPotCents > 0;
+    case RANK_CATEGORY_PLAYER:
+        return gScanOcr.playerCents > 0;
+    default:
+        return !gScanOcr.npcAmountsCents.empty();
+    }
+}
+
+// Inserts gWarmStartSeeds that still hold a plausible value. Runs from the first scan step
+// after a reset, since EnterPoker can reset before getGlobalPtr is resolved.
+static void SeedWarmStart(DWORD now)
+{
+    static std::vector<int> idxs;
+    static std::vector<int> vals;
+    static std::vector<unsigned char> ok;
+    std::vector<SessionCacheEntry> sorted;
+    sorted.swap(gWarmStartSeeds);
+    std::sort(sorted.begin(), sorted.end(),
+        [](const SessionCacheEntry& a, const SessionCacheEntry& b) { return a.idx < b.idx; });
+    sorted.erase(std::unique(sorted.begin(), sorted.end(),
+        [](const SessionCacheEntry& a, const SessionCacheEntry& b) { return a.idx == b.idx; }), sorted.end());
+    while (!sorted.empty() && sorted.front().idx < 0)
+        sorted.erase(sorted.begin());
+
+    int n = (int)sorted.size();
+    idxs.resize((size_t)n);
+    vals.resize((size_t)n);
+    ok.resize((size_t)n);
+    for (int i = 0; i < n; i++)
+        idxs[(size_t)i] = sorted[(size_t)i].idx;
+    ReadGlobalIndices(idxs.data(), n, vals.data(), ok.data());
+
+    std::vector<MoneyCandidate> rows;
+    for (int i = 0; i < n; i++)
+    {
+        int v = vals[(size_t)i];
+        if (!ok[(size_t)i] || v < gCfg.moneyValueMin || v > gCfg.moneyValueMax)
+            continue;
+        MoneyCandidate row;
+        row.idx = idxs[(size_t)i];
+        row.last = v;
+        row.firstSeenMs = now;
+        row.lastSeenMs = now;
+        row.epoch = gScanEpochs.Stamp();
+        rows.push_back(row);
+
+        WarmStartCandidate wc;
+        wc.cached = sorted[(size_t)i];
+        gWarmStart.push_back(wc);
+    }
+    gMoneyCands.InsertSorted(rows);
+    for (const MoneyCandidate& row : rows)
+        gRescanTiers.MarkHot(row.idx);  // hot until the first OCR pass; only correlated ones stay
+    Log("[MONEY] WarmStart: seeded %d/%d cached candidates, revalidating against OCR.", (int)rows.size(), n);
+}
+
+// Saved counters come back as a floor; firstSeen moves back so the change rate stays plausible.
+static void RestoreWarmStartStats(MoneyCandidateStore& s, int slot, const SessionCacheEntry& c, DWORD now)
+{
+    size_t k = (size_t)slot;
+    s.changes[k] = (std::max)(s.changes[k], (int)c.changes);
+    s.betStepMatches[k] = (std::max)(s.betStepMatches[k], (int)c.betStepMatches);
+    s.betStepMismatches[k] = (std::max)(s.betStepMismatches[k], (int)c.betStepMismatches);
+    s.ocrAnyMatches[k] = (std::max)(s.ocrAnyMatches[k], (int)c.ocrAnyMatches);
+    s.ocrPotMatches[k] = (std::max)(s.ocrPotMatches[k], (int)c.ocrPotMatches);
+    s.ocrPlayerMatches[k] = (std::max)(s.ocrPlayerMatches[k], (int)c.ocrPlayerMatches);
+    s.ocrNpcMatches[k] = (std::max)(s.ocrNpcMatches[k], (int)c.ocrNpcMatches);
+    DWORD ageMs = (DWORD)(std::max)(0, (int)c.ageMs);
+    if (ageMs > now - s.firstSeenMs[k])
+        s.firstSeenMs[k] = now - ageMs;
+}
+
+// Once per OCR sample, after the rescan correlated it: confirm or drop pending cached candidates.
+static void RevalidateWarmStart(DWORD now)
+{
+    if (gWarmStart.empty())
+        return;
+    if (gRescanOcrSampleId != gScanOcr.sampleId || gWarmStartSampleId == gScanOcr.sampleId)
+        return;
+    gWarmStartSampleId = gScanOcr.sampleId;
+
+    size_t kept = 0;
+    for (size_t i = 0; i < gWarmStart.size(); i++)
+    {
+        WarmStartCandidate wc = gWarmStart[i];
+        const SessionCacheEntry& c = wc.cached;
+        int slot = gMoneyCands.Find(c.idx);
+        if (slot < 0)
+        {
+            Log("[MONEY] WarmStart: idx=%d (%s) dropped, no longer a candidate.", c.idx, RankCategoryName(c.category));
+            continue;
+        }
+        if (ScanOcrHasCategory(c.category))
+        {
+            if (ComputeOcrMatchBits(gMoneyCands.last[(size_t)slot]) & RankCategoryOcrBit(c.category))
+                wc.confirms++;
+            else
+                wc.misses++;
+        }
+
+        int needed = (c.flags & SESSION_CACHE_LOCKED) ? 1 : kWarmStartConfirmSamples;
+        if (wc.confirms >= needed)
+        {
+            RestoreWarmStartStats(gMoneyCands, slot, c, now);
+            RankCandidate(gMoneyCands, slot, now);
+            Log("[MONEY] WarmStart: idx=%d (%s%s) confirmed by %d OCR sample(s), restored ocrPot=%d ocrPlayer=%d changes=%d.",
+                c.idx, RankCategoryName(c.category), (c.flags & SESSION_CACHE_LOCKED) ? ", was locked" : "",
+                wc.confirms, c.ocrPotMatches, c.ocrPlayerMatches, c.changes);
+            continue;
+        }
+        if (wc.misses >= kWarmStartMaxMisses)
+        {
+            Log("[MONEY] WarmStart: idx=%d (%s) dropped, val=%d disagreed with %d OCR samples.",
+                c.idx, RankCategoryName(c.category), gMoneyCands.last[(size_t)slot], wc.misses);
+            continue;
+        }
+        gWarmStart[kept++] = wc;
+    }
+    gWarmStart.resize(kept);
+}
+
+// ---------------- HUD text ----------------
+enum HudUiMode
+{
+    HUD_UI_MODE_LEGACY_TEXT = 0,
+    HUD_UI_MODE_HYBRID_PANEL_TOASTS = 1,
+    HUD_UI_MODE_ROCKSTAR_TOASTS_HYBRID = 2
+};
+
+enum HudToastEventKind
+{
+    HUD_TOAST_EVENT_GENERIC = 0,
+    HUD_TOAST_EVENT_ENTER_POKER = 1,
+    HUD_TOAST_EVENT_EXIT_POKER = 2,
+    HUD_TOAST_EVENT_OCR_UNAVAILABLE = 3,
+    HUD_TOAST_EVENT_MONEY_OVERLAY_TOGGLE = 4,
+    HUD_TOAST_EVENT_MONEY_SCAN_RESET = 5
+};
+
+// DrawMethod:
+// 1 = _BG_DISPLAY_TEXT (often reliable, legacy fallback path)
+// 2 = candidate _DISPLAY_TEXT hash (verify for your build)
+static int gDrawMethod = 1;
+static bool gHudToastNativeFailed = false;
+static bool gHudToastNativeWarned = false;
+static DWORD gHudToastNativeRetryAt = 0;
+static int gHudToastNativeFailCount = 0;
+static std::string gLegacyHudMessage = "~COLOR_GOLD~Mod Online";
+static DWORD gLegacyHudMessageUntil = 0;
+static int gOcrStartFailureStreak = 0;
+static bool gOcrStartFailureWarned = false;
+enum OcrStartFailReason
+{
+    OCR_START_FAIL_NONE = 0,
+    OCR_START_FAIL_NO_FOREGROUND = 1,
+    OCR_START_FAIL_CAPTURE = 2,
+    OCR_START_FAIL_CREATE_PROCESS = 3,
+    OCR_START_FAIL_ENGINE = 4,
+    OCR_START_FAIL_WORKER = 5
+};
+static OcrStartFailReason gLastOcrStartFailReason = OCR_START_FAIL_NONE;
+static DWORD gLastOcrStartWinErr = 0;
+static Hash gHudToastIconHash = 0;
+static Hash gHudToastColorHash = 0;
+
+// SET_TEXT_SCALE:        0x4170B650590B3B00
+// SET_TEXT_CENTRE:       0xBE5261939FBECB8C
+// _SET_TEXT_COLOR:       0x50A41AD966910F03
+// _BG_DISPLAY_TEXT:      0x16794E044C9EFB58
+// _DISPLAY_TEXT:         0xD79334A4BB99BAD1 (candidate; may differ per native DB)
+static void DrawTextBasic(const char* msg, float x, float y, bool center, float scale = 0.6f)
+{
+    const char* str = MISC::VAR_STRING(10, "LITERAL_STRING", msg);
+
+    float clampedScale = scale;
+    if (clampedScale < 0.25f) clampedScale = 0.25f;
+    if (clampedScale > 0.85f) clampedScale = 0.85f;
+    invoke<Void>(0x4170B650590B3B00, clampedScale, clampedScale); // SET_TEXT_SCALE
+    invoke<Void>(0xBE5261939FBECB8C, center);              // SET_TEXT_CENTRE
+    invoke<Void>(0x50A41AD966910F03, 255, 255, 255, 255);  // _SET_TEXT_COLOR
+
+    if (gDrawMethod == 2)
+    {
+        invoke<Void>(0xD79334A4BB99BAD1, str, x, y);       // _DISPLAY_TEXT
+    }
+    else
+    {
+        invoke<Void>(0x16794E044C9EFB58, str, x, y);       // _BG_DISPLAY_TEXT
+    }
+}
+
+static void DrawCenteredText(const char* msg, float x, float y)
+{
+    DrawTextBasic(msg, x, y, true, 0.6f);
+}
+
+static void DrawLeftText(const char* msg, float x, float y)
+{
+    DrawTextBasic(msg, x, y, false, 0.6f);
+}
+
+static float ClampFloat(float v, float lo, float hi)
+{
+    if (v < lo) return lo;
+    if (v > hi) return hi;
+    return v;
+}
+
+struct HudPanelCursor
+{
+    float x = 0.72f;
+    float y = 0.35f;
+    float step = 0.022f;
+    float dir = 1.0f;
+    float textScale = 0.45f;
+    int maxChars = 48;
+    int lines = 0;
+    int maxLines = 18;
+    bool clipped = false;
+};
+
+static HudPanelCursor MakeHudPanelCursor(float yOffsetNorm = 0.0f)
+{
+    HudPanelCursor c;
+    c.x = ClampFloat((float)gCfg.hudPanelX / 100.0f, 0.01f, 0.94f);
+    c.y = ClampFloat((float)gCfg.hudPanelY / 100.0f + yOffsetNorm, 0.02f, 0.98f);
     c.step = ClampFloat(gCfg.hudPanelLineStep / 100.0f, 0.012f, 0.06f);
     c.maxLines = gCfg.hudPanelMaxLines;
     if (c.maxLines < 1) c.maxLines = 1;
@@ -1462,12 +2096,8 @@ static std::vector<std::string> gOcrKeywords;
 static std::string gLastOcrText;
 static char gOcrBmpBottomLeftPath[MAX_PATH]{ 0 };
 static char gOcrBmpTopRightPath[MAX_PATH]{ 0 };
-static char gOcrOutBaseBottomLeftPath[MAX_PATH]{ 0 };
-static char gOcrOutBaseTopRightPath[MAX_PATH]{ 0 };
 static char gOcrTxtBottomLeftPath[MAX_PATH]{ 0 };
 static char gOcrTxtTopRightPath[MAX_PATH]{ 0 };
-static HANDLE gOcrProcess = nullptr;
-static DWORD gOcrProcessStartMs = 0;
 static DWORD gNextOcrStartAt = 0;
 static DWORD gNextOcrLogAt = 0;
 static float gPendingOpacityHint = 0.5f;
@@ -1602,119 +2232,15 @@ static std::string BuildReasonSummary(std::vector<std::pair<float, std::string>>
     return out;
 }
 
-static bool ComputeRegionLumaStdDev(HWND hwnd, int xPctIn, int yPctIn, int wPctIn, int hPctIn, float& outStdDev)
-{
-    outStdDev = 0.0f;
-
-    RECT rc{};
-    if (!GetClientRect(hwnd, &rc))
-        return false;
-
-    int cw = rc.right - rc.left;
-    int ch = rc.bottom - rc.top;
-    if (cw <= 0 || ch <= 0)
-        return false;
-
-    int xPct = ClampInt(xPctIn, 0, 100);
-    int yPct = ClampInt(yPctIn, 0, 100);
-    int wPct = ClampInt(wPctIn, 1, 100);
-    int hPct = ClampInt(hPctIn, 1, 100);
-
-    int x = (cw * xPct) / 100;
-    int y = (ch * yPct) / 100;
-    int w = (cw * wPct) / 100;
-    int h = (ch * hPct) / 100;
-    if (x + w > cw) w = cw - x;
-    if (y + h > ch) h = ch - y;
-    if (w <= 0 || h <= 0)
-        return false;
-
-    POINT p{ 0, 0 };
-    ClientToScreen(hwnd, &p);
-
-    HDC screen = GetDC(nullptr);
-    if (!screen)
-        return false;
-
-    HDC memdc = CreateCompatibleDC(screen);
-    HBITMAP bmp = CreateCompatibleBitmap(screen, w, h);
-    if (!memdc || !bmp)
-    {
-        if (bmp) DeleteObject(bmp);
-        if (memdc) DeleteDC(memdc);
-        ReleaseDC(nullptr, screen);
-        return false;
-    }
-
-    HGDIOBJ old = SelectObject(memdc, bmp);
-    BOOL bltOk = BitBlt(memdc, 0, 0, w, h, screen, p.x + x, p.y + y, SRCCOPY);
-    if (old)
-        SelectObject(memdc, old);
-
-    bool ok = false;
-    if (bltOk)
-    {
-        BITMAPINFO bi{};
-        bi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-        bi.bmiHeader.biWidth = w;
-        bi.bmiHeader.biHeight = -h;
-        bi.bmiHeader.biPlanes = 1;
-        bi.bmiHeader.biBitCount = 24;
-        bi.bmiHeader.biCompression = BI_RGB;
-
-        int stride = ((w * 3 + 3) & ~3);
-        int dataSize = stride * h;
-        std::vector<unsigned char> pixels((size_t)dataSize);
-        if (GetDIBits(memdc, bmp, 0, (UINT)h, pixels.data(), &bi, DIB_RGB_COLORS))
-        {
-            double sum = 0.0;
-            double sumSq = 0.0;
-            int count = 0;
-            for (int yy = 0; yy < h; yy++)
-            {
-                const unsigned char* row = pixels.data() + yy * stride;
-                for (int xx = 0; xx < w; xx++)
-                {
-                    unsigned char b = row[xx * 3 + 0];
-                    unsigned char g = row[xx * 3 + 1];
-                    unsigned char r = row[xx * 3 + 2];
-                    double luma = 0.114 * b + 0.587 * g + 0.299 * r;
-                    sum += luma;
-                    sumSq += luma * luma;
-                    count++;
-                }
-            }
-            if (count > 0)
-            {
-                double mean = sum / count;
-                double var = (sumSq / count) - (mean * mean);
-                if (var < 0.0) var = 0.0;
-                outStdDev = (float)std::sqrt(var);
-                ok = true;
-            }
-        }
-    }
-
-    DeleteObject(bmp);
-    DeleteDC(memdc);
-    ReleaseDC(nullptr, screen);
-    return ok;
-}
-
-static float ComputeOpacityHint(HWND hwnd)
+// view = the opacity region of this cycle's grab (empty when OpacityHintEnable=0).
+static float ComputeOpacityHint(const PixelView& view)
 {
     if (!gCfg.ocrOpacityHintEnable)
         return 0.5f;
 
     float stddev = 0.0f;
-    if (!ComputeRegionLumaStdDev(
-        hwnd,
-        gCfg.ocrOpacityRoiXPct, gCfg.ocrOpacityRoiYPct,
-        gCfg.ocrOpacityRoiWPct, gCfg.ocrOpacityRoiHPct,
-        stddev))
-    {
+    if (!LumaStdDev(view, stddev))
         return 0.5f;
-    }
 
     float lo = gCfg.ocrOpacityLow;
     float hi = gCfg.ocrOpacityHigh;
@@ -1724,18 +2250,7 @@ static float ComputeOpacityHint(HWND hwnd)
     return ClampFloat(norm, 0.0f, 1.0f);
 }
 
-static void CleanupOcrArtifactsIfNeeded()
-{
-    if (gCfg.ocrDumpArtifacts)
-        return;
-
-    DeleteFileA(gOcrBmpBottomLeftPath);
-    DeleteFileA(gOcrBmpTopRightPath);
-    DeleteFileA(gOcrTxtBottomLeftPath);
-    DeleteFileA(gOcrTxtTopRightPath);
-}
-
-static const char* OcrStartFailReasonToString(OcrStartFailReason reason)
+static const char* OcrStartFailReasonToString(OcrStartFailReason reason)
 {
     switch (reason)
     {
@@ -1745,6 +2260,10 @@ static const char* OcrStartFailReasonToString(OcrStartFailReason reason)
         return "capture";
     case OCR_START_FAIL_CREATE_PROCESS:
         return "createProcess";
+    case OCR_START_FAIL_ENGINE:
+        return "engine";
+    case OCR_START_FAIL_WORKER:
+        return "worker";
     default:
         return "none";
     }
@@ -1839,43 +2358,61 @@ static void BuildOcrKeywordList()
         gOcrKeywords.push_back(tail);
 }
 
-static bool SaveBitmap24(const char* path, HBITMAP bmp, HDC hdc, int width, int height)
+// In-memory .bmp file (what tesseract reads from stdin). out keeps its allocation.
+static bool EncodeBitmap24(const OcrImage& img, std::vector<unsigned char>& out)
 {
-    if (!bmp || width <= 0 || height <= 0)
+    if (img.width <= 0 || img.height <= 0)
         return false;
 
-    BITMAPINFO bi{};
-    bi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-    bi.bmiHeader.biWidth = width;
-    bi.bmiHeader.biHeight = -height;
-    bi.bmiHeader.biPlanes = 1;
-    bi.bmiHeader.biBitCount = 24;
-    bi.bmiHeader.biCompression = BI_RGB;
-
-    int stride = ((width * 3 + 3) & ~3);
-    int dataSize = stride * height;
-    std::vector<unsigned char> pixels((size_t)dataSize);
-
-    if (!GetDIBits(hdc, bmp, 0, (UINT)height, pixels.data(), &bi, DIB_RGB_COLORS))
-        return false;
+    BITMAPINFOHEADER bih{};
+    bih.biSize = sizeof(BITMAPINFOHEADER);
+    bih.biWidth = img.width;
+    bih.biHeight = -img.height;
+    bih.biPlanes = 1;
+    bih.biBitCount = 24;
+    bih.biCompression = BI_RGB;
 
+    int dataSize = img.stride * img.height;
     BITMAPFILEHEADER bfh{};
     bfh.bfType = 0x4D42;
     bfh.bfOffBits = sizeof(BITMAPFILEHEADER) + sizeof(BITMAPINFOHEADER);
     bfh.bfSize = bfh.bfOffBits + dataSize;
 
+    out.resize((size_t)bfh.bfSize);
+    memcpy(out.data(), &bfh, sizeof(bfh));
+    memcpy(out.data() + sizeof(bfh), &bih, sizeof(bih));
+    memcpy(out.data() + bfh.bfOffBits, img.pixels.data(), (size_t)dataSize);
+    return true;
+}
+
+// DumpArtifacts only.
+static bool SaveBitmap24(const char* path, const OcrImage& img)
+{
+    std::vector<unsigned char> bytes;
+    if (!EncodeBitmap24(img, bytes))
+        return false;
+
     FILE* f = nullptr;
     fopen_s(&f, path, "wb");
     if (!f)
         return false;
 
-    fwrite(&bfh, sizeof(bfh), 1, f);
-    fwrite(&bi.bmiHeader, sizeof(BITMAPINFOHEADER), 1, f);
-    fwrite(pixels.data(), 1, (size_t)dataSize, f);
+    fwrite(bytes.data(), 1, bytes.size(), f);
     fclose(f);
     return true;
 }
 
+static void SaveTextFile(const char* path, const std::string& text)
+{
+    FILE* f = nullptr;
+    fopen_s(&f, path, "wb");
+    if (!f)
+        return;
+
+    fwrite(text.data(), 1, text.size(), f);
+    fclose(f);
+}
+
 static bool GetGameForegroundWindow(HWND& outHwnd)
 {
     outHwnd = GetForegroundWindow();
@@ -1887,65 +2424,179 @@ static bool GetGameForegroundWindow(HWND& outHwnd)
     return pid == GetCurrentProcessId();
 }
 
-static bool CaptureOcrRegionToBmp(HWND hwnd, int xPctIn, int yPctIn, int wPctIn, int hPctIn, const char* outPath)
+// ---------------- Frame grab ----------------
+// One grab per OCR cycle covers the opacity, bottom-left and top-right regions. They land in one DIB
+// section (laid out by PlanGrabLayout) and are read in place through PixelViews, so a cycle creates
+// no GDI objects and needs no GetDIBits copy. The memory DC and the DIB section persist and are
+// recreated when the layout outgrows them or needs less than half of them. GrabSingleBlit=1 reads
+// the regions' bounding box with one BitBlt; 0 blits each region into a stacked surface (fewer
+// pixels read and kept); 2 takes one blit only when the box is barely larger than the regions.
+class FrameGrabber
 {
-    RECT rc{};
-    if (!GetClientRect(hwnd, &rc))
-        return false;
+public:
+    bool Grab(HWND hwnd);
+    // Empty when the region was not part of the last grab (OpacityHintEnable=0).
+    PixelView View(GrabRoi roi) const { return GrabView(bits, stride, layout.place[roi]); }
+    void Release();
+
+    size_t SurfaceBytes() const { return (size_t)stride * (size_t)surfaceH; }
+    int Blits() const { return blits; }
+    int64_t LastUs() const { return lastUs; }
+    int64_t MaxUs() const { return maxUs; }
+    uint64_t SurfaceAllocs() const { return surfaceAllocs; }
+    DWORD WinErr() const { return winErr; }
+
+private:
+    bool EnsureSurface(HDC screen, int w, int h);
+
+    HDC memdc = nullptr;
+    HBITMAP dib = nullptr;
+    HGDIOBJ oldBitmap = nullptr;
+    unsigned char* bits = nullptr;
+    int surfaceW = 0;
+    int surfaceH = 0;
+    int stride = 0;
+    GrabRect rois[GRAB_ROI_COUNT];     // client coords
+    GrabLayout layout;
+    int blits = 0;
+    int64_t lastUs = 0;
+    int64_t maxUs = 0;
+    uint64_t surfaceAllocs = 0;        // DIB sections created so far
+    DWORD winErr = 0;
+};
 
-    int cw = rc.right - rc.left;
-    int ch = rc.bottom - rc.top;
-    if (cw <= 0 || ch <= 0)
+void FrameGrabber::Release()
+{
+    if (memdc && oldBitmap)
+        SelectObject(memdc, oldBitmap);
+    if (dib)
+        DeleteObject(dib);
+    if (memdc)
+        DeleteDC(memdc);
+    memdc = nullptr;
+    dib = nullptr;
+    oldBitmap = nullptr;
+    bits = nullptr;
+    surfaceW = 0;
+    surfaceH = 0;
+    stride = 0;
+}
+
+bool FrameGrabber::EnsureSurface(HDC screen, int w, int h)
+{
+    // Kept while it fits; a surface more than twice the size needed (the layout or the
+    // regions changed) is given back.
+    if (dib && w <= surfaceW && h <= surfaceH && (int64_t)w * h * 2 >= (int64_t)surfaceW * surfaceH)
+        return true;
+
+    if (!memdc)
+        memdc = CreateCompatibleDC(screen);
+    if (!memdc)
         return false;
+    if (dib)
+    {
+        SelectObject(memdc, oldBitmap);
+        DeleteObject(dib);
+        dib = nullptr;
+        bits = nullptr;
+    }
 
-    int xPct = ClampInt(xPctIn, 0, 100);
-    int yPct = ClampInt(yPctIn, 0, 100);
-    int wPct = ClampInt(wPctIn, 1, 100);
-    int hPct = ClampInt(hPctIn, 1, 100);
+    BITMAPINFO bi{};
+    bi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bi.bmiHeader.biWidth = w;
+    bi.bmiHeader.biHeight = -h;  // top-down, like the OcrImage rows
+    bi.bmiHeader.biPlanes = 1;
+    bi.bmiHeader.biBitCount = 24;
+    bi.bmiHeader.biCompression = BI_RGB;
+    void* p = nullptr;
+    dib = CreateDIBSection(screen, &bi, DIB_RGB_COLORS, &p, nullptr, 0);
+    if (!dib || !p)
+    {
+        if (dib)
+            DeleteObject(dib);
+        dib = nullptr;
+        surfaceW = surfaceH = stride = 0;
+        return false;
+    }
+    oldBitmap = SelectObject(memdc, dib);
+    bits = (unsigned char*)p;
+    surfaceW = w;
+    surfaceH = h;
+    stride = GrabStride(w);
+    surfaceAllocs++;
+    return true;
+}
 
-    int x = (cw * xPct) / 100;
-    int y = (ch * yPct) / 100;
-    int w = (cw * wPct) / 100;
-    int h = (ch * hPct) / 100;
+bool FrameGrabber::Grab(HWND hwnd)
+{
+    winErr = 0;
+    for (GrabRect& r : rois)
+        r = GrabRect{};
+    layout = GrabLayout{};
 
-    if (x + w > cw) w = cw - x;
-    if (y + h > ch) h = ch - y;
-    if (w <= 0 || h <= 0)
+    RECT rc{};
+    if (!GetClientRect(hwnd, &rc))
+    {
+        winErr = GetLastError();
+        return false;
+    }
+    int cw = rc.right - rc.left;
+    int ch = rc.bottom - rc.top;
+    if (gCfg.ocrOpacityHintEnable)
+    {
+        GrabRectFromPct(cw, ch, gCfg.ocrOpacityRoiXPct, gCfg.ocrOpacityRoiYPct,
+            gCfg.ocrOpacityRoiWPct, gCfg.ocrOpacityRoiHPct, rois[GRAB_ROI_OPACITY]);
+    }
+    if (!GrabRectFromPct(cw, ch, gCfg.ocrBottomLeftXPct, gCfg.ocrBottomLeftYPct,
+            gCfg.ocrBottomLeftWPct, gCfg.ocrBottomLeftHPct, rois[GRAB_ROI_BOTTOM_LEFT]) ||
+        !GrabRectFromPct(cw, ch, gCfg.ocrTopRightXPct, gCfg.ocrTopRightYPct,
+            gCfg.ocrTopRightWPct, gCfg.ocrTopRightHPct, rois[GRAB_ROI_TOP_RIGHT]))
+    {
         return false;
+    }
+    PlanGrabLayout(rois, gCfg.ocrGrabSingleBlit, layout);
 
+    int64_t t0 = QpcNowUs();
     POINT p{ 0, 0 };
     ClientToScreen(hwnd, &p);
-
     HDC screen = GetDC(nullptr);
     if (!screen)
-        return false;
-
-    HDC memdc = CreateCompatibleDC(screen);
-    HBITMAP bmp = CreateCompatibleBitmap(screen, w, h);
-    if (!memdc || !bmp)
     {
-        if (bmp) DeleteObject(bmp);
-        if (memdc) DeleteDC(memdc);
-        ReleaseDC(nullptr, screen);
+        winErr = GetLastError();
         return false;
     }
 
-    HGDIOBJ old = SelectObject(memdc, bmp);
-    BOOL bltOk = BitBlt(memdc, 0, 0, w, h, screen, p.x + x, p.y + y, SRCCOPY);
-    if (old)
-        SelectObject(memdc, old);
-
-    bool writeOk = false;
-    if (bltOk)
-        writeOk = SaveBitmap24(outPath, bmp, memdc, w, h);
-
-    DeleteObject(bmp);
-    DeleteDC(memdc);
+    bool ok = EnsureSurface(screen, layout.width, layout.height);
+    blits = 0;
+    if (ok && layout.single)
+    {
+        const GrabRect& box = layout.box;
+        ok = BitBlt(memdc, 0, 0, box.w, box.h, screen, p.x + box.x, p.y + box.y, SRCCOPY) != 0;
+        blits = 1;
+    }
+    else if (ok)
+    {
+        for (int i = 0; i < GRAB_ROI_COUNT; i++)
+        {
+            const GrabRect& r = rois[i];
+            const GrabRect& at = layout.place[i];
+            if (r.Empty())
+                continue;
+            ok = ok && BitBlt(memdc, at.x, at.y, r.w, r.h, screen, p.x + r.x, p.y + r.y, SRCCOPY) != 0;
+            blits++;
+        }
+    }
+    if (!ok)
+        winErr = GetLastError();
     ReleaseDC(nullptr, screen);
+    GdiFlush();  // the views read the DIB bits directly
 
-    return writeOk;
+    lastUs = QpcNowUs() - t0;
+    maxUs = (std::max)(maxUs, lastUs);
+    return ok;
 }
 
+static FrameGrabber gFrameGrab;
 static bool ReadTextFileAll(const char* path, std::string& out)
 {
     out.clear();
@@ -1969,18 +2620,6 @@ static bool ReadTextFileAll(const char* path, std::string& out)
     return true;
 }
 
-static void StopOcrProcess(bool terminate)
-{
-    if (gOcrProcess)
-    {
-        if (terminate)
-            TerminateProcess(gOcrProcess, 1);
-        CloseHandle(gOcrProcess);
-    }
-    gOcrProcess = nullptr;
-    gOcrProcessStartMs = 0;
-}
-
 static bool FileExistsPath(const char* path)
 {
     if (!path || !*path)
@@ -2042,83 +2681,44 @@ static std::string ResolveOcrExecutablePath(bool& outUsingPortable)
     return configured;
 }
 
-static bool StartOcrProcess(DWORD now)
+// ---------------- OCR backends ----------------
+// StartOcrCycle captures both regions on the script thread and hands them to gOcrBackend;
+// TryCollectOcrResult polls it once per detection tick. Pixels and text stay in memory:
+// only DumpArtifacts=1 writes the captured BMPs and the recognized text, for inspection.
+// The spawn backend runs one tesseract.exe per region, BMP in through stdin and text out
+// through stdout, still paying a process launch and a model load per region each cycle.
+// The engine backend loads libtesseract once, keeps one initialized TessBaseAPI on its own
+// thread for the session and recognizes straight from the capture buffers. Engine=1 uses
+// it whenever the library loads and falls back to spawning otherwise.
+// Starts cmd with its stdin and stdout on fresh pipes. Our stdin end is non-blocking (a write
+// takes what fits, never waits); stdinBytes sizes that pipe. stderr is not captured.
+static bool LaunchWithPipes(const std::string& cmd, const char* workDir, DWORD stdinBytes,
+    HANDLE& process, HANDLE& stdinWrite, HANDLE& stdoutRead)
 {
-    if (gOcrProcess)
-        return false;
-
-    gLastOcrStartFailReason = OCR_START_FAIL_NONE;
-    gLastOcrStartWinErr = 0;
-
-    HWND hwnd = nullptr;
-    if (!GetGameForegroundWindow(hwnd))
-    {
-        gLastOcrStartFailReason = OCR_START_FAIL_NO_FOREGROUND;
-        return false;
-    }
-    gPendingOpacityHint = ComputeOpacityHint(hwnd);
-
-    DeleteFileA(gOcrTxtBottomLeftPath);
-    DeleteFileA(gOcrTxtTopRightPath);
-
-    if (!CaptureOcrRegionToBmp(
-        hwnd,
-        gCfg.ocrBottomLeftXPct, gCfg.ocrBottomLeftYPct,
-        gCfg.ocrBottomLeftWPct, gCfg.ocrBottomLeftHPct,
-        gOcrBmpBottomLeftPath))
-    {
-        gLastOcrStartFailReason = OCR_START_FAIL_CAPTURE;
-        gLastOcrStartWinErr = GetLastError();
-        CleanupOcrArtifactsIfNeeded();
+    SECURITY_ATTRIBUTES sa{};
+    sa.nLength = sizeof(sa);
+    sa.bInheritHandle = TRUE;
+    HANDLE childIn = nullptr;
+    HANDLE childOut = nullptr;
+    if (!CreatePipe(&childIn, &stdinWrite, &sa, stdinBytes))
         return false;
-    }
-
-    if (!CaptureOcrRegionToBmp(
-        hwnd,
-        gCfg.ocrTopRightXPct, gCfg.ocrTopRightYPct,
-        gCfg.ocrTopRightWPct, gCfg.ocrTopRightHPct,
-        gOcrBmpTopRightPath))
+    if (!CreatePipe(&stdoutRead, &childOut, &sa, 0))
     {
-        gLastOcrStartFailReason = OCR_START_FAIL_CAPTURE;
-        gLastOcrStartWinErr = GetLastError();
-        CleanupOcrArtifactsIfNeeded();
+        CloseHandle(childIn);
         return false;
     }
-
-    bool usingPortableOcr = false;
-    std::string ocrExePath = ResolveOcrExecutablePath(usingPortableOcr);
-    if (usingPortableOcr)
-    {
-        static bool warnedPortable = false;
-        if (!warnedPortable)
-        {
-            warnedPortable = true;
-            Log("[OCR] Using portable OCR runtime: '%s'", ocrExePath.c_str());
-        }
-    }
-
-    std::string cmd = "cmd /C \"\"";
-    cmd += ocrExePath;
-    cmd += "\" \"";
-    cmd += gOcrBmpBottomLeftPath;
-    cmd += "\" \"";
-    cmd += gOcrOutBaseBottomLeftPath;
-    cmd += "\" --psm ";
-    cmd += std::to_string(gCfg.ocrPsm);
-    cmd += " -l eng quiet && \"";
-    cmd += ocrExePath;
-    cmd += "\" \"";
-    cmd += gOcrBmpTopRightPath;
-    cmd += "\" \"";
-    cmd += gOcrOutBaseTopRightPath;
-    cmd += "\" --psm ";
-    cmd += std::to_string(gCfg.ocrPsm);
-    cmd += " -l eng quiet\"";
+    SetHandleInformation(stdinWrite, HANDLE_FLAG_INHERIT, 0);
+    SetHandleInformation(stdoutRead, HANDLE_FLAG_INHERIT, 0);
+    DWORD mode = PIPE_READMODE_BYTE | PIPE_NOWAIT;
+    SetNamedPipeHandleState(stdinWrite, &mode, nullptr, nullptr);
 
     STARTUPINFOA si{};
     si.cb = sizeof(si);
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdInput = childIn;
+    si.hStdOutput = childOut;
+    si.hStdError = nullptr;
     PROCESS_INFORMATION pi{};
-    const char* workDir = (gGameDirPath[0] != '\0') ? gGameDirPath : nullptr;
 
     std::vector<char> cmdLine(cmd.begin(), cmd.end());
     cmdLine.push_back('\0');
@@ -2128,615 +2728,2263 @@ static bool StartOcrProcess(DWORD now)
         cmdLine.data(),
         nullptr,
         nullptr,
-        FALSE,
+        TRUE,
         CREATE_NO_WINDOW,
         nullptr,
         workDir,
         &si,
         &pi);
+    DWORD err = GetLastError();
 
+    // The child holds its own copies; ours must go or stdout never reaches EOF.
+    CloseHandle(childIn);
+    CloseHandle(childOut);
     if (!ok)
     {
-        gLastOcrStartFailReason = OCR_START_FAIL_CREATE_PROCESS;
-        gLastOcrStartWinErr = GetLastError();
-        Log("[OCR] CreateProcess failed for OCR runtime='%s' cmd='%s' err=%lu",
-            ocrExePath.c_str(), cmd.c_str(), (unsigned long)gLastOcrStartWinErr);
-        CleanupOcrArtifactsIfNeeded();
+        SetLastError(err);
         return false;
     }
-
     CloseHandle(pi.hThread);
-    gOcrProcess = pi.hProcess;
-    gOcrProcessStartMs = now;
+    process = pi.hProcess;
     return true;
 }
 
-static bool TryCollectOcrResult(DWORD now, DetectionInputs& out, bool& hasResult)
+// Appends whatever the pipe holds without waiting; closes it at EOF. false = closed.
+static bool DrainPipe(HANDLE& pipe, std::string& out)
 {
-    hasResult = false;
-    out = DetectionInputs{};
-
-    if (!gOcrProcess)
-        return false;
-
-    DWORD wait = WaitForSingleObject(gOcrProcess, 0);
-    if (wait == WAIT_TIMEOUT)
+    while (pipe)
     {
-        if (gOcrProcessStartMs > 0 &&
-            (now - gOcrProcessStartMs) >= (DWORD)gCfg.ocrProcessTimeoutMs)
+        DWORD avail = 0;
+        if (!PeekNamedPipe(pipe, nullptr, 0, nullptr, &avail, nullptr))
         {
-            StopOcrProcess(true);
-            hasResult = true;
-            out.scanOk = false;
-            CleanupOcrArtifactsIfNeeded();
+            CloseHandle(pipe);  // broken pipe: the writer closed its end
+            pipe = nullptr;
+            break;
         }
-        else
+        if (avail == 0)
+            break;
+        char buf[4096];
+        DWORD n = 0;
+        if (!ReadFile(pipe, buf, (std::min)(avail, (DWORD)sizeof(buf)), &n, nullptr) || n == 0)
         {
-            out.pending = true;
+            CloseHandle(pipe);
+            pipe = nullptr;
+            break;
         }
-        return true;
+        out.append(buf, n);
     }
+    return pipe != nullptr;
+}
+
+class OcrSpawnBackend final : public OcrBackend
+{
+public:
+    const char* Name() const override { return "spawn"; }
+    bool Busy() const override { return running; }
+    bool Submit(OcrImage* rois, unsigned roiMask, uint32_t nowMs) override;
+    OcrPollResult Poll(uint32_t nowMs, OcrCycleResult& out) override;
+    void Cancel() override { Stop(true); }
+
+private:
+    struct Job
+    {
+        HANDLE process = nullptr;
+        HANDLE stdinWrite = nullptr;     // closed once the whole BMP is in
+        HANDLE stdoutRead = nullptr;     // closed at EOF
+        std::vector<unsigned char> bmp;  // kept across cycles
+        size_t written = 0;
+        std::string text;
+    };
+
+    static bool Pump(Job& job);
+    void Stop(bool terminate);
 
-    if (wait == WAIT_OBJECT_0)
+    Job jobs[OCR_ROI_COUNT];
+    bool running = false;
+    uint32_t startMs = 0;
+};
+
+void OcrSpawnBackend::Stop(bool terminate)
+{
+    for (Job& job : jobs)
     {
-        StopOcrProcess(false);
-        std::string leftText;
-        std::string rightText;
-        bool leftOk = ReadTextFileAll(gOcrTxtBottomLeftPath, leftText);
-        bool rightOk = ReadTextFileAll(gOcrTxtTopRightPath, rightText);
-        if (!leftOk && !rightOk)
+        if (job.process)
         {
-            hasResult = true;
-            out.scanOk = false;
-            gLastOcrText.clear();
-            CleanupOcrArtifactsIfNeeded();
-            return true;
+            if (terminate)
+                TerminateProcess(job.process, 1);
+            CloseHandle(job.process);
         }
+        if (job.stdinWrite)
+            CloseHandle(job.stdinWrite);
+        if (job.stdoutRead)
+            CloseHandle(job.stdoutRead);
+        job.process = nullptr;
+        job.stdinWrite = nullptr;
+        job.stdoutRead = nullptr;
+    }
+    running = false;
+    startMs = 0;
+}
 
-        std::string text;
-        if (leftOk)
-            text += leftText;
-        if (rightOk)
+// Moves whatever the pipes allow without waiting. true = stdout reached EOF.
+bool OcrSpawnBackend::Pump(Job& job)
+{
+    while (job.stdinWrite && job.written < job.bmp.size())
+    {
+        DWORD chunk = (DWORD)(std::min)(job.bmp.size() - job.written, (size_t)65536);
+        DWORD n = 0;
+        if (!WriteFile(job.stdinWrite, job.bmp.data() + job.written, chunk, &n, nullptr))
         {
-            if (!text.empty())
-                text += "\n";
-            text += rightText;
+            job.written = job.bmp.size();  // tesseract gave up on stdin; its exit code reports it
+            break;
         }
+        if (n == 0)
+            break;  // pipe full
+        job.written += n;
+    }
+    if (job.stdinWrite && job.written >= job.bmp.size())
+    {
+        CloseHandle(job.stdinWrite);
+        job.stdinWrite = nullptr;
+    }
+
+    return !DrainPipe(job.stdoutRead, job.text);
+}
+
+bool OcrSpawnBackend::Submit(OcrImage* rois, unsigned roiMask, uint32_t nowMs)
+{
+    if (running)
+        return false;
 
-        text = ToLowerAscii(text);
-        gLastOcrText = text;
-        out.rawText = text;
-        out.opacityHint = gPendingOpacityHint;
-        gLastOpacityHint = gPendingOpacityHint;
-        std::unordered_map<std::string, int> tokenCounts;
-        out.normalizedText = NormalizeOcrText(text, tokenCounts);
-        out.scanOk = true;
-        for (const auto& kw : gOcrKeywords)
+    bool usingPortableOcr = false;
+    std::string ocrExePath = ResolveOcrExecutablePath(usingPortableOcr);
+    if (usingPortableOcr)
+    {
+        static bool warnedPortable = false;
+        if (!warnedPortable)
         {
-            if (!kw.empty() && text.find(kw) != std::string::npos)
-                out.keywordHits++;
+            warnedPortable = true;
+            Log("[OCR] Using portable OCR runtime: '%s'", ocrExePath.c_str());
         }
-        const char* anchors[] = {
-            "blind","cards","community","pot","call","fold","raise","bet",
-            "check","turn","pair","straight","flush","wins","amount",
-            "called","raised","folded","checked","skip","auto"
-        };
-        for (const char* anchor : anchors)
-            if (HasToken(tokenCounts, anchor))
-                out.anchorHits++;
-        out.seenKeyword = (out.keywordHits > 0);
-        CleanupOcrArtifactsIfNeeded();
-        hasResult = true;
-        return true;
     }
 
-    // WAIT_FAILED / WAIT_ABANDONED: treat as OCR failure.
-    StopOcrProcess(true);
-    hasResult = true;
-    out.scanOk = false;
-    CleanupOcrArtifactsIfNeeded();
+    std::string cmd = "\"";
+    cmd += ocrExePath;
+    cmd += "\" stdin stdout --psm ";
+    cmd += std::to_string(gCfg.ocrPsm);
+    cmd += " -l eng quiet";
+    const char* workDir = (gGameDirPath[0] != '\0') ? gGameDirPath : nullptr;
+
+    running = true;
+    startMs = nowMs;
+    for (int r = 0; r < OCR_ROI_COUNT; r++)
+    {
+        Job& job = jobs[r];
+        job.text.clear();
+        if (!(roiMask & (1u << r)))
+            continue;
+        if (!EncodeBitmap24(rois[r], job.bmp))
+        {
+            gLastOcrStartFailReason = OCR_START_FAIL_CAPTURE;
+            gLastOcrStartWinErr = 0;
+            Stop(true);
+            return false;
+        }
+        if (!LaunchWithPipes(cmd, workDir, (DWORD)job.bmp.size(), job.process, job.stdinWrite, job.stdoutRead))
+        {
+            gLastOcrStartFailReason = OCR_START_FAIL_CREATE_PROCESS;
+            gLastOcrStartWinErr = GetLastError();
+            Log("[OCR] CreateProcess failed for OCR runtime='%s' cmd='%s' err=%lu",
+                ocrExePath.c_str(), cmd.c_str(), (unsigned long)gLastOcrStartWinErr);
+            Stop(true);
+            return false;
+        }
+        job.written = 0;
+        Pump(job);
+    }
     return true;
 }
 
-static DetectionScore ComputeDetectionScore(const DetectionInputs& in)
+OcrPollResult OcrSpawnBackend::Poll(uint32_t nowMs, OcrCycleResult& out)
 {
-    DetectionScore out;
-    out.opacityHint = in.opacityHint;
+    if (!running)
+        return OCR_POLL_IDLE;
 
-    if (!in.scanOk)
+    bool done = true;
+    for (Job& job : jobs)
     {
-        out.gateFail = true;
-        out.gateReason = "ocrFail";
-        return out;
+        if (job.process && (!Pump(job) || WaitForSingleObject(job.process, 0) == WAIT_TIMEOUT))
+            done = false;
+    }
+    if (!done)
+    {
+        if ((nowMs - startMs) < (uint32_t)gCfg.ocrProcessTimeoutMs)
+            return OCR_POLL_PENDING;
+        Stop(true);
+        return OCR_POLL_FAILED;
     }
 
-    out.total = in.keywordHits;
-    out.gateReason = in.seenKeyword ? "ocrHit" : "ocrMiss";
+    for (int r = 0; r < OCR_ROI_COUNT; r++)
+    {
+        DWORD code = 1;
+        out.ok[r] = jobs[r].process && GetExitCodeProcess(jobs[r].process, &code) && code == 0;
+        out.text[r].swap(jobs[r].text);
+        out.words[r].clear();
+    }
+    Stop(false);
+    return OCR_POLL_DONE;
+}
 
-    std::unordered_map<std::string, int> tokens;
-    std::string normalized = in.normalizedText;
-    if (normalized.empty())
-        normalized = NormalizeOcrText(in.rawText, tokens);
-    else
-        (void)NormalizeOcrText(normalized, tokens);
+// libtesseract's C API (capi.h), resolved at runtime: the plugin neither links nor ships it.
+struct TessApi
+{
+    HMODULE dll = nullptr;
+    std::string path;
+    void* (*create)() = nullptr;
+    void (*destroy)(void*) = nullptr;
+    int (*init3)(void*, const char*, const char*) = nullptr;
+    void (*setPageSegMode)(void*, int) = nullptr;
+    void (*setImage)(void*, const unsigned char*, int, int, int, int) = nullptr;
+    void (*setSourceResolution)(void*, int) = nullptr;  // optional
+    char* (*getUtf8Text)(void*) = nullptr;
+    void (*deleteText)(const char*) = nullptr;
+    void (*end)(void*) = nullptr;
+    const char* (*version)() = nullptr;                  // optional
+};
 
-    std::string padded = " " + normalized + " ";
-    auto hasToken = [&](const char* t) { return HasToken(tokens, t); };
-    auto hasPhrase = [&](const char* p) {
-        std::string needle = " ";
-        needle += p;
-        needle += " ";
-        return padded.find(needle) != std::string::npos;
-    };
+enum OcrEngineState
+{
+    OCR_ENGINE_LOADING = 0,  // thread started, model loading
+    OCR_ENGINE_READY = 1,
+    OCR_ENGINE_BROKEN = 2    // TessBaseAPIInit3 failed; the thread has exited
+};
 
-    std::vector<std::pair<float, std::string>> reasons;
-    auto add = [&](PokerPhase p, float w, const char* why) {
-        out.phaseScores[(size_t)p] += w;
-        reasons.emplace_back(w, why);
-    };
+// Script thread <-> engine thread, under gOcrEngineLock.
+struct OcrEngineShared
+{
+    int generation = 0;        // bumped when a thread is detached; older threads stop publishing
+    int state = OCR_ENGINE_LOADING;
+    int submitted = 0;         // serial of the newest cycle handed over
+    int finished = 0;          // serial of the newest cycle recognized
+    int psm = 11;
+    unsigned roiMask = kOcrAllRois;
+    DWORD heartbeatMs = 0;     // last Submit / Poll
+    OcrImage rois[OCR_ROI_COUNT];  // swapped in by Submit, out by the engine thread
+    OcrCycleResult result;     // of cycle `finished`
+};
 
-    // Table idle / seated markers.
-    if (hasPhrase("small blind")) add(POKER_PHASE_TABLE_IDLE, 2.2f, "small blind");
-    if (hasPhrase("big blind")) add(POKER_PHASE_TABLE_IDLE, 2.2f, "big blind");
-    if (hasToken("blind")) add(POKER_PHASE_TABLE_IDLE, 0.8f, "blind");
-    if (hasToken("pot")) add(POKER_PHASE_TABLE_IDLE, 1.2f, "pot");
+constexpr DWORD kOcrEngineIdleWaitMs = 250;
+constexpr DWORD kOcrEngineOrphanMs = 10000;  // no Poll for this long: the script stopped, exit
+constexpr DWORD kOcrEngineStopWaitMs = 500;  // Shutdown waits this long for a recognition, then detaches
+constexpr int kOcrEngineDpi = 70;            // what tesseract.exe assumes for a BMP without a resolution
+
+static TessApi gTess;
+static std::string gOcrEngineDataPath;       // tessdata directory; empty = TESSDATA_PREFIX
+static SRWLOCK gOcrEngineLock = SRWLOCK_INIT;
+static OcrEngineShared gOcrEngineShared;
+static HANDLE gOcrEngineThread = nullptr;
+static HANDLE gOcrEngineStopEvent = nullptr;
+static HANDLE gOcrEngineJobEvent = nullptr;
+static HANDLE gOcrEngineDetached = nullptr;  // a thread Shutdown stopped waiting for; it exits on its own
+
+// Everything the engine thread uses is copied here at start, so a detached thread never
+// sees the next thread's events, library or shared state.
+struct OcrEngineThreadArgs
+{
+    HMODULE self = nullptr;
+    HANDLE stopEvent = nullptr;  // the thread's own handles, closed when it exits
+    HANDLE jobEvent = nullptr;
+    int generation = 0;
+    TessApi tess;
+    std::string dataPath;
+};
 
-    // Active decision markers.
-    if (hasPhrase("your cards")) add(POKER_PHASE_PLAYER_DECISION, 2.4f, "your cards");
-    if (hasPhrase("take your turn")) add(POKER_PHASE_PLAYER_DECISION, 2.6f, "take your turn");
-    if (hasToken("call") || hasToken("called")) add(POKER_PHASE_PLAYER_DECISION, 1.1f, "call");
-    if (hasToken("fold") || hasToken("folded")) add(POKER_PHASE_PLAYER_DECISION, 1.1f, "fold");
-    if (hasToken("check") || hasToken("checked")) add(POKER_PHASE_PLAYER_DECISION, 1.1f, "check");
-    if (hasToken("raise") || hasToken("raised")) add(POKER_PHASE_PLAYER_DECISION, 1.1f, "raise");
-    if (hasToken("bet")) add(POKER_PHASE_PLAYER_DECISION, 1.1f, "bet");
-    if (hasToken("amount")) add(POKER_PHASE_PLAYER_DECISION, 0.9f, "amount");
+// GetDIBits rows are BGR; the C API reads 3-byte pixels as RGB.
+static void SwapRedBlue(OcrImage& img)
+{
+    for (int y = 0; y < img.height; y++)
+    {
+        unsigned char* row = img.pixels.data() + (size_t)y * (size_t)img.stride;
+        for (int x = 0; x < img.width; x++)
+        {
+            unsigned char b = row[x * 3];
+            row[x * 3] = row[x * 3 + 2];
+            row[x * 3 + 2] = b;
+        }
+    }
+}
 
-    // Waiting/auto-action markers.
-    if (hasToken("skip")) add(POKER_PHASE_WAITING_ACTION, 2.0f, "skip");
-    if (hasPhrase("auto bet")) add(POKER_PHASE_WAITING_ACTION, 2.2f, "auto bet");
-    if (hasToken("leave")) add(POKER_PHASE_WAITING_ACTION, 0.7f, "leave");
-    if (hasToken("waiting")) add(POKER_PHASE_WAITING_ACTION, 1.0f, "waiting");
+static DWORD WINAPI OcrEngineMain(LPVOID param)
+{
+    OcrEngineThreadArgs* args = (OcrEngineThreadArgs*)param;
+    const TessApi& tess = args->tess;
+    void* api = tess.create();
+    bool ready = api && tess.init3(api, args->dataPath.empty() ? nullptr : args->dataPath.c_str(), "eng") == 0;
+    AcquireSRWLockExclusive(&gOcrEngineLock);
+    if (gOcrEngineShared.generation == args->generation)
+        gOcrEngineShared.state = ready ? OCR_ENGINE_READY : OCR_ENGINE_BROKEN;
+    ReleaseSRWLockExclusive(&gOcrEngineLock);
+
+    OcrImage rois[OCR_ROI_COUNT];
+    OcrCycleResult result;
+    HANDLE waits[2] = { args->stopEvent, args->jobEvent };
+    while (ready)
+    {
+        DWORD w = WaitForMultipleObjects(2, waits, FALSE, kOcrEngineIdleWaitMs);
+        if (w == WAIT_OBJECT_0 || w == WAIT_FAILED)
+            break;
 
-    // Reveal markers.
-    if (hasToken("pair")) add(POKER_PHASE_SHOWDOWN_REVEAL, 1.6f, "pair");
-    if (hasToken("straight")) add(POKER_PHASE_SHOWDOWN_REVEAL, 1.8f, "straight");
-    if (hasToken("flush")) add(POKER_PHASE_SHOWDOWN_REVEAL, 1.8f, "flush");
-    if (hasToken("muck")) add(POKER_PHASE_SHOWDOWN_REVEAL, 1.6f, "muck");
-    if (hasToken("reveal")) add(POKER_PHASE_SHOWDOWN_REVEAL, 1.4f, "reveal");
-    if (hasPhrase("waiting to reveal")) add(POKER_PHASE_SHOWDOWN_REVEAL, 2.2f, "waiting reveal");
-    if (hasPhrase("community cards")) add(POKER_PHASE_SHOWDOWN_REVEAL, 1.2f, "community cards");
+        AcquireSRWLockExclusive(&gOcrEngineLock);
+        if (gOcrEngineShared.generation != args->generation)
+        {
+            ReleaseSRWLockExclusive(&gOcrEngineLock);
+            break;  // detached; a newer thread owns the shared state
+        }
+        DWORD heartbeatMs = gOcrEngineShared.heartbeatMs;
+        int serial = gOcrEngineShared.submitted;
+        bool job = serial != gOcrEngineShared.finished;
+        int psm = gOcrEngineShared.psm;
+        unsigned roiMask = gOcrEngineShared.roiMask;
+        if (job)
+        {
+            for (int r = 0; r < OCR_ROI_COUNT; r++)
+                std::swap(rois[r], gOcrEngineShared.rois[r]);
+        }
+        ReleaseSRWLockExclusive(&gOcrEngineLock);
 
-    // Payout markers.
-    if (in.rawText.find("wins $") != std::string::npos) add(POKER_PHASE_PAYOUT_SETTLEMENT, 3.0f, "wins $");
-    if (hasToken("wins")) add(POKER_PHASE_PAYOUT_SETTLEMENT, 1.8f, "wins");
+        if (!job)
+        {
+            if ((GetTickCount() - heartbeatMs) > kOcrEngineOrphanMs)
+                break;
+            continue;
+        }
 
-    // Opacity hint weighting (secondary signal only).
-    if (gCfg.ocrOpacityHintEnable)
-    {
-        if (in.opacityHint >= 0.70f)
+        tess.setPageSegMode(api, psm);
+        for (int r = 0; r < OCR_ROI_COUNT; r++)
         {
-            add(POKER_PHASE_PLAYER_DECISION, 0.9f, "opacity:active");
-            add(POKER_PHASE_TABLE_IDLE, 0.3f, "opacity:active");
+            OcrImage& img = rois[r];
+            result.text[r].clear();
+            result.ok[r] = false;
+            if (!(roiMask & (1u << r)) || img.width <= 0 || img.height <= 0)
+                continue;
+            SwapRedBlue(img);
+            tess.setImage(api, img.pixels.data(), img.width, img.height, 3, img.stride);
+            if (tess.setSourceResolution)
+                tess.setSourceResolution(api, kOcrEngineDpi);
+            char* text = tess.getUtf8Text(api);
+            if (text)
+            {
+                result.text[r] = text;
+                result.ok[r] = true;
+                tess.deleteText(text);
+            }
         }
-        else if (in.opacityHint <= 0.30f)
+
+        AcquireSRWLockExclusive(&gOcrEngineLock);
+        if (gOcrEngineShared.generation == args->generation)
         {
-            add(POKER_PHASE_WAITING_ACTION, 0.6f, "opacity:faded");
-            add(POKER_PHASE_SHOWDOWN_REVEAL, 0.6f, "opacity:faded");
-            add(POKER_PHASE_PAYOUT_SETTLEMENT, 0.4f, "opacity:faded");
+            std::swap(gOcrEngineShared.result, result);
+            gOcrEngineShared.finished = serial;
         }
+        ReleaseSRWLockExclusive(&gOcrEngineLock);
     }
 
-    int anchorCount = in.anchorHits;
-    if (anchorCount <= 0)
+    if (api)
     {
-        const char* anchors[] = {
-            "blind","cards","community","pot","call","fold","raise","bet",
-            "check","turn","pair","straight","flush","wins","amount",
-            "called","raised","folded","checked","skip","auto"
-        };
-        for (const char* a : anchors)
-            if (hasToken(a))
-                anchorCount++;
+        tess.end(api);
+        tess.destroy(api);
     }
-    out.pokerAnchor = anchorCount > 0;
-
-    float outScore = 0.4f;
-    if (!out.pokerAnchor)
-        outScore += 2.2f;
-    if (normalized.size() < 6)
-        outScore += 0.7f;
-    if (in.opacityHint < 0.25f)
-        outScore += 0.3f;
-    if (hasToken("leave"))
-        outScore += 0.4f;
-    out.phaseScores[(size_t)POKER_PHASE_OUT_OF_POKER] += outScore;
-
-    out.reasons = BuildReasonSummary(reasons);
-    return out;
+    CloseHandle(args->stopEvent);
+    CloseHandle(args->jobEvent);
+    // Holds a module reference so the DLL cannot unload underneath the loop.
+    HMODULE self = args->self;
+    delete args;
+    FreeLibraryAndExitThread(self, 0);
+    return 0;
 }
 
-static bool IsPhaseTransitionAllowed(PokerPhase from, PokerPhase to)
+// True while a detached engine thread may still be inside libtesseract.
+static bool OcrEngineDetachedRunning()
 {
-    if (from == to)
-        return true;
-    if (to == POKER_PHASE_OUT_OF_POKER)
+    if (!gOcrEngineDetached)
+        return false;
+    if (WaitForSingleObject(gOcrEngineDetached, 0) == WAIT_TIMEOUT)
         return true;
-    if (from == POKER_PHASE_OUT_OF_POKER)
-        return (to == POKER_PHASE_TABLE_IDLE || to == POKER_PHASE_PLAYER_DECISION || to == POKER_PHASE_WAITING_ACTION);
-    if (from == POKER_PHASE_SHOWDOWN_REVEAL)
-        return (to == POKER_PHASE_PAYOUT_SETTLEMENT || to == POKER_PHASE_TABLE_IDLE || to == POKER_PHASE_OUT_OF_POKER);
-    if (from == POKER_PHASE_PAYOUT_SETTLEMENT)
-        return (to == POKER_PHASE_TABLE_IDLE || to == POKER_PHASE_PLAYER_DECISION || to == POKER_PHASE_WAITING_ACTION || to == POKER_PHASE_OUT_OF_POKER);
-    return true;
+    CloseHandle(gOcrEngineDetached);
+    gOcrEngineDetached = nullptr;
+    return false;
 }
 
-static bool UpdatePokerStateMachine(DetectionScore& score, DWORD now)
+// Explicit TesseractDll, else the first known libtesseract name next to the resolved tesseract.exe.
+static std::string ResolveTesseractDllPath()
 {
-    if (score.gateFail)
+    std::string configured = TrimAscii(gCfg.ocrTesseractDll);
+    if (!configured.empty())
     {
-        score.guessPhase = gDetectRuntime.phase;
-        score.confidence = gDetectRuntime.phaseConfidence;
-        score.candidateStableMs = 0;
-        return gDetectRuntime.inPoker;
+        if (FileExistsPath(configured.c_str()))
+            return configured;
+        std::string fromGame = BuildGamePath(configured.c_str());
+        return FileExistsPath(fromGame.c_str()) ? fromGame : std::string();
     }
 
-    gDetectRuntime.scoreHistory.push_back(score.phaseScores);
-    while ((int)gDetectRuntime.scoreHistory.size() > 6)
-        gDetectRuntime.scoreHistory.pop_front();
+    bool usingPortableOcr = false;
+    std::string exe = ResolveOcrExecutablePath(usingPortableOcr);
+    size_t slash = exe.find_last_of("\\/");
+    if (slash == std::string::npos)
+        return std::string();  // tesseract from PATH: no directory to look in
+    std::string dir = exe.substr(0, slash + 1);
+    const char* names[] = {
+        "libtesseract-5.dll",   // UB Mannheim / MSYS2 builds
+        "tesseract55.dll",      // vcpkg / MSVC builds
+        "tesseract54.dll",
+        "tesseract53.dll",
+        "tesseract52.dll",
+        "tesseract51.dll",
+        "tesseract50.dll",
+        "libtesseract-4.dll",
+        "tesseract41.dll"
+    };
+    for (const char* name : names)
+    {
+        std::string candidate = dir + name;
+        if (FileExistsPath(candidate.c_str()))
+            return candidate;
+    }
+    return std::string();
+}
 
-    std::array<float, POKER_PHASE_COUNT> smooth{};
-    for (const auto& s : gDetectRuntime.scoreHistory)
-        for (size_t i = 0; i < smooth.size(); i++)
-            smooth[i] += s[i];
+class OcrEngineBackend final : public OcrBackend
+{
+public:
+    // Script thread. Loads the library (kept while the path does not change). false = use spawn.
+    bool Load(std::string& why);
+    void Shutdown();
+    bool Broken() const;
+
+    const char* Name() const override { return "engine"; }
+    bool Busy() const override;
+    bool Submit(OcrImage* rois, unsigned roiMask, uint32_t nowMs) override;
+    OcrPollResult Poll(uint32_t nowMs, OcrCycleResult& out) override;
+    void Cancel() override { pending = 0; }
+
+private:
+    bool EnsureThread(uint32_t nowMs);
+
+    int serial = 0;       // newest submitted
+    int pending = 0;      // serial whose result is still wanted, 0 = none
+    uint32_t startMs = 0;
+};
 
-    float histN = (float)gDetectRuntime.scoreHistory.size();
-    if (histN <= 0.0f)
-        histN = 1.0f;
-    for (size_t i = 0; i < smooth.size(); i++)
-        smooth[i] /= histN;
+bool OcrEngineBackend::Load(std::string& why)
+{
+    std::string path = ResolveTesseractDllPath();
+    if (path.empty())
+    {
+        why = "no libtesseract DLL found (set TesseractDll)";
+        return false;
+    }
+    if (gTess.dll && gTess.path == path)
+        return true;  // keep the warm engine across settings reloads
 
-    int bestIdx = 0;
-    float bestScore = smooth[0];
-    float scoreSum = smooth[0];
-    for (int i = 1; i < POKER_PHASE_COUNT; i++)
+    Shutdown();
+    // A detached thread still runs the old library: leave it loaded rather than unload under it.
+    if (gTess.dll && !OcrEngineDetachedRunning())
+        FreeLibrary(gTess.dll);
+    gTess = TessApi{};
+
+    // Altered search path: leptonica and the other dependencies sit next to the DLL.
+    HMODULE dll = LoadLibraryExA(path.c_str(), nullptr, LOAD_WITH_ALTERED_SEARCH_PATH);
+    if (!dll)
     {
-        scoreSum += smooth[i];
-        if (smooth[i] > bestScore)
-        {
-            bestScore = smooth[i];
-            bestIdx = i;
-        }
+        char buf[64];
+        _snprintf_s(buf, sizeof(buf), " failed err=%lu", (unsigned long)GetLastError());
+        why = "LoadLibrary('" + path + "')" + buf;
+        return false;
     }
 
-    if (scoreSum <= 0.0001f)
-        scoreSum = 0.0001f;
+    TessApi t;
+    t.dll = dll;
+    t.path = path;
+    t.create = (void* (*)())GetProcAddress(dll, "TessBaseAPICreate");
+    t.destroy = (void (*)(void*))GetProcAddress(dll, "TessBaseAPIDelete");
+    t.init3 = (int (*)(void*, const char*, const char*))GetProcAddress(dll, "TessBaseAPIInit3");
+    t.setPageSegMode = (void (*)(void*, int))GetProcAddress(dll, "TessBaseAPISetPageSegMode");
+    t.setImage = (void (*)(void*, const unsigned char*, int, int, int, int))GetProcAddress(dll, "TessBaseAPISetImage");
+    t.setSourceResolution = (void (*)(void*, int))GetProcAddress(dll, "TessBaseAPISetSourceResolution");
+    t.getUtf8Text = (char* (*)(void*))GetProcAddress(dll, "TessBaseAPIGetUTF8Text");
+    t.deleteText = (void (*)(const char*))GetProcAddress(dll, "TessDeleteText");
+    t.end = (void (*)(void*))GetProcAddress(dll, "TessBaseAPIEnd");
+    t.version = (const char* (*)())GetProcAddress(dll, "TessVersion");
+    if (!t.create || !t.destroy || !t.init3 || !t.setPageSegMode || !t.setImage ||
+        !t.getUtf8Text || !t.deleteText || !t.end)
+    {
+        FreeLibrary(dll);
+        why = "DLL lacks the Tesseract C API";
+        return false;
+    }
+    gTess = t;
 
-    score.phaseScores = smooth;
-    score.guessPhase = (PokerPhase)bestIdx;
-    score.confidence = ClampFloat(bestScore / scoreSum, 0.0f, 1.0f);
+    // Prefer the tessdata shipped with the DLL; otherwise tesseract falls back to TESSDATA_PREFIX.
+    size_t slash = path.find_last_of("\\/");
+    std::string dataDir = path.substr(0, slash == std::string::npos ? 0 : slash + 1) + "tessdata";
+    std::string model = dataDir + "\\eng.traineddata";
+    gOcrEngineDataPath = FileExistsPath(model.c_str()) ? dataDir : std::string();
+    return true;
+}
 
-    if (gDetectRuntime.candidatePhase != score.guessPhase)
+// Waits up to kOcrEngineStopWaitMs for a recognition to finish. A thread still inside
+// libtesseract after that is detached: it keeps its own events and library, publishes
+// nothing more and exits when the recognition returns.
+void OcrEngineBackend::Shutdown()
+{
+    pending = 0;
+    if (!gOcrEngineThread)
+        return;
+    SetEvent(gOcrEngineStopEvent);
+    if (WaitForSingleObject(gOcrEngineThread, kOcrEngineStopWaitMs) == WAIT_TIMEOUT)
+    {
+        AcquireSRWLockExclusive(&gOcrEngineLock);
+        gOcrEngineShared.generation++;
+        ReleaseSRWLockExclusive(&gOcrEngineLock);
+        Log("[OCR] Engine: recognition still running after %lu ms; detached the engine thread.",
+            (unsigned long)kOcrEngineStopWaitMs);
+        if (OcrEngineDetachedRunning())
+            CloseHandle(gOcrEngineThread);  // one is already being tracked; this one exits the same way
+        else
+            gOcrEngineDetached = gOcrEngineThread;
+        gOcrEngineThread = nullptr;
+        // The detached thread holds duplicates; the next thread gets fresh events.
+        CloseHandle(gOcrEngineStopEvent);
+        CloseHandle(gOcrEngineJobEvent);
+        gOcrEngineStopEvent = nullptr;
+        gOcrEngineJobEvent = nullptr;
+        return;
+    }
+    CloseHandle(gOcrEngineThread);
+    gOcrEngineThread = nullptr;
+    ResetEvent(gOcrEngineStopEvent);
+}
+
+bool OcrEngineBackend::Broken() const
+{
+    AcquireSRWLockShared(&gOcrEngineLock);
+    bool broken = gOcrEngineShared.state == OCR_ENGINE_BROKEN;
+    ReleaseSRWLockShared(&gOcrEngineLock);
+    return broken;
+}
+
+bool OcrEngineBackend::Busy() const
+{
+    if (pending)
+        return true;
+    // An abandoned (timed out) cycle still occupies the engine until it finishes.
+    AcquireSRWLockShared(&gOcrEngineLock);
+    bool running = gOcrEngineShared.finished != gOcrEngineShared.submitted;
+    ReleaseSRWLockShared(&gOcrEngineLock);
+    return running && gOcrEngineThread && WaitForSingleObject(gOcrEngineThread, 0) == WAIT_TIMEOUT;
+}
+
+bool OcrEngineBackend::EnsureThread(uint32_t nowMs)
+{
+    if (gOcrEngineThread && WaitForSingleObject(gOcrEngineThread, 0) == WAIT_TIMEOUT)
+        return true;
+    if (gOcrEngineThread)
+    {
+        CloseHandle(gOcrEngineThread);
+        gOcrEngineThread = nullptr;
+    }
+
+    if (!gOcrEngineStopEvent)
+        gOcrEngineStopEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    if (!gOcrEngineJobEvent)
+        gOcrEngineJobEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+    OcrEngineThreadArgs* args = new OcrEngineThreadArgs();
+    GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS, (const char*)&OcrEngineMain, &args->self);
+    HANDLE process = GetCurrentProcess();
+    bool ok = gOcrEngineStopEvent && gOcrEngineJobEvent && args->self &&
+        DuplicateHandle(process, gOcrEngineStopEvent, process, &args->stopEvent, 0, FALSE, DUPLICATE_SAME_ACCESS) &&
+        DuplicateHandle(process, gOcrEngineJobEvent, process, &args->jobEvent, 0, FALSE, DUPLICATE_SAME_ACCESS);
+    if (!ok)
     {
-        gDetectRuntime.candidatePhase = score.guessPhase;
-        gDetectRuntime.candidateSince = now;
+        gLastOcrStartFailReason = OCR_START_FAIL_ENGINE;
+        gLastOcrStartWinErr = GetLastError();
+        if (args->stopEvent)
+            CloseHandle(args->stopEvent);
+        if (args->jobEvent)
+            CloseHandle(args->jobEvent);
+        if (args->self)
+            FreeLibrary(args->self);
+        delete args;
+        return false;
     }
-    score.candidateStableMs = (gDetectRuntime.candidateSince > 0) ? (now - gDetectRuntime.candidateSince) : 0;
+    args->tess = gTess;
+    args->dataPath = gOcrEngineDataPath;
 
-    bool shouldTransition = false;
-    if (score.guessPhase == POKER_PHASE_OUT_OF_POKER)
+    AcquireSRWLockExclusive(&gOcrEngineLock);
+    args->generation = gOcrEngineShared.generation;
+    gOcrEngineShared.state = OCR_ENGINE_LOADING;
+    gOcrEngineShared.finished = gOcrEngineShared.submitted;
+    gOcrEngineShared.heartbeatMs = nowMs;
+    ReleaseSRWLockExclusive(&gOcrEngineLock);
+
+    HMODULE self = args->self;
+    gOcrEngineThread = CreateThread(nullptr, 0, OcrEngineMain, args, 0, nullptr);
+    if (!gOcrEngineThread)
     {
-        DWORD requiredOutStableMs = (DWORD)gCfg.ocrOutStableMs;
-        bool fadeLikely = gCfg.ocrBlackoutGuardEnable &&
-            score.opacityHint <= gCfg.ocrBlackoutOpacityThreshold;
-        if (fadeLikely)
-            requiredOutStableMs += (DWORD)gCfg.ocrBlackoutOutExtraMs;
+        gLastOcrStartFailReason = OCR_START_FAIL_ENGINE;
+        gLastOcrStartWinErr = GetLastError();
+        CloseHandle(args->stopEvent);
+        CloseHandle(args->jobEvent);
+        delete args;
+        FreeLibrary(self);
+        return false;
+    }
+    SetThreadPriority(gOcrEngineThread, THREAD_PRIORITY_BELOW_NORMAL);
+    return true;
+}
 
-        bool recentPokerAnchor = gCfg.ocrBlackoutGuardEnable &&
-            gDetectRuntime.phase != POKER_PHASE_OUT_OF_POKER &&
-            gLastPokerAnchorSeenAt > 0 &&
-            (now - gLastPokerAnchorSeenAt) <= (DWORD)gCfg.ocrBlackoutAnchorGraceMs;
-        bool fadeHoldActive = fadeLikely &&
-            recentPokerAnchor &&
-            score.candidateStableMs < (requiredOutStableMs + (DWORD)gCfg.ocrBlackoutMaxHoldMs);
+bool OcrEngineBackend::Submit(OcrImage* rois, unsigned roiMask, uint32_t nowMs)
+{
+    if (Busy() || !EnsureThread(nowMs))
+        return false;
 
-        bool payoutHoldWindowActive = gCfg.ocrPayoutGuardEnable &&
-            gDetectRuntime.phase != POKER_PHASE_OUT_OF_POKER &&
-            gPayoutHoldUntilAt > now;
-        if (payoutHoldWindowActive)
-            requiredOutStableMs += (DWORD)gCfg.ocrPayoutOutExtraMs;
-        bool payoutHoldActive = payoutHoldWindowActive &&
-            score.candidateStableMs < requiredOutStableMs;
+    serial++;
+    AcquireSRWLockExclusive(&gOcrEngineLock);
+    for (int r = 0; r < OCR_ROI_COUNT; r++)
+        std::swap(rois[r], gOcrEngineShared.rois[r]);
+    gOcrEngineShared.psm = gCfg.ocrPsm;
+    gOcrEngineShared.roiMask = roiMask;
+    gOcrEngineShared.submitted = serial;
+    gOcrEngineShared.heartbeatMs = nowMs;
+    ReleaseSRWLockExclusive(&gOcrEngineLock);
+    SetEvent(gOcrEngineJobEvent);
+
+    pending = serial;
+    startMs = nowMs;
+    return true;
+}
 
-        if (!score.pokerAnchor &&
-            score.confidence >= gCfg.ocrPhaseConfThreshold &&
-            score.candidateStableMs >= requiredOutStableMs &&
-            !fadeHoldActive &&
-            !payoutHoldActive)
-        {
-            shouldTransition = true;
-        }
-        else if (fadeHoldActive)
-        {
-            score.gateReason = "fadeHold";
-            if (score.reasons.empty())
-                score.reasons = "fadeHold";
-            else
-                score.reasons += ",fadeHold";
-        }
-        else if (payoutHoldActive)
-        {
-            score.gateReason = "payoutHold";
-            if (score.reasons.empty())
-                score.reasons = "payoutHold";
-            else
-                score.reasons += ",payoutHold";
-        }
+OcrPollResult OcrEngineBackend::Poll(uint32_t nowMs, OcrCycleResult& out)
+{
+    AcquireSRWLockExclusive(&gOcrEngineLock);
+    gOcrEngineShared.heartbeatMs = nowMs;
+    int state = gOcrEngineShared.state;
+    bool done = pending && gOcrEngineShared.finished == pending;
+    if (done)
+        out = gOcrEngineShared.result;
+    ReleaseSRWLockExclusive(&gOcrEngineLock);
+
+    if (!pending)
+        return OCR_POLL_IDLE;
+    if (done)
+    {
+        pending = 0;
+        return OCR_POLL_DONE;
     }
-    else if (score.confidence >= gCfg.ocrPhaseConfThreshold &&
-        score.pokerAnchor &&
-        score.candidateStableMs >= (DWORD)gCfg.ocrPhaseStableMs &&
-        IsPhaseTransitionAllowed(gDetectRuntime.phase, score.guessPhase))
+    if (state == OCR_ENGINE_BROKEN)
     {
-        shouldTransition = true;
+        pending = 0;
+        return OCR_POLL_FAILED;
     }
-
-    if (shouldTransition && gDetectRuntime.phase != score.guessPhase)
+    if (state == OCR_ENGINE_LOADING)
+        startMs = nowMs;  // the model load is not part of the cycle's timeout
+    if ((nowMs - startMs) >= (uint32_t)gCfg.ocrProcessTimeoutMs)
     {
-        Log("[PHASE] transition %s -> %s conf=%.2f",
-            PokerPhaseToString(gDetectRuntime.phase),
-            PokerPhaseToString(score.guessPhase),
-            score.confidence);
-        gDetectRuntime.phase = score.guessPhase;
-        if (gDetectRuntime.phase == POKER_PHASE_PAYOUT_SETTLEMENT)
-        {
-            gLastPayoutMarkerSeenAt = now;
-            DWORD holdMs = (DWORD)gCfg.ocrPayoutMarkerGraceMs + (DWORD)gCfg.ocrPayoutOutExtraMs;
-            DWORD holdUntil = now + holdMs;
-            if (holdUntil > gPayoutHoldUntilAt)
-                gPayoutHoldUntilAt = holdUntil;
-        }
+        pending = 0;  // the late result is dropped
+        return OCR_POLL_FAILED;
     }
+    return OCR_POLL_PENDING;
+}
 
-    gDetectRuntime.phaseConfidence = score.confidence;
-    gDetectRuntime.inPoker = (gDetectRuntime.phase != POKER_PHASE_OUT_OF_POKER);
-    return gDetectRuntime.inPoker;
+// Engine=2: the highstakes_ocr worker (tools/highstakes_ocr.cpp), started with the first cycle and
+// kept for the session. Frames go through a shared-memory ring (ocr_ipc.h); requests and results
+// through the worker's stdin/stdout. A worker that dies costs the cycle in flight and is started
+// again with the next one; one that cannot start at all is given up on (Broken).
+constexpr int kOcrWorkerSlots = 3;                // the cycle in flight plus an abandoned one still finishing
+constexpr DWORD kOcrWorkerStuckMs = 30000;        // abandoned result still missing: the worker is hung, restart it
+constexpr DWORD kOcrWorkerRetryMs = 5000;         // after a failed start
+constexpr DWORD kOcrWorkerHelloTimeoutMs = 30000; // model load included
+constexpr DWORD kOcrWorkerQuitWaitMs = 200;
+constexpr int kOcrWorkerMaxStartFailures = 3;
+
+static std::string ResolveOcrWorkerPath()
+{
+    std::string configured = TrimAscii(gCfg.ocrWorkerPath);
+    if (configured.empty())
+        return std::string();
+    if (FileExistsPath(configured.c_str()))
+        return configured;
+    std::string fromGame = BuildGamePath(configured.c_str());
+    return FileExistsPath(fromGame.c_str()) ? fromGame : std::string();
 }
 
-static bool ComputeInPokerV2(DWORD now)
+class OcrWorkerBackend final : public OcrBackend
 {
-    if (!gCfg.ocrEnabled)
+public:
+    // Script thread. Resolves the executable; the process starts with the first Submit. false = use spawn.
+    bool Configure(std::string& why);
+    void Shutdown();
+    bool Broken() const { return startFailures >= kOcrWorkerMaxStartFailures; }
+    const std::string& Path() const { return path; }
+    const std::string& Recognizer() const { return recognizer; }
+
+    const char* Name() const override { return "worker"; }
+    // An abandoned (timed out or cancelled) request still occupies the worker until its result arrives.
+    bool Busy() const override { return pending != 0 || abandoned != 0; }
+    bool Submit(OcrImage* rois, unsigned roiMask, uint32_t nowMs) override;
+    OcrPollResult Poll(uint32_t nowMs, OcrCycleResult& out) override;
+    void Cancel() override { Abandon(GetTickCount()); }
+
+private:
+    void Abandon(uint32_t nowMs);
+    bool Start(size_t slotBytes, uint32_t nowMs);
+    bool Send(int type, uint32_t requestId, const void* payload, size_t bytes);
+    void StartFailed(uint32_t nowMs);
+
+    std::string path;
+    HANDLE process = nullptr;
+    HANDLE toWorker = nullptr;
+    HANDLE fromWorker = nullptr;
+    HANDLE mapping = nullptr;
+    void* view = nullptr;
+    OcrIpcRing ring;
+    OcrIpcDecoder decoder;
+    OcrIpcMessage msg;
+    std::string inbox;         // raw bytes read this Poll
+    std::string wire;          // message being sent
+    std::string recognizer;    // from HELLO; empty = not up yet
+    uint32_t nextRequestId = 0;
+    uint32_t pending = 0;      // request whose result is still wanted, 0 = none
+    uint32_t abandoned = 0;    // request given up on whose result has not arrived, 0 = none
+    uint32_t abandonedMs = 0;
+    uint32_t startMs = 0;
+    uint32_t launchMs = 0;
+    uint32_t retryAtMs = 0;    // 0 = may start now
+    int startFailures = 0;
+    int generation = 0;        // keeps mapping names unique across restarts
+};
+
+bool OcrWorkerBackend::Configure(std::string& why)
+{
+    std::string resolved = ResolveOcrWorkerPath();
+    if (resolved.empty())
     {
-        StopOcrProcess(true);
-        gOcrStartFailureStreak = 0;
-        gOcrStartFailureWarned = false;
+        why = "'" + gCfg.ocrWorkerPath + "' not found";
         return false;
     }
+    if (resolved != path)
+    {
+        Shutdown();
+        path = resolved;
+        startFailures = 0;
+        retryAtMs = 0;
+    }
+    return true;
+}
 
-    DetectionInputs in;
-    bool hasResult = false;
-    TryCollectOcrResult(now, in, hasResult);
+void OcrWorkerBackend::Shutdown()
+{
+    pending = 0;
+    abandoned = 0;
+    if (process)
+    {
+        Send(OCR_IPC_QUIT, 0, nullptr, 0);
+        CloseHandle(toWorker);  // stdin EOF ends it as well
+        toWorker = nullptr;
+        if (WaitForSingleObject(process, kOcrWorkerQuitWaitMs) == WAIT_TIMEOUT)
+            TerminateProcess(process, 1);
+        CloseHandle(process);
+        process = nullptr;
+    }
+    if (toWorker)
+        CloseHandle(toWorker);
+    if (fromWorker)
+        CloseHandle(fromWorker);
+    toWorker = nullptr;
+    fromWorker = nullptr;
+    if (view)
+        UnmapViewOfFile(view);
+    if (mapping)
+        CloseHandle(mapping);
+    view = nullptr;
+    mapping = nullptr;
+    ring = OcrIpcRing();
+    decoder.Reset();
+    recognizer.clear();
+}
 
-    if (!hasResult && !gOcrProcess && now >= gNextOcrStartAt)
+bool OcrWorkerBackend::Start(size_t slotBytes, uint32_t nowMs)
+{
+    Shutdown();
+    size_t bytes = OcrIpcRingBytes(kOcrWorkerSlots, slotBytes);
+    char name[64];
+    _snprintf_s(name, sizeof(name), "Local\\highstakes_ocr_%lu_%d", (unsigned long)GetCurrentProcessId(), ++generation);
+    mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+        (DWORD)((uint64_t)bytes >> 32), (DWORD)bytes, name);
+    if (mapping)
+        view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+    if (!view || !ring.Create(view, bytes, kOcrWorkerSlots))
     {
-        // Start OCR only when the game window is currently foreground.
-        if (StartOcrProcess(now))
-        {
-            gNextOcrStartAt = now + gCfg.ocrIntervalMs;
-            in.pending = true;
-            gOcrStartFailureStreak = 0;
-            gOcrStartFailureWarned = false;
-        }
-        else
-        {
-            HWND hwnd = nullptr;
-            if (!GetGameForegroundWindow(hwnd))
-            {
-                // Ignore alt-tab / non-game foreground transitions.
-                return gDetectRuntime.inPoker;
-            }
-            gNextOcrStartAt = now + gCfg.ocrIntervalMs;
-            hasResult = true;
-            in.scanOk = false;
+        gLastOcrStartWinErr = GetLastError();
+        Shutdown();
+        return false;
+    }
 
-            gOcrStartFailureStreak++;
-            if (gOcrStartFailureStreak >= 3 && !gOcrStartFailureWarned)
-            {
-                gOcrStartFailureWarned = true;
-                bool usingPortableOcr = false;
-                std::string ocrExePath = ResolveOcrExecutablePath(usingPortableOcr);
-                Log("[OCR] WARNING: Failed to start OCR process repeatedly (reason=%s, winerr=%lu, bl=(%d,%d,%d,%d), tr=(%d,%d,%d,%d), tesseract='%s').",
-                    OcrStartFailReasonToString(gLastOcrStartFailReason),
-                    (unsigned long)gLastOcrStartWinErr,
-                    gCfg.ocrBottomLeftXPct, gCfg.ocrBottomLeftYPct, gCfg.ocrBottomLeftWPct, gCfg.ocrBottomLeftHPct,
-                    gCfg.ocrTopRightXPct, gCfg.ocrTopRightYPct, gCfg.ocrTopRightWPct, gCfg.ocrTopRightHPct,
-                    ocrExePath.c_str());
-                PostHudToast("OCR unavailable - check TesseractPath", HUD_TOAST_EVENT_OCR_UNAVAILABLE, now);
-            }
-        }
+    char args[128];
+    _snprintf_s(args, sizeof(args), "\" --shm %s --bytes %zu", name, bytes);
+    std::string cmd = "\"" + path + args;
+    // Its own folder, where its DLLs and tessdata live.
+    std::string dir = path.substr(0, path.find_last_of("\\/") + 1);
+    if (!LaunchWithPipes(cmd, dir.empty() ? nullptr : dir.c_str(), 0, process, toWorker, fromWorker))
+    {
+        gLastOcrStartWinErr = GetLastError();
+        Shutdown();
+        return false;
     }
+    launchMs = nowMs;
+    return true;
+}
 
-    if (!hasResult)
+void OcrWorkerBackend::Abandon(uint32_t nowMs)
+{
+    if (!pending)
+        return;
+    abandoned = pending;
+    abandonedMs = nowMs;
+    pending = 0;
+}
+
+void OcrWorkerBackend::StartFailed(uint32_t nowMs)
+{
+    startFailures++;
+    retryAtMs = (nowMs + kOcrWorkerRetryMs) | 1;
+    gLastOcrStartFailReason = OCR_START_FAIL_WORKER;
+    Log("[OCR] Worker '%s' failed to start err=%lu (%d/%d).",
+        path.c_str(), (unsigned long)gLastOcrStartWinErr, startFailures, kOcrWorkerMaxStartFailures);
+}
+
+bool OcrWorkerBackend::Send(int type, uint32_t requestId, const void* payload, size_t bytes)
+{
+    if (!toWorker)
+        return false;
+    wire.clear();
+    OcrIpcAppendMessage(wire, type, requestId, payload, bytes);
+    // Non-blocking, and the pipe holds far more than the one request in flight: a short write
+    // means the worker stopped reading.
+    DWORD n = 0;
+    return WriteFile(toWorker, wire.data(), (DWORD)wire.size(), &n, nullptr) && n == (DWORD)wire.size();
+}
+
+bool OcrWorkerBackend::Submit(OcrImage* rois, unsigned roiMask, uint32_t nowMs)
+{
+    if (Busy())
+        return false;
+
+    size_t need = OcrIpcSlotBytesFor(rois);
+    bool alive = process && WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    if (!alive || need > ring.SlotCapacity())
     {
-        gLastDetectInputs = in;
-        gLastDetectScore.gateReason = in.pending ? "pending" : "idle";
-        return gDetectRuntime.inPoker;
+        if (retryAtMs && (int32_t)(nowMs - retryAtMs) < 0)
+        {
+            gLastOcrStartFailReason = OCR_START_FAIL_WORKER;
+            return false;
+        }
+        // Headroom, so a slightly larger window does not restart the worker again.
+        if (!Start(need + need / 4, nowMs))
+        {
+            StartFailed(nowMs);
+            return false;
+        }
+        retryAtMs = 0;
     }
 
-    if (in.scanOk)
+    int slot = ring.FindFree();
+    if (slot < 0)
     {
-        bool fadeLikely = gCfg.ocrBlackoutGuardEnable &&
-            in.opacityHint <= gCfg.ocrBlackoutOpacityThreshold;
-        bool hasMoneyGlyph = in.rawText.find('$') != std::string::npos;
+        gLastOcrStartFailReason = OCR_START_FAIL_WORKER;  // abandoned cycles still hold every slot
+        return false;
+    }
+    uint32_t id = ++nextRequestId;
+    if (!id)
+        id = ++nextRequestId;
+    uint32_t slotIdx = (uint32_t)slot;
+    if (!ring.Write(slot, id, gCfg.ocrPsm, rois, roiMask))
+    {
+        gLastOcrStartFailReason = OCR_START_FAIL_WORKER;
+        return false;
+    }
+    if (!Send(OCR_IPC_SUBMIT, id, &slotIdx, sizeof(slotIdx)))
+    {
+        ring.Release(slot);
+        gLastOcrStartFailReason = OCR_START_FAIL_WORKER;
+        gLastOcrStartWinErr = GetLastError();
+        return false;
+    }
+    pending = id;
+    startMs = nowMs;
+    return true;
+}
 
-        // During blackout/fade with no visible money glyphs, keep last OCR money snapshot.
-        if (!(fadeLikely && !hasMoneyGlyph))
-            UpdateOcrMoneySnapshot(in.rawText, now);
+OcrPollResult OcrWorkerBackend::Poll(uint32_t nowMs, OcrCycleResult& out)
+{
+    if (!process)
+        return OCR_POLL_IDLE;
 
-        bool payoutMarkerNow = false;
-        if (in.rawText.find("wins") != std::string::npos ||
-            in.rawText.find("winner") != std::string::npos ||
-            in.rawText.find("collect") != std::string::npos ||
-            in.rawText.find("collected") != std::string::npos ||
-            in.rawText.find("payout") != std::string::npos)
+    inbox.clear();
+    DrainPipe(fromWorker, inbox);
+    decoder.Feed(inbox.data(), inbox.size());
+    bool done = false;
+    bool bad = false;
+    while (decoder.Next(msg))
+    {
+        if (msg.type == OCR_IPC_HELLO)
         {
-            payoutMarkerNow = true;
+            recognizer = msg.payload;
+            startFailures = 0;
+            Log("[OCR] Worker ready: %s (%u ms after launch).", recognizer.c_str(), (unsigned)(nowMs - launchMs));
         }
-        if (gOcrMoney.winsCents > 0)
-            payoutMarkerNow = true;
-        if (payoutMarkerNow)
+        else if (msg.type == OCR_IPC_RESULT && pending && msg.requestId == pending)
         {
-            gLastPayoutMarkerSeenAt = now;
-            DWORD holdMs = (DWORD)gCfg.ocrPayoutMarkerGraceMs + (DWORD)gCfg.ocrPayoutOutExtraMs;
-            DWORD holdUntil = now + holdMs;
-            if (holdUntil > gPayoutHoldUntilAt)
-                gPayoutHoldUntilAt = holdUntil;
+            done = OcrIpcDecodeResult(msg.payload, out);
+            bad = !done;
+            pending = 0;
+        }
+        else if (msg.type == OCR_IPC_RESULT && abandoned && msg.requestId == abandoned)
+            abandoned = 0;  // dropped; the worker is free again
+    }
+    if (done)
+        return OCR_POLL_DONE;
+
+    bool exited = WaitForSingleObject(process, 0) != WAIT_TIMEOUT;
+    bool mute = recognizer.empty() && (nowMs - launchMs) >= kOcrWorkerHelloTimeoutMs;
+    bool stuck = abandoned && (nowMs - abandonedMs) >= kOcrWorkerStuckMs;
+    if (bad || decoder.Broken() || exited || mute || stuck)
+    {
+        DWORD code = 0;
+        GetExitCodeProcess(process, &code);
+        Log("[OCR] Worker %s (exit=%lu); restarting with the next cycle.",
+            exited ? "exited" : (mute ? "never came up" : (stuck ? "hung on an abandoned request" : "stream out of step")),
+            (unsigned long)code);
+        bool neverUp = recognizer.empty();
+        bool wasPending = pending != 0 || bad;
+        Shutdown();
+        if (neverUp)
+        {
+            gLastOcrStartWinErr = code;
+            StartFailed(nowMs);
         }
+        return wasPending ? OCR_POLL_FAILED : OCR_POLL_IDLE;
     }
 
-    DetectionScore score = ComputeDetectionScore(in);
-    if (score.pokerAnchor || in.anchorHits > 0)
-        gLastPokerAnchorSeenAt = now;
+    if (!pending)
+        return OCR_POLL_IDLE;
+    if (recognizer.empty())
+        startMs = nowMs;  // the model load is not part of the cycle's timeout
+    if ((nowMs - startMs) >= (uint32_t)gCfg.ocrProcessTimeoutMs)
+    {
+        Abandon(nowMs);  // the late result is dropped when it arrives; its slot frees itself
+        return OCR_POLL_FAILED;
+    }
+    return OCR_POLL_PENDING;
+}
 
-    gLastDetectInputs = in;
-    gLastDetectScore = score;
-    bool inPoker = UpdatePokerStateMachine(gLastDetectScore, now);
-    gLastDetectScore.opacityHint = in.opacityHint;
+static OcrSpawnBackend gOcrSpawn;
+static OcrEngineBackend gOcrEngine;
+static OcrWorkerBackend gOcrWorker;
+static OcrBackend* gOcrBackend = &gOcrSpawn;
+static OcrImage gOcrRois[OCR_ROI_COUNT];  // capture buffers; Submit may swap them with the backend's
+static int64_t gOcrCycleStartUs = 0;
+static int64_t gOcrLastCycleUs = 0;       // capture to text, last completed cycle
+
+// ---------------- OCR dirty regions ----------------
+// Most cycles capture a HUD that has not changed since the last one. Each region's capture is
+// reduced to a TileSignature and compared with the signature of the frame its cached text came
+// from; only regions with a tile above DirtyNoise are submitted, the others keep their text.
+// Reuse is per region, not per tile band: recognizing a crop would cut text lines in half.
+// A cycle with no dirty region completes on the spot without touching the backend.
+static TileSignature gOcrTileRef[OCR_ROI_COUNT];      // frame the cached text was read from
+static TileSignature gOcrTileNow[OCR_ROI_COUNT];
+static TileSignature gOcrTilePending[OCR_ROI_COUNT];  // frame in flight; becomes Ref on success
+static std::string gOcrRoiText[OCR_ROI_COUNT];
+static bool gOcrRoiCached[OCR_ROI_COUNT] = {};
+static DWORD gOcrRoiTextAt[OCR_ROI_COUNT] = {};
+static unsigned gOcrCycleMask = 0;        // regions submitted by the cycle in flight
+static unsigned gOcrLastMask = 0;         // ... by the last started cycle (log)
+static bool gOcrReuseReady = false;       // started cycle needs no backend; collect it right away
+static int64_t gOcrLastHashUs = 0;
+static uint64_t gOcrReusedCycles = 0;
+static uint64_t gOcrReusedRegions = 0;
+
+static void ResetOcrRegionCache()
+{
+    for (int r = 0; r < OCR_ROI_COUNT; r++)
+    {
+        gOcrTileRef[r].Clear();
+        gOcrRoiText[r].clear();
+        gOcrRoiCached[r] = false;
+    }
+    gOcrCycleMask = 0;
+    gOcrReuseReady = false;
+}
 
-    if (gCfg.ocrLogEveryMs > 0 && now >= gNextOcrLogAt)
+// Regions this cycle has to recognize; the others keep gOcrRoiText. views = this cycle's grab.
+static unsigned PlanOcrRegions(DWORD now, const PixelView* views)
+{
+    if (!gCfg.ocrDirtySkip)
+        return kOcrAllRois;
+
+    int64_t t0 = QpcNowUs();
+    unsigned mask = 0;
+    for (int r = 0; r < OCR_ROI_COUNT; r++)
+    {
+        const PixelView& v = views[r];
+        gOcrTileNow[r].Compute(v.pixels, v.width, v.height, v.stride);
+        TileDiff diff;
+        gOcrTileNow[r].Compare(gOcrTileRef[r], gCfg.ocrDirtyNoise, diff);
+        bool stale = !gOcrRoiCached[r] || (now - gOcrRoiTextAt[r]) >= (DWORD)gCfg.ocrDirtyMaxReuseMs;
+        if (stale || diff.dirty > 0)
+            mask |= 1u << r;
+        else
+            gOcrReusedRegions++;
+    }
+    gOcrLastHashUs = QpcNowUs() - t0;
+    return mask;
+}
+
+static void StoreOcrRegionText(int r, bool ok, const std::string& text, DWORD now)
+{
+    gOcrRoiCached[r] = ok;
+    gOcrRoiText[r] = ok ? text : std::string();
+    if (!ok)
+        return;
+    gOcrRoiTextAt[r] = now;
+    if (gCfg.ocrDirtySkip)
+        gOcrTileRef[r].Swap(gOcrTilePending[r]);
+}
+
+// Called from LoadSettings. A loaded engine or a running worker is kept across reloads while its
+// path does not change.
+static void SelectOcrBackend()
+{
+    gOcrBackend->Cancel();
+    gOcrBackend = &gOcrSpawn;
+    ResetOcrRegionCache();
+    if (gCfg.ocrEngine != 1)
+        gOcrEngine.Shutdown();
+    if (gCfg.ocrEngine != 2)
+        gOcrWorker.Shutdown();
+
+    std::string why;
+    if (gCfg.ocrEngine == 1)
+    {
+        if (!gOcrEngine.Load(why))
+        {
+            Log("[OCR] Engine unavailable (%s); spawning tesseract per cycle.", why.c_str());
+            return;
+        }
+        gOcrBackend = &gOcrEngine;
+        Log("[OCR] Engine: in-process libtesseract %s ('%s', tessdata='%s').",
+            gTess.version ? gTess.version() : "?", gTess.path.c_str(),
+            gOcrEngineDataPath.empty() ? "TESSDATA_PREFIX" : gOcrEngineDataPath.c_str());
+    }
+    else if (gCfg.ocrEngine == 2)
     {
-        gNextOcrLogAt = now + (DWORD)gCfg.ocrLogEveryMs;
-        std::string snippet = in.scanOk ? OcrTextLogSnippet(gLastOcrText, 96) : "";
-        Log("[OCR] scanOk=%d pending=%d hits=%d anchors=%d score=%d gate=%s text='%s'",
-            in.scanOk ? 1 : 0,
-            in.pending ? 1 : 0,
-            in.keywordHits,
-            in.anchorHits,
-            gLastDetectScore.total,
-            gLastDetectScore.gateReason,
-            snippet.c_str());
-        Log("[PHASE] guess=%s conf=%.2f stableMs=%lu opacity=%.2f reasons=%s",
-            PokerPhaseToString(gLastDetectScore.guessPhase),
-            gLastDetectScore.confidence,
-            (unsigned long)gLastDetectScore.candidateStableMs,
-            gLastDetectScore.opacityHint,
-            gLastDetectScore.reasons.empty() ? "-" : gLastDetectScore.reasons.c_str());
-        if (in.scanOk)
+        if (!gOcrWorker.Configure(why))
         {
-            Log("[OCR$] pot=%d($%.2f) src=%s main=%d($%.2f) side=%d($%.2f) wins=%d($%.2f) player=%d($%.2f) npc=%s amounts=%s",
-                gOcrMoney.potCents, (double)gOcrMoney.potCents / 100.0,
-                OcrPotSourceToString(gOcrMoney.potSource),
-                gOcrMoney.mainPotCents, (double)gOcrMoney.mainPotCents / 100.0,
-                gOcrMoney.sidePotCents, (double)gOcrMoney.sidePotCents / 100.0,
-                gOcrMoney.winsCents, (double)gOcrMoney.winsCents / 100.0,
-                gOcrMoney.playerCents, (double)gOcrMoney.playerCents / 100.0,
-                OcrAmountListSnippet(gOcrMoney.npcAmountsCents).c_str(),
-                OcrAmountListSnippet(gOcrMoney.amountsCents).c_str());
+            Log("[OCR] Worker unavailable (%s); spawning tesseract per cycle.", why.c_str());
+            return;
         }
+        gOcrBackend = &gOcrWorker;
+        Log("[OCR] Worker: '%s' (%s).", gOcrWorker.Path().c_str(),
+            gOcrWorker.Recognizer().empty() ? "starts with the next cycle" : gOcrWorker.Recognizer().c_str());
     }
-
-    return inPoker;
 }
-// ---------------- Message + state ----------------
-static bool  gWasInPoker = false;
-static DWORD gNextAllowedEnterMsg = 0;
 
-// Detection throttling
-static DWORD gNextDetectAt = 0;
-static bool  gCachedInPoker = false;
-static PokerPhase gLastMoneyPhase = POKER_PHASE_OUT_OF_POKER;
-static int gSettlementSerial = 0;
-static int gLastPaidSettlementSerial = -1;
-static DWORD gNextAllowedPayoutAt = 0;
+// A backend that cannot come up is not retried forever; spawning still works.
+static void FallBackToSpawnIfBroken()
+{
+    if (gOcrBackend == &gOcrEngine && gOcrEngine.Broken())
+    {
+        Log("[OCR] Engine failed to initialize (tessdata='%s'); spawning tesseract per cycle.",
+            gOcrEngineDataPath.empty() ? "TESSDATA_PREFIX" : gOcrEngineDataPath.c_str());
+        gOcrBackend = &gOcrSpawn;
+    }
+    else if (gOcrBackend == &gOcrWorker && gOcrWorker.Broken())
+    {
+        Log("[OCR] Worker failed to start %d times in a row; spawning tesseract per cycle.", kOcrWorkerMaxStartFailures);
+        gOcrWorker.Shutdown();
+        gOcrBackend = &gOcrSpawn;
+    }
+}
 
-static void LoadSettings()
+static bool StartOcrCycle(DWORD now)
 {
-    // Main
-    gCfg.pokerRadius       = IniGetFloat("Main", "PokerRadius", 25.0f, gIniPath);
-    gCfg.msgDurationMs     = IniGetInt("Main", "MessageDurationMs", 1500, gIniPath);
-    gCfg.enterCooldownMs   = IniGetInt("Main", "EnterCooldownMs", 3000, gIniPath);
-    gCfg.checkIntervalMs   = IniGetInt("Main", "CheckIntervalMs", 100, gIniPath);
-    gCfg.debugOverlay      = IniGetInt("Main", "DebugOverlay", 0, gIniPath);
+    if (gOcrBackend->Busy())
+        return false;
 
-    // HUD
-    gDrawMethod = IniGetInt("HUD", "DrawMethod", 1, gIniPath);
-    gCfg.hudUiMode           = IniGetInt("HUD", "HUDUiMode", 2, gIniPath);
-    gCfg.hudToastEnabled     = IniGetInt("HUD", "ToastEnabled", 1, gIniPath);
-    gCfg.hudToastFallbackText = IniGetInt("HUD", "ToastFallbackText", 1, gIniPath);
-    gCfg.hudToastIconDict    = IniGetString("HUD", "ToastIconDict", "ITEMTYPE_TEXTURES", gIniPath);
-    gCfg.hudToastIcon        = IniGetString("HUD", "ToastIcon", "ITEMTYPE_CASH", gIniPath);
-    gCfg.hudToastColor       = IniGetString("HUD", "ToastColor", "COLOR_PURE_WHITE", gIniPath);
-    gCfg.hudToastDurationMs  = IniGetInt("HUD", "ToastDurationMs", 450, gIniPath);
-    gCfg.hudToastRetryMs     = IniGetInt("HUD", "ToastRetryMs", 4000, gIniPath);
-    gCfg.hudToastSoundSet    = IniGetString("HUD", "ToastSoundSet", "", gIniPath);
-    gCfg.hudToastSound       = IniGetString("HUD", "ToastSound", "", gIniPath);
-    gCfg.hudPanelX           = IniGetInt("HUD", "PanelX", 80, gIniPath);
-    gCfg.hudPanelY           = IniGetInt("HUD", "PanelY", 94, gIniPath);
-    gCfg.hudPanelLineStep    = IniGetFloat("HUD", "PanelLineStep", 2.2f, gIniPath);
-    gCfg.hudPanelMaxLines    = IniGetInt("HUD", "PanelMaxLines", 24, gIniPath);
-    gCfg.hudPanelAnchorBottom = IniGetInt("HUD", "PanelAnchorBottom", 1, gIniPath);
+    gLastOcrStartFailReason = OCR_START_FAIL_NONE;
+    gLastOcrStartWinErr = 0;
 
-    bool hudCfgClamped = false;
-    hudCfgClamped |= ClampSectionIntSetting("HUD", "DrawMethod", gDrawMethod, 1, 2);
-    hudCfgClamped |= ClampSectionIntSetting("HUD", "HUDUiMode", gCfg.hudUiMode, HUD_UI_MODE_LEGACY_TEXT, HUD_UI_MODE_ROCKSTAR_TOASTS_HYBRID);
-    hudCfgClamped |= ClampSectionIntSetting("HUD", "ToastEnabled", gCfg.hudToastEnabled, 0, 1);
-    hudCfgClamped |= ClampSectionIntSetting("HUD", "ToastFallbackText", gCfg.hudToastFallbackText, 0, 1);
-    hudCfgClamped |= ClampSectionIntSetting("HUD", "ToastDurationMs", gCfg.hudToastDurationMs, 100, 10000);
-    hudCfgClamped |= ClampSectionIntSetting("HUD", "ToastRetryMs", gCfg.hudToastRetryMs, 250, 60000);
-    hudCfgClamped |= ClampSectionIntSetting("HUD", "PanelX", gCfg.hudPanelX, 0, 100);
-    hudCfgClamped |= ClampSectionIntSetting("HUD", "PanelY", gCfg.hudPanelY, 0, 100);
-    hudCfgClamped |= ClampSectionIntSetting("HUD", "PanelMaxLines", gCfg.hudPanelMaxLines, 1, 128);
-    hudCfgClamped |= ClampSectionIntSetting("HUD", "PanelAnchorBottom", gCfg.hudPanelAnchorBottom, 0, 1);
-    if (gCfg.hudPanelLineStep < 0.8f)
+    HWND hwnd = nullptr;
+    if (!GetGameForegroundWindow(hwnd))
     {
-        gCfg.hudPanelLineStep = 0.8f;
-        hudCfgClamped = true;
-        Log("[CFG] WARNING: HUD.PanelLineStep too small. Clamped to 0.8.");
+        gLastOcrStartFailReason = OCR_START_FAIL_NO_FOREGROUND;
+        return false;
     }
-    else if (gCfg.hudPanelLineStep > 8.0f)
+    gOcrCycleStartUs = QpcNowUs();
+    if (!gFrameGrab.Grab(hwnd))
     {
-        gCfg.hudPanelLineStep = 8.0f;
-        hudCfgClamped = true;
-        Log("[CFG] WARNING: HUD.PanelLineStep too large. Clamped to 8.0.");
+        gLastOcrStartFailReason = OCR_START_FAIL_CAPTURE;
+        gLastOcrStartWinErr = gFrameGrab.WinErr();
+        return false;
     }
+    gPendingOpacityHint = ComputeOpacityHint(gFrameGrab.View(GRAB_ROI_OPACITY));
 
-    if (gCfg.hudToastIconDict.empty())
+    PixelView views[OCR_ROI_COUNT];
+    views[OCR_ROI_BOTTOM_LEFT] = gFrameGrab.View(GRAB_ROI_BOTTOM_LEFT);
+    views[OCR_ROI_TOP_RIGHT] = gFrameGrab.View(GRAB_ROI_TOP_RIGHT);
+    unsigned mask = PlanOcrRegions(now, views);
+    gOcrLastMask = mask;
+
+    // Only the regions the backend (or a dump) reads leave the grab surface.
+    unsigned copyMask = gCfg.ocrDumpArtifacts ? kOcrAllRois : mask;
+    for (int r = 0; r < OCR_ROI_COUNT; r++)
     {
-        gCfg.hudToastIconDict = "ITEMTYPE_TEXTURES";
-        hudCfgClamped = true;
-        Log("[CFG] WARNING: HUD.ToastIconDict was empty. Defaulted to ITEMTYPE_TEXTURES.");
+        if (copyMask & (1u << r))
+            CopyView(views[r], gOcrRois[r]);
     }
-    if (gCfg.hudToastIcon.empty())
+    if (gCfg.ocrDumpArtifacts)
     {
-        gCfg.hudToastIcon = "ITEMTYPE_CASH";
-        hudCfgClamped = true;
-        Log("[CFG] WARNING: HUD.ToastIcon was empty. Defaulted to ITEMTYPE_CASH.");
+        SaveBitmap24(gOcrBmpBottomLeftPath, gOcrRois[OCR_ROI_BOTTOM_LEFT]);
+        SaveBitmap24(gOcrBmpTopRightPath, gOcrRois[OCR_ROI_TOP_RIGHT]);
     }
-    if (gCfg.hudToastColor.empty())
+    if (mask == 0)
     {
-        gCfg.hudToastColor = "COLOR_PURE_WHITE";
-        hudCfgClamped = true;
-        Log("[CFG] WARNING: HUD.ToastColor was empty. Defaulted to COLOR_PURE_WHITE.");
+        gOcrReuseReady = true;
+        return true;
     }
-
-    gHudToastIconHash = MISC::GET_HASH_KEY(gCfg.hudToastIcon.c_str());
-    gHudToastColorHash = MISC::GET_HASH_KEY(gCfg.hudToastColor.c_str());
-    if (gHudToastIconHash == 0)
+    if (gCfg.ocrDirtySkip)
     {
-        gHudToastIconHash = MISC::GET_HASH_KEY("ITEMTYPE_CASH");
-        hudCfgClamped = true;
-        Log("[CFG] WARNING: HUD.ToastIcon hash was 0. Defaulted to ITEMTYPE_CASH.");
+        for (int r = 0; r < OCR_ROI_COUNT; r++)
+        {
+            if (mask & (1u << r))
+                gOcrTilePending[r].Swap(gOcrTileNow[r]);
+        }
     }
-    if (gHudToastColorHash == 0)
+
+    if (gOcrBackend->Submit(gOcrRois, mask, now))
     {
-        gHudToastColorHash = MISC::GET_HASH_KEY("COLOR_PURE_WHITE");
-        hudCfgClamped = true;
-        Log("[CFG] WARNING: HUD.ToastColor hash was 0. Defaulted to COLOR_PURE_WHITE.");
+        gOcrCycleMask = mask;
+        return true;
     }
+    FallBackToSpawnIfBroken();
+    return false;
+}
 
-    if (hudCfgClamped)
-        Log("[CFG] WARNING: Applied safety clamps to HUD settings.");
+static void FinishOcrInputs(DetectionInputs& out);
 
-    // OCR
+static bool TryCollectOcrResult(DWORD now, DetectionInputs& out, bool& hasResult)
+{
+    hasResult = false;
+    out = DetectionInputs{};
+
+    if (gOcrReuseReady)
+    {
+        gOcrReuseReady = false;
+        hasResult = true;
+        gOcrReusedCycles++;
+        FinishOcrInputs(out);
+        return true;
+    }
+
+    static OcrCycleResult cycle;
+    OcrPollResult poll = gOcrBackend->Poll(now, cycle);
+    if (poll == OCR_POLL_IDLE)
+        return false;
+    if (poll == OCR_POLL_PENDING)
+    {
+        out.pending = true;
+        return true;
+    }
+
+    hasResult = true;
+    if (poll == OCR_POLL_FAILED)
+    {
+        for (int r = 0; r < OCR_ROI_COUNT; r++)
+        {
+            if (gOcrCycleMask & (1u << r))
+                StoreOcrRegionText(r, false, std::string(), now);
+        }
+        out.scanOk = false;
+        FallBackToSpawnIfBroken();
+        return true;
+    }
+
+    if (gCfg.ocrDumpArtifacts)
+    {
+        SaveTextFile(gOcrTxtBottomLeftPath, cycle.text[OCR_ROI_BOTTOM_LEFT]);
+        SaveTextFile(gOcrTxtTopRightPath, cycle.text[OCR_ROI_TOP_RIGHT]);
+    }
+    for (int r = 0; r < OCR_ROI_COUNT; r++)
+    {
+        if (gOcrCycleMask & (1u << r))
+            StoreOcrRegionText(r, cycle.ok[r], cycle.text[r], now);
+    }
+    FinishOcrInputs(out);
+    return true;
+}
+
+// Detection inputs from the per-region texts, whether just recognized or reused.
+static void FinishOcrInputs(DetectionInputs& out)
+{
+    bool leftOk = gOcrRoiCached[OCR_ROI_BOTTOM_LEFT];
+    bool rightOk = gOcrRoiCached[OCR_ROI_TOP_RIGHT];
+    if (!leftOk && !rightOk)
+    {
+        out.scanOk = false;
+        gLastOcrText.clear();
+        return;
+    }
+    gOcrLastCycleUs = QpcNowUs() - gOcrCycleStartUs;
+
+    std::string text;
+    if (leftOk)
+        text += gOcrRoiText[OCR_ROI_BOTTOM_LEFT];
+    if (rightOk)
+    {
+        if (!text.empty())
+            text += "\n";
+        text += gOcrRoiText[OCR_ROI_TOP_RIGHT];
+    }
+
+    text = ToLowerAscii(text);
+    gLastOcrText = text;
+    out.rawText = text;
+    out.opacityHint = gPendingOpacityHint;
+    gLastOpacityHint = gPendingOpacityHint;
+    std::unordered_map<std::string, int> tokenCounts;
+    out.normalizedText = NormalizeOcrText(text, tokenCounts);
+    out.scanOk = true;
+    for (const auto& kw : gOcrKeywords)
+    {
+        if (!kw.empty() && text.find(kw) != std::string::npos)
+            out.keywordHits++;
+    }
+    const char* anchors[] = {
+        "blind","cards","community","pot","call","fold","raise","bet",
+        "check","turn","pair","straight","flush","wins","amount",
+        "called","raised","folded","checked","skip","auto"
+    };
+    for (const char* anchor : anchors)
+        if (HasToken(tokenCounts, anchor))
+            out.anchorHits++;
+    out.seenKeyword = (out.keywordHits > 0);
+}
+
+static DetectionScore ComputeDetectionScore(const DetectionInputs& in)
+{
+    DetectionScore out;
+    out.opacityHint = in.opacityHint;
+
+    if (!in.scanOk)
+    {
+        out.gateFail = true;
+        out.gateReason = "ocrFail";
+        return out;
+    }
+
+    out.total = in.keywordHits;
+    out.gateReason = in.seenKeyword ? "ocrHit" : "ocrMiss";
+
+    std::unordered_map<std::string, int> tokens;
+    std::string normalized = in.normalizedText;
+    if (normalized.empty())
+        normalized = NormalizeOcrText(in.rawText, tokens);
+    else
+        (void)NormalizeOcrText(normalized, tokens);
+
+    std::string padded = " " + normalized + " ";
+    auto hasToken = [&](const char* t) { return HasToken(tokens, t); };
+    auto hasPhrase = [&](const char* p) {
+        std::string needle = " ";
+        needle += p;
+        needle += " ";
+        return padded.find(needle) != std::string::npos;
+    };
+
+    std::vector<std::pair<float, std::string>> reasons;
+    auto add = [&](PokerPhase p, float w, const char* why) {
+        out.phaseScores[(size_t)p] += w;
+        reasons.emplace_back(w, why);
+    };
+
+    // Table idle / seated markers.
+    if (hasPhrase("small blind")) add(POKER_PHASE_TABLE_IDLE, 2.2f, "small blind");
+    if (hasPhrase("big blind")) add(POKER_PHASE_TABLE_IDLE, 2.2f, "big blind");
+    if (hasToken("blind")) add(POKER_PHASE_TABLE_IDLE, 0.8f, "blind");
+    if (hasToken("pot")) add(POKER_PHASE_TABLE_IDLE, 1.2f, "pot");
+
+    // Active decision markers.
+    if (hasPhrase("your cards")) add(POKER_PHASE_PLAYER_DECISION, 2.4f, "your cards");
+    if (hasPhrase("take your turn")) add(POKER_PHASE_PLAYER_DECISION, 2.6f, "take your turn");
+    if (hasToken("call") || hasToken("called")) add(POKER_PHASE_PLAYER_DECISION, 1.1f, "call");
+    if (hasToken("fold") || hasToken("folded")) add(POKER_PHASE_PLAYER_DECISION, 1.1f, "fold");
+    if (hasToken("check") || hasToken("checked")) add(POKER_PHASE_PLAYER_DECISION, 1.1f, "check");
+    if (hasToken("raise") || hasToken("raised")) add(POKER_PHASE_PLAYER_DECISION, 1.1f, "raise");
+    if (hasToken("bet")) add(POKER_PHASE_PLAYER_DECISION, 1.1f, "bet");
+    if (hasToken("amount")) add(POKER_PHASE_PLAYER_DECISION, 0.9f, "amount");
+
+    // Waiting/auto-action markers.
+    if (hasToken("skip")) add(POKER_PHASE_WAITING_ACTION, 2.0f, "skip");
+    if (hasPhrase("auto bet")) add(POKER_PHASE_WAITING_ACTION, 2.2f, "auto bet");
+    if (hasToken("leave")) add(POKER_PHASE_WAITING_ACTION, 0.7f, "leave");
+    if (hasToken("waiting")) add(POKER_PHASE_WAITING_ACTION, 1.0f, "waiting");
+
+    // Reveal markers.
+    if (hasToken("pair")) add(POKER_PHASE_SHOWDOWN_REVEAL, 1.6f, "pair");
+    if (hasToken("straight")) add(POKER_PHASE_SHOWDOWN_REVEAL, 1.8f, "straight");
+    if (hasToken("flush")) add(POKER_PHASE_SHOWDOWN_REVEAL, 1.8f, "flush");
+    if (hasToken("muck")) add(POKER_PHASE_SHOWDOWN_REVEAL, 1.6f, "muck");
+    if (hasToken("reveal")) add(POKER_PHASE_SHOWDOWN_REVEAL, 1.4f, "reveal");
+    if (hasPhrase("waiting to reveal")) add(POKER_PHASE_SHOWDOWN_REVEAL, 2.2f, "waiting reveal");
+    if (hasPhrase("community cards")) add(POKER_PHASE_SHOWDOWN_REVEAL, 1.2f, "community cards");
+
+    // Payout markers.
+    if (in.rawText.find("wins $") != std::string::npos) add(POKER_PHASE_PAYOUT_SETTLEMENT, 3.0f, "wins $");
+    if (hasToken("wins")) add(POKER_PHASE_PAYOUT_SETTLEMENT, 1.8f, "wins");
+
+    // Opacity hint weighting (secondary signal only).
+    if (gCfg.ocrOpacityHintEnable)
+    {
+        if (in.opacityHint >= 0.70f)
+        {
+            add(POKER_PHASE_PLAYER_DECISION, 0.9f, "opacity:active");
+            add(POKER_PHASE_TABLE_IDLE, 0.3f, "opacity:active");
+        }
+        else if (in.opacityHint <= 0.30f)
+        {
+            add(POKER_PHASE_WAITING_ACTION, 0.6f, "opacity:faded");
+            add(POKER_PHASE_SHOWDOWN_REVEAL, 0.6f, "opacity:faded");
+            add(POKER_PHASE_PAYOUT_SETTLEMENT, 0.4f, "opacity:faded");
+        }
+    }
+
+    int anchorCount = in.anchorHits;
+    if (anchorCount <= 0)
+    {
+        const char* anchors[] = {
+            "blind","cards","community","pot","call","fold","raise","bet",
+            "check","turn","pair","straight","flush","wins","amount",
+            "called","raised","folded","checked","skip","auto"
+        };
+        for (const char* a : anchors)
+            if (hasToken(a))
+                anchorCount++;
+    }
+    out.pokerAnchor = anchorCount > 0;
+
+    float outScore = 0.4f;
+    if (!out.pokerAnchor)
+        outScore += 2.2f;
+    if (normalized.size() < 6)
+        outScore += 0.7f;
+    if (in.opacityHint < 0.25f)
+        outScore += 0.3f;
+    if (hasToken("leave"))
+        outScore += 0.4f;
+    out.phaseScores[(size_t)POKER_PHASE_OUT_OF_POKER] += outScore;
+
+    out.reasons = BuildReasonSummary(reasons);
+    return out;
+}
+
+static bool IsPhaseTransitionAllowed(PokerPhase from, PokerPhase to)
+{
+    if (from == to)
+        return true;
+    if (to == POKER_PHASE_OUT_OF_POKER)
+        return true;
+    if (from == POKER_PHASE_OUT_OF_POKER)
+        return (to == POKER_PHASE_TABLE_IDLE || to == POKER_PHASE_PLAYER_DECISION || to == POKER_PHASE_WAITING_ACTION);
+    if (from == POKER_PHASE_SHOWDOWN_REVEAL)
+        return (to == POKER_PHASE_PAYOUT_SETTLEMENT || to == POKER_PHASE_TABLE_IDLE || to == POKER_PHASE_OUT_OF_POKER);
+    if (from == POKER_PHASE_PAYOUT_SETTLEMENT)
+        return (to == POKER_PHASE_TABLE_IDLE || to == POKER_PHASE_PLAYER_DECISION || to == POKER_PHASE_WAITING_ACTION || to == POKER_PHASE_OUT_OF_POKER);
+    return true;
+}
+
+static bool UpdatePokerStateMachine(DetectionScore& score, DWORD now)
+{
+    if (score.gateFail)
+    {
+        score.guessPhase = gDetectRuntime.phase;
+        score.confidence = gDetectRuntime.phaseConfidence;
+        score.candidateStableMs = 0;
+        return gDetectRuntime.inPoker;
+    }
+
+    gDetectRuntime.scoreHistory.push_back(score.phaseScores);
+    while ((int)gDetectRuntime.scoreHistory.size() > 6)
+        gDetectRuntime.scoreHistory.pop_front();
+
+    std::array<float, POKER_PHASE_COUNT> smooth{};
+    for (const auto& s : gDetectRuntime.scoreHistory)
+        for (size_t i = 0; i < smooth.size(); i++)
+            smooth[i] += s[i];
+
+    float histN = (float)gDetectRuntime.scoreHistory.size();
+    if (histN <= 0.0f)
+        histN = 1.0f;
+    for (size_t i = 0; i < smooth.size(); i++)
+        smooth[i] /= histN;
+
+    int bestIdx = 0;
+    float bestScore = smooth[0];
+    float scoreSum = smooth[0];
+    for (int i = 1; i < POKER_PHASE_COUNT; i++)
+    {
+        scoreSum += smooth[i];
+        if (smooth[i] > bestScore)
+        {
+            bestScore = smooth[i];
+            bestIdx = i;
+        }
+    }
+
+    if (scoreSum <= 0.0001f)
+        scoreSum = 0.0001f;
+
+    score.phaseScores = smooth;
+    score.guessPhase = (PokerPhase)bestIdx;
+    score.confidence = ClampFloat(bestScore / scoreSum, 0.0f, 1.0f);
+
+    if (gDetectRuntime.candidatePhase != score.guessPhase)
+    {
+        gDetectRuntime.candidatePhase = score.guessPhase;
+        gDetectRuntime.candidateSince = now;
+    }
+    score.candidateStableMs = (gDetectRuntime.candidateSince > 0) ? (now - gDetectRuntime.candidateSince) : 0;
+
+    bool shouldTransition = false;
+    if (score.guessPhase == POKER_PHASE_OUT_OF_POKER)
+    {
+        DWORD requiredOutStableMs = (DWORD)gCfg.ocrOutStableMs;
+        bool fadeLikely = gCfg.ocrBlackoutGuardEnable &&
+            score.opacityHint <= gCfg.ocrBlackoutOpacityThreshold;
+        if (fadeLikely)
+            requiredOutStableMs += (DWORD)gCfg.ocrBlackoutOutExtraMs;
+
+        bool recentPokerAnchor = gCfg.ocrBlackoutGuardEnable &&
+            gDetectRuntime.phase != POKER_PHASE_OUT_OF_POKER &&
+            gLastPokerAnchorSeenAt > 0 &&
+            (now - gLastPokerAnchorSeenAt) <= (DWORD)gCfg.ocrBlackoutAnchorGraceMs;
+        bool fadeHoldActive = fadeLikely &&
+            recentPokerAnchor &&
+            score.candidateStableMs < (requiredOutStableMs + (DWORD)gCfg.ocrBlackoutMaxHoldMs);
+
+        bool payoutHoldWindowActive = gCfg.ocrPayoutGuardEnable &&
+            gDetectRuntime.phase != POKER_PHASE_OUT_OF_POKER &&
+            gPayoutHoldUntilAt > now;
+        if (payoutHoldWindowActive)
+            requiredOutStableMs += (DWORD)gCfg.ocrPayoutOutExtraMs;
+        bool payoutHoldActive = payoutHoldWindowActive &&
+            score.candidateStableMs < requiredOutStableMs;
+
+        if (!score.pokerAnchor &&
+            score.confidence >= gCfg.ocrPhaseConfThreshold &&
+            score.candidateStableMs >= requiredOutStableMs &&
+            !fadeHoldActive &&
+            !payoutHoldActive)
+        {
+            shouldTransition = true;
+        }
+        else if (fadeHoldActive)
+        {
+            score.gateReason = "fadeHold";
+            if (score.reasons.empty())
+                score.reasons = "fadeHold";
+            else
+                score.reasons += ",fadeHold";
+        }
+        else if (payoutHoldActive)
+        {
+            score.gateReason = "payoutHold";
+            if (score.reasons.empty())
+                score.reasons = "payoutHold";
+            else
+                score.reasons += ",payoutHold";
+        }
+    }
+    else if (score.confidence >= gCfg.ocrPhaseConfThreshold &&
+        score.pokerAnchor &&
+        score.candidateStableMs >= (DWORD)gCfg.ocrPhaseStableMs &&
+        IsPhaseTransitionAllowed(gDetectRuntime.phase, score.guessPhase))
+    {
+        shouldTransition = true;
+    }
+
+    if (shouldTransition && gDetectRuntime.phase != score.guessPhase)
+    {
+        Log("[PHASE] transition %s -> %s conf=%.2f",
+            PokerPhaseToString(gDetectRuntime.phase),
+            PokerPhaseToString(score.guessPhase),
+            score.confidence);
+        gDetectRuntime.phase = score.guessPhase;
+        if (gDetectRuntime.phase == POKER_PHASE_PAYOUT_SETTLEMENT)
+        {
+            gLastPayoutMarkerSeenAt = now;
+            DWORD holdMs = (DWORD)gCfg.ocrPayoutMarkerGraceMs + (DWORD)gCfg.ocrPayoutOutExtraMs;
+            DWORD holdUntil = now + holdMs;
+            if (holdUntil > gPayoutHoldUntilAt)
+                gPayoutHoldUntilAt = holdUntil;
+        }
+    }
+
+    gDetectRuntime.phaseConfidence = score.confidence;
+    gDetectRuntime.inPoker = (gDetectRuntime.phase != POKER_PHASE_OUT_OF_POKER);
+    return gDetectRuntime.inPoker;
+}
+
+static bool ComputeInPokerV2(DWORD now)
+{
+    if (!gCfg.ocrEnabled)
+    {
+        gOcrBackend->Cancel();
+        ResetOcrRegionCache();
+        gFrameGrab.Release();
+        gOcrStartFailureStreak = 0;
+        gOcrStartFailureWarned = false;
+        return false;
+    }
+
+    DetectionInputs in;
+    bool hasResult = false;
+    TryCollectOcrResult(now, in, hasResult);
+
+    if (!hasResult && !gOcrBackend->Busy() && now >= gNextOcrStartAt)
+    {
+        // Start OCR only when the game window is currently foreground.
+        if (StartOcrCycle(now))
+        {
+            gNextOcrStartAt = now + gCfg.ocrIntervalMs;
+            in.pending = true;
+            gOcrStartFailureStreak = 0;
+            gOcrStartFailureWarned = false;
+            if (gOcrReuseReady)
+                TryCollectOcrResult(now, in, hasResult);  // nothing changed: same tick, no backend
+        }
+        else
+        {
+            HWND hwnd = nullptr;
+            if (!GetGameForegroundWindow(hwnd))
+            {
+                // Ignore alt-tab / non-game foreground transitions.
+                return gDetectRuntime.inPoker;
+            }
+            gNextOcrStartAt = now + gCfg.ocrIntervalMs;
+            hasResult = true;
+            in.scanOk = false;
+
+            gOcrStartFailureStreak++;
+            if (gOcrStartFailureStreak >= 3 && !gOcrStartFailureWarned)
+            {
+                gOcrStartFailureWarned = true;
+                bool usingPortableOcr = false;
+                std::string ocrExePath = ResolveOcrExecutablePath(usingPortableOcr);
+                Log("[OCR] WARNING: Failed to start OCR process repeatedly (reason=%s, winerr=%lu, bl=(%d,%d,%d,%d), tr=(%d,%d,%d,%d), tesseract='%s').",
+                    OcrStartFailReasonToString(gLastOcrStartFailReason),
+                    (unsigned long)gLastOcrStartWinErr,
+                    gCfg.ocrBottomLeftXPct, gCfg.ocrBottomLeftYPct, gCfg.ocrBottomLeftWPct, gCfg.ocrBottomLeftHPct,
+                    gCfg.ocrTopRightXPct, gCfg.ocrTopRightYPct, gCfg.ocrTopRightWPct, gCfg.ocrTopRightHPct,
+                    ocrExePath.c_str());
+                PostHudToast("OCR unavailable - check TesseractPath", HUD_TOAST_EVENT_OCR_UNAVAILABLE, now);
+            }
+        }
+    }
+
+    if (!hasResult)
+    {
+        gLastDetectInputs = in;
+        gLastDetectScore.gateReason = in.pending ? "pending" : "idle";
+        return gDetectRuntime.inPoker;
+    }
+
+    if (in.scanOk)
+    {
+        bool fadeLikely = gCfg.ocrBlackoutGuardEnable &&
+            in.opacityHint <= gCfg.ocrBlackoutOpacityThreshold;
+        bool hasMoneyGlyph = in.rawText.find('$') != std::string::npos;
+
+        // During blackout/fade with no visible money glyphs, keep last OCR money snapshot.
+        if (!(fadeLikely && !hasMoneyGlyph))
+            UpdateOcrMoneySnapshot(in.rawText, now);
+
+        bool payoutMarkerNow = false;
+        if (in.rawText.find("wins") != std::string::npos ||
+            in.rawText.find("winner") != std::string::npos ||
+            in.rawText.find("collect") != std::string::npos ||
+            in.rawText.find("collected") != std::string::npos ||
+            in.rawText.find("payout") != std::string::npos)
+        {
+            payoutMarkerNow = true;
+        }
+        if (gOcrMoney.winsCents > 0)
+            payoutMarkerNow = true;
+        if (payoutMarkerNow)
+        {
+            gLastPayoutMarkerSeenAt = now;
+            DWORD holdMs = (DWORD)gCfg.ocrPayoutMarkerGraceMs + (DWORD)gCfg.ocrPayoutOutExtraMs;
+            DWORD holdUntil = now + holdMs;
+            if (holdUntil > gPayoutHoldUntilAt)
+                gPayoutHoldUntilAt = holdUntil;
+        }
+    }
+
+    DetectionScore score = ComputeDetectionScore(in);
+    if (score.pokerAnchor || in.anchorHits > 0)
+        gLastPokerAnchorSeenAt = now;
+
+    gLastDetectInputs = in;
+    gLastDetectScore = score;
+    bool inPoker = UpdatePokerStateMachine(gLastDetectScore, now);
+    gLastDetectScore.opacityHint = in.opacityHint;
+
+    if (gCfg.ocrLogEveryMs > 0 && now >= gNextOcrLogAt)
+    {
+        gNextOcrLogAt = now + (DWORD)gCfg.ocrLogEveryMs;
+        std::string snippet = in.scanOk ? OcrTextLogSnippet(gLastOcrText, 96) : "";
+        Log("[OCR] backend=%s cycleMs=%.1f grabUs=%lld/%lld blits=%d surfKB=%zu dirty=%u hashUs=%lld reused=%llu/%llu scanOk=%d pending=%d hits=%d anchors=%d score=%d gate=%s text='%s'",
+            gOcrBackend->Name(), (double)gOcrLastCycleUs / 1000.0,
+            (long long)gFrameGrab.LastUs(), (long long)gFrameGrab.MaxUs(), gFrameGrab.Blits(),
+            gFrameGrab.SurfaceBytes() / 1024,
+            gOcrLastMask, (long long)gOcrLastHashUs,
+            (unsigned long long)gOcrReusedCycles, (unsigned long long)gOcrReusedRegions,
+            in.scanOk ? 1 : 0,
+            in.pending ? 1 : 0,
+            in.keywordHits,
+            in.anchorHits,
+            gLastDetectScore.total,
+            gLastDetectScore.gateReason,
+            snippet.c_str());
+        Log("[PHASE] guess=%s conf=%.2f stableMs=%lu opacity=%.2f reasons=%s",
+            PokerPhaseToString(gLastDetectScore.guessPhase),
+            gLastDetectScore.confidence,
+            (unsigned long)gLastDetectScore.candidateStableMs,
+            gLastDetectScore.opacityHint,
+            gLastDetectScore.reasons.empty() ? "-" : gLastDetectScore.reasons.c_str());
+        if (in.scanOk)
+        {
+            Log("[OCR$] pot=%d($%.2f) src=%s main=%d($%.2f) side=%d($%.2f) wins=%d($%.2f) player=%d($%.2f) npc=%s amounts=%s",
+                gOcrMoney.potCents, (double)gOcrMoney.potCents / 100.0,
+                OcrPotSourceToString(gOcrMoney.potSource),
+                gOcrMoney.mainPotCents, (double)gOcrMoney.mainPotCents / 100.0,
+                gOcrMoney.sidePotCents, (double)gOcrMoney.sidePotCents / 100.0,
+                gOcrMoney.winsCents, (double)gOcrMoney.winsCents / 100.0,
+                gOcrMoney.playerCents, (double)gOcrMoney.playerCents / 100.0,
+                OcrAmountListSnippet(gOcrMoney.npcAmountsCents).c_str(),
+                OcrAmountListSnippet(gOcrMoney.amountsCents).c_str());
+        }
+    }
+
+    return inPoker;
+}
+// ---------------- Message + state ----------------
+static bool  gWasInPoker = false;
+static DWORD gNextAllowedEnterMsg = 0;
+
+// Detection throttling
+static DWORD gNextDetectAt = 0;
+static bool  gCachedInPoker = false;
+static PokerPhase gLastMoneyPhase = POKER_PHASE_OUT_OF_POKER;
+static int gSettlementSerial = 0;
+static int gLastPaidSettlementSerial = -1;
+static DWORD gNextAllowedPayoutAt = 0;
+
+// ---------------- Global fault map ----------------
+static GlobalFaultMap gFaultMap;  // scanner-owned, like gMoneyCands
+static std::string gGameBuildKey;
+
+// Main module PE timestamp + image size; both change with every game patch.
+static std::string GetGameBuildKey()
+{
+    const unsigned char* base = (const unsigned char*)GetModuleHandleA(nullptr);
+    if (!base)
+        return "unknown";
+    const IMAGE_DOS_HEADER* dos = (const IMAGE_DOS_HEADER*)base;
+    if (dos->e_magic != IMAGE_DOS_SIGNATURE)
+        return "unknown";
+    const IMAGE_NT_HEADERS* nt = (const IMAGE_NT_HEADERS*)(base + dos->e_lfanew);
+    if (nt->Signature != IMAGE_NT_SIGNATURE)
+        return "unknown";
+    char key[32];
+    _snprintf_s(key, sizeof(key), "%08lX-%08lX",
+        (unsigned long)nt->FileHeader.TimeDateStamp, (unsigned long)nt->OptionalHeader.SizeOfImage);
+    return key;
+}
+
+// The scanner serializes the map at a wrap; the script thread writes it out, so the scan
+// worker never does file IO.
+static SRWLOCK gFaultMapSaveLock = SRWLOCK_INIT;
+static std::string gFaultMapSaveText;  // pending write, empty when none
+
+static void QueueFaultMapSave()
+{
+    std::string text = gFaultMap.Serialize(gGameBuildKey);
+    AcquireSRWLockExclusive(&gFaultMapSaveLock);
+    gFaultMapSaveText.swap(text);
+    ReleaseSRWLockExclusive(&gFaultMapSaveLock);
+}
+
+// Script thread.
+static void SaveFaultMap()
+{
+    std::string text;
+    AcquireSRWLockExclusive(&gFaultMapSaveLock);
+    text.swap(gFaultMapSaveText);
+    ReleaseSRWLockExclusive(&gFaultMapSaveLock);
+    if (text.empty())
+        return;
+    FILE* f = nullptr;
+    fopen_s(&f, gFaultMapPath, "wb");
+    if (!f)
+    {
+        Log("[MONEY] FaultMap: cannot write '%s'.", gFaultMapPath);
+        return;
+    }
+    fwrite(text.data(), 1, text.size(), f);
+    fclose(f);
+}
+
+// Resets the map to the configured scan range and seeds it from disk when the build matches.
+static void LoadFaultMap()
+{
+    gFaultMap.Reset(gCfg.moneyScanStart, gCfg.moneyScanEnd);
+    if (!gCfg.moneyFaultMapEnable)
+        return;
+    if (gGameBuildKey.empty())
+        gGameBuildKey = GetGameBuildKey();
+
+    std::string text;
+    if (!ReadTextFileAll(gFaultMapPath, text) || text.empty())
+    {
+        Log("[MONEY] FaultMap: nothing saved yet (build=%s).", gGameBuildKey.c_str());
+        return;
+    }
+    std::string why;
+    if (!gFaultMap.Deserialize(text, gGameBuildKey, why))
+    {
+        Log("[MONEY] FaultMap: ignoring saved map (%s), relearning for build=%s.", why.c_str(), gGameBuildKey.c_str());
+        return;
+    }
+    Log("[MONEY] FaultMap: loaded saved ranges for build=%s, re-probing them before skipping.", gGameBuildKey.c_str());
+}
+
+// Reads a few sample slots of the saved ranges per step (see GlobalFaultMap::NextProbe).
+static int ProbeSavedFaultRanges()
+{
+    constexpr int kProbesPerStep = 8;
+    if (!gFaultMap.Probing())
+        return 0;
+    int reads = 0;
+    int idx = 0;
+    while (reads < kProbesPerStep && gFaultMap.NextProbe(idx))
+    {
+        int value = 0;
+        uint64_t fault = 0;
+        ReadGlobalRange(idx, 1, &value, &fault);
+        gFaultMap.RecordProbe(idx, fault != 0);
+        reads++;
+    }
+    if (!gFaultMap.Probing())
+        Log("[MONEY] FaultMap: re-probed saved ranges, %d still bad (%d slots), %d dropped.",
+            gFaultMap.ProbeConfirmed(), gFaultMap.BadSlotCount(), gFaultMap.ProbeDropped());
+    if (!gFaultMap.Probing() && gFaultMap.ProbeDropped() > 0)
+        QueueFaultMapSave();
+    return reads;
+}
+
+// ---------------- Discovery hotspots ----------------
+// Buckets of the global index space where pot / stack globals were locked before. Their peaks
+// seed the discovery pass (see "Discovery"), so a global that moved a little between sessions
+// is found without sweeping the range. Weights decay once per game session.
+constexpr int kHotspotSeeds = 8;
+constexpr float kHotspotSessionDecay = 0.8f;
+
+static void SaveHotspots()
+{
+    std::string text = gHotspots.Serialize(gGameBuildKey);
+    FILE* f = nullptr;
+    fopen_s(&f, gHotspotsPath, "wb");
+    if (!f)
+    {
+        Log("[MONEY] Hotspots: cannot write '%s'.", gHotspotsPath);
+        return;
+    }
+    fwrite(text.data(), 1, text.size(), f);
+    fclose(f);
+}
+
+// Reads the histogram once per process; a settings reload only refreshes the seeds.
+static void LoadHotspots()
+{
+    static bool loaded = false;
+    if (!loaded)
+    {
+        loaded = true;
+        if (gGameBuildKey.empty())
+            gGameBuildKey = GetGameBuildKey();
+        std::string text;
+        std::string why;
+        if (!ReadTextFileAll(gHotspotsPath, text) || text.empty())
+            Log("[MONEY] Hotspots: nothing saved yet (build=%s).", gGameBuildKey.c_str());
+        else if (!gHotspots.Deserialize(text, gGameBuildKey, why))
+            Log("[MONEY] Hotspots: ignoring saved histogram (%s), relearning for build=%s.", why.c_str(), gGameBuildKey.c_str());
+        else
+        {
+            gHotspots.Decay(kHotspotSessionDecay);
+            Log("[MONEY] Hotspots: loaded %d buckets for build=%s.", gHotspots.BucketCount(), gGameBuildKey.c_str());
+        }
+    }
+    gHotspotSeeds.clear();
+    if (gCfg.moneyDiscoveryMode)
+        gHotspots.Peaks(kHotspotSeeds, gHotspotSeeds);
+}
+
+// Called on every pot / stack lock. The scanner sees the new seeds at its next hard reset.
+static void RecordHotspot(int idx)
+{
+    if (idx < 0)
+        return;
+    gHotspots.Record(idx, 1.0f);
+    if (gCfg.moneyDiscoveryMode)
+        gHotspots.Peaks(kHotspotSeeds, gHotspotSeeds);
+    SaveHotspots();
+}
+
+// ---------------- Session cache ----------------
+constexpr int kSessionCachePerCategory = 8;
+constexpr DWORD kSessionCacheSaveMs = 30000;  // refresh while a lock holds
+
+static SessionCacheKey GetSessionCacheKey()
+{
+    if (gGameBuildKey.empty())
+        gGameBuildKey = GetGameBuildKey();
+    SessionCacheKey key;
+    key.build = gGameBuildKey;
+    key.script = (uint32_t)MISC::GET_HASH_KEY(gCfg.moneySessionCacheScript.c_str());
+    return key;
+}
+
+static void LoadSessionCache()
+{
+    gSessionCacheEntries.clear();
+    if (!gCfg.moneySessionCache)
+        return;
+
+    SessionCacheKey key = GetSessionCacheKey();
+    std::string bytes;
+    if (!ReadTextFileAll(gSessionCachePath, bytes) || bytes.empty())
+    {
+        Log("[MONEY] SessionCache: nothing saved yet (build=%s script=%s).",
+            key.build.c_str(), gCfg.moneySessionCacheScript.c_str());
+        return;
+    }
+    std::string why;
+    if (!DeserializeSessionCache(bytes, key, gSessionCacheEntries, why))
+    {
+        Log("[MONEY] SessionCache: ignoring '%s' (%s).", gSessionCachePath, why.c_str());
+        return;
+    }
+    Log("[MONEY] SessionCache: loaded %d candidates for build=%s script=%s.",
+        (int)gSessionCacheEntries.size(), key.build.c_str(), gCfg.moneySessionCacheScript.c_str());
+}
+
+static void AppendSessionCacheEntry(std::vector<SessionCacheEntry>& out, const MoneyCandidateStore& s,
+    int slot, int category, int flags, DWORD now)
+{
+    size_t k = (size_t)slot;
+    for (const SessionCacheEntry& e : out)
+    {
+        if (e.idx == s.idx[k])
+            return;
+    }
+    SessionCacheEntry e;
+    e.idx = s.idx[k];
+    e.category = category;
+    e.flags = flags;
+    e.last = s.last[k];
+    e.ageMs = (int32_t)(std::min)((DWORD)(std::numeric_limits<int32_t>::max)(), now - s.firstSeenMs[k]);
+    e.changes = s.changes[k];
+    e.betStepMatches = s.betStepMatches[k];
+    e.betStepMismatches = s.betStepMismatches[k];
+    e.ocrAnyMatches = s.ocrAnyMatches[k];
+    e.ocrPotMatches = s.ocrPotMatches[k];
+    e.ocrPlayerMatches = s.ocrPlayerMatches[k];
+    e.ocrNpcMatches = s.ocrNpcMatches[k];
+    out.push_back(e);
+}
+
+// Locked globals first, then the best few of each ranking category. Only saves once
+// something is locked, so a weak session never overwrites a cache that worked.
+static void SaveSessionCache(const MoneyCandidateStore& s, const RankedSlots& ranked, DWORD now)
+{
+    if (!gCfg.moneySessionCache)
+        return;
+    gNextSessionCacheSaveAt = now + kSessionCacheSaveMs;
+
+    std::vector<SessionCacheEntry> entries;
+    int potSlot = s.Find(gAutoPotGlobal);
+    if (potSlot >= 0)
+        AppendSessionCacheEntry(entries, s, potSlot, RANK_CATEGORY_POT, SESSION_CACHE_LOCKED, now);
+    int playerSlot = s.Find(gAutoPlayerGlobal);
+    if (playerSlot >= 0)
+        AppendSessionCacheEntry(entries, s, playerSlot, RANK_CATEGORY_PLAYER, SESSION_CACHE_LOCKED, now);
+    if (entries.empty())
+        return;
+    for (int cat = 0; cat < RANK_CATEGORY_COUNT; cat++)
+    {
+        int n = (std::min)((int)ranked.slots[cat].size(), kSessionCachePerCategory);
+        for (int i = 0; i < n; i++)
+            AppendSessionCacheEntry(entries, s, ranked.slots[cat][(size_t)i], cat, 0, now);
+    }
+
+    std::string bytes = SerializeSessionCache(GetSessionCacheKey(), entries);
+    FILE* f = nullptr;
+    fopen_s(&f, gSessionCachePath, "wb");
+    if (!f)
+    {
+        Log("[MONEY] SessionCache: cannot write '%s'.", gSessionCachePath);
+        return;
+    }
+    fwrite(bytes.data(), 1, bytes.size(), f);
+    fclose(f);
+    gSessionCacheEntries.swap(entries);
+}
+
+// ---------------- Recorder ----------------
+// Binary time series of watch values, OCR money fields and phase changes for offline study
+// (decode with tools/trace_dump.cpp). One highstakes_rec_<time>.bin + .idx per game session;
+// samples are encoded into a preallocated block on the script thread and written block-wise.
+constexpr int kRecWatchBase = 0;
+constexpr int kRecMaxWatches = 32;
+constexpr int kRecOcrBase = 32;
+constexpr int kRecPhase = 48;
+constexpr int kRecChannels = 64;
+constexpr int kRecOcrNpcChannels = 5;
+
+enum RecordOcrChannel
+{
+    REC_OCR_POT = 0,
+    REC_OCR_MAIN_POT,
+    REC_OCR_SIDE_POT,
+    REC_OCR_WINS,
+    REC_OCR_PLAYER,
+    REC_OCR_NPC0,
+    REC_OCR_COUNT = REC_OCR_NPC0 + kRecOcrNpcChannels
+};
+
+static TraceWriter gRecorder;
+static FILE* gRecordFile = nullptr;
+static FILE* gRecordIdxFile = nullptr;
+static bool  gRecordOpenFailed = false;
+static DWORD gNextRecordFlushAt = 0;
+static int   gRecordOcrSampleId = -1;
+static int   gRecordOcrLast[REC_OCR_COUNT];
+static int   gRecordLastPhase = -1;
+
+static void DefineRecordChannels();
+
+static void CloseRecorder()
+{
+    gRecorder.Close();
+    if (gRecordFile)
+        fclose(gRecordFile);
+    if (gRecordIdxFile)
+        fclose(gRecordIdxFile);
+    gRecordFile = nullptr;
+    gRecordIdxFile = nullptr;
+}
+
+// DllMain, DLL_PROCESS_DETACH: the game is closing (or the plugin unloading), so the blocks
+// the recorder still holds are written and both files closed. Nothing else is torn down here.
+void HighStakesDetach()
+{
+    if (gRecorder.IsOpen())
+        CloseRecorder();
+}
+
+static void WriteRecordBlock(const uint8_t* block, size_t bytes, const TraceIndexEntry& e)
+{
+    uint8_t entry[kTraceIndexEntryBytes];
+    WriteTraceIndexEntry(entry, e);
+    if (fwrite(block, 1, bytes, gRecordFile) != bytes || fwrite(entry, 1, sizeof(entry), gRecordIdxFile) != sizeof(entry))
+        Log("[REC] Write failed at offset %llu.", (unsigned long long)e.offset);
+}
+
+// Opens the session's recording on first use; closes it when RecordEnable is turned off.
+static bool EnsureRecorder(DWORD now)
+{
+    if (!gCfg.moneyRecordEnable)
+    {
+        if (gRecorder.IsOpen())
+        {
+            Log("[REC] Closed after %llu samples (%llu bytes).", (unsigned long long)gRecorder.Samples(),
+                (unsigned long long)gRecorder.BytesWritten());
+            CloseRecorder();
+        }
+        return false;
+    }
+    if (gRecorder.IsOpen())
+        return true;
+    if (gRecordOpenFailed)
+        return false;
+
+    SYSTEMTIME st;
+    GetLocalTime(&st);
+    char path[MAX_PATH];
+    char idxPath[MAX_PATH];
+    _snprintf_s(path, sizeof(path), "%shighstakes_rec_%04u%02u%02u_%02u%02u%02u.bin", gGameDirPath,
+        st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond);
+    strcpy_s(idxPath, sizeof(idxPath), path);
+    strcpy_s(idxPath + strlen(idxPath) - 4, 5, ".idx");
+    fopen_s(&gRecordFile, path, "wb");
+    fopen_s(&gRecordIdxFile, idxPath, "wb");
+    if (!gRecordFile || !gRecordIdxFile)
+    {
+        Log("[REC] Cannot create '%s' / '%s'; recording disabled until restart.", path, idxPath);
+        CloseRecorder();
+        gRecordOpenFailed = true;
+        return false;
+    }
+    uint8_t header[kTraceFileHeaderBytes];
+    WriteTraceFileHeader(header, (uint32_t)now);
+    fwrite(header, 1, sizeof(header), gRecordFile);
+    uint8_t idxHeader[kTraceIndexHeaderBytes];
+    WriteTraceIndexHeader(idxHeader);
+    fwrite(idxHeader, 1, sizeof(idxHeader), gRecordIdxFile);
+
+    gRecorder.Open(kTraceFileHeaderBytes, kRecChannels, (size_t)gCfg.moneyRecordBlockKB * 1024, WriteRecordBlock);
+    DefineRecordChannels();
+    gRecordOcrSampleId = -1;
+    for (int& v : gRecordOcrLast)
+        v = -1;
+    gRecordLastPhase = -1;
+    gNextRecordFlushAt = now + (DWORD)gCfg.moneyRecordFlushMs;
+    Log("[REC] Recording to '%s' (block=%dKB flush=%dms).", path, gCfg.moneyRecordBlockKB, gCfg.moneyRecordFlushMs);
+    return true;
+}
+
+static void RecordOcrField(int field, int cents, DWORD now)
+{
+    if (cents == gRecordOcrLast[field])
+        return;
+    gRecordOcrLast[field] = cents;
+    gRecorder.Record((uint32_t)now, kRecOcrBase + field, cents);
+}
+
+// Script thread, every frame. Watch values are recorded by their change subscription.
+static void RecordTick(PokerPhase phase, DWORD now)
+{
+    if (!EnsureRecorder(now))
+        return;
+    if ((int)phase != gRecordLastPhase)
+    {
+        gRecordLastPhase = (int)phase;
+        gRecorder.Record((uint32_t)now, kRecPhase, (int)phase);
+    }
+    if (gOcrMoney.sampleId != gRecordOcrSampleId)
+    {
+        gRecordOcrSampleId = gOcrMoney.sampleId;
+        RecordOcrField(REC_OCR_POT, gOcrMoney.potCents, now);
+        RecordOcrField(REC_OCR_MAIN_POT, gOcrMoney.mainPotCents, now);
+        RecordOcrField(REC_OCR_SIDE_POT, gOcrMoney.sidePotCents, now);
+        RecordOcrField(REC_OCR_WINS, gOcrMoney.winsCents, now);
+        RecordOcrField(REC_OCR_PLAYER, gOcrMoney.playerCents, now);
+        for (int i = 0; i < kRecOcrNpcChannels; i++)
+        {
+            int cents = (i < (int)gOcrMoney.npcAmountsCents.size()) ? gOcrMoney.npcAmountsCents[(size_t)i] : -1;
+            RecordOcrField(REC_OCR_NPC0 + i, cents, now);
+        }
+    }
+    if (now >= gNextRecordFlushAt)
+    {
+        gNextRecordFlushAt = now + (DWORD)gCfg.moneyRecordFlushMs;
+        gRecorder.Flush();
+        fflush(gRecordFile);
+        fflush(gRecordIdxFile);
+    }
+}
+
+// Rebuilt on every settings load; subscriptions go with it.
+static void InitWatches()
+{
+    gWatches.Clear();
+    WatchSpec builtin;
+    builtin.periodMs = (uint32_t)gCfg.moneyWatchPeriodMs;
+    builtin.history = gCfg.moneyWatchHistory;
+    builtin.name = "Pot";
+    gWatches.Add(builtin);
+    for (int stack = 0; stack < kSeatArrayMaxSeats; stack++)
+    {
+        builtin.name = "Stk" + std::to_string(stack);
+        gWatches.Add(builtin);
+    }
+    for (const std::string& line : gCfg.moneyWatches)
+    {
+        WatchSpec spec;
+        spec.history = gCfg.moneyWatchHistory;
+        if (!ParseWatchSpec(line, spec))
+        {
+            Log("[CFG] Money watch '%s' ignored: expected name,index[,periodMs[,raw|cents|dollars]].", line.c_str());
+            continue;
+        }
+        gWatches.Add(spec);
+        Log("[CFG] Money watch: %s idx=%d periodMs=%u unit=%s", spec.name.c_str(), spec.idx,
+            (unsigned)spec.periodMs, WatchUnitName(spec.unit));
+    }
+
+    if (gCfg.moneyRecordEnable)
+    {
+        gWatches.Subscribe(-1, [](const WatchChange& c)
+        {
+            if (c.id < kRecMaxWatches)
+                gRecorder.Record(c.ms, kRecWatchBase + c.id, c.value);
+        });
+    }
+    if (gRecorder.IsOpen())
+        DefineRecordChannels();  // watch names may have changed
+    if (gCfg.moneyWatchLogChanges)
+    {
+        gWatches.Subscribe(-1, [](const WatchChange& c)
+        {
+            if (c.first)
+                Log("[WATCH] %s [%d] = %d", c.spec->name.c_str(), c.spec->idx, c.value);
+            else
+                Log("[WATCH] %s [%d] %d -> %d (%+d)", c.spec->name.c_str(), c.spec->idx, c.prev, c.value, c.value - c.prev);
+        });
+    }
+}
+
+static void DefineRecordChannels()
+{
+    for (int id = 0; id < gWatches.Count() && id < kRecMaxWatches; id++)
+        gRecorder.DefineChannel(kRecWatchBase + id, "watch." + gWatches.Spec(id).name);
+    static const char* kOcrNames[REC_OCR_NPC0] = { "ocr.pot", "ocr.mainPot", "ocr.sidePot", "ocr.wins", "ocr.player" };
+    for (int f = 0; f < REC_OCR_NPC0; f++)
+        gRecorder.DefineChannel(kRecOcrBase + f, kOcrNames[f]);
+    for (int i = 0; i < kRecOcrNpcChannels; i++)
+        gRecorder.DefineChannel(kRecOcrBase + REC_OCR_NPC0 + i, "ocr.npc" + std::to_string(i));
+    gRecorder.DefineChannel(kRecPhase, "phase");
+}
+
+// Value from this frame's watch read, if watch id is bound to idx, is read every frame
+// (WatchPeriodMs=0) and the read succeeded. Slower watches hold an older value, so the
+// caller reads the global itself.
+static bool TryGetWatchValue(int id, int idx, int& outVal)
+{
+    if (id >= gWatches.Count() || gWatches.Spec(id).idx != idx || gWatches.Spec(id).periodMs != 0)
+        return false;
+    int32_t v = 0;
+    bool fresh = false;
+    if (!gWatches.Value(id, v, &fresh) || !fresh)
+        return false;
+    outVal = v;
+    return true;
+}
+
+static void LoadSettings()
+{
+    // The worker reads gCfg without a lock, so it must not run while settings change.
+    StopScanWorker();
+    gScanWorkerStartFailed = false;
+
+    // Main
+    gCfg.pokerRadius       = IniGetFloat("Main", "PokerRadius", 25.0f, gIniPath);
+    gCfg.msgDurationMs     = IniGetInt("Main", "MessageDurationMs", 1500, gIniPath);
+    gCfg.enterCooldownMs   = IniGetInt("Main", "EnterCooldownMs", 3000, gIniPath);
+    gCfg.checkIntervalMs   = IniGetInt("Main", "CheckIntervalMs", 100, gIniPath);
+    gCfg.debugOverlay      = IniGetInt("Main", "DebugOverlay", 0, gIniPath);
+
+    // HUD
+    gDrawMethod = IniGetInt("HUD", "DrawMethod", 1, gIniPath);
+    gCfg.hudUiMode           = IniGetInt("HUD", "HUDUiMode", 2, gIniPath);
+    gCfg.hudToastEnabled     = IniGetInt("HUD", "ToastEnabled", 1, gIniPath);
+    gCfg.hudToastFallbackText = IniGetInt("HUD", "ToastFallbackText", 1, gIniPath);
+    gCfg.hudToastIconDict    = IniGetString("HUD", "ToastIconDict", "ITEMTYPE_TEXTURES", gIniPath);
+    gCfg.hudToastIcon        = IniGetString("HUD", "ToastIcon", "ITEMTYPE_CASH", gIniPath);
+    gCfg.hudToastColor       = IniGetString("HUD", "ToastColor", "COLOR_PURE_WHITE", gIniPath);
+    gCfg.hudToastDurationMs  = IniGetInt("HUD", "ToastDurationMs", 450, gIniPath);
+    gCfg.hudToastRetryMs     = IniGetInt("HUD", "ToastRetryMs", 4000, gIniPath);
+    gCfg.hudToastSoundSet    = IniGetString("HUD", "ToastSoundSet", "", gIniPath);
+    gCfg.hudToastSound       = IniGetString("HUD", "ToastSound", "", gIniPath);
+    gCfg.hudPanelX           = IniGetInt("HUD", "PanelX", 80, gIniPath);
+    gCfg.hudPanelY           = IniGetInt("HUD", "PanelY", 94, gIniPath);
+    gCfg.hudPanelLineStep    = IniGetFloat("HUD", "PanelLineStep", 2.2f, gIniPath);
+    gCfg.hudPanelMaxLines    = IniGetInt("HUD", "PanelMaxLines", 24, gIniPath);
+    gCfg.hudPanelAnchorBottom = IniGetInt("HUD", "PanelAnchorBottom", 1, gIniPath);
+
+    bool hudCfgClamped = false;
+    hudCfgClamped |= ClampSectionIntSetting("HUD", "DrawMethod", gDrawMethod, 1, 2);
+    hudCfgClamped |= ClampSectionIntSetting("HUD", "HUDUiMode", gCfg.hudUiMode, HUD_UI_MODE_LEGACY_TEXT, HUD_UI_MODE_ROCKSTAR_TOASTS_HYBRID);
+    hudCfgClamped |= ClampSectionIntSetting("HUD", "ToastEnabled", gCfg.hudToastEnabled, 0, 1);
+    hudCfgClamped |= ClampSectionIntSetting("HUD", "ToastFallbackText", gCfg.hudToastFallbackText, 0, 1);
+    hudCfgClamped |= ClampSectionIntSetting("HUD", "ToastDurationMs", gCfg.hudToastDurationMs, 100, 10000);
+    hudCfgClamped |= ClampSectionIntSetting("HUD", "ToastRetryMs", gCfg.hudToastRetryMs, 250, 60000);
+    hudCfgClamped |= ClampSectionIntSetting("HUD", "PanelX", gCfg.hudPanelX, 0, 100);
+    hudCfgClamped |= ClampSectionIntSetting("HUD", "PanelY", gCfg.hudPanelY, 0, 100);
+    hudCfgClamped |= ClampSectionIntSetting("HUD", "PanelMaxLines", gCfg.hudPanelMaxLines, 1, 128);
+    hudCfgClamped |= ClampSectionIntSetting("HUD", "PanelAnchorBottom", gCfg.hudPanelAnchorBottom, 0, 1);
+    if (gCfg.hudPanelLineStep < 0.8f)
+    {
+        gCfg.hudPanelLineStep = 0.8f;
+        hudCfgClamped = true;
+        Log("[CFG] WARNING: HUD.PanelLineStep too small. Clamped to 0.8.");
+    }
+    else if (gCfg.hudPanelLineStep > 8.0f)
+    {
+        gCfg.hudPanelLineStep = 8.0f;
+        hudCfgClamped = true;
+        Log("[CFG] WARNING: HUD.PanelLineStep too large. Clamped to 8.0.");
+    }
+
+    if (gCfg.hudToastIconDict.empty())
+    {
+        gCfg.hudToastIconDict = "ITEMTYPE_TEXTURES";
+        hudCfgClamped = true;
+        Log("[CFG] WARNING: HUD.ToastIconDict was empty. Defaulted to ITEMTYPE_TEXTURES.");
+    }
+    if (gCfg.hudToastIcon.empty())
+    {
+        gCfg.hudToastIcon = "ITEMTYPE_CASH";
+        hudCfgClamped = true;
+        Log("[CFG] WARNING: HUD.ToastIcon was empty. Defaulted to ITEMTYPE_CASH.");
+    }
+    if (gCfg.hudToastColor.empty())
+    {
+        gCfg.hudToastColor = "COLOR_PURE_WHITE";
+        hudCfgClamped = true;
+        Log("[CFG] WARNING: HUD.ToastColor was empty. Defaulted to COLOR_PURE_WHITE.");
+    }
+
+    gHudToastIconHash = MISC::GET_HASH_KEY(gCfg.hudToastIcon.c_str());
+    gHudToastColorHash = MISC::GET_HASH_KEY(gCfg.hudToastColor.c_str());
+    if (gHudToastIconHash == 0)
+    {
+        gHudToastIconHash = MISC::GET_HASH_KEY("ITEMTYPE_CASH");
+        hudCfgClamped = true;
+        Log("[CFG] WARNING: HUD.ToastIcon hash was 0. Defaulted to ITEMTYPE_CASH.");
+    }
+    if (gHudToastColorHash == 0)
+    {
+        gHudToastColorHash = MISC::GET_HASH_KEY("COLOR_PURE_WHITE");
+        hudCfgClamped = true;
+        Log("[CFG] WARNING: HUD.ToastColor hash was 0. Defaulted to COLOR_PURE_WHITE.");
+    }
+
+    if (hudCfgClamped)
+        Log("[CFG] WARNING: Applied safety clamps to HUD settings.");
+
+    // OCR
     gCfg.ocrEnabled            = IniGetInt("OCR", "Enabled", 1, gIniPath);
     gCfg.ocrIntervalMs         = IniGetInt("OCR", "IntervalMs", 1000, gIniPath);
     gCfg.ocrProcessTimeoutMs   = IniGetInt("OCR", "ProcessTimeoutMs", 2000, gIniPath);
@@ -2772,594 +5020,2241 @@ static void LoadSettings()
     gCfg.ocrPayoutOutExtraMs = IniGetInt("OCR", "PayoutOutExtraMs", 5000, gIniPath);
     gCfg.ocrPlayerNameHint    = IniGetString("OCR", "PlayerNameHint", "arthur", gIniPath);
     gCfg.ocrTesseractPath      = IniGetString("OCR", "TesseractPath", "tesseract", gIniPath);
+    gCfg.ocrEngine             = IniGetInt("OCR", "Engine", 1, gIniPath);
+    gCfg.ocrTesseractDll       = IniGetString("OCR", "TesseractDll", "", gIniPath);
+    gCfg.ocrWorkerPath         = IniGetString("OCR", "WorkerPath", "highstakes_ocr\\highstakes_ocr.exe", gIniPath);
+    gCfg.ocrGrabSingleBlit     = IniGetInt("OCR", "GrabSingleBlit", GRAB_MODE_AUTO, gIniPath);
+    gCfg.ocrDirtySkip          = IniGetInt("OCR", "DirtySkip", 1, gIniPath);
+    gCfg.ocrDirtyNoise         = IniGetInt("OCR", "DirtyNoise", 3, gIniPath);
+    gCfg.ocrDirtyMaxReuseMs    = IniGetInt("OCR", "DirtyMaxReuseMs", 5000, gIniPath);
     gCfg.ocrKeywords           = IniGetString("OCR", "Keywords", "poker,ante,call,fold,raise,check,bet,pot,blind,cards,community,turn", gIniPath);
 
-    gCfg.ocrEnabled            = ClampInt(gCfg.ocrEnabled, 0, 1);
-    gCfg.ocrIntervalMs         = ClampInt(gCfg.ocrIntervalMs, 200, 30000);
-    gCfg.ocrProcessTimeoutMs   = ClampInt(gCfg.ocrProcessTimeoutMs, 250, 10000);
-    gCfg.ocrBottomLeftXPct     = ClampInt(gCfg.ocrBottomLeftXPct, 0, 100);
-    gCfg.ocrBottomLeftYPct     = ClampInt(gCfg.ocrBottomLeftYPct, 0, 100);
-    gCfg.ocrBottomLeftWPct     = ClampInt(gCfg.ocrBottomLeftWPct, 1, 100);
-    gCfg.ocrBottomLeftHPct     = ClampInt(gCfg.ocrBottomLeftHPct, 1, 100);
-    gCfg.ocrTopRightXPct       = ClampInt(gCfg.ocrTopRightXPct, 0, 100);
-    gCfg.ocrTopRightYPct       = ClampInt(gCfg.ocrTopRightYPct, 0, 100);
-    gCfg.ocrTopRightWPct       = ClampInt(gCfg.ocrTopRightWPct, 1, 100);
-    gCfg.ocrTopRightHPct       = ClampInt(gCfg.ocrTopRightHPct, 1, 100);
-    gCfg.ocrPsm                = ClampInt(gCfg.ocrPsm, 3, 13);
-    gCfg.ocrDebugReasonOverlay = 0;
-    gCfg.ocrLogEveryMs         = ClampInt(gCfg.ocrLogEveryMs, 0, 60000);
-    gCfg.ocrDumpArtifacts      = ClampInt(gCfg.ocrDumpArtifacts, 0, 1);
-    gCfg.ocrPhaseStableMs      = ClampInt(gCfg.ocrPhaseStableMs, 250, 15000);
-    gCfg.ocrOutStableMs        = ClampInt(gCfg.ocrOutStableMs, 500, 30000);
-    gCfg.ocrOpacityHintEnable  = ClampInt(gCfg.ocrOpacityHintEnable, 0, 1);
-    gCfg.ocrOpacityRoiXPct     = ClampInt(gCfg.ocrOpacityRoiXPct, 0, 100);
-    gCfg.ocrOpacityRoiYPct     = ClampInt(gCfg.ocrOpacityRoiYPct, 0, 100);
-    gCfg.ocrOpacityRoiWPct     = ClampInt(gCfg.ocrOpacityRoiWPct, 1, 100);
-    gCfg.ocrOpacityRoiHPct     = ClampInt(gCfg.ocrOpacityRoiHPct, 1, 100);
-    gCfg.ocrBlackoutGuardEnable = ClampInt(gCfg.ocrBlackoutGuardEnable, 0, 1);
-    gCfg.ocrBlackoutAnchorGraceMs = ClampInt(gCfg.ocrBlackoutAnchorGraceMs, 0, 60000);
-    gCfg.ocrBlackoutOutExtraMs = ClampInt(gCfg.ocrBlackoutOutExtraMs, 0, 30000);
-    gCfg.ocrBlackoutMaxHoldMs = ClampInt(gCfg.ocrBlackoutMaxHoldMs, 0, 30000);
-    gCfg.ocrPayoutGuardEnable = ClampInt(gCfg.ocrPayoutGuardEnable, 0, 1);
-    gCfg.ocrPayoutMarkerGraceMs = ClampInt(gCfg.ocrPayoutMarkerGraceMs, 0, 60000);
-    gCfg.ocrPayoutOutExtraMs = ClampInt(gCfg.ocrPayoutOutExtraMs, 0, 30000);
-    gCfg.ocrPhaseConfThreshold = ClampFloat(gCfg.ocrPhaseConfThreshold, 0.20f, 0.95f);
-    gCfg.ocrOpacityLow         = ClampFloat(gCfg.ocrOpacityLow, 0.0f, 255.0f);
-    gCfg.ocrOpacityHigh        = ClampFloat(gCfg.ocrOpacityHigh, 0.0f, 255.0f);
-    gCfg.ocrBlackoutOpacityThreshold = ClampFloat(gCfg.ocrBlackoutOpacityThreshold, 0.00f, 1.00f);
-    gCfg.ocrPlayerNameHint = ToLowerAscii(TrimAscii(gCfg.ocrPlayerNameHint));
-    if (gCfg.ocrOpacityHigh <= gCfg.ocrOpacityLow + 0.1f)
-        gCfg.ocrOpacityHigh = gCfg.ocrOpacityLow + 0.1f;
+    gCfg.ocrEnabled            = ClampInt(gCfg.ocrEnabled, 0, 1);
+    gCfg.ocrIntervalMs         = ClampInt(gCfg.ocrIntervalMs, 200, 30000);
+    gCfg.ocrProcessTimeoutMs   = ClampInt(gCfg.ocrProcessTimeoutMs, 250, 10000);
+    gCfg.ocrBottomLeftXPct     = ClampInt(gCfg.ocrBottomLeftXPct, 0, 100);
+    gCfg.ocrBottomLeftYPct     = ClampInt(gCfg.ocrBottomLeftYPct, 0, 100);
+    gCfg.ocrBottomLeftWPct     = ClampInt(gCfg.ocrBottomLeftWPct, 1, 100);
+    gCfg.ocrBottomLeftHPct     = ClampInt(gCfg.ocrBottomLeftHPct, 1, 100);
+    gCfg.ocrTopRightXPct       = ClampInt(gCfg.ocrTopRightXPct, 0, 100);
+    gCfg.ocrTopRightYPct       = ClampInt(gCfg.ocrTopRightYPct, 0, 100);
+    gCfg.ocrTopRightWPct       = ClampInt(gCfg.ocrTopRightWPct, 1, 100);
+    gCfg.ocrTopRightHPct       = ClampInt(gCfg.ocrTopRightHPct, 1, 100);
+    gCfg.ocrPsm                = ClampInt(gCfg.ocrPsm, 3, 13);
+    gCfg.ocrDebugReasonOverlay = 0;
+    gCfg.ocrLogEveryMs         = ClampInt(gCfg.ocrLogEveryMs, 0, 60000);
+    gCfg.ocrDumpArtifacts      = ClampInt(gCfg.ocrDumpArtifacts, 0, 1);
+    gCfg.ocrEngine             = ClampInt(gCfg.ocrEngine, 0, 2);
+    gCfg.ocrGrabSingleBlit     = ClampInt(gCfg.ocrGrabSingleBlit, GRAB_MODE_PER_ROI, GRAB_MODE_AUTO);
+    gCfg.ocrDirtySkip          = ClampInt(gCfg.ocrDirtySkip, 0, 1);
+    gCfg.ocrDirtyNoise         = ClampInt(gCfg.ocrDirtyNoise, 0, 64);
+    gCfg.ocrDirtyMaxReuseMs    = ClampInt(gCfg.ocrDirtyMaxReuseMs, 0, 600000);
+    gCfg.ocrPhaseStableMs      = ClampInt(gCfg.ocrPhaseStableMs, 250, 15000);
+    gCfg.ocrOutStableMs        = ClampInt(gCfg.ocrOutStableMs, 500, 30000);
+    gCfg.ocrOpacityHintEnable  = ClampInt(gCfg.ocrOpacityHintEnable, 0, 1);
+    gCfg.ocrOpacityRoiXPct     = ClampInt(gCfg.ocrOpacityRoiXPct, 0, 100);
+    gCfg.ocrOpacityRoiYPct     = ClampInt(gCfg.ocrOpacityRoiYPct, 0, 100);
+    gCfg.ocrOpacityRoiWPct     = ClampInt(gCfg.ocrOpacityRoiWPct, 1, 100);
+    gCfg.ocrOpacityRoiHPct     = ClampInt(gCfg.ocrOpacityRoiHPct, 1, 100);
+    gCfg.ocrBlackoutGuardEnable = ClampInt(gCfg.ocrBlackoutGuardEnable, 0, 1);
+    gCfg.ocrBlackoutAnchorGraceMs = ClampInt(gCfg.ocrBlackoutAnchorGraceMs, 0, 60000);
+    gCfg.ocrBlackoutOutExtraMs = ClampInt(gCfg.ocrBlackoutOutExtraMs, 0, 30000);
+    gCfg.ocrBlackoutMaxHoldMs = ClampInt(gCfg.ocrBlackoutMaxHoldMs, 0, 30000);
+    gCfg.ocrPayoutGuardEnable = ClampInt(gCfg.ocrPayoutGuardEnable, 0, 1);
+    gCfg.ocrPayoutMarkerGraceMs = ClampInt(gCfg.ocrPayoutMarkerGraceMs, 0, 60000);
+    gCfg.ocrPayoutOutExtraMs = ClampInt(gCfg.ocrPayoutOutExtraMs, 0, 30000);
+    gCfg.ocrPhaseConfThreshold = ClampFloat(gCfg.ocrPhaseConfThreshold, 0.20f, 0.95f);
+    gCfg.ocrOpacityLow         = ClampFloat(gCfg.ocrOpacityLow, 0.0f, 255.0f);
+    gCfg.ocrOpacityHigh        = ClampFloat(gCfg.ocrOpacityHigh, 0.0f, 255.0f);
+    gCfg.ocrBlackoutOpacityThreshold = ClampFloat(gCfg.ocrBlackoutOpacityThreshold, 0.00f, 1.00f);
+    gCfg.ocrPlayerNameHint = ToLowerAscii(TrimAscii(gCfg.ocrPlayerNameHint));
+    if (gCfg.ocrOpacityHigh <= gCfg.ocrOpacityLow + 0.1f)
+        gCfg.ocrOpacityHigh = gCfg.ocrOpacityLow + 0.1f;
+
+    BuildOcrKeywordList();
+    SelectOcrBackend();
+    gNextOcrStartAt = 0;
+    gNextOcrLogAt = 0;
+    gPendingOpacityHint = 0.5f;
+    gLastOpacityHint = 0.5f;
+    gLastPokerAnchorSeenAt = 0;
+    gLastPayoutMarkerSeenAt = 0;
+    gPayoutHoldUntilAt = 0;
+    gOcrStartFailureStreak = 0;
+    gOcrStartFailureWarned = false;
+    gLastOcrStartFailReason = OCR_START_FAIL_NONE;
+    gLastOcrStartWinErr = 0;
+    gDetectRuntime = DetectionRuntime{};
+    gLastDetectInputs = DetectionInputs{};
+    gLastDetectScore = DetectionScore{};
+    gHudToastNativeFailed = false;
+    gHudToastNativeWarned = false;
+    gHudToastNativeRetryAt = 0;
+    gHudToastNativeFailCount = 0;
+    gLegacyHudMessage = "~COLOR_GOLD~Mod Online";
+    gLegacyHudMessageUntil = 0;
+    gOcrMoney = OcrMoneySnapshot{};
+    gAutoPotGlobal = -1;
+    gAutoPlayerGlobal = -1;
+    gLastMoneyPhase = POKER_PHASE_OUT_OF_POKER;
+    gSettlementSerial = 0;
+    gLastPaidSettlementSerial = -1;
+    gNextAllowedPayoutAt = 0;
+
+    // Money
+    gCfg.moneyOverlay           = IniGetInt("Money", "Overlay", 1, gIniPath);
+    gCfg.moneyScanEnable        = IniGetInt("Money", "ScanEnable", 1, gIniPath);
+    gCfg.moneyScanStart         = IniGetInt("Money", "ScanStart", 0, gIniPath);
+    gCfg.moneyScanEnd           = IniGetInt("Money", "ScanEnd", 100000, gIniPath);
+    gCfg.moneyScanBatch         = IniGetInt("Money", "ScanBatch", 16384, gIniPath);
+    gCfg.moneyScanIntervalMs    = IniGetInt("Money", "ScanIntervalMs", 20, gIniPath);
+    gCfg.moneyScanMaxReadsPerStep = IniGetInt("Money", "ScanMaxReadsPerStep", 16384, gIniPath);
+    gCfg.moneyDiscoveryMode     = IniGetInt("Money", "DiscoveryMode", 1, gIniPath);
+    gCfg.moneyDiscoverySeedRadius = IniGetInt("Money", "DiscoverySeedRadius", 8192, gIniPath);
+    gCfg.moneyDiscoveryCoarseStride = IniGetInt("Money", "DiscoveryCoarseStride", 4096, gIniPath);
+    gCfg.moneyDiscoveryRefineRadius = IniGetInt("Money", "DiscoveryRefineRadius", 1024, gIniPath);
+    gCfg.moneyRescanColdMaxAgeMs = IniGetInt("Money", "RescanColdMaxAgeMs", 2000, gIniPath);
+    gCfg.moneyScanMaxStepMs     = IniGetInt("Money", "ScanMaxStepMs", 4, gIniPath);
+    gCfg.moneyScanBudgetUs      = IniGetInt("Money", "ScanBudgetUs", 300, gIniPath);
+    gCfg.moneyScanWorker        = IniGetInt("Money", "ScanWorker", 0, gIniPath);
+    gCfg.moneyTypedScan         = IniGetInt("Money", "TypedScan", 0, gIniPath);
+    gCfg.moneySeatArrayEnable   = IniGetInt("Money", "SeatArrayEnable", 1, gIniPath);
+    gCfg.moneySeatArraySeats    = IniGetInt("Money", "SeatArraySeats", 6, gIniPath);
+    gCfg.moneySeatArrayMaxStride = IniGetInt("Money", "SeatArrayMaxStride", 64, gIniPath);
+    gCfg.moneySeatArrayMinSeats = IniGetInt("Money", "SeatArrayMinSeats", 4, gIniPath);
+    gCfg.moneySeatArrayMinMatches = IniGetInt("Money", "SeatArrayMinMatches", 2, gIniPath);
+    gCfg.moneySeatArrayStopScan = IniGetInt("Money", "SeatArrayStopScan", 1, gIniPath);
+    gCfg.moneyCorrEnable        = IniGetInt("Money", "CorrEnable", 1, gIniPath);
+    gCfg.moneyCorrLagMs         = IniGetInt("Money", "CorrLagMs", 2500, gIniPath);
+    gCfg.moneyCorrPoolSize      = IniGetInt("Money", "CorrPoolSize", 4096, gIniPath);
+    gCfg.moneyCorrRejectMisses  = IniGetInt("Money", "CorrRejectMisses", 2, gIniPath);
+    gCfg.moneyCorrLockSteps     = IniGetInt("Money", "CorrLockSteps", 3, gIniPath);
+    gCfg.moneyNarrowEnable      = IniGetInt("Money", "NarrowEnable", 1, gIniPath);
+    gCfg.moneyNarrowAuto        = IniGetInt("Money", "NarrowAuto", 0, gIniPath);
+    gCfg.moneyNarrowTarget      = IniGetInt("Money", "NarrowTarget", 0, gIniPath);
+    gCfg.moneyNarrowKeyStart    = IniGetInt("Money", "NarrowKeyStart", 0x60, gIniPath);
+    gCfg.moneyNarrowKeyEquals   = IniGetInt("Money", "NarrowKeyEquals", 0x61, gIniPath);
+    gCfg.moneyNarrowKeyDelta    = IniGetInt("Money", "NarrowKeyDelta", 0x62, gIniPath);
+    gCfg.moneyNarrowKeyUnchanged = IniGetInt("Money", "NarrowKeyUnchanged", 0x63, gIniPath);
+    gCfg.moneyNarrowKeyChanged  = IniGetInt("Money", "NarrowKeyChanged", 0x64, gIniPath);
+    gCfg.moneyValueMin          = IniGetInt("Money", "ValueMin", 1, gIniPath);
+    gCfg.moneyValueMax          = IniGetInt("Money", "ValueMax", 500000, gIniPath);
+    gCfg.moneyTopN              = IniGetInt("Money", "TopN", 10, gIniPath);
+    gCfg.moneyPruneMs           = IniGetInt("Money", "PruneMs", 300000, gIniPath);
+    gCfg.moneyCandidateCap      = IniGetInt("Money", "CandidateCap", 25000, gIniPath);
+    gCfg.moneyLogEnable         = IniGetInt("Money", "LogEnable", 1, gIniPath);
+    gCfg.moneyLogIntervalMs     = IniGetInt("Money", "LogIntervalMs", 3000, gIniPath);
+    gCfg.moneyLogTopN           = IniGetInt("Money", "LogTopN", 5, gIniPath);
+    gCfg.moneyLogOnlyOnChange   = IniGetInt("Money", "LogOnlyOnChange", 1, gIniPath);
+    gCfg.moneyLikelyMaxChangesPerSec = IniGetFloat("Money", "LikelyMaxChangesPerSec", 1.5f, gIniPath);
+    gCfg.moneyNpcTrackMax       = IniGetInt("Money", "NpcTrackMax", 5, gIniPath);
+    gCfg.moneyBetStepFilterEnable = IniGetInt("Money", "BetStepFilterEnable", 1, gIniPath);
+    gCfg.moneyBetStepDollars    = IniGetInt("Money", "BetStepDollars", 5, gIniPath);
+    gCfg.moneyBetMinDollars     = IniGetInt("Money", "BetMinDollars", 10, gIniPath);
+    gCfg.moneyExceptionLogCooldownMs = IniGetInt("Money", "ExceptionLogCooldownMs", 30000, gIniPath);
+    gCfg.moneySkipFaultRuns     = IniGetInt("Money", "SkipFaultRuns", 1, gIniPath);
+    gCfg.moneyFaultMapEnable    = IniGetInt("Money", "FaultMapEnable", 1, gIniPath);
+    gCfg.moneySessionCache      = IniGetInt("Money", "SessionCache", 1, gIniPath);
+    gCfg.moneySessionCacheScript = IniGetString("Money", "SessionCacheScript", "poker", gIniPath);
+    gCfg.moneyOcrMatchToleranceCents = IniGetInt("Money", "OcrMatchToleranceCents", 6, gIniPath);
+    gCfg.moneyAutoLockPot       = IniGetInt("Money", "AutoLockPot", 1, gIniPath);
+    gCfg.moneyAutoLockPotMinMatches = IniGetInt("Money", "AutoLockPotMinMatches", 10, gIniPath);
+    gCfg.moneyAutoLockPlayer    = IniGetInt("Money", "AutoLockPlayer", 1, gIniPath);
+    gCfg.moneyAutoLockPlayerMinMatches = IniGetInt("Money", "AutoLockPlayerMinMatches", 8, gIniPath);
+    gCfg.moneyOverlayMultiplier = IniGetFloat("Money", "OverlayMultiplier", 2.0f, gIniPath);
+    gCfg.moneyPayoutEnable      = IniGetInt("Money", "PayoutEnable", 0, gIniPath);
+    gCfg.moneyPayoutMultiplier  = IniGetFloat("Money", "PayoutMultiplier", 2.0f, gIniPath);
+    gCfg.moneyPayoutUseWinsAmount = IniGetInt("Money", "PayoutUseWinsAmount", 1, gIniPath);
+    gCfg.moneyPayoutFallbackToPot = IniGetInt("Money", "PayoutFallbackToPot", 1, gIniPath);
+    gCfg.moneyPayoutCooldownMs  = IniGetInt("Money", "PayoutCooldownMs", 6000, gIniPath);
+    gCfg.moneyPayoutMinPhaseConf = IniGetFloat("Money", "PayoutMinPhaseConf", 0.55f, gIniPath);
+
+    gCfg.potGlobal    = IniGetInt("Money", "PotGlobal", -1, gIniPath);
+    gCfg.stackGlobal0 = IniGetInt("Money", "StackGlobal0", -1, gIniPath);
+    gCfg.stackGlobal1 = IniGetInt("Money", "StackGlobal1", -1, gIniPath);
+    gCfg.stackGlobal2 = IniGetInt("Money", "StackGlobal2", -1, gIniPath);
+    gCfg.stackGlobal3 = IniGetInt("Money", "StackGlobal3", -1, gIniPath);
+    gCfg.stackGlobal4 = IniGetInt("Money", "StackGlobal4", -1, gIniPath);
+    gCfg.stackGlobal5 = IniGetInt("Money", "StackGlobal5", -1, gIniPath);
+    gCfg.moneyWatchPeriodMs   = IniGetInt("Money", "WatchPeriodMs", 0, gIniPath);
+    gCfg.moneyWatchHistory    = IniGetInt("Money", "WatchHistory", 32, gIniPath);
+    gCfg.moneyWatchLogChanges = IniGetInt("Money", "WatchLogChanges", 0, gIniPath);
+    gCfg.moneyRecordEnable    = IniGetInt("Money", "RecordEnable", 0, gIniPath);
+    gCfg.moneyRecordFlushMs   = IniGetInt("Money", "RecordFlushMs", 1000, gIniPath);
+    gCfg.moneyRecordBlockKB   = IniGetInt("Money", "RecordBlockKB", 64, gIniPath);
+    gCfg.moneyWatches.clear();
+    for (int i = 0; i < kMaxIniWatches; i++)
+    {
+        char key[16];
+        _snprintf_s(key, sizeof(key), "Watch%d", i);
+        std::string line = IniGetString("Money", key, "", gIniPath);
+        if (!line.empty())
+            gCfg.moneyWatches.push_back(line);
+    }
+
+    bool moneyCfgClamped = false;
+    moneyCfgClamped |= ClampIntSetting("ScanStart", gCfg.moneyScanStart, 0, std::numeric_limits<int>::max() - 1);
+    moneyCfgClamped |= ClampIntSetting("ScanEnd", gCfg.moneyScanEnd, 1, std::numeric_limits<int>::max());
+    moneyCfgClamped |= ClampIntSetting("ScanBatch", gCfg.moneyScanBatch, 1, 1000000);
+    moneyCfgClamped |= ClampIntSetting("ScanIntervalMs", gCfg.moneyScanIntervalMs, 1, 60000);
+    moneyCfgClamped |= ClampIntSetting("ScanMaxReadsPerStep", gCfg.moneyScanMaxReadsPerStep, 1, 1000000);
+    moneyCfgClamped |= ClampIntSetting("DiscoveryMode", gCfg.moneyDiscoveryMode, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("DiscoverySeedRadius", gCfg.moneyDiscoverySeedRadius, 0, 1000000);
+    moneyCfgClamped |= ClampIntSetting("DiscoveryCoarseStride", gCfg.moneyDiscoveryCoarseStride, 0, 1000000);
+    moneyCfgClamped |= ClampIntSetting("DiscoveryRefineRadius", gCfg.moneyDiscoveryRefineRadius, 0, 65536);
+    moneyCfgClamped |= ClampIntSetting("CandidateCap", gCfg.moneyCandidateCap, 0, 4000000);
+    moneyCfgClamped |= ClampIntSetting("RescanColdMaxAgeMs", gCfg.moneyRescanColdMaxAgeMs, 50, 600000);
+    moneyCfgClamped |= ClampIntSetting("ScanMaxStepMs", gCfg.moneyScanMaxStepMs, 1, 1000);
+    moneyCfgClamped |= ClampIntSetting("ScanBudgetUs", gCfg.moneyScanBudgetUs, 0, 1000000);
+    moneyCfgClamped |= ClampIntSetting("ScanWorker", gCfg.moneyScanWorker, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("TypedScan", gCfg.moneyTypedScan, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("SeatArrayEnable", gCfg.moneySeatArrayEnable, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("SeatArraySeats", gCfg.moneySeatArraySeats, 2, kSeatArrayMaxSeats);
+    moneyCfgClamped |= ClampIntSetting("SeatArrayMaxStride", gCfg.moneySeatArrayMaxStride, 1, 1024);
+    moneyCfgClamped |= ClampIntSetting("SeatArrayMinSeats", gCfg.moneySeatArrayMinSeats, 2, kSeatArrayMaxSeats);
+    moneyCfgClamped |= ClampIntSetting("SeatArrayMinMatches", gCfg.moneySeatArrayMinMatches, 1, 1000);
+    moneyCfgClamped |= ClampIntSetting("SeatArrayStopScan", gCfg.moneySeatArrayStopScan, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("CorrEnable", gCfg.moneyCorrEnable, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("CorrLagMs", gCfg.moneyCorrLagMs, 100, 30000);
+    moneyCfgClamped |= ClampIntSetting("CorrPoolSize", gCfg.moneyCorrPoolSize, 0, 262144);
+    moneyCfgClamped |= ClampIntSetting("CorrRejectMisses", gCfg.moneyCorrRejectMisses, 0, 255);
+    moneyCfgClamped |= ClampIntSetting("CorrLockSteps", gCfg.moneyCorrLockSteps, 0, 255);
+    moneyCfgClamped |= ClampIntSetting("WatchPeriodMs", gCfg.moneyWatchPeriodMs, 0, 60000);
+    moneyCfgClamped |= ClampIntSetting("WatchHistory", gCfg.moneyWatchHistory, 1, 4096);
+    moneyCfgClamped |= ClampIntSetting("WatchLogChanges", gCfg.moneyWatchLogChanges, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("RecordEnable", gCfg.moneyRecordEnable, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("RecordFlushMs", gCfg.moneyRecordFlushMs, 50, 60000);
+    moneyCfgClamped |= ClampIntSetting("RecordBlockKB", gCfg.moneyRecordBlockKB, 4, 4096);
+    moneyCfgClamped |= ClampIntSetting("NarrowEnable", gCfg.moneyNarrowEnable, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("NarrowAuto", gCfg.moneyNarrowAuto, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("NarrowTarget", gCfg.moneyNarrowTarget, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("NarrowKeyStart", gCfg.moneyNarrowKeyStart, 0, 255);
+    moneyCfgClamped |= ClampIntSetting("NarrowKeyEquals", gCfg.moneyNarrowKeyEquals, 0, 255);
+    moneyCfgClamped |= ClampIntSetting("NarrowKeyDelta", gCfg.moneyNarrowKeyDelta, 0, 255);
+    moneyCfgClamped |= ClampIntSetting("NarrowKeyUnchanged", gCfg.moneyNarrowKeyUnchanged, 0, 255);
+    moneyCfgClamped |= ClampIntSetting("NarrowKeyChanged", gCfg.moneyNarrowKeyChanged, 0, 255);
+    moneyCfgClamped |= ClampIntSetting("LogOnlyOnChange", gCfg.moneyLogOnlyOnChange, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("NpcTrackMax", gCfg.moneyNpcTrackMax, 0, 32);
+    moneyCfgClamped |= ClampIntSetting("BetStepFilterEnable", gCfg.moneyBetStepFilterEnable, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("BetStepDollars", gCfg.moneyBetStepDollars, 1, 1000);
+    moneyCfgClamped |= ClampIntSetting("BetMinDollars", gCfg.moneyBetMinDollars, 1, 100000);
+    moneyCfgClamped |= ClampIntSetting("ExceptionLogCooldownMs", gCfg.moneyExceptionLogCooldownMs, 0, 600000);
+    moneyCfgClamped |= ClampIntSetting("SkipFaultRuns", gCfg.moneySkipFaultRuns, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("FaultMapEnable", gCfg.moneyFaultMapEnable, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("SessionCache", gCfg.moneySessionCache, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("LogTopN", gCfg.moneyLogTopN, 0, 64);
+    moneyCfgClamped |= ClampIntSetting("OcrMatchToleranceCents", gCfg.moneyOcrMatchToleranceCents, 0, 2500);
+    moneyCfgClamped |= ClampIntSetting("AutoLockPot", gCfg.moneyAutoLockPot, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("AutoLockPotMinMatches", gCfg.moneyAutoLockPotMinMatches, 1, 1000000);
+    moneyCfgClamped |= ClampIntSetting("AutoLockPlayer", gCfg.moneyAutoLockPlayer, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("AutoLockPlayerMinMatches", gCfg.moneyAutoLockPlayerMinMatches, 1, 1000000);
+    moneyCfgClamped |= ClampIntSetting("PayoutEnable", gCfg.moneyPayoutEnable, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("PayoutUseWinsAmount", gCfg.moneyPayoutUseWinsAmount, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("PayoutFallbackToPot", gCfg.moneyPayoutFallbackToPot, 0, 1);
+    moneyCfgClamped |= ClampIntSetting("PayoutCooldownMs", gCfg.moneyPayoutCooldownMs, 250, 600000);
+
+    if (gCfg.moneyLikelyMaxChangesPerSec < 0.0f)
+    {
+        gCfg.moneyLikelyMaxChangesPerSec = 0.0f;
+        moneyCfgClamped = true;
+        Log("[CFG] WARNING: Money.LikelyMaxChangesPerSec was negative. Clamped to 0.");
+    }
+    else if (gCfg.moneyLikelyMaxChangesPerSec > 1000.0f)
+    {
+        gCfg.moneyLikelyMaxChangesPerSec = 1000.0f;
+        moneyCfgClamped = true;
+        Log("[CFG] WARNING: Money.LikelyMaxChangesPerSec too large. Clamped to 1000.");
+    }
+
+    if (gCfg.moneyOverlayMultiplier < 0.10f)
+    {
+        gCfg.moneyOverlayMultiplier = 0.10f;
+        moneyCfgClamped = true;
+        Log("[CFG] WARNING: Money.OverlayMultiplier too small. Clamped to 0.10.");
+    }
+    else if (gCfg.moneyOverlayMultiplier > 1000.0f)
+    {
+        gCfg.moneyOverlayMultiplier = 1000.0f;
+        moneyCfgClamped = true;
+        Log("[CFG] WARNING: Money.OverlayMultiplier too large. Clamped to 1000.");
+    }
+
+    if (gCfg.moneyBetMinDollars < gCfg.moneyBetStepDollars)
+    {
+        int oldMin = gCfg.moneyBetMinDollars;
+        gCfg.moneyBetMinDollars = gCfg.moneyBetStepDollars;
+        moneyCfgClamped = true;
+        Log("[CFG] WARNING: Money.BetMinDollars (%d) < BetStepDollars (%d). Clamped to %d.",
+            oldMin, gCfg.moneyBetStepDollars, gCfg.moneyBetMinDollars);
+    }
+
+    if (gCfg.moneyPayoutMultiplier < 1.0f)
+    {
+        gCfg.moneyPayoutMultiplier = 1.0f;
+        moneyCfgClamped = true;
+        Log("[CFG] WARNING: Money.PayoutMultiplier below 1.0. Clamped to 1.0.");
+    }
+    else if (gCfg.moneyPayoutMultiplier > 1000.0f)
+    {
+        gCfg.moneyPayoutMultiplier = 1000.0f;
+        moneyCfgClamped = true;
+        Log("[CFG] WARNING: Money.PayoutMultiplier too large. Clamped to 1000.");
+    }
+    gCfg.moneyPayoutMinPhaseConf = ClampFloat(gCfg.moneyPayoutMinPhaseConf, 0.20f, 0.99f);
+
+    if (gCfg.moneyScanEnd <= gCfg.moneyScanStart)
+    {
+        int oldEnd = gCfg.moneyScanEnd;
+        gCfg.moneyScanEnd = gCfg.moneyScanStart + 1;
+        moneyCfgClamped = true;
+        Log("[CFG] WARNING: Money.ScanEnd must be > ScanStart (%d <= %d). Clamped to %d.",
+            oldEnd, gCfg.moneyScanStart, gCfg.moneyScanEnd);
+    }
+
+    if (gCfg.moneyValueMax < gCfg.moneyValueMin)
+    {
+        int oldMax = gCfg.moneyValueMax;
+        gCfg.moneyValueMax = gCfg.moneyValueMin;
+        moneyCfgClamped = true;
+        Log("[CFG] WARNING: Money.ValueMax (%d) < ValueMin (%d). Clamped to %d.",
+            oldMax, gCfg.moneyValueMin, gCfg.moneyValueMax);
+    }
+
+    if (moneyCfgClamped)
+        Log("[CFG] WARNING: Applied safety clamps to Money settings.");
+    gCandidateRules = MakeCandidateRules();
+
+    // Log config
+    Log("[CFG] PokerRadius=%.2f MsgMs=%d CooldownMs=%d CheckIntervalMs=%d DebugOverlay=%d",
+        gCfg.pokerRadius, gCfg.msgDurationMs, gCfg.enterCooldownMs, gCfg.checkIntervalMs,
+        gCfg.debugOverlay);
+    Log("[CFG] OCR: Enabled=%d IntervalMs=%d ProcTimeoutMs=%d BL=(%d,%d,%d,%d) TR=(%d,%d,%d,%d) PSM=%d DebugReason=%d LogEveryMs=%d DumpArtifacts=%d PhaseStableMs=%d OutStableMs=%d PhaseConf=%.2f OpacityHint=%d OpacityROI=(%d,%d,%d,%d) OpacityRange=[%.1f..%.1f] BlackoutGuard=%d BlackoutOpacity<=%.2f BlackoutGraceMs=%d BlackoutOutExtraMs=%d BlackoutMaxHoldMs=%d PayoutGuard=%d PayoutGraceMs=%d PayoutOutExtraMs=%d PlayerNameHint='%s' Tesseract='%s' Keywords=%d",
+        gCfg.ocrEnabled, gCfg.ocrIntervalMs,
+        gCfg.ocrProcessTimeoutMs,
+        gCfg.ocrBottomLeftXPct, gCfg.ocrBottomLeftYPct, gCfg.ocrBottomLeftWPct, gCfg.ocrBottomLeftHPct,
+        gCfg.ocrTopRightXPct, gCfg.ocrTopRightYPct, gCfg.ocrTopRightWPct, gCfg.ocrTopRightHPct,
+        gCfg.ocrPsm, gCfg.ocrDebugReasonOverlay, gCfg.ocrLogEveryMs, gCfg.ocrDumpArtifacts,
+        gCfg.ocrPhaseStableMs, gCfg.ocrOutStableMs, gCfg.ocrPhaseConfThreshold,
+        gCfg.ocrOpacityHintEnable,
+        gCfg.ocrOpacityRoiXPct, gCfg.ocrOpacityRoiYPct, gCfg.ocrOpacityRoiWPct, gCfg.ocrOpacityRoiHPct,
+        gCfg.ocrOpacityLow, gCfg.ocrOpacityHigh,
+        gCfg.ocrBlackoutGuardEnable, gCfg.ocrBlackoutOpacityThreshold, gCfg.ocrBlackoutAnchorGraceMs, gCfg.ocrBlackoutOutExtraMs, gCfg.ocrBlackoutMaxHoldMs,
+        gCfg.ocrPayoutGuardEnable, gCfg.ocrPayoutMarkerGraceMs, gCfg.ocrPayoutOutExtraMs,
+        gCfg.ocrPlayerNameHint.c_str(),
+        gCfg.ocrTesseractPath.c_str(), (int)gOcrKeywords.size());
+    {
+        bool usingPortableOcr = false;
+        std::string ocrExePath = ResolveOcrExecutablePath(usingPortableOcr);
+        Log("[CFG] OCR runtime: resolved='%s' portable=%d gameDir='%s' Engine=%d TesseractDll='%s' WorkerPath='%s' backend=%s GrabSingleBlit=%d DirtySkip=%d DirtyNoise=%d DirtyMaxReuseMs=%d tiles=%s",
+            ocrExePath.c_str(), usingPortableOcr ? 1 : 0, gGameDirPath,
+            gCfg.ocrEngine, gCfg.ocrTesseractDll.c_str(), gCfg.ocrWorkerPath.c_str(), gOcrBackend->Name(),
+            gCfg.ocrGrabSingleBlit, gCfg.ocrDirtySkip, gCfg.ocrDirtyNoise, gCfg.ocrDirtyMaxReuseMs, TileSignatureIsaName());
+    }
+    Log("[CFG] HUD: DrawMethod=%d HUDUiMode=%d ToastEnabled=%d ToastFallbackText=%d ToastIconDict='%s' ToastIcon='%s' ToastColor='%s' ToastDurationMs=%d ToastRetryMs=%d Panel=(%d,%d) LineStep=%.2f MaxLines=%d AnchorBottom=%d ToastSoundSet='%s' ToastSound='%s'",
+        gDrawMethod, gCfg.hudUiMode, gCfg.hudToastEnabled, gCfg.hudToastFallbackText,
+        gCfg.hudToastIconDict.c_str(), gCfg.hudToastIcon.c_str(), gCfg.hudToastColor.c_str(),
+        gCfg.hudToastDurationMs, gCfg.hudToastRetryMs, gCfg.hudPanelX, gCfg.hudPanelY, gCfg.hudPanelLineStep, gCfg.hudPanelMaxLines, gCfg.hudPanelAnchorBottom,
+        gCfg.hudToastSoundSet.c_str(), gCfg.hudToastSound.c_str());
+
+    Log("[CFG] Money: Overlay=%d ScanEnable=%d Range=[%d..%d) Batch=%d IntervalMs=%d ValueRange=[%d..%d] TopN=%d PruneMs=%d CandidateCap=%d",
+        gCfg.moneyOverlay, gCfg.moneyScanEnable,
+        gCfg.moneyScanStart, gCfg.moneyScanEnd,
+        gCfg.moneyScanBatch, gCfg.moneyScanIntervalMs,
+        gCfg.moneyValueMin, gCfg.moneyValueMax,
+        gCfg.moneyTopN, gCfg.moneyPruneMs, gCfg.moneyCandidateCap);
+    Log("[CFG] Money perf: ScanMaxReadsPerStep=%d RescanColdMaxAgeMs=%d ScanMaxStepMs=%d ScanBudgetUs=%d ScanWorker=%d TypedScan=%d ExceptionLogCooldownMs=%d SkipFaultRuns=%d FaultMap=%d LikelyMaxChangesPerSec=%.2f BetStepFilter=%d BetStepDollars=%d BetMinDollars=%d",
+        gCfg.moneyScanMaxReadsPerStep, gCfg.moneyRescanColdMaxAgeMs, gCfg.moneyScanMaxStepMs, gCfg.moneyScanBudgetUs,
+        gCfg.moneyScanWorker, gCfg.moneyTypedScan, gCfg.moneyExceptionLogCooldownMs, gCfg.moneySkipFaultRuns, gCfg.moneyFaultMapEnable, gCfg.moneyLikelyMaxChangesPerSec,
+        gCfg.moneyBetStepFilterEnable, gCfg.moneyBetStepDollars, gCfg.moneyBetMinDollars);
+    Log("[CFG] Money discovery: Mode=%d SeedRadius=%d CoarseStride=%d RefineRadius=%d",
+        gCfg.moneyDiscoveryMode, gCfg.moneyDiscoverySeedRadius, gCfg.moneyDiscoveryCoarseStride, gCfg.moneyDiscoveryRefineRadius);
+    Log("[CFG] Money OCR: OcrMatchToleranceCents=%d NpcTrackMax=%d AutoLockPot=%d AutoLockPotMinMatches=%d AutoLockPlayer=%d AutoLockPlayerMinMatches=%d SessionCache=%d SessionCacheScript=%s OverlayMultiplier=%.2f",
+        gCfg.moneyOcrMatchToleranceCents, gCfg.moneyNpcTrackMax, gCfg.moneyAutoLockPot, gCfg.moneyAutoLockPotMinMatches,
+        gCfg.moneyAutoLockPlayer, gCfg.moneyAutoLockPlayerMinMatches, gCfg.moneySessionCache,
+        gCfg.moneySessionCacheScript.c_str(), gCfg.moneyOverlayMultiplier);
+    Log("[CFG] Money seat array: Enable=%d Seats=%d MaxStride=%d MinSeats=%d MinMatches=%d StopScan=%d",
+        gCfg.moneySeatArrayEnable, gCfg.moneySeatArraySeats, gCfg.moneySeatArrayMaxStride,
+        gCfg.moneySeatArrayMinSeats, gCfg.moneySeatArrayMinMatches, gCfg.moneySeatArrayStopScan);
+    Log("[CFG] Money corr: Enable=%d LagMs=%d PoolSize=%d (%zu KB) RejectMisses=%d LockSteps=%d",
+        gCfg.moneyCorrEnable, gCfg.moneyCorrLagMs, gCfg.moneyCorrPoolSize,
+        (size_t)gCfg.moneyCorrPoolSize * sizeof(SeriesRing) / 1024, gCfg.moneyCorrRejectMisses, gCfg.moneyCorrLockSteps);
+    Log("[CFG] Money narrow: Enable=%d Auto=%d Target=%s Keys start=0x%02X equals=0x%02X delta=0x%02X unchanged=0x%02X changed=0x%02X",
+        gCfg.moneyNarrowEnable, gCfg.moneyNarrowAuto, gCfg.moneyNarrowTarget ? "player" : "pot",
+        gCfg.moneyNarrowKeyStart, gCfg.moneyNarrowKeyEquals, gCfg.moneyNarrowKeyDelta,
+        gCfg.moneyNarrowKeyUnchanged, gCfg.moneyNarrowKeyChanged);
+    Log("[CFG] Money payout: Enable=%d Multiplier=%.2f UseWinsAmount=%d FallbackToPot=%d CooldownMs=%d MinPhaseConf=%.2f",
+        gCfg.moneyPayoutEnable, gCfg.moneyPayoutMultiplier, gCfg.moneyPayoutUseWinsAmount,
+        gCfg.moneyPayoutFallbackToPot, gCfg.moneyPayoutCooldownMs, gCfg.moneyPayoutMinPhaseConf);
+    if (gCfg.moneyLogEnable)
+    {
+        Log("[CFG] Money log: LogEnable=%d LogIntervalMs=%d LogTopN=%d LogOnlyOnChange=%d",
+            gCfg.moneyLogEnable, gCfg.moneyLogIntervalMs, gCfg.moneyLogTopN, gCfg.moneyLogOnlyOnChange);
+    }
+
+    // Estimate wrap time
+    if (gCfg.moneyScanEnable && gCfg.moneyScanBatch > 0 && gCfg.moneyScanIntervalMs > 0)
+    {
+        int range = gCfg.moneyScanEnd - gCfg.moneyScanStart;
+        int effectiveBatch = (std::min)(gCfg.moneyScanBatch, gCfg.moneyScanMaxReadsPerStep);
+        if (effectiveBatch > 0)
+        {
+            float steps = (float)range / (float)effectiveBatch;
+            float wrapSec = steps * gCfg.moneyScanIntervalMs / 1000.0f;
+            Log("[CFG] Money estWrap=%.1fs (approx, cap-based)", wrapSec);
+        }
+    }
+
+    Log("[CFG] Money Watch: PotGlobal=%d StackGlobals=%d,%d,%d,%d,%d,%d PeriodMs=%d History=%d LogChanges=%d Extra=%d",
+        gCfg.potGlobal,
+        gCfg.stackGlobal0, gCfg.stackGlobal1, gCfg.stackGlobal2,
+        gCfg.stackGlobal3, gCfg.stackGlobal4, gCfg.stackGlobal5,
+        gCfg.moneyWatchPeriodMs, gCfg.moneyWatchHistory, gCfg.moneyWatchLogChanges, (int)gCfg.moneyWatches.size());
+    Log("[CFG] Money record: Enable=%d FlushMs=%d BlockKB=%d",
+        gCfg.moneyRecordEnable, gCfg.moneyRecordFlushMs, gCfg.moneyRecordBlockKB);
+    InitWatches();
+
+    LoadFaultMap();
+    LoadHotspots();
+    LoadSessionCache();
+}
+
+static int GetEffectivePotGlobalIndex()
+{
+    if (gCfg.potGlobal >= 0)
+        return gCfg.potGlobal;
+    return gAutoPotGlobal;
+}
+
+static int GetEffectivePlayerGlobalIndex()
+{
+    if (gCfg.stackGlobal0 >= 0)
+        return gCfg.stackGlobal0;
+    return gAutoPlayerGlobal;
+}
+
+static int GetEffectiveStackGlobalIndex(int stack);
 
-    BuildOcrKeywordList();
-    StopOcrProcess(true);
-    gNextOcrStartAt = 0;
-    gNextOcrLogAt = 0;
-    gPendingOpacityHint = 0.5f;
-    gLastOpacityHint = 0.5f;
-    gLastPokerAnchorSeenAt = 0;
-    gLastPayoutMarkerSeenAt = 0;
-    gPayoutHoldUntilAt = 0;
-    gOcrStartFailureStreak = 0;
-    gOcrStartFailureWarned = false;
-    gLastOcrStartFailReason = OCR_START_FAIL_NONE;
-    gLastOcrStartWinErr = 0;
-    gDetectRuntime = DetectionRuntime{};
-    gLastDetectInputs = DetectionInputs{};
-    gLastDetectScore = DetectionScore{};
-    gHudToastNativeFailed = false;
-    gHudToastNativeWarned = false;
-    gHudToastNativeRetryAt = 0;
-    gHudToastNativeFailCount = 0;
-    gLegacyHudMessage = "~COLOR_GOLD~Mod Online";
-    gLegacyHudMessageUntil = 0;
-    gOcrMoney = OcrMoneySnapshot{};
-    gAutoPotGlobal = -1;
-    gAutoPlayerGlobal = -1;
-    gLastMoneyPhase = POKER_PHASE_OUT_OF_POKER;
-    gSettlementSerial = 0;
-    gLastPaidSettlementSerial = -1;
-    gNextAllowedPayoutAt = 0;
+static bool TryReadEffectivePotCents(int& outPotCents)
+{
+    outPotCents = 0;
+    int idx = GetEffectivePotGlobalIndex();
+    if (idx < 0)
+        return false;
+    int val = 0;
+    if (!TryGetWatchValue(kWatchPot, idx, val) && !ReadGlobalInt(idx, val))
+        return false;
+    outPotCents = val;
+    return true;
+}
+
+static bool TryReadEffectivePlayerCents(int& outPlayerCents)
+{
+    outPlayerCents = 0;
+    int idx = GetEffectivePlayerGlobalIndex();
+    if (idx < 0)
+        return false;
+    int val = 0;
+    if (!TryGetWatchValue(kWatchStack0, idx, val) && !ReadGlobalInt(idx, val))
+        return false;
+    outPlayerCents = val;
+    return true;
+}
+
+// A worker snapshot can predate the last soft reset; its counters are from before the bump.
+static bool IsCandidateEpochCurrent(const MoneyCandidateStore& s, int slot)
+{
+    return s.epoch[(size_t)slot] == gEpochRequests.Stamp();
+}
+
+static bool TryAutoLockPotGlobal(const MoneyCandidateStore& s, const std::vector<int>& sorted, DWORD now)
+{
+    if (!gCfg.moneyAutoLockPot)
+        return false;
+    if (gCfg.potGlobal >= 0 || gAutoPotGlobal >= 0)
+        return false;
+    if (gOcrMoney.potSource == 5)
+        return false; // fallback OCR pot is too ambiguous for auto-lock
+    if (sorted.empty())
+        return false;
+
+    for (int slot : sorted)
+    {
+        size_t k = (size_t)slot;
+        if (!IsCandidateEpochCurrent(s, slot) || !CandidateCanLockPot(s, slot, now, gOcrMoney.potCents, gCandidateRules))
+            continue;
+
+        gAutoPotGlobal = s.idx[k];
+        Log("[MONEY] AutoLock: Pot global locked to idx=%d (ocrPot=%d ocrAny=%d changes=%d steps=%d/%d val=%d).",
+            s.idx[k], s.ocrPotMatches[k], s.ocrAnyMatches[k], s.changes[k],
+            StepAlignedCount(s, slot, OCR_SERIES_POT), StepMissedCount(s, slot, OCR_SERIES_POT), s.last[k]);
+        RecordHotspot(gAutoPotGlobal);
+        if (!gCfg.moneySessionCache)
+        {
+            // Without the session cache the lock is persisted as a manual override.
+            char idxBuf[32];
+            _snprintf_s(idxBuf, sizeof(idxBuf), "%d", gAutoPotGlobal);
+            WritePrivateProfileStringA("Money", "PotGlobal", idxBuf, gIniPath);
+            Log("[MONEY] AutoLock: Persisted PotGlobal=%d to %s.", gAutoPotGlobal, gIniPath);
+        }
+        if (gCfg.hudUiMode != HUD_UI_MODE_LEGACY_TEXT)
+        {
+            char toast[128];
+            _snprintf_s(toast, sizeof(toast), "Pot source locked [%d]", s.idx[k]);
+            PostHudToast(toast, HUD_TOAST_EVENT_GENERIC, now);
+        }
+        return true;
+    }
+
+    return false;
+}
+
+// ranked: player-category slots, best PlayerStackScore first.
+static bool TryAutoLockPlayerGlobal(const MoneyCandidateStore& s, const std::vector<int>& ranked, DWORD now)
+{
+    if (!gCfg.moneyAutoLockPlayer)
+        return false;
+    if (gCfg.stackGlobal0 >= 0 || gAutoPlayerGlobal >= 0)
+        return false;
+    if (gOcrMoney.playerCents <= 0)
+        return false;
+
+    int best = -1;
+    for (int slot : ranked)
+    {
+        if (IsCandidateEpochCurrent(s, slot) && CandidateCanLockPlayer(s, slot, now, gCandidateRules))
+        {
+            best = slot;
+            break;
+        }
+    }
+
+    if (best < 0)
+        return false;
+
+    size_t b = (size_t)best;
+    gAutoPlayerGlobal = s.idx[b];
+    Log("[MONEY] AutoLock: Player stack global locked to idx=%d (ocrPlayer=%d ocrPot=%d ocrAny=%d steps=%d/%d val=%d).",
+        s.idx[b], s.ocrPlayerMatches[b], s.ocrPotMatches[b], s.ocrAnyMatches[b],
+        StepAlignedCount(s, best, OCR_SERIES_PLAYER), StepMissedCount(s, best, OCR_SERIES_PLAYER), s.last[b]);
+    RecordHotspot(gAutoPlayerGlobal);
+    if (!gCfg.moneySessionCache)
+    {
+        char idxBuf[32];
+        _snprintf_s(idxBuf, sizeof(idxBuf), "%d", gAutoPlayerGlobal);
+        WritePrivateProfileStringA("Money", "StackGlobal0", idxBuf, gIniPath);
+        Log("[MONEY] AutoLock: Persisted StackGlobal0=%d to %s.", gAutoPlayerGlobal, gIniPath);
+    }
+    if (gCfg.hudUiMode != HUD_UI_MODE_LEGACY_TEXT)
+    {
+        char toast[128];
+        _snprintf_s(toast, sizeof(toast), "Player source locked [%d]", s.idx[b]);
+        PostHudToast(toast, HUD_TOAST_EVENT_GENERIC, now);
+    }
+    return true;
+}
+
+// ---------------- Seat array ----------------
+// StackGlobal1..5 used to be found by hand. The table keeps every seat's stack in one script
+// array at a constant stride, so candidates that keep matching NPC / player OCR amounts are
+// fitted to a lattice (seat_layout.h) and a fit is locked together with the pot in one step.
+// With SeatArrayStopScan=1 the scanner then idles and only the pot and seat globals are read,
+// in one batched read per frame. The locked values must keep matching OCR: a pot, player or
+// NPC field that misses kSeatArrayMaxMisses samples in a row unlocks, and inference waits
+// kSeatArrayRelockMs before trying again. Main-thread owned.
+constexpr DWORD kSeatArrayInferMs = 2000;
+constexpr int kSeatArrayMaxEvidence = 512;
+constexpr int kSeatArrayMaxMisses = 4;
+constexpr DWORD kSeatArrayRelockMs = 30000;
+
+static int GetEffectiveStackGlobalIndex(int stack)
+{
+    const int manual[kSeatArrayMaxSeats] = {
+        gCfg.stackGlobal0, gCfg.stackGlobal1, gCfg.stackGlobal2,
+        gCfg.stackGlobal3, gCfg.stackGlobal4, gCfg.stackGlobal5
+    };
+    if (stack == 0)
+        return GetEffectivePlayerGlobalIndex();
+    if (manual[stack] >= 0)
+        return manual[stack];
+    return gSeatArray.locked ? gSeatArray.stackIdx[stack] : -1;
+}
+
+static bool SeatArrayStopsScan()
+{
+    return gSeatArray.locked && gCfg.moneySeatArrayStopScan;
+}
+
+static void UnlockSeatArray(const char* reason)
+{
+    if (!gSeatArray.locked)
+        return;
+    Log("[MONEY] SeatArray: unlocked (%s), scanning resumes.", reason);
+    if (gSeatArray.setAutoPot)
+        gAutoPotGlobal = -1;
+    if (gSeatArray.setAutoPlayer)
+        gAutoPlayerGlobal = -1;
+    gSeatArray = SeatArrayLock{};
+}
+
+// One batched read of the pot and seat globals. Unlocks on a read fault.
+static bool ReadSeatArray()
+{
+    if (!gSeatArray.locked)
+        return false;
+    int n = (int)gSeatArray.readIdx.size();
+    ReadGlobalIndices(gSeatArray.readIdx.data(), n, gSeatArray.readVals.data(), gSeatArray.readOk.data());
+    for (int i = 0; i < n; i++)
+    {
+        if (!gSeatArray.readOk[(size_t)i])
+        {
+            char reason[64];
+            _snprintf_s(reason, sizeof(reason), "read fault at idx=%d", gSeatArray.readIdx[(size_t)i]);
+            UnlockSeatArray(reason);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Value of a locked pot/seat global from this frame's batched read.
+static bool TryGetSeatArrayValue(int idx, int& outVal)
+{
+    if (!gSeatArray.locked)
+        return false;
+    for (size_t i = 0; i < gSeatArray.readIdx.size(); i++)
+    {
+        if (gSeatArray.readIdx[i] == idx && gSeatArray.readOk[i])
+        {
+            outVal = gSeatArray.readVals[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+// Counts one OCR sample against a locked field. Returns true when the field has missed too often.
+static bool CountSeatArrayMiss(int& misses, bool matched)
+{
+    misses = matched ? 0 : misses + 1;
+    return misses >= kSeatArrayMaxMisses;
+}
+
+// Once per OCR sample: the locked pot, player seat and NPC seats must still read what OCR reads.
+static void ValidateSeatArray(DWORD now)
+{
+    SeatArrayLock& lock = gSeatArray;
+    if (!lock.locked || lock.checkedSampleId == gOcrMoney.sampleId || !IsOcrMoneyFresh(now, 3000))
+        return;
+    lock.checkedSampleId = gOcrMoney.sampleId;
+
+    const char* field = nullptr;
+    int v = 0;
+    if (gOcrMoney.potCents > 0 && gOcrMoney.potSource != 5 && TryGetSeatArrayValue(lock.potIdx, v) &&
+        CountSeatArrayMiss(lock.potMisses, CandidateMatchesObservedOcrAmount(v, gOcrMoney.potCents)))
+        field = "pot";
+    if (!field && gOcrMoney.playerCents > 0 && TryGetSeatArrayValue(lock.stackIdx[0], v) &&
+        CountSeatArrayMiss(lock.playerMisses, CandidateMatchesObservedOcrAmount(v, gOcrMoney.playerCents)))
+        field = "player seat";
+    if (!field && !gOcrMoney.npcAmountsCents.empty())
+    {
+        bool any = false;
+        for (int stack = 1; stack < kSeatArrayMaxSeats && !any; stack++)
+        {
+            if (lock.stackIdx[stack] < 0 || !TryGetSeatArrayValue(lock.stackIdx[stack], v))
+                continue;
+            for (int amount : gOcrMoney.npcAmountsCents)
+                any |= CandidateMatchesObservedOcrAmount(v, amount);
+        }
+        if (CountSeatArrayMiss(lock.npcMisses, any))
+            field = "NPC seats";
+    }
+    if (!field)
+        return;
+
+    char reason[96];
+    _snprintf_s(reason, sizeof(reason), "%s stopped matching OCR for %d samples", field, kSeatArrayMaxMisses);
+    UnlockSeatArray(reason);
+    gNextSeatArrayInferAt = now + kSeatArrayRelockMs;
+}
+
+static void BuildSeatEvidence(const MoneyCandidateStore& s, std::vector<SeatEvidence>& out)
+{
+    out.clear();
+    int player = GetEffectivePlayerGlobalIndex();
+    bool playerSeen = false;
+    int minMatches = gCfg.moneySeatArrayMinMatches;
+    for (int slot = 0; slot < s.Size(); slot++)
+    {
+        size_t k = (size_t)slot;
+        SeatEvidence e;
+        e.idx = s.idx[k];
+        e.value = s.last[k];
+        e.npcScore = s.ocrNpcMatches[k] + StepAlignedCount(s, slot, OCR_SERIES_NPC);
+        e.playerScore = s.ocrPlayerMatches[k] + StepAlignedCount(s, slot, OCR_SERIES_PLAYER);
+        e.isPlayer = e.idx == player;
+        if (!e.isPlayer)
+        {
+            if (e.npcScore < minMatches && e.playerScore < minMatches)
+                continue;
+            if (s.ocrPotMatches[k] > e.npcScore + e.playerScore)
+                continue;  // pot lookalike
+        }
+        for (int amount : gOcrMoney.npcAmountsCents)
+        {
+            if (CandidateMatchesObservedOcrAmount(e.value, amount))
+            {
+                e.matchesNpcNow = true;
+                break;
+            }
+        }
+        playerSeen |= e.isPlayer;
+        out.push_back(e);
+    }
+
+    // A manual StackGlobal0 need not be a candidate.
+    if (player >= 0 && !playerSeen)
+    {
+        SeatEvidence e;
+        e.idx = player;
+        e.isPlayer = true;
+        ReadGlobalInt(player, e.value);
+        out.push_back(e);
+    }
+
+    if ((int)out.size() > kSeatArrayMaxEvidence)
+    {
+        std::nth_element(out.begin(), out.begin() + kSeatArrayMaxEvidence, out.end(),
+            [](const SeatEvidence& a, const SeatEvidence& b)
+            {
+                if (a.isPlayer != b.isPlayer)
+                    return a.isPlayer;
+                return (a.npcScore + a.playerScore) > (b.npcScore + b.playerScore);
+            });
+        out.resize((size_t)kSeatArrayMaxEvidence);
+    }
+}
+
+static bool IsSeatArrayIndex(const SeatArrayFit& fit, int idx)
+{
+    int last = fit.SeatIndex(fit.seats - 1);
+    return idx >= fit.base && idx <= last && (idx - fit.base) % fit.stride == 0;
+}
+
+// The locked pot, else the best pot-ranked candidate off the seat lattice that the pot
+// auto-lock would take as well.
+static int PickSeatArrayPot(const MoneyCandidateStore& s, const std::vector<int>& potRanked, const SeatArrayFit& fit, DWORD now)
+{
+    int pot = GetEffectivePotGlobalIndex();
+    if (pot >= 0)
+        return pot;
+    if (!gCfg.moneyAutoLockPot || gOcrMoney.potSource == 5)
+        return -1;
+    for (int slot : potRanked)
+    {
+        if (IsSeatArrayIndex(fit, s.idx[(size_t)slot]) || !IsCandidateEpochCurrent(s, slot))
+            continue;
+        if (!CandidateCanLockPot(s, slot, now, gOcrMoney.potCents, gCandidateRules))
+            continue;
+        return s.idx[(size_t)slot];
+    }
+    return -1;
+}
+
+// The fit's player seat is either the locked player global or a slot the player auto-lock
+// would take on its own.
+static bool SeatArrayPlayerSeatOk(const MoneyCandidateStore& s, const SeatArrayFit& fit, DWORD now)
+{
+    int idx = fit.SeatIndex(fit.playerSeat);
+    if (idx == GetEffectivePlayerGlobalIndex())
+        return true;
+    if (!gCfg.moneyAutoLockPlayer || gOcrMoney.playerCents <= 0)
+        return false;
+    int slot = s.Find(idx);
+    return slot >= 0 && IsCandidateEpochCurrent(s, slot) && CandidateCanLockPlayer(s, slot, now, gCandidateRules);
+}
+
+static bool TryLockSeatArray(const MoneyCandidateStore& s, const RankedSlots& ranked, DWORD now)
+{
+    static std::vector<SeatEvidence> evidence;
+
+    if (!gCfg.moneySeatArrayEnable || gSeatArray.locked || now < gNextSeatArrayInferAt)
+        return false;
+    gNextSeatArrayInferAt = now + kSeatArrayInferMs;
+    if (gCfg.stackGlobal1 >= 0 && gCfg.stackGlobal2 >= 0 && gCfg.stackGlobal3 >= 0 &&
+        gCfg.stackGlobal4 >= 0 && gCfg.stackGlobal5 >= 0)
+        return false;  // layout set by hand
+
+    BuildSeatEvidence(s, evidence);
+    SeatArrayParams params;
+    params.seats = gCfg.moneySeatArraySeats;
+    params.maxStride = gCfg.moneySeatArrayMaxStride;
+    params.minSeats = gCfg.moneySeatArrayMinSeats;
+    SeatArrayFit fit = InferSeatArray(evidence, params, [](int idx)
+    {
+        // Seats without evidence must read as an empty seat or a stack.
+        int v = 0;
+        return ReadGlobalInt(idx, v) && v >= 0 && v <= gCfg.moneyValueMax;
+    });
+    if (!fit.found || fit.playerSeat < 0 || !SeatArrayPlayerSeatOk(s, fit, now))
+        return false;
+    int potIdx = PickSeatArrayPot(s, ranked.slots[RANK_CATEGORY_POT], fit, now);
+    if (potIdx < 0)
+        return false;
+
+    SeatArrayLock lock;
+    lock.locked = true;
+    lock.fit = fit;
+    lock.potIdx = potIdx;
+    lock.stackIdx[0] = fit.SeatIndex(fit.playerSeat);
+    int next = 1;
+    for (int seat = 0; seat < fit.seats && next < kSeatArrayMaxSeats; seat++)
+    {
+        if (seat != fit.playerSeat)
+            lock.stackIdx[next++] = fit.SeatIndex(seat);
+    }
+    if (gCfg.potGlobal < 0 && gAutoPotGlobal < 0)
+    {
+        gAutoPotGlobal = potIdx;
+        lock.setAutoPot = true;
+    }
+    if (gCfg.stackGlobal0 < 0 && gAutoPlayerGlobal < 0)
+    {
+        gAutoPlayerGlobal = lock.stackIdx[0];
+        lock.setAutoPlayer = true;
+    }
+    lock.readIdx.push_back(potIdx);
+    for (int seat = 0; seat < fit.seats; seat++)
+        lock.readIdx.push_back(fit.SeatIndex(seat));
+    SortUniqueIntVector(lock.readIdx);
+    lock.readVals.assign(lock.readIdx.size(), 0);
+    lock.readOk.assign(lock.readIdx.size(), 0);
+    gSeatArray = lock;
+    ReadSeatArray();
+    RecordHotspot(potIdx);
+    RecordHotspot(lock.stackIdx[0]);
+
+    std::string seatsText;
+    char item[48];
+    for (int seat = 0; seat < fit.seats; seat++)
+    {
+        int v = 0;
+        TryGetSeatArrayValue(fit.SeatIndex(seat), v);
+        _snprintf_s(item, sizeof(item), "%s%d=%d%s", seatsText.empty() ? "" : " ", fit.SeatIndex(seat), v,
+            (seat == fit.playerSeat) ? "(you)" : ((fit.memberMask >> seat) & 1u) ? "" : "(?)");
+        seatsText += item;
+    }
+    Log("[MONEY] SeatArray: locked base=%d stride=%d seats=%d evidence=%d/%d%s pot=%d seats: %s",
+        fit.base, fit.stride, fit.seats, fit.members, fit.seats, fit.baseAmbiguous ? " (base ambiguous, lowest plausible)" : "",
+        potIdx, seatsText.c_str());
+
+    if (gCfg.hudUiMode != HUD_UI_MODE_LEGACY_TEXT)
+    {
+        char toast[128];
+        _snprintf_s(toast, sizeof(toast), "Seat array locked [%d +%d x%d]", fit.base, fit.stride, fit.seats);
+        PostHudToast(toast, HUD_TOAST_EVENT_GENERIC, now);
+    }
+    return true;
+}
+
+// ---------------- Watchpoints ----------------
+// Pot, Stk0-5 and the WatchN globals from the INI live in gWatches. Once per frame the due
+// watches are read in one batch (locked seat-array globals come from that batch instead) and
+// the registry notifies subscribers of changes; the overlay and payout use the cached values.
+static void WatchTick(DWORD now)
+{
+    static std::vector<int> readIdx;
+    static std::vector<int> readVals;
+    static std::vector<unsigned char> readOk;
+    static std::vector<int> vals;
+    static std::vector<unsigned char> ok;
+
+    gWatches.Bind(kWatchPot, GetEffectivePotGlobalIndex());
+    for (int stack = 0; stack < kSeatArrayMaxSeats; stack++)
+        gWatches.Bind(kWatchStack0 + stack, GetEffectiveStackGlobalIndex(stack));
+
+    const std::vector<int>& due = gWatches.Due((uint32_t)now);
+    int n = (int)due.size();
+    vals.assign((size_t)n, 0);
+    ok.assign((size_t)n, 0);
+    readIdx.clear();
+    for (int i = 0; i < n; i++)
+    {
+        if (TryGetSeatArrayValue(due[(size_t)i], vals[(size_t)i]))
+            ok[(size_t)i] = 1;
+        else
+            readIdx.push_back(due[(size_t)i]);
+    }
+    if (!readIdx.empty())
+    {
+        readVals.resize(readIdx.size());
+        readOk.resize(readIdx.size());
+        ReadGlobalIndices(readIdx.data(), (int)readIdx.size(), readVals.data(), readOk.data());
+        size_t r = 0;
+        for (int i = 0; i < n; i++)
+        {
+            if (ok[(size_t)i])
+                continue;
+            vals[(size_t)i] = readVals[r];
+            ok[(size_t)i] = readOk[r];
+            r++;
+        }
+    }
+    gWatches.Apply((uint32_t)now, vals.data(), ok.data());
+}
 
-    // Money
-    gCfg.moneyOverlay           = IniGetInt("Money", "Overlay", 1, gIniPath);
-    gCfg.moneyScanEnable        = IniGetInt("Money", "ScanEnable", 1, gIniPath);
-    gCfg.moneyScanStart         = IniGetInt("Money", "ScanStart", 0, gIniPath);
-    gCfg.moneyScanEnd           = IniGetInt("Money", "ScanEnd", 100000, gIniPath);
-    gCfg.moneyScanBatch         = IniGetInt("Money", "ScanBatch", 512, gIniPath);
-    gCfg.moneyScanIntervalMs    = IniGetInt("Money", "ScanIntervalMs", 20, gIniPath);
-    gCfg.moneyScanMaxReadsPerStep = IniGetInt("Money", "ScanMaxReadsPerStep", 512, gIniPath);
-    gCfg.moneyScanMaxStepMs     = IniGetInt("Money", "ScanMaxStepMs", 4, gIniPath);
-    gCfg.moneyValueMin          = IniGetInt("Money", "ValueMin", 1, gIniPath);
-    gCfg.moneyValueMax          = IniGetInt("Money", "ValueMax", 500000, gIniPath);
-    gCfg.moneyTopN              = IniGetInt("Money", "TopN", 10, gIniPath);
-    gCfg.moneyPruneMs           = IniGetInt("Money", "PruneMs", 300000, gIniPath);
-    gCfg.moneyLogEnable         = IniGetInt("Money", "LogEnable", 1, gIniPath);
-    gCfg.moneyLogIntervalMs     = IniGetInt("Money", "LogIntervalMs", 3000, gIniPath);
-    gCfg.moneyLogTopN           = IniGetInt("Money", "LogTopN", 5, gIniPath);
-    gCfg.moneyLogOnlyOnChange   = IniGetInt("Money", "LogOnlyOnChange", 1, gIniPath);
-    gCfg.moneyLikelyMaxChangesPerSec = IniGetFloat("Money", "LikelyMaxChangesPerSec", 1.5f, gIniPath);
-    gCfg.moneyNpcTrackMax       = IniGetInt("Money", "NpcTrackMax", 5, gIniPath);
-    gCfg.moneyBetStepFilterEnable = IniGetInt("Money", "BetStepFilterEnable", 1, gIniPath);
-    gCfg.moneyBetStepDollars    = IniGetInt("Money", "BetStepDollars", 5, gIniPath);
-    gCfg.moneyBetMinDollars     = IniGetInt("Money", "BetMinDollars", 10, gIniPath);
-    gCfg.moneyExceptionLogCooldownMs = IniGetInt("Money", "ExceptionLogCooldownMs", 30000, gIniPath);
-    gCfg.moneySkipFaultRuns     = IniGetInt("Money", "SkipFaultRuns", 1, gIniPath);
-    gCfg.moneyOcrMatchToleranceCents = IniGetInt("Money", "OcrMatchToleranceCents", 6, gIniPath);
-    gCfg.moneyAutoLockPot       = IniGetInt("Money", "AutoLockPot", 1, gIniPath);
-    gCfg.moneyAutoLockPotMinMatches = IniGetInt("Money", "AutoLockPotMinMatches", 10, gIniPath);
-    gCfg.moneyAutoLockPlayer    = IniGetInt("Money", "AutoLockPlayer", 1, gIniPath);
-    gCfg.moneyAutoLockPlayerMinMatches = IniGetInt("Money", "AutoLockPlayerMinMatches", 8, gIniPath);
-    gCfg.moneyOverlayMultiplier = IniGetFloat("Money", "OverlayMultiplier", 2.0f, gIniPath);
-    gCfg.moneyPayoutEnable      = IniGetInt("Money", "PayoutEnable", 0, gIniPath);
-    gCfg.moneyPayoutMultiplier  = IniGetFloat("Money", "PayoutMultiplier", 2.0f, gIniPath);
-    gCfg.moneyPayoutUseWinsAmount = IniGetInt("Money", "PayoutUseWinsAmount", 1, gIniPath);
-    gCfg.moneyPayoutFallbackToPot = IniGetInt("Money", "PayoutFallbackToPot", 1, gIniPath);
-    gCfg.moneyPayoutCooldownMs  = IniGetInt("Money", "PayoutCooldownMs", 6000, gIniPath);
-    gCfg.moneyPayoutMinPhaseConf = IniGetFloat("Money", "PayoutMinPhaseConf", 0.55f, gIniPath);
+static bool IsLikelyValidPayoutAmount(int cents)
+{
+    if (cents <= 0)
+        return false;
+    if (cents > gCfg.moneyValueMax * 4)
+        return false;
 
-    gCfg.potGlobal    = IniGetInt("Money", "PotGlobal", -1, gIniPath);
-    gCfg.stackGlobal0 = IniGetInt("Money", "StackGlobal0", -1, gIniPath);
-    gCfg.stackGlobal1 = IniGetInt("Money", "StackGlobal1", -1, gIniPath);
-    gCfg.stackGlobal2 = IniGetInt("Money", "StackGlobal2", -1, gIniPath);
-    gCfg.stackGlobal3 = IniGetInt("Money", "StackGlobal3", -1, gIniPath);
-    gCfg.stackGlobal4 = IniGetInt("Money", "StackGlobal4", -1, gIniPath);
-    gCfg.stackGlobal5 = IniGetInt("Money", "StackGlobal5", -1, gIniPath);
+    // If OCR has a non-fallback pot, reject payout amounts wildly off that anchor.
+    if (gOcrMoney.potCents > 0 && gOcrMoney.potSource != 5)
+    {
+        if (cents > gOcrMoney.potCents * 2)
+            return false;
+        if (cents * 3 < gOcrMoney.potCents)
+            return false;
+    }
+    return true;
+}
 
-    bool moneyCfgClamped = false;
-    moneyCfgClamped |= ClampIntSetting("ScanStart", gCfg.moneyScanStart, 0, std::numeric_limits<int>::max() - 1);
-    moneyCfgClamped |= ClampIntSetting("ScanEnd", gCfg.moneyScanEnd, 1, std::numeric_limits<int>::max());
-    moneyCfgClamped |= ClampIntSetting("ScanBatch", gCfg.moneyScanBatch, 1, 1000000);
-    moneyCfgClamped |= ClampIntSetting("ScanIntervalMs", gCfg.moneyScanIntervalMs, 1, 60000);
-    moneyCfgClamped |= ClampIntSetting("ScanMaxReadsPerStep", gCfg.moneyScanMaxReadsPerStep, 1, 1000000);
-    moneyCfgClamped |= ClampIntSetting("ScanMaxStepMs", gCfg.moneyScanMaxStepMs, 1, 1000);
-    moneyCfgClamped |= ClampIntSetting("LogOnlyOnChange", gCfg.moneyLogOnlyOnChange, 0, 1);
-    moneyCfgClamped |= ClampIntSetting("NpcTrackMax", gCfg.moneyNpcTrackMax, 0, 32);
-    moneyCfgClamped |= ClampIntSetting("BetStepFilterEnable", gCfg.moneyBetStepFilterEnable, 0, 1);
-    moneyCfgClamped |= ClampIntSetting("BetStepDollars", gCfg.moneyBetStepDollars, 1, 1000);
-    moneyCfgClamped |= ClampIntSetting("BetMinDollars", gCfg.moneyBetMinDollars, 1, 100000);
-    moneyCfgClamped |= ClampIntSetting("ExceptionLogCooldownMs", gCfg.moneyExceptionLogCooldownMs, 0, 600000);
-    moneyCfgClamped |= ClampIntSetting("SkipFaultRuns", gCfg.moneySkipFaultRuns, 0, 1);
-    moneyCfgClamped |= ClampIntSetting("LogTopN", gCfg.moneyLogTopN, 0, 64);
-    moneyCfgClamped |= ClampIntSetting("OcrMatchToleranceCents", gCfg.moneyOcrMatchToleranceCents, 0, 2500);
-    moneyCfgClamped |= ClampIntSetting("AutoLockPot", gCfg.moneyAutoLockPot, 0, 1);
-    moneyCfgClamped |= ClampIntSetting("AutoLockPotMinMatches", gCfg.moneyAutoLockPotMinMatches, 1, 1000000);
-    moneyCfgClamped |= ClampIntSetting("AutoLockPlayer", gCfg.moneyAutoLockPlayer, 0, 1);
-    moneyCfgClamped |= ClampIntSetting("AutoLockPlayerMinMatches", gCfg.moneyAutoLockPlayerMinMatches, 1, 1000000);
-    moneyCfgClamped |= ClampIntSetting("PayoutEnable", gCfg.moneyPayoutEnable, 0, 1);
-    moneyCfgClamped |= ClampIntSetting("PayoutUseWinsAmount", gCfg.moneyPayoutUseWinsAmount, 0, 1);
-    moneyCfgClamped |= ClampIntSetting("PayoutFallbackToPot", gCfg.moneyPayoutFallbackToPot, 0, 1);
-    moneyCfgClamped |= ClampIntSetting("PayoutCooldownMs", gCfg.moneyPayoutCooldownMs, 250, 600000);
+static bool TryGetPayoutSourceCents(DWORD now, int& outSourceCents, const char*& outSourceLabel)
+{
+    outSourceCents = 0;
+    outSourceLabel = "none";
 
-    if (gCfg.moneyLikelyMaxChangesPerSec < 0.0f)
+    bool ocrFresh = IsOcrMoneyFresh(now);
+
+    if (gCfg.moneyPayoutUseWinsAmount && ocrFresh && gOcrMoney.winsCents > 0 &&
+        IsLikelyValidPayoutAmount(gOcrMoney.winsCents))
     {
-        gCfg.moneyLikelyMaxChangesPerSec = 0.0f;
-        moneyCfgClamped = true;
-        Log("[CFG] WARNING: Money.LikelyMaxChangesPerSec was negative. Clamped to 0.");
+        outSourceCents = gOcrMoney.winsCents;
+        outSourceLabel = "wins";
+        return true;
     }
-    else if (gCfg.moneyLikelyMaxChangesPerSec > 1000.0f)
+
+    if (gCfg.moneyPayoutFallbackToPot)
     {
-        gCfg.moneyLikelyMaxChangesPerSec = 1000.0f;
-        moneyCfgClamped = true;
-        Log("[CFG] WARNING: Money.LikelyMaxChangesPerSec too large. Clamped to 1000.");
+        if (ocrFresh && gOcrMoney.potCents > 0 && gOcrMoney.potSource != 5)
+        {
+            outSourceCents = gOcrMoney.potCents;
+            outSourceLabel = "potOCR";
+            return true;
+        }
+
+        int potCents = 0;
+        if (TryReadEffectivePotCents(potCents) && potCents > 0)
+        {
+            outSourceCents = potCents;
+            outSourceLabel = "potGlobal";
+            return true;
+        }
     }
 
-    if (gCfg.moneyOverlayMultiplier < 0.10f)
+    return false;
+}
+
+static bool TryApplyPokerPayout(int sourceCents, const char* sourceLabel, DWORD now)
+{
+    if (sourceCents <= 0)
+        return false;
+
+    double scaled = (double)sourceCents * (double)gCfg.moneyPayoutMultiplier;
+    int targetCents = (int)std::llround(scaled);
+    int bonusCents = targetCents - sourceCents;
+    if (bonusCents <= 0)
+        return false;
+
+    BOOL ok = MONEY::_MONEY_INCREMENT_CASH_BALANCE(bonusCents, MISC::GET_HASH_KEY("ADD_REASON_DEFAULT"));
+    if (!ok)
     {
-        gCfg.moneyOverlayMultiplier = 0.10f;
-        moneyCfgClamped = true;
-        Log("[CFG] WARNING: Money.OverlayMultiplier too small. Clamped to 0.10.");
+        Log("[PAYOUT] FAILED source=%s src=%d($%.2f) bonus=%d($%.2f) mul=%.2f",
+            sourceLabel ? sourceLabel : "?", sourceCents, (double)sourceCents / 100.0,
+            bonusCents, (double)bonusCents / 100.0, gCfg.moneyPayoutMultiplier);
+        return false;
     }
-    else if (gCfg.moneyOverlayMultiplier > 1000.0f)
+
+    Log("[PAYOUT] Applied source=%s src=%d($%.2f) bonus=%d($%.2f) target=%d($%.2f) mul=%.2f",
+        sourceLabel ? sourceLabel : "?",
+        sourceCents, (double)sourceCents / 100.0,
+        bonusCents, (double)bonusCents / 100.0,
+        targetCents, (double)targetCents / 100.0,
+        gCfg.moneyPayoutMultiplier);
+
+    if (gCfg.hudUiMode != HUD_UI_MODE_LEGACY_TEXT)
     {
-        gCfg.moneyOverlayMultiplier = 1000.0f;
-        moneyCfgClamped = true;
-        Log("[CFG] WARNING: Money.OverlayMultiplier too large. Clamped to 1000.");
+        char toast[128];
+        _snprintf_s(toast, sizeof(toast), "Poker bonus +$%.2f", (double)bonusCents / 100.0);
+        PostHudToast(toast, HUD_TOAST_EVENT_GENERIC, now);
     }
+    return true;
+}
 
-    if (gCfg.moneyBetMinDollars < gCfg.moneyBetStepDollars)
+// Draws this frame's value of watch id, with its last change from the history ring.
+static bool DrawWatchLine(int id, HudPanelCursor& panel, DWORD now)
+{
+    const WatchSpec& spec = gWatches.Spec(id);
+    if (spec.idx < 0) return true;
+    int32_t val = 0;
+    bool fresh = false;
+    bool ok = gWatches.Value(id, val, &fresh) && fresh;
+    char buf[128];
+    int changes = gWatches.HistoryCount(id);
+    if (!ok)
+        _snprintf_s(buf, sizeof(buf), "%s [%d] = ???", spec.name.c_str(), spec.idx);
+    else if (changes >= 2)
     {
-        int oldMin = gCfg.moneyBetMinDollars;
-        gCfg.moneyBetMinDollars = gCfg.moneyBetStepDollars;
-        moneyCfgClamped = true;
-        Log("[CFG] WARNING: Money.BetMinDollars (%d) < BetStepDollars (%d). Clamped to %d.",
-            oldMin, gCfg.moneyBetStepDollars, gCfg.moneyBetMinDollars);
+        const WatchSample& last = gWatches.HistoryAt(id, changes - 1);
+        const WatchSample& before = gWatches.HistoryAt(id, changes - 2);
+        _snprintf_s(buf, sizeof(buf), "%s [%d] = %d (%+d, %.1fs ago)", spec.name.c_str(), spec.idx, val,
+            last.value - before.value, (double)(now - last.ms) / 1000.0);
     }
+    else
+        _snprintf_s(buf, sizeof(buf), "%s [%d] = %d", spec.name.c_str(), spec.idx, val);
+    return DrawPanelLine(panel, buf);
+}
 
-    if (gCfg.moneyPayoutMultiplier < 1.0f)
+// Rescan tier 0: the globals the overlay watches. Script thread; the scanner gets a copy.
+static void CollectLockedWatchIdx(std::vector<int>& out)
+{
+    out.clear();
+    out.push_back(GetEffectivePotGlobalIndex());
+    for (int stack = 0; stack < kSeatArrayMaxSeats; stack++)
+        out.push_back(GetEffectiveStackGlobalIndex(stack));
+}
+
+// OCR-correlated candidates move to the hot tier; retired ones fall back to cold.
+static void UpdateRescanTier(int slot)
+{
+    int idx = gMoneyCands.idx[(size_t)slot];
+    if (IsOcrCorrelatedCandidate(gMoneyCands, slot) && !IsStepRetired(gMoneyCands, slot))
+        gRescanTiers.MarkHot(idx);
+    else
+        gRescanTiers.Forget(idx);
+}
+
+// ---------------- Epochs ----------------
+// Soft resets and settlements bump a generation in gEpochRequests; the scanner adopts it in
+// ApplyEpochRequests and each candidate catches up (see candidate_epochs.h) the next time the
+// rescan reads or correlates it. Every OCR sample is correlated against the whole store, so no
+// candidate keeps pre-bump counters for longer than one correlation pass; the ranked ones,
+// which the locks read, catch up at the bump.
+static void CatchUpCandidateEpoch(int slot, DWORD now)
+{
+    size_t k = (size_t)slot;
+    uint32_t stamp = gScanEpochs.Stamp();
+    if (gMoneyCands.epoch[k] == stamp)
+        return;
+    EpochCrossing x = CrossedSince(gMoneyCands.epoch[k], stamp);
+    ForgetRankedCandidate(gMoneyCands, slot);
+    CatchUpCandidate(gMoneyCands, slot, x, stamp, (uint32_t)now);
+    int h = gMoneyCands.series[k];
+    if (h >= 0 && x.session)
     {
-        gCfg.moneyPayoutMultiplier = 1.0f;
-        moneyCfgClamped = true;
-        Log("[CFG] WARNING: Money.PayoutMultiplier below 1.0. Clamped to 1.0.");
+        gSeriesPool.Release(h);
+        gMoneyCands.series[k] = -1;
     }
-    else if (gCfg.moneyPayoutMultiplier > 1000.0f)
+    else if (h >= 0 && x.table)
     {
-        gCfg.moneyPayoutMultiplier = 1000.0f;
-        moneyCfgClamped = true;
-        Log("[CFG] WARNING: Money.PayoutMultiplier too large. Clamped to 1000.");
+        gSeriesPool.Ring(h).Reset((uint32_t)now, gMoneyCands.last[k]);
     }
-    gCfg.moneyPayoutMinPhaseConf = ClampFloat(gCfg.moneyPayoutMinPhaseConf, 0.20f, 0.99f);
+    if (x.session || x.table)
+        UpdateRescanTier(slot);
+    RankCandidate(gMoneyCands, slot, now);
+}
 
-    if (gCfg.moneyScanEnd <= gCfg.moneyScanStart)
+static void ApplyEpochRequests(const CandidateEpochs& want, DWORD now)
+{
+    uint32_t before = gScanEpochs.Stamp();
+    bool restart = false;
+    bool session = false;
+    for (int kind = 0; kind < EPOCH_KIND_COUNT; kind++)
     {
-        int oldEnd = gCfg.moneyScanEnd;
-        gCfg.moneyScanEnd = gCfg.moneyScanStart + 1;
-        moneyCfgClamped = true;
-        Log("[CFG] WARNING: Money.ScanEnd must be > ScanStart (%d <= %d). Clamped to %d.",
-            oldEnd, gCfg.moneyScanStart, gCfg.moneyScanEnd);
+        if (want.gen[kind] == gScanEpochs.gen[kind])
+            continue;
+        gScanEpochs.gen[kind] = want.gen[kind];
+        if (kind == EPOCH_HAND)
+            continue;
+        restart = true;
+        session |= kind == EPOCH_SESSION;
+        Log("[MONEY] Epoch: %s %u, %d candidates catch up as they are rescanned.",
+            CandidateEpochName(kind), want.gen[kind], gMoneyCands.Size());
     }
+    if (want.Stamp() == before)
+        return;
 
-    if (gCfg.moneyValueMax < gCfg.moneyValueMin)
+    // The top-K members are the lock candidates: bring them up to date now, not on their next
+    // rescan, so a pre-bump score cannot lock a global.
+    static std::vector<int> memberIdx;
+    memberIdx.clear();
+    for (int cat = 0; cat < RANK_CATEGORY_COUNT; cat++)
     {
-        int oldMax = gCfg.moneyValueMax;
-        gCfg.moneyValueMax = gCfg.moneyValueMin;
-        moneyCfgClamped = true;
-        Log("[CFG] WARNING: Money.ValueMax (%d) < ValueMin (%d). Clamped to %d.",
-            oldMax, gCfg.moneyValueMin, gCfg.moneyValueMax);
+        for (const RankKey& key : gRanking.top[cat].heap)
+            memberIdx.push_back(key.idx);
+    }
+    SortUniqueIntVector(memberIdx);
+    for (int idx : memberIdx)
+    {
+        int slot = gMoneyCands.Find(idx);
+        if (slot >= 0)
+            CatchUpCandidateEpoch(slot, now);
     }
 
-    if (moneyCfgClamped)
-        Log("[CFG] WARNING: Applied safety clamps to Money settings.");
+    if (!restart)
+        return;
+    RestartOcrSeries(now);
+    gSeriesPoolFullLogged = false;
+    if (session)
+    {
+        // Evicted globals get another chance; an open cap round restarts on the new scores.
+        gEvictedBits.clear();
+        gEvictPendingIdx.clear();
+        gEvictor.Clear();
+    }
+}
 
-    // Log config
-    Log("[CFG] PokerRadius=%.2f MsgMs=%d CooldownMs=%d CheckIntervalMs=%d DebugOverlay=%d",
-        gCfg.pokerRadius, gCfg.msgDurationMs, gCfg.enterCooldownMs, gCfg.checkIntervalMs,
-        gCfg.debugOverlay);
-    Log("[CFG] OCR: Enabled=%d IntervalMs=%d ProcTimeoutMs=%d BL=(%d,%d,%d,%d) TR=(%d,%d,%d,%d) PSM=%d DebugReason=%d LogEveryMs=%d DumpArtifacts=%d PhaseStableMs=%d OutStableMs=%d PhaseConf=%.2f OpacityHint=%d OpacityROI=(%d,%d,%d,%d) OpacityRange=[%.1f..%.1f] BlackoutGuard=%d BlackoutOpacity<=%.2f BlackoutGraceMs=%d BlackoutOutExtraMs=%d BlackoutMaxHoldMs=%d PayoutGuard=%d PayoutGraceMs=%d PayoutOutExtraMs=%d PlayerNameHint='%s' Tesseract='%s' Keywords=%d",
-        gCfg.ocrEnabled, gCfg.ocrIntervalMs,
-        gCfg.ocrProcessTimeoutMs,
-        gCfg.ocrBottomLeftXPct, gCfg.ocrBottomLeftYPct, gCfg.ocrBottomLeftWPct, gCfg.ocrBottomLeftHPct,
-        gCfg.ocrTopRightXPct, gCfg.ocrTopRightYPct, gCfg.ocrTopRightWPct, gCfg.ocrTopRightHPct,
-        gCfg.ocrPsm, gCfg.ocrDebugReasonOverlay, gCfg.ocrLogEveryMs, gCfg.ocrDumpArtifacts,
-        gCfg.ocrPhaseStableMs, gCfg.ocrOutStableMs, gCfg.ocrPhaseConfThreshold,
-        gCfg.ocrOpacityHintEnable,
-        gCfg.ocrOpacityRoiXPct, gCfg.ocrOpacityRoiYPct, gCfg.ocrOpacityRoiWPct, gCfg.ocrOpacityRoiHPct,
-        gCfg.ocrOpacityLow, gCfg.ocrOpacityHigh,
-        gCfg.ocrBlackoutGuardEnable, gCfg.ocrBlackoutOpacityThreshold, gCfg.ocrBlackoutAnchorGraceMs, gCfg.ocrBlackoutOutExtraMs, gCfg.ocrBlackoutMaxHoldMs,
-        gCfg.ocrPayoutGuardEnable, gCfg.ocrPayoutMarkerGraceMs, gCfg.ocrPayoutOutExtraMs,
-        gCfg.ocrPlayerNameHint.c_str(),
-        gCfg.ocrTesseractPath.c_str(), (int)gOcrKeywords.size());
+static void CorrelateRescannedCandidate(int slot, DWORD now)
+{
+    CatchUpCandidateEpoch(slot, now);
+    UpdateCandidateOcrMatches(gMoneyCands, slot, gMoneyCands.last[(size_t)slot], now);
+    // A candidate that moves with an OCR amount marks the struct it lives in: read around it next.
+    size_t k = (size_t)slot;
+    if (gMoneyCands.changes[k] > 0 &&
+        gMoneyCands.ocrPotMatches[k] + gMoneyCands.ocrPlayerMatches[k] + gMoneyCands.ocrNpcMatches[k] >= kDiscoveryAnchorMatches)
+        gDiscovery.OnCorrelated(gMoneyCands.idx[k]);
+    if (gCfg.moneyCorrEnable)
+        TrackCandidateSeries(slot, now);
+    UpdateRescanTier(slot);
+    RankCandidate(gMoneyCands, slot, now);
+}
+
+// v0.5 OCR: Re-read existing candidates and track value changes. gRescanTiers picks the slots
+// read this step. A new OCR sample is correlated against every candidate over the next few steps,
+// using the cached value for slots the tiers did not read. Returns the number of reads.
+static int RescanExistingCandidates(DWORD now, int64_t budgetUs)
+{
+    static std::vector<int> sel;         // slots read this step, ascending
+    static std::vector<uint8_t> selTier;
+    static std::vector<int> selIdx;
+    static std::vector<int> prevVals;
+    static std::vector<int> rescanVals;
+    static std::vector<unsigned char> rescanOk;
+    static std::vector<unsigned char> dead;
+    static std::vector<int> moved;
+    static SnapshotDiff diff;
+
+    RescanBudget budget;
+    // Sized like a discovery chunk: what is left of the step at the learned per-candidate cost.
+    constexpr int kMinRescanReads = 64;  // progress guarantee when discovery ran over
+    budget.maxReads = gScanSched.RescansForBudget(budgetUs, kMinRescanReads, gCfg.moneyScanMaxReadsPerStep);
+    budget.stepIntervalMs = (uint32_t)(std::max)(1, gCfg.moneyScanIntervalMs / 2);
+    budget.coldMaxAgeMs = (uint32_t)gCfg.moneyRescanColdMaxAgeMs;
+    gRescanTiers.SetLocked(gScanLockedIdx);
+    gRescanTiers.Plan(gMoneyCands, budget, (uint32_t)now, sel, selTier);
+    int n = (int)sel.size();
+    if (n <= 0)
+        return 0;
+
+    // Ascending slots are ascending global indices, so neighbours still share one bulk read.
+    selIdx.resize((size_t)n);
+    prevVals.resize((size_t)n);
+    rescanVals.resize((size_t)n);
+    rescanOk.resize((size_t)n);
+    for (int i = 0; i < n; i++)
+    {
+        size_t k = (size_t)sel[(size_t)i];
+        selIdx[(size_t)i] = gMoneyCands.idx[k];
+        prevVals[(size_t)i] = gMoneyCands.last[k];
+    }
+    ReadGlobalIndices(selIdx.data(), n, rescanVals.data(), rescanOk.data());
+
+    // Diff positions index sel; only positions that moved need the scalar path.
+    DiffSnapshot(prevVals.data(), rescanVals.data(), n, gCfg.moneyValueMin, gCfg.moneyValueMax, diff);
+    for (int i = 0; i < n; i++)
+    {
+        size_t k = (size_t)sel[(size_t)i];
+        gRescanTiers.OnRead(selTier[(size_t)i], (uint32_t)(now - gMoneyCands.lastSeenMs[k]));
+        gMoneyCands.lastSeenMs[k] = now;
+        CatchUpCandidateEpoch(sel[(size_t)i], now);
+    }
+
+    // Drop unreadable candidates and ones whose value left the valid range
+    dead.assign((size_t)gMoneyCands.Size(), 0);
+    bool anyDead = false;
+    for (int i = 0; i < n; i++)
     {
-        bool usingPortableOcr = false;
-        std::string ocrExePath = ResolveOcrExecutablePath(usingPortableOcr);
-        Log("[CFG] OCR runtime: resolved='%s' portable=%d gameDir='%s'",
-            ocrExePath.c_str(), usingPortableOcr ? 1 : 0, gGameDirPath);
+        if (!rescanOk[(size_t)i] || (diff.outOfRangeCount > 0 && diff.OutOfRange(i)))
+        {
+            dead[(size_t)sel[(size_t)i]] = 1;
+            anyDead = true;
+        }
     }
-    Log("[CFG] HUD: DrawMethod=%d HUDUiMode=%d ToastEnabled=%d ToastFallbackText=%d ToastIconDict='%s' ToastIcon='%s' ToastColor='%s' ToastDurationMs=%d ToastRetryMs=%d Panel=(%d,%d) LineStep=%.2f MaxLines=%d AnchorBottom=%d ToastSoundSet='%s' ToastSound='%s'",
-        gDrawMethod, gCfg.hudUiMode, gCfg.hudToastEnabled, gCfg.hudToastFallbackText,
-        gCfg.hudToastIconDict.c_str(), gCfg.hudToastIcon.c_str(), gCfg.hudToastColor.c_str(),
-        gCfg.hudToastDurationMs, gCfg.hudToastRetryMs, gCfg.hudPanelX, gCfg.hudPanelY, gCfg.hudPanelLineStep, gCfg.hudPanelMaxLines, gCfg.hudPanelAnchorBottom,
-        gCfg.hudToastSoundSet.c_str(), gCfg.hudToastSound.c_str());
 
-    Log("[CFG] Money: Overlay=%d ScanEnable=%d Range=[%d..%d) Batch=%d IntervalMs=%d ValueRange=[%d..%d] TopN=%d PruneMs=%d",
-        gCfg.moneyOverlay, gCfg.moneyScanEnable,
-        gCfg.moneyScanStart, gCfg.moneyScanEnd,
-        gCfg.moneyScanBatch, gCfg.moneyScanIntervalMs,
-        gCfg.moneyValueMin, gCfg.moneyValueMax,
-        gCfg.moneyTopN, gCfg.moneyPruneMs);
-    Log("[CFG] Money perf: ScanMaxReadsPerStep=%d ScanMaxStepMs=%d ExceptionLogCooldownMs=%d SkipFaultRuns=%d LikelyMaxChangesPerSec=%.2f BetStepFilter=%d BetStepDollars=%d BetMinDollars=%d",
-        gCfg.moneyScanMaxReadsPerStep, gCfg.moneyScanMaxStepMs,
-        gCfg.moneyExceptionLogCooldownMs, gCfg.moneySkipFaultRuns, gCfg.moneyLikelyMaxChangesPerSec,
-        gCfg.moneyBetStepFilterEnable, gCfg.moneyBetStepDollars, gCfg.moneyBetMinDollars);
-    Log("[CFG] Money OCR: OcrMatchToleranceCents=%d NpcTrackMax=%d AutoLockPot=%d AutoLockPotMinMatches=%d AutoLockPlayer=%d AutoLockPlayerMinMatches=%d OverlayMultiplier=%.2f",
-        gCfg.moneyOcrMatchToleranceCents, gCfg.moneyNpcTrackMax, gCfg.moneyAutoLockPot, gCfg.moneyAutoLockPotMinMatches,
-        gCfg.moneyAutoLockPlayer, gCfg.moneyAutoLockPlayerMinMatches, gCfg.moneyOverlayMultiplier);
-    Log("[CFG] Money payout: Enable=%d Multiplier=%.2f UseWinsAmount=%d FallbackToPot=%d CooldownMs=%d MinPhaseConf=%.2f",
-        gCfg.moneyPayoutEnable, gCfg.moneyPayoutMultiplier, gCfg.moneyPayoutUseWinsAmount,
-        gCfg.moneyPayoutFallbackToPot, gCfg.moneyPayoutCooldownMs, gCfg.moneyPayoutMinPhaseConf);
-    if (gCfg.moneyLogEnable)
+    moved.clear();
+    for (size_t d = 0; d < diff.slots.size(); d++)
     {
-        Log("[CFG] Money log: LogEnable=%d LogIntervalMs=%d LogTopN=%d LogOnlyOnChange=%d",
-            gCfg.moneyLogEnable, gCfg.moneyLogIntervalMs, gCfg.moneyLogTopN, gCfg.moneyLogOnlyOnChange);
+        int i = diff.slots[d];
+        size_t k = (size_t)sel[(size_t)i];
+        if (dead[k])
+            continue;
+        int delta = diff.deltas[d];
+        int absDelta = (delta < 0) ? -delta : delta;
+        gMoneyCands.changes[k]++;
+        gMoneyCands.lastDelta[k] = delta;
+        if (MatchesBetGridDelta(absDelta, gCandidateRules))
+            gMoneyCands.betStepMatches[k]++;
+        else
+            gMoneyCands.betStepMismatches[k]++;
+        gMoneyCands.last[k] = rescanVals[(size_t)i];
+        gMoneyCands.lastChangeMs[k] = now;
+        if (gMoneyCands.series[k] >= 0)
+            gSeriesPool.Ring(gMoneyCands.series[k]).Push((uint32_t)now, rescanVals[(size_t)i]);
+        moved.push_back((int)k);
     }
 
-    // Estimate wrap time
-    if (gCfg.moneyScanEnable && gCfg.moneyScanBatch > 0 && gCfg.moneyScanIntervalMs > 0)
+    // A new OCR sample can match values that did not move: while its pass runs, every slot read
+    // this step is correlated, plus as many further slots (the same budgeted cap) from their cached value.
+    if (gScanOcr.sampleId != gRescanOcrPassSampleId)
     {
-        int range = gCfg.moneyScanEnd - gCfg.moneyScanStart;
-        int effectiveBatch = (std::min)(gCfg.moneyScanBatch, gCfg.moneyScanMaxReadsPerStep);
-        if (effectiveBatch > 0)
+        gRescanOcrPassSampleId = gScanOcr.sampleId;
+        gRescanOcrPassIdx = 0;
+        if (gCfg.moneyCorrEnable && gScanOcr.sampleId > 0)
+            RecordOcrSeries();
+    }
+    if (gRescanOcrSampleId != gScanOcr.sampleId)
+    {
+        for (int i = 0; i < n; i++)
         {
-            float steps = (float)range / (float)effectiveBatch;
-            float wrapSec = steps * gCfg.moneyScanIntervalMs / 1000.0f;
-            Log("[CFG] Money estWrap=%.1fs (approx, cap-based)", wrapSec);
+            int slot = sel[(size_t)i];
+            if (!dead[(size_t)slot])
+                CorrelateRescannedCandidate(slot, now);
+        }
+        int size = gMoneyCands.Size();
+        int slot = (int)(std::lower_bound(gMoneyCands.idx.begin(), gMoneyCands.idx.end(), gRescanOcrPassIdx) - gMoneyCands.idx.begin());
+        int passEnd = (std::min)(size, slot + budget.maxReads);
+        for (; slot < passEnd; slot++)
+        {
+            if (!dead[(size_t)slot])
+                CorrelateRescannedCandidate(slot, now);
+        }
+        if (slot >= size)
+            gRescanOcrSampleId = gScanOcr.sampleId;  // every candidate has seen this sample
+        else
+            gRescanOcrPassIdx = gMoneyCands.idx[(size_t)slot];
+    }
+    else
+    {
+        for (int slot : moved)
+            CorrelateRescannedCandidate(slot, now);
+    }
+
+    if (anyDead)
+    {
+        for (int slot = 0; slot < gMoneyCands.Size(); slot++)
+        {
+            if (dead[(size_t)slot])
+                ForgetRankedCandidate(gMoneyCands, slot);
         }
+        ReleaseCompactedCandidates(dead);
+        gMoneyCands.Compact(dead);
     }
 
-    Log("[CFG] Money Watch: PotGlobal=%d StackGlobals=%d,%d,%d,%d,%d,%d",
-        gCfg.potGlobal,
-        gCfg.stackGlobal0, gCfg.stackGlobal1, gCfg.stackGlobal2,
-        gCfg.stackGlobal3, gCfg.stackGlobal4, gCfg.stackGlobal5);
+    // Step counters move eligibility both ways, so the best-K sets are rebuilt.
+    if (gCfg.moneyCorrEnable && SettleOcrSeries(now))
+        gRanking.stale = true;
+    return n;
 }
 
-static int GetEffectivePotGlobalIndex()
+// ---------------- Candidate cap ----------------
+// ValueMin=1 admits nearly every small positive global, so the store is capped. Above
+// CandidateCap a round evicts the lowest keep scores (rank score, OCR correlation, staleness)
+// down to 7/8 of the cap. The round is spread over scan steps: each step scores the slice of
+// slots gScanSched fits in what is left of the step budget and queues those at or below the
+// sampled threshold. Queued victims leave the store with the next compaction the step does
+// anyway (pruning), or with one compaction when the round closes, not one per slice.
+static const int kCapMinSliceCands = 1024;   // a round always moves, even on a spent step
+static const int kCapMaxSliceCands = 4096;
+
+static bool IsEvictedIdx(int idx)
 {
-    if (gCfg.potGlobal >= 0)
-        return gCfg.potGlobal;
-    return gAutoPotGlobal;
+    size_t word = (size_t)idx >> 6;
+    return word < gEvictedBits.size() && ((gEvictedBits[word] >> (idx & 63)) & 1ull) != 0;
 }
 
-static int GetEffectivePlayerGlobalIndex()
+static void MarkEvictedIdx(int idx)
 {
-    if (gCfg.stackGlobal0 >= 0)
-        return gCfg.stackGlobal0;
-    return gAutoPlayerGlobal;
+    size_t word = (size_t)idx >> 6;
+    if (word >= gEvictedBits.size())
+        gEvictedBits.resize(word + 1, 0);
+    gEvictedBits[word] |= 1ull << (idx & 63);
 }
 
-static bool TryReadEffectivePotCents(int& outPotCents)
+// Re-admitted on an OCR match. While a slot is in the store, the bit means "queued by the round".
+static void ClearEvictedIdx(int idx)
 {
-    outPotCents = 0;
-    int idx = GetEffectivePotGlobalIndex();
-    if (idx < 0)
-        return false;
-    int val = 0;
-    if (!ReadGlobalInt(idx, val))
-        return false;
-    outPotCents = val;
-    return true;
+    size_t word = (size_t)idx >> 6;
+    if (word < gEvictedBits.size())
+        gEvictedBits[word] &= ~(1ull << (idx & 63));
 }
 
-static bool TryReadEffectivePlayerCents(int& outPlayerCents)
+static float CandidateKeepScore(int slot, DWORD now)
 {
-    outPlayerCents = 0;
-    int idx = GetEffectivePlayerGlobalIndex();
-    if (idx < 0)
-        return false;
-    int val = 0;
-    if (!ReadGlobalInt(idx, val))
-        return false;
-    outPlayerCents = val;
-    return true;
+    static const EvictionWeights weights;
+    size_t k = (size_t)slot;
+    DWORD lastUseful = (std::max)((std::max)(gMoneyCands.firstSeenMs[k], gMoneyCands.lastChangeMs[k]), gMoneyCands.lastOcrMatchMs[k]);
+    return EvictionKeepScore(CandidateRankScore(gMoneyCands, slot, now, gCandidateRules), (uint32_t)(now - lastUseful),
+        IsOcrCorrelatedCandidate(gMoneyCands, slot), weights);
 }
 
-static bool CandidatePassesPotAutoLockChecks(const MoneyCandidate& c, DWORD now)
+static bool IsScanLockedIdx(int idx)
 {
-    if (c.ocrPotMatches < gCfg.moneyAutoLockPotMinMatches)
-        return false;
-    if (c.changes < 2)
-        return false;
-    if (!IsLikelyMoneyCandidate(c, now))
-        return false;
-    if (c.ocrPlayerMatches * 2 > c.ocrPotMatches)
-        return false;
-    if (c.ocrAnyMatches > 0 && c.ocrPotMatches * 2 < c.ocrAnyMatches)
-        return false;
-    if (gCfg.moneyBetStepFilterEnable)
+    return std::find(gScanLockedIdx.begin(), gScanLockedIdx.end(), idx) != gScanLockedIdx.end();
+}
+
+// One slice of the open round. live = store size minus what dead already drops this step;
+// compacting = the step compacts anyway. Returns the queued victims marked in dead.
+static int StepCandidateCap(DWORD now, int64_t budgetUs, int live, bool compacting, std::vector<unsigned char>& dead)
+{
+    int cap = gCfg.moneyCandidateCap;
+    int n = gMoneyCands.Size();
+    bool opening = gEvictor.Owed() == 0;
+    if (gEvictor.Update(live - (int)gEvictPendingIdx.size(), cap) > 0)
     {
-        int totalBet = c.betStepMatches + c.betStepMismatches;
-        if (totalBet >= 4 && c.betStepMatches * 2 < totalBet)
-            return false;
+        auto keepAt = [now, &dead](int slot, float& keep)
+        {
+            int idx = gMoneyCands.idx[(size_t)slot];
+            if (dead[(size_t)slot] || IsEvictedIdx(idx) || IsScanLockedIdx(idx))
+                return false;
+            keep = CandidateKeepScore(slot, now);
+            return true;
+        };
+        if (opening)
+        {
+            gEvictRoundCursorIdx = 0;
+            gEvictRoundCount = 0;
+            gEvictRoundSteps = 0;
+            gEvictor.Sample(n, keepAt);
+        }
+        gEvictRoundSteps++;
+
+        int64_t sliceStartUs = QpcNowUs();
+        int slice = gScanSched.EvictScoresForBudget(budgetUs, kCapMinSliceCands, kCapMaxSliceCands);
+        int slot = (int)(std::lower_bound(gMoneyCands.idx.begin(), gMoneyCands.idx.end(), gEvictRoundCursorIdx) - gMoneyCands.idx.begin());
+        int scored = 0;
+        bool wrapped = false;
+        while (scored < slice && gEvictor.Owed() > 0)
+        {
+            if (slot >= n)
+            {
+                // A whole pass left some owed: the sample put the threshold too low.
+                if (wrapped)
+                    break;
+                wrapped = true;
+                slot = 0;
+                gEvictor.Sample(n, keepAt);
+                continue;
+            }
+            size_t k = (size_t)slot++;
+            int idx = gMoneyCands.idx[k];
+            if (dead[k] || IsEvictedIdx(idx))
+                continue;
+            scored++;
+            if (gEvictor.Evicts(CandidateKeepScore((int)k, now)) && !IsScanLockedIdx(idx))
+            {
+                MarkEvictedIdx(idx);
+                gEvictPendingIdx.push_back(idx);
+                gEvictor.OnEvicted(1);
+            }
+        }
+        gEvictRoundCursorIdx = (slot < n) ? gMoneyCands.idx[(size_t)slot] : 0;
+        gScanSched.OnEvictScores(scored, QpcNowUs() - sliceStartUs);
     }
-    return true;
+
+    if (gEvictPendingIdx.empty() || (!compacting && gEvictor.Owed() > 0))
+        return 0;
+    int marked = 0;
+    for (int idx : gEvictPendingIdx)
+    {
+        int slot = gMoneyCands.Find(idx);
+        if (slot >= 0 && !dead[(size_t)slot])
+        {
+            dead[(size_t)slot] = 1;
+            marked++;
+        }
+    }
+    gEvictPendingIdx.clear();
+    gEvictedTotal += marked;
+    gEvictRoundCount += marked;
+    if (gEvictor.Owed() == 0 && now >= gNextEvictLogAt)
+    {
+        Log("[MONEY] CandidateCap: evicted %d candidates over %d steps (cap=%d, now %d, %d evicted since reset).",
+            gEvictRoundCount, gEvictRoundSteps, cap, live - marked, gEvictedTotal);
+        gNextEvictLogAt = now + 10000;
+    }
+    return marked;
 }
 
-static bool TryAutoLockPotGlobal(const std::vector<const MoneyCandidate*>& sorted, DWORD now)
+// Scanner-owned subsystems; the script thread adds its own in UpdateMemoryLedger.
+static void MeasureScannerMemory(MemoryUsage& u)
 {
-    if (!gCfg.moneyAutoLockPot)
-        return false;
-    if (gCfg.potGlobal >= 0 || gAutoPotGlobal >= 0)
-        return false;
-    if (gOcrMoney.potSource == 5)
-        return false; // fallback OCR pot is too ambiguous for auto-lock
-    if (sorted.empty())
-        return false;
+    u = MemoryUsage();
+    u.bytes[MEM_CANDIDATES] = gMoneyCands.MemoryBytes() + gEvictedBits.capacity() * sizeof(uint64_t) + gEvictor.MemoryBytes()
+        + gEvictPendingIdx.capacity() * sizeof(int);
+    for (int cat = 0; cat < RANK_CATEGORY_COUNT; cat++)
+        u.bytes[MEM_RANKING] += gRanking.top[cat].MemoryBytes() + gRankedSlots.slots[cat].capacity() * sizeof(int);
+    u.bytes[MEM_SERIES] = gSeriesPool.MemoryBytes();
+    u.bytes[MEM_RESCAN] = gRescanTiers.MemoryBytes();
+    u.bytes[MEM_FAULT_MAP] = gFaultMap.MemoryBytes() + gDiscovery.MemoryBytes();
+}
 
-    for (const MoneyCandidate* c : sorted)
-    {
-        if (!c)
-            continue;
-        if (!CandidatePassesPotAutoLockChecks(*c, now))
-            continue;
-        if (gOcrMoney.potCents > 0 && gOcrMoney.potSource != 5 &&
-            !CandidateMatchesObservedOcrAmount(c->last, gOcrMoney.potCents))
-            continue;
-        if (c->lastOcrMatchMs == 0)
-            continue;
-        if ((now - c->lastOcrMatchMs) > 12000)
-            continue;
+// ---------------- Typed scan ----------------
+// Discovery decodes each raw slot as int32 for the candidate store. With TypedScan=1 the same
+// slots are also decoded as float and as the high int32 half and matched against the current
+// OCR amounts; repeat matches are logged so such globals can be put on a watch. int64 is not
+// scanned here: an in-range int64 has a zero high half and is already an int32 candidate.
+using MoneyValueScanner = Scanner<SlotInt32, InRange<SlotInt32>>;
+using TypedFloatScanner = Scanner<SlotFloat, AllOf<InRange<SlotFloat>, NearAnyAmount<SlotFloat>>>;
+using TypedHigh32Scanner = Scanner<SlotHigh32, AllOf<InRange<SlotHigh32>, NearAnyAmount<SlotHigh32>>>;
+using TypedMoneyScanner = MultiScanner<TypedFloatScanner, TypedHigh32Scanner>;
+
+constexpr int kTypedHitMax = 256;
+constexpr int kTypedHitLogMatches = 3;  // distinct OCR samples before a typed hit is logged
+
+// Points the predicates at the current OCR amounts; hit vectors keep their capacity.
+static void SetTypedMoneyScanner(TypedMoneyScanner& s)
+{
+    const int* amounts = gScanOcr.amountsCents.data();
+    int count = (int)gScanOcr.amountsCents.size();
+    int tol = (std::max)(0, gCfg.moneyOcrMatchToleranceCents);
+    // A float may hold dollars where an int holds cents, so ValueMin cents is its floor.
+    std::get<0>(s.scanners).pred.preds = {
+        { (float)gCfg.moneyValueMin / 100.0f, (float)gCfg.moneyValueMax },
+        { amounts, count, tol } };
+    std::get<1>(s.scanners).pred.preds = {
+        { gCfg.moneyValueMin, gCfg.moneyValueMax },
+        { amounts, count, tol } };
+}
 
-        gAutoPotGlobal = c->idx;
-        Log("[MONEY] AutoLock: Pot global locked to idx=%d (ocrPot=%d ocrAny=%d changes=%d val=%d).",
-            c->idx, c->ocrPotMatches, c->ocrAnyMatches, c->changes, c->last);
-        char idxBuf[32];
-        _snprintf_s(idxBuf, sizeof(idxBuf), "%d", gAutoPotGlobal);
-        WritePrivateProfileStringA("Money", "PotGlobal", idxBuf, gIniPath);
-        Log("[MONEY] AutoLock: Persisted PotGlobal=%d to %s.", gAutoPotGlobal, gIniPath);
-        if (gCfg.hudUiMode != HUD_UI_MODE_LEGACY_TEXT)
+static void RecordTypedHit(const char* type, int idx, double value)
+{
+    TypedMoneyHit* slot = nullptr;
+    TypedMoneyHit* weakest = nullptr;
+    for (TypedMoneyHit& t : gTypedHits)
+    {
+        if (t.idx == idx && t.type == type)
         {
-            char toast[128];
-            _snprintf_s(toast, sizeof(toast), "Pot source locked [%d]", c->idx);
-            PostHudToast(toast, HUD_TOAST_EVENT_GENERIC, now);
+            slot = &t;
+            break;
         }
-        return true;
+        if (!weakest || t.matches < weakest->matches)
+            weakest = &t;
+    }
+    if (!slot)
+    {
+        if ((int)gTypedHits.size() < kTypedHitMax)
+        {
+            gTypedHits.push_back(TypedMoneyHit{});
+            slot = &gTypedHits.back();
+        }
+        else if (weakest->matches <= 1)
+        {
+            slot = weakest;  // one-off matches make room for new ones
+        }
+        else
+        {
+            return;
+        }
+        *slot = TypedMoneyHit{};
+        slot->idx = idx;
+        slot->type = type;
     }
 
-    return false;
+    slot->value = value;
+    if (slot->lastSampleId == gScanOcr.sampleId)
+        return;
+    slot->lastSampleId = gScanOcr.sampleId;
+    slot->matches++;
+    if (slot->matches == kTypedHitLogMatches)
+    {
+        Log("[MONEY] TypedScan: %s idx=%d val=%.2f matched %d OCR samples.",
+            slot->type, slot->idx, slot->value, slot->matches);
+    }
 }
 
-static bool TryAutoLockPlayerGlobal(DWORD now)
+template <class Codec, class Hit>
+static void RecordTypedHits(const std::vector<Hit>& hits)
 {
-    if (!gCfg.moneyAutoLockPlayer)
-        return false;
-    if (gCfg.stackGlobal0 >= 0 || gAutoPlayerGlobal >= 0)
-        return false;
-    if (gOcrMoney.playerCents <= 0)
-        return false;
+    for (const Hit& hit : hits)
+        RecordTypedHit(Codec::Name(), hit.idx, (double)hit.value);
+}
+
+// Scan step budget in microseconds. On the script thread it also backs off on hitch frames.
+static int64_t ScanStepBudgetUs(bool onScriptThread)
+{
+    int64_t budgetUs = (gCfg.moneyScanBudgetUs > 0)
+        ? (int64_t)gCfg.moneyScanBudgetUs
+        : (int64_t)gCfg.moneyScanMaxStepMs * 1000;
+    return onScriptThread ? gFrameClock.ScaleBudget(budgetUs) : budgetUs;
+}
 
-    const MoneyCandidate* best = nullptr;
-    float bestScore = -1e9f;
-    for (const auto& kv : gMoneyCands)
+// Discovery, rescan and prune. Runs inline from MoneyTick, or on the scan worker when ScanWorker=1 - never both.
+static void MoneyScanStep(DWORD now, bool onScriptThread)
+{
+    int64_t stepStartUs = QpcNowUs();
+    int64_t stepBudgetUs = ScanStepBudgetUs(onScriptThread);
+    if (!gWarmStartSeeds.empty() && GlobalsReady())
+        SeedWarmStart(now);
+    bool rescanDue = GlobalsReady() && now >= gNextMoneyRescanAt;
+
+    // ---- Scan: discover new candidates ----
+    if (gCfg.moneyScanEnable && GlobalsReady() && now >= gNextMoneyScanAt)
     {
-        const MoneyCandidate& c = kv.second;
-        if (c.ocrPlayerMatches < gCfg.moneyAutoLockPlayerMinMatches)
-            continue;
-        if (c.lastOcrMatchMs == 0 || (now - c.lastOcrMatchMs) > 12000)
-            continue;
+        gNextMoneyScanAt = now + gCfg.moneyScanIntervalMs;
+
+        // Leave room for this step's rescan, at the learned per-read cost. The rescan is capped
+        // to what is left of the step, so discovery keeps at least half of it.
+        int64_t discoveryBudgetUs = stepBudgetUs;
+        if (rescanDue)
+            discoveryBudgetUs -= (std::min)(stepBudgetUs / 2,
+                gScanSched.ExpectedRescanUs((std::min)(gMoneyCands.Size(), gCfg.moneyScanMaxReadsPerStep)));
+        constexpr int kMinDiscoveryReads = 256;  // progress guarantee when the rescan eats the budget
+
+        int reads = 0;
+        int maxReads = (std::min)(gCfg.moneyScanBatch, gCfg.moneyScanMaxReadsPerStep);
+        int consecutiveSehFaults = 0;
+        constexpr int kFaultRunThreshold = 16;
+        constexpr int kFaultRunSkipSpan = 256;
+        constexpr int kDiscoveryChunk = 4096;   // slots per bulk read between time-budget checks
+        static std::vector<uint64_t> chunkSlots;
+        static std::vector<uint64_t> chunkFaults;
+        static std::vector<MoneyCandidate> discovered;
+        static std::vector<MoneyValueScanner::Hit> valueHits;
+        discovered.clear();
+        MoneyValueScanner valueScanner{ { gCfg.moneyValueMin, gCfg.moneyValueMax } };
+        bool typedScan = gCfg.moneyTypedScan && !gScanOcr.amountsCents.empty();
+        static TypedMoneyScanner typedScanner;
+        if (typedScan)
+            SetTypedMoneyScanner(typedScanner);
+        bool stepDone = false;
+        bool passDone = false;
+        SyncDiscoveryPlan();
+        if (gCfg.moneyFaultMapEnable)
+            reads += ProbeSavedFaultRanges();
+
+        while (!stepDone && reads < maxReads)
+        {
+            int64_t spentUs = QpcNowUs() - stepStartUs;
+            if (reads > 0 && spentUs >= discoveryBudgetUs)
+                break;
+
+            int spanStart = 0;
+            int spanEnd = 0;
+            int source = 0;
+            if (!gDiscovery.Next((std::min)(maxReads - reads, kDiscoveryChunk), spanStart, spanEnd, source))
+            {
+                passDone = true;
+                break;
+            }
+
+            // Never touch ranges already known to fault.
+            int readableFrom = gFaultMap.SkipKnownBad(spanStart);
+            if (readableFrom != spanStart)
+            {
+                gDiscovery.MarkRead(spanStart, readableFrom);
+                continue;
+            }
+
+            int chunkStart = spanStart;
+            int chunkLen = spanEnd - chunkStart;
+            chunkLen = (std::min)(chunkLen, gFaultMap.NextBadStart(chunkStart) - chunkStart);
+            chunkLen = (std::min)(chunkLen, gScanSched.ReadsForBudget(discoveryBudgetUs - spentUs, kMinDiscoveryReads, kDiscoveryChunk));
+            chunkSlots.resize((size_t)chunkLen);
+            chunkFaults.resize((size_t)((chunkLen + 63) >> 6));
+            int64_t readStartUs = QpcNowUs();
+            ReadGlobalRange(chunkStart, chunkLen, chunkSlots.data(), chunkFaults.data());
+            int64_t readEndUs = QpcNowUs();
+            gScanSched.OnReads(chunkLen, readEndUs - readStartUs, readEndUs);
+            if (gCfg.moneyFaultMapEnable)
+                gFaultMap.Record(chunkStart, chunkLen, chunkFaults.data());
+            reads += chunkLen;
+
+            // A long fault run ends the step; only slots up to the cut are scanned.
+            int scanLen = chunkLen;
+            int readEnd = chunkStart + chunkLen;
+            for (int k = 0; k < chunkLen; k++)
+            {
+                if ((k & 63) == 0 && chunkFaults[(size_t)k >> 6] == 0)
+                {
+                    consecutiveSehFaults = 0;
+                    k += 63;  // whole word readable
+                    continue;
+                }
+                if (!GlobalFaultBitTest(chunkFaults.data(), k))
+                {
+                    consecutiveSehFaults = 0;
+                    continue;
+                }
+                consecutiveSehFaults++;
+                if (gCfg.moneySkipFaultRuns && consecutiveSehFaults >= kFaultRunThreshold)
+                {
+                    int i = chunkStart + k;
+                    int oldCursor = i + 1;
+                    readEnd = oldCursor;
+                    int skipCursor = (std::min)(i + kFaultRunSkipSpan + 1, gCfg.moneyScanEnd);
+                    if (skipCursor > oldCursor)
+                    {
+                        readEnd = skipCursor;
+                        if (now >= gNextFaultRunSkipLogAt)
+                        {
+                            Log("[MONEY] SkipFaultRuns: %d consecutive SEH faults near idx=%d. cursor %d -> %d.",
+                                consecutiveSehFaults, i, oldCursor, readEnd);
+                            gNextFaultRunSkipLogAt = now + 2000;
+                        }
+                    }
+                    scanLen = k + 1;
+                    stepDone = true;
+                    break;
+                }
+            }
+            gDiscovery.MarkRead(chunkStart, readEnd);
+            gMoneyScanCursor = readEnd;
+
+            valueHits.clear();
+            valueScanner.Scan(chunkStart, chunkSlots.data(), scanLen, chunkFaults.data(), valueHits);
+            for (const MoneyValueScanner::Hit& hit : valueHits)
+            {
+                // Skip if already a candidate
+                if (gMoneyCands.Contains(hit.idx))
+                    continue;
+                MoneyCandidate mc;
+                mc.idx = hit.idx;
+                mc.last = hit.value;
+                mc.changes = 0;
+                mc.firstSeenMs = now;
+                mc.lastSeenMs = now;
+                mc.lastChangeMs = 0;
+                mc.epoch = gScanEpochs.Stamp();
+                UpdateCandidateOcrMatches(mc, hit.value, now);
+                if (IsEvictedIdx(hit.idx) && mc.ocrAnyMatches == 0 && mc.ocrPotMatches == 0 &&
+                    mc.ocrPlayerMatches == 0 && mc.ocrNpcMatches == 0)
+                    continue;
+                discovered.push_back(mc);
+            }
+
+            if (typedScan)
+            {
+                typedScanner.Clear();
+                typedScanner.Scan(chunkStart, chunkSlots.data(), scanLen, chunkFaults.data());
+                RecordTypedHits<SlotFloat>(std::get<0>(typedScanner.hits));
+                RecordTypedHits<SlotHigh32>(std::get<1>(typedScanner.hits));
+            }
+        }
 
-        float score = (float)c.ocrPlayerMatches * 12.0f
-            - (float)c.ocrPotMatches * 7.0f
-            - (float)c.ocrNpcMatches * 2.5f
-            + (float)c.ocrAnyMatches * 0.5f;
-        if (score > bestScore)
+        // Spans come from several windows per step, so discoveries arrive out of order.
+        std::sort(discovered.begin(), discovered.end(),
+            [](const MoneyCandidate& a, const MoneyCandidate& b) { return a.idx < b.idx; });
+        gMoneyCands.InsertSorted(discovered);
+        for (const MoneyCandidate& mc : discovered)
         {
-            bestScore = score;
-            best = &c;
+            ClearEvictedIdx(mc.idx);
+            if (mc.ocrAnyMatches > 0 || mc.ocrPotMatches > 0 || mc.ocrPlayerMatches > 0 || mc.ocrNpcMatches > 0)
+            {
+                gRescanTiers.MarkHot(mc.idx);
+                RankCandidate(gMoneyCands, gMoneyCands.Find(mc.idx), now);
+            }
         }
-    }
 
-    if (!best)
-        return false;
+        // Wrap: every slot of the range has been read once.
+        if (passDone)
+        {
+            BeginDiscoveryPass();
+            gMoneyScanCursor = gCfg.moneyScanStart;
+            gMoneyScanWrapCount++;
+            gScanSched.OnWrap(QpcNowUs());
+            if (gCfg.moneyFaultMapEnable && gFaultMap.Rebuild(kFaultRunThreshold))
+            {
+                QueueFaultMapSave();
+                Log("[MONEY] FaultMap: %d bad ranges (%d slots) after wrap %d, saving.",
+                    (int)gFaultMap.Intervals().size(), gFaultMap.BadSlotCount(), gMoneyScanWrapCount);
+            }
+            if (!gMoneyScanWrapped)
+            {
+                gMoneyScanWrapped = true;
+                const DiscoveryPlanMetrics& m = gDiscovery.Metrics();
+                int64_t total = m.slots[DISCOVERY_REFINE] + m.slots[DISCOVERY_SEED] + m.slots[DISCOVERY_COARSE] + m.slots[DISCOVERY_SWEEP];
+                double pct = total > 0 ? 100.0 / (double)total : 0.0;
+                Log("[MONEY] First full scan wrap complete. candidates=%d wraps=%d read: refine=%.1f%% seed=%.1f%% coarse=%.1f%% sweep=%.1f%%",
+                    gMoneyCands.Size(), gMoneyScanWrapCount,
+                    m.slots[DISCOVERY_REFINE] * pct, m.slots[DISCOVERY_SEED] * pct,
+                    m.slots[DISCOVERY_COARSE] * pct, m.slots[DISCOVERY_SWEEP] * pct);
+            }
+        }
+    }
 
-    gAutoPlayerGlobal = best->idx;
-    Log("[MONEY] AutoLock: Player stack global locked to idx=%d (ocrPlayer=%d ocrPot=%d ocrAny=%d val=%d).",
-        best->idx, best->ocrPlayerMatches, best->ocrPotMatches, best->ocrAnyMatches, best->last);
-    char idxBuf[32];
-    _snprintf_s(idxBuf, sizeof(idxBuf), "%d", gAutoPlayerGlobal);
-    WritePrivateProfileStringA("Money", "StackGlobal0", idxBuf, gIniPath);
-    Log("[MONEY] AutoLock: Persisted StackGlobal0=%d to %s.", gAutoPlayerGlobal, gIniPath);
-    if (gCfg.hudUiMode != HUD_UI_MODE_LEGACY_TEXT)
+    // ---- Re-read existing candidates to detect value changes ----
+    if (rescanDue)
     {
-        char toast[128];
-        _snprintf_s(toast, sizeof(toast), "Player source locked [%d]", best->idx);
-        PostHudToast(toast, HUD_TOAST_EVENT_GENERIC, now);
+        gNextMoneyRescanAt = now + (gCfg.moneyScanIntervalMs / 2);  // rescan faster than discovery
+        int64_t rescanStartUs = QpcNowUs();
+        int rescanReads = RescanExistingCandidates(now, stepBudgetUs - (rescanStartUs - stepStartUs));
+        int64_t rescanEndUs = QpcNowUs();
+        gScanSched.OnRescan(rescanReads, rescanEndUs - rescanStartUs, rescanEndUs);
+    }
+    RevalidateWarmStart(now);
+
+    // ---- Prune stale candidates, evict over the cap ----
+    static std::vector<unsigned char> dropMask;
+    int n = gMoneyCands.Size();
+    dropMask.assign((size_t)n, 0);
+    int dropped = 0;
+    if (gCfg.moneyPruneMs > 0)
+    {
+        for (int slot = 0; slot < n; slot++)
+        {
+            size_t k = (size_t)slot;
+            // Only prune candidates with 0 changes that are old
+            if (gMoneyCands.changes[k] == 0 && (now - gMoneyCands.firstSeenMs[k]) > (DWORD)gCfg.moneyPruneMs)
+                dropMask[k] = 1;
+            else if (gMoneyCands.ocrAnyMatches[k] == 0 && gMoneyCands.ocrPotMatches[k] == 0 && gMoneyCands.changes[k] > 4)
+            {
+                float cps = CandidateChangesPerSec(gMoneyCands, slot, now);
+                if (gCfg.moneyLikelyMaxChangesPerSec > 0.0f && cps > (gCfg.moneyLikelyMaxChangesPerSec * 6.0f))
+                    dropMask[k] = 1;
+            }
+            dropped += dropMask[k];
+        }
     }
-    return true;
+    dropped += StepCandidateCap(now, stepBudgetUs - (QpcNowUs() - stepStartUs), n - dropped, dropped > 0, dropMask);
+    if (dropped > 0)
+    {
+        for (int slot = 0; slot < n; slot++)
+        {
+            if (dropMask[(size_t)slot])
+                ForgetRankedCandidate(gMoneyCands, slot);
+        }
+        ReleaseCompactedCandidates(dropMask);
+        gMoneyCands.Compact(dropMask);
+    }
+
+    FinishRankingStep(gMoneyCands, now);
+    gScanSched.OnStep(QpcNowUs() - stepStartUs, stepBudgetUs);
 }
 
-static bool IsLikelyValidPayoutAmount(int cents)
+// ---------------- Scan worker ----------------
+// The worker owns gMoneyCands, the cursor and gScanOcr while it runs. The script thread hands it
+// OCR samples and reset requests through gScanInputs and reads back immutable snapshots.
+struct ScanWorkerInputs
+{
+    bool active = false;       // seated, overlay on
+    DWORD heartbeatMs = 0;     // last MoneyTick on the script thread
+    int resetSerial = 0;
+    std::vector<SessionCacheEntry> warm;  // seeds for the reset named by resetSerial
+    std::vector<int> hotspots;            // gHotspotSeeds for that reset
+    CandidateEpochs epochs;    // gEpochRequests
+    OcrMoneySnapshot ocr;
+    std::vector<int> locked;   // rescan tier 0, see CollectLockedWatchIdx
+};
+
+// The script thread only looks at ranked, locked and OCR-matched candidates, so a snapshot
+// carries those rows instead of the whole store.
+struct MoneyScanSnapshot
+{
+    MoneyCandidateStore cands;  // published rows only; ranked slots index into it
+    RankedSlots ranked;
+    int candidates = 0;         // size of the scanner's store
+    int cursor = 0;
+    int wraps = 0;
+    ScanSchedulerMetrics sched;
+    RescanTierMetrics tiers;
+    MemoryUsage memory;        // scanner-owned subsystems
+    int evicted = 0;
+    int resetSerial = -1;
+};
+
+struct MoneyScanView
+{
+    const MoneyCandidateStore* cands;
+    const RankedSlots* ranked;
+    int candidates;
+    int cursor;
+    int wraps;
+    ScanSchedulerMetrics sched;
+    RescanTierMetrics tiers;
+    MemoryUsage memory;
+    int evicted;
+};
+
+constexpr DWORD kScanWorkerPublishMs = 33;      // snapshot copies per second are bounded by this
+constexpr DWORD kScanWorkerIdleWaitMs = 50;
+constexpr DWORD kScanWorkerOrphanMs = 10000;    // no MoneyTick for this long: the script stopped, exit
+
+static SRWLOCK gScanInputsLock = SRWLOCK_INIT;
+static ScanWorkerInputs gScanInputs;
+static TripleBuffer<MoneyScanSnapshot> gScanSnapshots;
+static HANDLE gScanWorkerThread = nullptr;
+static HANDLE gScanWorkerStopEvent = nullptr;
+static int gScanWorkerAppliedReset = 0;  // worker-written; read only once the thread has exited
+
+static bool IsScanWorkerRunning()
 {
-    if (cents <= 0)
-        return false;
-    if (cents > gCfg.moneyValueMax * 4)
-        return false;
+    return gScanWorkerThread && WaitForSingleObject(gScanWorkerThread, 0) == WAIT_TIMEOUT;
+}
 
-    // If OCR has a non-fallback pot, reject payout amounts wildly off that anchor.
-    if (gOcrMoney.potCents > 0 && gOcrMoney.potSource != 5)
+// Store slots worth publishing, ascending.
+static void CollectPublishedSlots(std::vector<int>& out)
+{
+    out.clear();
+    for (int cat = 0; cat < RANK_CATEGORY_COUNT; cat++)
+        out.insert(out.end(), gRankedSlots.slots[cat].begin(), gRankedSlots.slots[cat].end());
+    for (int idx : gScanLockedIdx)
     {
-        if (cents > gOcrMoney.potCents * 2)
-            return false;
-        if (cents * 3 < gOcrMoney.potCents)
-            return false;
+        int slot = gMoneyCands.Find(idx);
+        if (slot >= 0)
+            out.push_back(slot);
     }
-    return true;
+    const MoneyCandidateStore& s = gMoneyCands;
+    for (int slot = 0; slot < s.Size(); slot++)
+    {
+        size_t k = (size_t)slot;
+        // Seat-array evidence and the log's OCR-correlated list come from these.
+        if (s.ocrAnyMatches[k] > 0 || s.stepAligned[k] != 0)
+            out.push_back(slot);
+    }
+    SortUniqueIntVector(out);
 }
 
-static bool TryGetPayoutSourceCents(DWORD now, int& outSourceCents, const char*& outSourceLabel)
+static void PublishScanSnapshot(int resetSerial)
 {
-    outSourceCents = 0;
-    outSourceLabel = "none";
+    static std::vector<int> published;
+    MoneyScanSnapshot& snap = gScanSnapshots.Back();
+    CollectPublishedSlots(published);
+    snap.cands.Gather(gMoneyCands, published);  // column vectors keep their capacity across publishes
+    for (int cat = 0; cat < RANK_CATEGORY_COUNT; cat++)
+    {
+        std::vector<int>& out = snap.ranked.slots[cat];
+        out = gRankedSlots.slots[cat];
+        for (int& slot : out)
+            slot = (int)(std::lower_bound(published.begin(), published.end(), slot) - published.begin());
+    }
+    snap.candidates = gMoneyCands.Size();
+    snap.cursor = gMoneyScanCursor;
+    snap.wraps = gMoneyScanWrapCount;
+    snap.sched = gScanSched.Metrics();
+    snap.tiers = gRescanTiers.Metrics();
+    MeasureScannerMemory(snap.memory);
+    snap.evicted = gEvictedTotal;
+    snap.resetSerial = resetSerial;
+    gScanSnapshots.Publish();
+}
 
-    bool ocrFresh = IsOcrMoneyFresh(now);
+static DWORD WINAPI ScanWorkerMain(LPVOID param)
+{
+    HMODULE self = (HMODULE)param;
 
-    if (gCfg.moneyPayoutUseWinsAmount && ocrFresh && gOcrMoney.winsCents > 0 &&
-        IsLikelyValidPayoutAmount(gOcrMoney.winsCents))
-    {
-        outSourceCents = gOcrMoney.winsCents;
-        outSourceLabel = "wins";
-        return true;
-    }
+    AcquireSRWLockExclusive(&gScanInputsLock);
+    int appliedReset = gScanInputs.resetSerial;
+    ReleaseSRWLockExclusive(&gScanInputsLock);
 
-    if (gCfg.moneyPayoutFallbackToPot)
+    Log("[MONEY] ScanWorker: started (cands=%d).", gMoneyCands.Size());
+    DWORD waitMs = 0;
+    DWORD nextPublishAt = 0;
+    std::vector<SessionCacheEntry> warm;
+    std::vector<int> hotspots;
+    while (WaitForSingleObject(gScanWorkerStopEvent, waitMs) == WAIT_TIMEOUT)
     {
-        if (ocrFresh && gOcrMoney.potCents > 0 && gOcrMoney.potSource != 5)
+        DWORD now = GetTickCount();
+        bool active = false;
+        DWORD heartbeatMs = 0;
+        bool resetRequested = false;
+        CandidateEpochs epochs;
+
+        AcquireSRWLockExclusive(&gScanInputsLock);
+        active = gScanInputs.active;
+        heartbeatMs = gScanInputs.heartbeatMs;
+        if (gScanInputs.resetSerial != appliedReset)
         {
-            outSourceCents = gOcrMoney.potCents;
-            outSourceLabel = "potOCR";
-            return true;
+            appliedReset = gScanInputs.resetSerial;
+            gScanWorkerAppliedReset = appliedReset;
+            resetRequested = true;
+            warm.swap(gScanInputs.warm);
+            hotspots.swap(gScanInputs.hotspots);
         }
+        if (gScanInputs.ocr.sampleId != gScanOcr.sampleId)
+            gScanOcr = gScanInputs.ocr;
+        gScanLockedIdx = gScanInputs.locked;
+        epochs = gScanInputs.epochs;
+        ReleaseSRWLockExclusive(&gScanInputsLock);
 
-        int potCents = 0;
-        if (TryReadEffectivePotCents(potCents) && potCents > 0)
+        if ((now - heartbeatMs) > kScanWorkerOrphanMs)
         {
-            outSourceCents = potCents;
-            outSourceLabel = "potGlobal";
-            return true;
+            Log("[MONEY] ScanWorker: no script heartbeat for %lums, exiting.", (unsigned long)(now - heartbeatMs));
+            break;
+        }
+
+        if (resetRequested)
+        {
+            ResetMoneyScanState(now, warm, hotspots);
+            PublishScanSnapshot(appliedReset);
+        }
+        ApplyEpochRequests(epochs, now);
+
+        if (!active)
+        {
+            waitMs = kScanWorkerIdleWaitMs;
+            continue;
+        }
+
+        MoneyScanStep(now, false);
+        if (now >= nextPublishAt)
+        {
+            nextPublishAt = now + kScanWorkerPublishMs;
+            PublishScanSnapshot(appliedReset);
         }
+
+        DWORD nextDue = (std::min)(gNextMoneyScanAt, gNextMoneyRescanAt);
+        DWORD after = GetTickCount();
+        waitMs = (nextDue > after) ? (std::min)(nextDue - after, kScanWorkerIdleWaitMs) : 0;
     }
 
-    return false;
+    Log("[MONEY] ScanWorker: stopped.");
+    // Holds a module reference so the DLL cannot unload underneath the loop.
+    FreeLibraryAndExitThread(self, 0);
+    return 0;
 }
 
-static bool TryApplyPokerPayout(int sourceCents, const char* sourceLabel, DWORD now)
+// The worker has exited: a ResetMoneyScan it had not picked up yet is applied here instead.
+static void ApplyPendingScanReset()
 {
-    if (sourceCents <= 0)
-        return false;
+    if (gScanWorkerAppliedReset == gScanResetSerial)
+        return;
+    ResetMoneyScanState(GetTickCount(), gSessionCacheEntries, gHotspotSeeds);
+    gScanWorkerAppliedReset = gScanResetSerial;
+}
 
-    double scaled = (double)sourceCents * (double)gCfg.moneyPayoutMultiplier;
-    int targetCents = (int)std::llround(scaled);
-    int bonusCents = targetCents - sourceCents;
-    if (bonusCents <= 0)
+static void StopScanWorker()
+{
+    if (!gScanWorkerThread)
+        return;
+    SetEvent(gScanWorkerStopEvent);
+    WaitForSingleObject(gScanWorkerThread, INFINITE);  // at most one scan step
+    CloseHandle(gScanWorkerThread);
+    gScanWorkerThread = nullptr;
+    ResetEvent(gScanWorkerStopEvent);
+    ApplyPendingScanReset();
+}
+
+// Starts (or restarts after an orphan exit) the worker. false = scan inline this frame.
+static bool EnsureScanWorker(DWORD now)
+{
+    if (IsScanWorkerRunning())
+        return true;
+    if (gScanWorkerThread)
+    {
+        CloseHandle(gScanWorkerThread);
+        gScanWorkerThread = nullptr;
+    }
+    ApplyPendingScanReset();  // the new worker starts at the current serial
+    if (gScanWorkerStartFailed)
         return false;
 
-    BOOL ok = MONEY::_MONEY_INCREMENT_CASH_BALANCE(bonusCents, MISC::GET_HASH_KEY("ADD_REASON_DEFAULT"));
-    if (!ok)
+    if (!gScanWorkerStopEvent)
+        gScanWorkerStopEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    HMODULE self = nullptr;
+    GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS, (const char*)&ScanWorkerMain, &self);
+    if (!gScanWorkerStopEvent || !self)
     {
-        Log("[PAYOUT] FAILED source=%s src=%d($%.2f) bonus=%d($%.2f) mul=%.2f",
-            sourceLabel ? sourceLabel : "?", sourceCents, (double)sourceCents / 100.0,
-            bonusCents, (double)bonusCents / 100.0, gCfg.moneyPayoutMultiplier);
+        Log("[MONEY] ScanWorker: setup failed (err=%lu), scanning inline.", GetLastError());
+        if (self)
+            FreeLibrary(self);
+        gScanWorkerStartFailed = true;
         return false;
     }
 
-    Log("[PAYOUT] Applied source=%s src=%d($%.2f) bonus=%d($%.2f) target=%d($%.2f) mul=%.2f",
-        sourceLabel ? sourceLabel : "?",
-        sourceCents, (double)sourceCents / 100.0,
-        bonusCents, (double)bonusCents / 100.0,
-        targetCents, (double)targetCents / 100.0,
-        gCfg.moneyPayoutMultiplier);
+    AcquireSRWLockExclusive(&gScanInputsLock);
+    gScanInputs.resetSerial = gScanResetSerial;
+    gScanInputs.heartbeatMs = now;
+    ReleaseSRWLockExclusive(&gScanInputsLock);
 
-    if (gCfg.hudUiMode != HUD_UI_MODE_LEGACY_TEXT)
+    gScanWorkerThread = CreateThread(nullptr, 0, ScanWorkerMain, self, 0, nullptr);
+    if (!gScanWorkerThread)
     {
-        char toast[128];
-        _snprintf_s(toast, sizeof(toast), "Poker bonus +$%.2f", (double)bonusCents / 100.0);
-        PostHudToast(toast, HUD_TOAST_EVENT_GENERIC, now);
+        Log("[MONEY] ScanWorker: CreateThread failed (err=%lu), scanning inline.", GetLastError());
+        FreeLibrary(self);
+        gScanWorkerStartFailed = true;
+        return false;
     }
+    SetThreadPriority(gScanWorkerThread, THREAD_PRIORITY_BELOW_NORMAL);
     return true;
 }
 
-static bool DrawWatchLine(const char* label, int idx, HudPanelCursor& panel)
+static void PostScanWorkerInputs(bool active, DWORD now)
 {
-    if (idx < 0) return true;
-    int val = 0;
-    bool ok = ReadGlobalInt(idx, val);
-    char buf[128];
-    if (ok)
-        _snprintf_s(buf, sizeof(buf), "%s [%d] = %d", label, idx, val);
-    else
-        _snprintf_s(buf, sizeof(buf), "%s [%d] = ???", label, idx);
-    return DrawPanelLine(panel, buf);
+    if (!EnsureScanWorker(now))
+        return;
+    AcquireSRWLockExclusive(&gScanInputsLock);
+    gScanInputs.active = active;
+    gScanInputs.heartbeatMs = now;
+    if (gScanInputs.resetSerial != gScanResetSerial)
+    {
+        gScanInputs.resetSerial = gScanResetSerial;
+        gScanInputs.warm = gSessionCacheEntries;
+        gScanInputs.hotspots = gHotspotSeeds;
+    }
+    if (gScanInputs.ocr.sampleId != gOcrMoney.sampleId)
+        gScanInputs.ocr = gOcrMoney;
+    gScanInputs.epochs = gEpochRequests;
+    CollectLockedWatchIdx(gScanInputs.locked);
+    ReleaseSRWLockExclusive(&gScanInputsLock);
 }
 
-// v0.5 OCR: Re-read all existing candidates and track value changes
-static void RescanExistingCandidates(DWORD now)
+// ---------------- Narrowing ----------------
+// Cheat-Engine-style "next scan" over [ScanStart, ScanEnd): a search keeps a bitset of surviving
+// indices and each step ANDs in one predicate. Independent of the candidate store, so it runs on
+// the script thread even with ScanWorker=1. Steps re-read the whole range while many indices
+// survive and only the survivors once the set is small.
+static std::vector<int> gNarrowValues;       // dense, one per range slot
+static std::vector<uint64_t> gNarrowFaults;  // one bit per range slot
+static std::vector<int> gNarrowIdx;
+static std::vector<int> gNarrowSparseVals;
+static std::vector<unsigned char> gNarrowSparseOk;
+
+static int NarrowTargetCents()
 {
-    int reads = 0;
-    int maxReads = gCfg.moneyScanMaxReadsPerStep;
-    std::vector<int> toRemove;
+    return gCfg.moneyNarrowTarget ? gOcrMoney.playerCents : gOcrMoney.potCents;
+}
+
+static const char* NarrowTargetName()
+{
+    return gCfg.moneyNarrowTarget ? "player" : "pot";
+}
 
-    for (auto& kv : gMoneyCands)
+// Refreshes gNarrowValues/gNarrowFaults at every alive index.
+static void ReadNarrowValues()
+{
+    int count = gNarrow.RangeCount();
+    gNarrowValues.resize((size_t)count);
+    gNarrowFaults.resize((size_t)((count + 63) >> 6));
+    if (gNarrow.AliveCount() > count / 8)
     {
-        if (reads >= maxReads)
-            break;
+        ReadGlobalRange(gNarrow.RangeStart(), count, gNarrowValues.data(), gNarrowFaults.data());
+        return;
+    }
 
-        int val = 0;
-        bool ok = ReadGlobalInt(kv.first, val);
-        reads++;
+    std::fill(gNarrowFaults.begin(), gNarrowFaults.end(), 0ull);
+    gNarrow.AliveIndices(gNarrowIdx, gNarrow.AliveCount());
+    int n = (int)gNarrowIdx.size();
+    gNarrowSparseVals.resize((size_t)n);
+    gNarrowSparseOk.resize((size_t)n);
+    ReadGlobalIndices(gNarrowIdx.data(), n, gNarrowSparseVals.data(), gNarrowSparseOk.data());
+    for (int i = 0; i < n; i++)
+    {
+        int k = gNarrowIdx[(size_t)i] - gNarrow.RangeStart();
+        gNarrowValues[(size_t)k] = gNarrowSparseVals[(size_t)i];
+        if (!gNarrowSparseOk[(size_t)i])
+            GlobalFaultBitSet(gNarrowFaults.data(), k);
+    }
+}
 
-        if (!ok)
+static void LogNarrowResult(const char* what, int64_t elapsedUs)
+{
+    std::vector<int> shown;
+    gNarrow.AliveIndices(shown, 6);
+    std::string list;
+    char item[48];
+    for (int idx : shown)
+    {
+        _snprintf_s(item, sizeof(item), "%s%d=%d", list.empty() ? "" : " ", idx, gNarrow.LastValue(idx));
+        list += item;
+    }
+    Log("[NARROW] %s: alive=%d steps=%d time=%lldus%s%s",
+        what, gNarrow.AliveCount(), gNarrow.Steps(), (long long)elapsedUs,
+        list.empty() ? "" : " first: ", list.c_str());
+}
+
+static void StartNarrowing()
+{
+    int start = gCfg.moneyScanStart;
+    int count = gCfg.moneyScanEnd - gCfg.moneyScanStart;
+    if (!GlobalsReady() || count <= 0)
+    {
+        Log("[NARROW] Start skipped: %s", GlobalsReady() ? "empty scan range" : "getGlobalPtr unresolved");
+        return;
+    }
+
+    int64_t t0 = QpcNowUs();
+    gNarrowValues.resize((size_t)count);
+    gNarrowFaults.resize((size_t)((count + 63) >> 6));
+    ReadGlobalRange(start, count, gNarrowValues.data(), gNarrowFaults.data());
+    gNarrow.Begin(start, count, gNarrowValues.data(), gNarrowFaults.data(), gCfg.moneyValueMin, gCfg.moneyValueMax);
+    gNarrowLastTargetCents = NarrowTargetCents();
+    gNarrowLastSampleId = gOcrMoney.sampleId;
+
+    char what[96];
+    _snprintf_s(what, sizeof(what), "Start range=[%d..%d) target=%s", start, start + count, NarrowTargetName());
+    LogNarrowResult(what, QpcNowUs() - t0);
+}
+
+static void StepNarrowing(NarrowPredicate pred)
+{
+    if (!gNarrow.Active())
+        return;
+
+    int targetCents = NarrowTargetCents();
+    NarrowStep step;
+    step.pred = pred;
+    step.toleranceCents = gCfg.moneyOcrMatchToleranceCents;
+    if (pred == NARROW_EQUALS)
+    {
+        if (targetCents > 0)
         {
-            toRemove.push_back(kv.first);
-            continue;
+            step.amountsCents = &targetCents;
+            step.amountCount = 1;
         }
-
-        // Check if value left valid range
-        if (val < gCfg.moneyValueMin || val > gCfg.moneyValueMax)
+        else
         {
-            toRemove.push_back(kv.first);
-            continue;
+            // No target in the last sample: any OCR amount will do.
+            step.amountsCents = gOcrMoney.amountsCents.data();
+            step.amountCount = (int)gOcrMoney.amountsCents.size();
         }
-
-        kv.second.lastSeenMs = now;
-        UpdateCandidateOcrMatches(kv.second, val, now);
-
-        // Detect change
-        if (val != kv.second.last)
+        if (step.amountCount <= 0)
         {
-            int delta = val - kv.second.last;
-            int absDelta = (delta < 0) ? -delta : delta;
-            kv.second.changes++;
-            kv.second.lastDelta = delta;
-            if (MatchesConfiguredBetGridDelta(absDelta))
-                kv.second.betStepMatches++;
-            else
-                kv.second.betStepMismatches++;
-            kv.second.last = val;
-            kv.second.lastChangeMs = now;
-            kv.second.lastSeenMs = now;
+            Log("[NARROW] equals skipped: no OCR amount");
+            return;
+        }
+    }
+    else if (pred == NARROW_CHANGED_BY)
+    {
+        if (targetCents <= 0 || gNarrowLastTargetCents <= 0)
+        {
+            Log("[NARROW] changed-by skipped: OCR %s unknown (now=%d last=%d)", NarrowTargetName(), targetCents, gNarrowLastTargetCents);
+            return;
         }
+        step.deltaCents = targetCents - gNarrowLastTargetCents;
+        if (step.deltaCents == 0)
+            step.pred = NARROW_UNCHANGED;
+    }
+
+    int64_t t0 = QpcNowUs();
+    ReadNarrowValues();
+    gNarrow.Step(step, gNarrowValues.data(), gNarrowFaults.data());
+    int64_t elapsedUs = QpcNowUs() - t0;
+    if (targetCents > 0)
+        gNarrowLastTargetCents = targetCents;
+
+    char what[96];
+    if (step.pred == NARROW_CHANGED_BY)
+        _snprintf_s(what, sizeof(what), "%s %+d", NarrowPredicateName(step.pred), step.deltaCents);
+    else if (step.pred == NARROW_EQUALS && step.amountCount == 1)
+        _snprintf_s(what, sizeof(what), "%s %d", NarrowPredicateName(step.pred), step.amountsCents[0]);
+    else
+        _snprintf_s(what, sizeof(what), "%s", NarrowPredicateName(step.pred));
+    LogNarrowResult(what, elapsedUs);
+}
+
+// Hotkeys are consumed even outside poker so a stale press does not fire on the next table join.
+static void NarrowTick(bool scanActive)
+{
+    if (!gCfg.moneyNarrowEnable)
+        return;
+
+    bool start = KeyPressed((DWORD)gCfg.moneyNarrowKeyStart);
+    bool equals = KeyPressed((DWORD)gCfg.moneyNarrowKeyEquals);
+    bool delta = KeyPressed((DWORD)gCfg.moneyNarrowKeyDelta);
+    bool unchanged = KeyPressed((DWORD)gCfg.moneyNarrowKeyUnchanged);
+    bool changed = KeyPressed((DWORD)gCfg.moneyNarrowKeyChanged);
+    if (!scanActive)
+        return;
+
+    // Auto restarts an emptied search at most once per OCR sample.
+    bool autoStart = gCfg.moneyNarrowAuto && GlobalsReady() &&
+        (!gNarrow.Active() || (gNarrow.AliveCount() == 0 && gOcrMoney.sampleId != gNarrowLastSampleId));
+    if (start || autoStart)
+        StartNarrowing();
+    if (delta) StepNarrowing(NARROW_CHANGED_BY);
+    if (unchanged) StepNarrowing(NARROW_UNCHANGED);
+    if (changed) StepNarrowing(NARROW_CHANGED);
+    if (equals) StepNarrowing(NARROW_EQUALS);
+
+    // Auto: one delta + equals pair per OCR sample that read the target.
+    if (gCfg.moneyNarrowAuto && gNarrow.Active() && gNarrow.AliveCount() > 1 &&
+        gOcrMoney.sampleId != gNarrowLastSampleId && NarrowTargetCents() > 0)
+    {
+        gNarrowLastSampleId = gOcrMoney.sampleId;
+        if (gNarrowLastTargetCents > 0)
+            StepNarrowing(NARROW_CHANGED_BY);
+        StepNarrowing(NARROW_EQUALS);
     }
+}
 
-    for (int idx : toRemove)
-        gMoneyCands.erase(idx);
+// No candidates: a reset the worker has not applied yet, or the scan is paused.
+static MoneyScanView IdleMoneyScanView()
+{
+    static const MoneyCandidateStore kNoCandidates;
+    static const RankedSlots kNoRanking;
+    return { &kNoCandidates, &kNoRanking, 0, gCfg.moneyScanStart, 0, ScanSchedulerMetrics{}, RescanTierMetrics{}, MemoryUsage{}, 0 };
+}
+
+// Scans inline, or takes the worker's latest snapshot. The view stays valid until the next call.
+static MoneyScanView RunMoneyScan(DWORD now)
+{
+    if (IsScanWorkerRunning())
+    {
+        gScanSnapshots.Consume();
+        const MoneyScanSnapshot& snap = gScanSnapshots.Front();
+        if (snap.resetSerial != gScanResetSerial)
+            return IdleMoneyScanView();
+        return { &snap.cands, &snap.ranked, snap.candidates, snap.cursor, snap.wraps, snap.sched, snap.tiers, snap.memory, snap.evicted };
+    }
+
+    if (gScanOcr.sampleId != gOcrMoney.sampleId)
+        gScanOcr = gOcrMoney;
+    CollectLockedWatchIdx(gScanLockedIdx);
+    ApplyEpochRequests(gEpochRequests, now);
+    MoneyScanStep(now, true);
+    MoneyScanView view = { &gMoneyCands, &gRankedSlots, gMoneyCands.Size(), gMoneyScanCursor, gMoneyScanWrapCount, gScanSched.Metrics(), gRescanTiers.Metrics(), MemoryUsage{}, gEvictedTotal };
+    MeasureScannerMemory(view.memory);
+    return view;
+}
+
+// ---------------- Memory ----------------
+// Byte counts are vector capacities, so the figures are what the plugin actually holds.
+// Scanner-owned subsystems arrive with the view; the rest are measured here.
+static void UpdateMemoryLedger(const MoneyScanView& view)
+{
+    gMemLedger.SetAll(view.memory);
+    size_t snapshotBytes = 0;
+    if (IsScanWorkerRunning())
+    {
+        // Three buffers, each holding the published rows and the ranked lists.
+        snapshotBytes = view.cands->MemoryBytes();
+        for (int cat = 0; cat < RANK_CATEGORY_COUNT; cat++)
+            snapshotBytes += view.ranked->slots[cat].capacity() * sizeof(int);
+        snapshotBytes *= 3;
+    }
+    gMemLedger.Set(MEM_SCAN_SNAPSHOTS, snapshotBytes);
+    gMemLedger.Set(MEM_NARROWING, gNarrow.MemoryBytes() + gNarrowValues.capacity() * sizeof(int) +
+        gNarrowFaults.capacity() * sizeof(uint64_t) + (gNarrowIdx.capacity() + gNarrowSparseVals.capacity()) * sizeof(int) +
+        gNarrowSparseOk.capacity());
+    gMemLedger.Set(MEM_WATCHES, gWatches.MemoryBytes());
+    gMemLedger.Set(MEM_RECORDER, gRecorder.MemoryBytes());
+}
+
+static void LogMemoryLedger(int evicted)
+{
+    auto mb = [](size_t bytes) { return (double)bytes / (1024.0 * 1024.0); };
+    Log("[MEM] total=%.2fMB peak=%.2fMB cap=%d evicted=%d | %s=%.2f %s=%.2f %s=%.2f %s=%.2f %s=%.2f %s=%.2f %s=%.2f %s=%.2f %s=%.2f",
+        mb(gMemLedger.Total()), mb(gMemLedger.PeakTotal()), gCfg.moneyCandidateCap, evicted,
+        MemorySubsystemName(MEM_CANDIDATES), mb(gMemLedger.Bytes(MEM_CANDIDATES)),
+        MemorySubsystemName(MEM_RANKING), mb(gMemLedger.Bytes(MEM_RANKING)),
+        MemorySubsystemName(MEM_SERIES), mb(gMemLedger.Bytes(MEM_SERIES)),
+        MemorySubsystemName(MEM_RESCAN), mb(gMemLedger.Bytes(MEM_RESCAN)),
+        MemorySubsystemName(MEM_FAULT_MAP), mb(gMemLedger.Bytes(MEM_FAULT_MAP)),
+        MemorySubsystemName(MEM_SCAN_SNAPSHOTS), mb(gMemLedger.Bytes(MEM_SCAN_SNAPSHOTS)),
+        MemorySubsystemName(MEM_NARROWING), mb(gMemLedger.Bytes(MEM_NARROWING)),
+        MemorySubsystemName(MEM_WATCHES), mb(gMemLedger.Bytes(MEM_WATCHES)),
+        MemorySubsystemName(MEM_RECORDER), mb(gMemLedger.Bytes(MEM_RECORDER)));
 }
 
 static void MoneyTick(bool inPoker, DWORD now)
@@ -3374,9 +7269,14 @@ static void MoneyTick(bool inPoker, DWORD now)
     }
     if (GetAsyncKeyState(VK_END) & 1)
     {
-        ResetMoneyScan(now);
+        // SHIFT+END clears the candidates; END alone starts their evidence over.
+        bool hard = (GetAsyncKeyState(VK_SHIFT) & 0x8000) != 0;
+        if (hard)
+            ResetMoneyScan(now);
+        else
+            SoftResetMoneyScan(EPOCH_SESSION, now);
         if (gCfg.hudUiMode != HUD_UI_MODE_LEGACY_TEXT)
-            PostHudToast("Money scan reset", HUD_TOAST_EVENT_MONEY_SCAN_RESET, now);
+            PostHudToast(hard ? "Money scan cleared" : "Money scan reset", HUD_TOAST_EVENT_MONEY_SCAN_RESET, now);
     }
 
     // Resolve getGlobalPtr (retries automatically)
@@ -3386,127 +7286,42 @@ static void MoneyTick(bool inPoker, DWORD now)
     if (phase != gLastMoneyPhase)
     {
         if (phase == POKER_PHASE_PAYOUT_SETTLEMENT)
+        {
             gSettlementSerial++;
+            gEpochRequests.Bump(EPOCH_HAND);
+        }
         gLastMoneyPhase = phase;
     }
+    RecordTick(phase, now);
 
-    if (!inPoker || !gCfg.moneyOverlay || !gMoneyOverlayRuntime)
+    bool scanActive = inPoker && gCfg.moneyOverlay && gMoneyOverlayRuntime;
+    if (scanActive && gSeatArray.locked && ReadSeatArray())  // unlocks on a fault, so scanning resumes this frame
+        ValidateSeatArray(now);
+    if (scanActive)
+        WatchTick(now);
+    else
+        gWatches.MarkStale();  // effective pot/player reads fall back to ReadGlobalInt
+    bool scanPaused = SeatArrayStopsScan();
+    if (gCfg.moneyScanWorker)
+        PostScanWorkerInputs(scanActive && !scanPaused, now);
+    NarrowTick(scanActive);
+    SaveFaultMap();  // queued by the scanner at a wrap
+    if (!scanActive)
         return;
 
-    // ---- Scan: discover new candidates ----
-    if (gCfg.moneyScanEnable && gGetGlobalPtr && now >= gNextMoneyScanAt)
-    {
-        gNextMoneyScanAt = now + gCfg.moneyScanIntervalMs;
-        DWORD stepStart = GetTickCount();
-
-        int reads = 0;
-        int maxReads = gCfg.moneyScanMaxReadsPerStep;
-        int consecutiveSehFaults = 0;
-        constexpr int kFaultRunThreshold = 16;
-        constexpr int kFaultRunSkipSpan = 256;
-        int batchEnd = (std::min)(gMoneyScanCursor + gCfg.moneyScanBatch, gCfg.moneyScanEnd);
-
-        for (int i = gMoneyScanCursor; i < batchEnd; i++)
-        {
-            if (reads >= maxReads)
-                break;
-            if ((GetTickCount() - stepStart) >= (DWORD)gCfg.moneyScanMaxStepMs)
-                break;
-
-            // Skip if already a candidate
-            if (gMoneyCands.count(i))
-            {
-                gMoneyScanCursor = i + 1;
-                continue;
-            }
-
-            int val = 0;
-            bool sehFault = false;
-            reads++;
-            if (!ReadGlobalInt(i, val, &sehFault))
-            {
-                if (sehFault)
-                    consecutiveSehFaults++;
-                else
-                    consecutiveSehFaults = 0;
-
-                gMoneyScanCursor = i + 1;
-
-                if (gCfg.moneySkipFaultRuns && sehFault && consecutiveSehFaults >= kFaultRunThreshold)
-                {
-                    int oldCursor = gMoneyScanCursor;
-                    int skipCursor = (std::min)(i + kFaultRunSkipSpan + 1, gCfg.moneyScanEnd);
-                    if (skipCursor > oldCursor)
-                    {
-                        gMoneyScanCursor = skipCursor;
-                        if (now >= gNextFaultRunSkipLogAt)
-                        {
-                            Log("[MONEY] SkipFaultRuns: %d consecutive SEH faults near idx=%d. cursor %d -> %d.",
-                                consecutiveSehFaults, i, oldCursor, gMoneyScanCursor);
-                            gNextFaultRunSkipLogAt = now + 2000;
-                        }
-                    }
-                    break;
-                }
-                continue;
-            }
-            consecutiveSehFaults = 0;
-
-            if (val >= gCfg.moneyValueMin && val <= gCfg.moneyValueMax)
-            {
-                MoneyCandidate mc;
-                mc.idx = i;
-                mc.last = val;
-                mc.changes = 0;
-                mc.firstSeenMs = now;
-                mc.lastSeenMs = now;
-                mc.lastChangeMs = 0;
-                UpdateCandidateOcrMatches(mc, val, now);
-                gMoneyCands[i] = mc;
-            }
-
-            gMoneyScanCursor = i + 1;
-        }
-
-        // Wrap
-        if (gMoneyScanCursor >= gCfg.moneyScanEnd)
-        {
-            gMoneyScanCursor = gCfg.moneyScanStart;
-            gMoneyScanWrapCount++;
-            if (!gMoneyScanWrapped)
-            {
-                gMoneyScanWrapped = true;
-                Log("[MONEY] First full scan wrap complete. candidates=%d wraps=%d",
-                    (int)gMoneyCands.size(), gMoneyScanWrapCount);
-            }
-        }
-    }
-
-    // ---- Re-read existing candidates to detect value changes ----
-    if (gGetGlobalPtr && now >= gNextMoneyRescanAt)
-    {
-        gNextMoneyRescanAt = now + (gCfg.moneyScanIntervalMs / 2);  // rescan faster than discovery
-        RescanExistingCandidates(now);
-    }
+    MoneyScanView view = scanPaused ? IdleMoneyScanView() : RunMoneyScan(now);
+    const MoneyCandidateStore& cands = *view.cands;
+    UpdateMemoryLedger(view);
 
-    // ---- Prune stale candidates ----
-    if (gCfg.moneyPruneMs > 0)
+    // The cold reserve is capped at half a rescan step, which can put RescanColdMaxAgeMs out of reach.
+    if (view.tiers.coldClamped != gLoggedColdClamped)
     {
-        std::vector<int> pruneList;
-        for (auto& kv : gMoneyCands)
-        {
-            // Only prune candidates with 0 changes that are old
-            if (kv.second.changes == 0 && (now - kv.second.firstSeenMs) > (DWORD)gCfg.moneyPruneMs)
-                pruneList.push_back(kv.first);
-            else if (kv.second.ocrAnyMatches == 0 && kv.second.ocrPotMatches == 0 && kv.second.changes > 4)
-            {
-                float cps = CandidateChangesPerSec(kv.second, now);
-                if (gCfg.moneyLikelyMaxChangesPerSec > 0.0f && cps > (gCfg.moneyLikelyMaxChangesPerSec * 6.0f))
-                    pruneList.push_back(kv.first);
-            }
-        }
-        for (int idx : pruneList)
-            gMoneyCands.erase(idx);
+        gLoggedColdClamped = view.tiers.coldClamped;
+        if (gLoggedColdClamped)
+            Log("[MONEY] Rescan: %d cold candidates need more than half a step's reads; cold lap is ~%ums, over RescanColdMaxAgeMs=%d.",
+                view.tiers.count[RESCAN_TIER_COLD], view.tiers.coldLapBoundMs, gCfg.moneyRescanColdMaxAgeMs);
+        else
+            Log("[MONEY] Rescan: cold lap back within RescanColdMaxAgeMs=%d.", gCfg.moneyRescanColdMaxAgeMs);
     }
 
     // ---- Log snapshot ----
@@ -3514,15 +7329,15 @@ static void MoneyTick(bool inPoker, DWORD now)
     {
         gNextMoneyLogAt = now + gCfg.moneyLogIntervalMs;
 
-        std::vector<const MoneyCandidate*> sorted;
-        bool usingRanked = BuildSortedCandidates(now, sorted);
+        std::vector<int> sorted;
+        bool usingRanked = BuildSortedCandidates(cands, now, sorted);
 
         bool shouldLog = true;
         if (gCfg.moneyLogOnlyOnChange)
         {
-            int topIdx = sorted.empty() ? -1 : sorted[0]->idx;
-            int topVal = sorted.empty() ? 0 : sorted[0]->last;
-            int candCount = (int)gMoneyCands.size();
+            int topIdx = sorted.empty() ? -1 : cands.idx[(size_t)sorted[0]];
+            int topVal = sorted.empty() ? 0 : cands.last[(size_t)sorted[0]];
+            int candCount = view.candidates;
             int candDiff = (gLastLoggedCandCount < 0) ? candCount : (candCount - gLastLoggedCandCount);
             if (candDiff < 0) candDiff = -candDiff;
             DWORD heartbeatMs = (DWORD)(std::max)(15000, gCfg.moneyLogIntervalMs * 10);
@@ -3534,36 +7349,51 @@ static void MoneyTick(bool inPoker, DWORD now)
         if (shouldLog)
         {
             gLastMoneySnapshotLogAt = now;
-            gLastLoggedTopIdx = sorted.empty() ? -1 : sorted[0]->idx;
-            gLastLoggedTopVal = sorted.empty() ? 0 : sorted[0]->last;
-            gLastLoggedCandCount = (int)gMoneyCands.size();
+            gLastLoggedTopIdx = sorted.empty() ? -1 : cands.idx[(size_t)sorted[0]];
+            gLastLoggedTopVal = sorted.empty() ? 0 : cands.last[(size_t)sorted[0]];
+            gLastLoggedCandCount = view.candidates;
 
             Log("[MONEY] Snapshot: inPoker=%d scan=%d cands=%d cursor=%d/%d wraps=%d mode=%s",
                 inPoker ? 1 : 0, gCfg.moneyScanEnable,
-                (int)gMoneyCands.size(), gMoneyScanCursor, gCfg.moneyScanEnd,
-                gMoneyScanWrapCount, usingRanked ? "ranked" : "all");
+                view.candidates, view.cursor, gCfg.moneyScanEnd,
+                view.wraps, usingRanked ? "ranked" : "all");
+            Log("[MONEY] Sched: budget=%dus step=%dus cost=%.1fns/read rescan=%.1fns/cand reads/s=%.0f frame=%.2fms firstWrap=%lldms",
+                view.sched.lastBudgetUs, view.sched.lastStepUs, view.sched.costNsPerRead,
+                view.sched.rescanNsPerCand, view.sched.readsPerSec, gFrameClock.AvgFrameMs(),
+                (long long)view.sched.firstWrapMs);
+            Log("[MONEY] Rescan: locked=%d maxAge=%ums hot=%d reads=%d maxAge=%ums lap=%ums cold=%d reads=%d maxAge=%ums lap=%ums",
+                view.tiers.count[RESCAN_TIER_LOCKED], view.tiers.maxAgeMs[RESCAN_TIER_LOCKED],
+                view.tiers.count[RESCAN_TIER_HOT], view.tiers.reads[RESCAN_TIER_HOT],
+                view.tiers.maxAgeMs[RESCAN_TIER_HOT], view.tiers.lapMs[RESCAN_TIER_HOT],
+                view.tiers.count[RESCAN_TIER_COLD], view.tiers.reads[RESCAN_TIER_COLD],
+                view.tiers.maxAgeMs[RESCAN_TIER_COLD], view.tiers.lapMs[RESCAN_TIER_COLD]);
+            LogMemoryLedger(view.evicted);
 
             int logN = (std::min)((int)sorted.size(), gCfg.moneyLogTopN);
             for (int i = 0; i < logN; i++)
             {
-                float cps = CandidateChangesPerSec(*sorted[i], now);
-                float stepRatio = CandidateBetStepRatio(*sorted[i]);
-                Log("[MONEY] Cand idx=%d val=%d (~%.2f if cents) changes=%d rate=%.2f/s step=%d/%d ratio=%.2f lastDelta=%+d ocrAny=%d ocrPot=%d ocrPlayer=%d ocrNpc=%d",
-                    sorted[i]->idx, sorted[i]->last, (double)sorted[i]->last / 100.0,
-                    sorted[i]->changes, cps, sorted[i]->betStepMatches, sorted[i]->betStepMismatches,
-                    stepRatio, sorted[i]->lastDelta,
-                    sorted[i]->ocrAnyMatches, sorted[i]->ocrPotMatches, sorted[i]->ocrPlayerMatches, sorted[i]->ocrNpcMatches);
+                int slot = sorted[(size_t)i];
+                size_t k = (size_t)slot;
+                float cps = CandidateChangesPerSec(cands, slot, now);
+                float stepRatio = CandidateBetStepRatio(cands, slot);
+                Log("[MONEY] Cand idx=%d val=%d (~%.2f if cents) changes=%d rate=%.2f/s step=%d/%d ratio=%.2f lastDelta=%+d ocrAny=%d ocrPot=%d ocrPlayer=%d ocrNpc=%d steps pot=%d/%d player=%d/%d npc=%d wins=%d",
+                    cands.idx[k], cands.last[k], (double)cands.last[k] / 100.0,
+                    cands.changes[k], cps, cands.betStepMatches[k], cands.betStepMismatches[k],
+                    stepRatio, cands.lastDelta[k],
+                    cands.ocrAnyMatches[k], cands.ocrPotMatches[k], cands.ocrPlayerMatches[k], cands.ocrNpcMatches[k],
+                    StepAlignedCount(cands, slot, OCR_SERIES_POT), StepMissedCount(cands, slot, OCR_SERIES_POT),
+                    StepAlignedCount(cands, slot, OCR_SERIES_PLAYER), StepMissedCount(cands, slot, OCR_SERIES_PLAYER),
+                    StepAlignedCount(cands, slot, OCR_SERIES_NPC), StepAlignedCount(cands, slot, OCR_SERIES_WINS));
             }
         }
     }
 
     // Auto-lock pot source as soon as OCR-correlation is strong enough.
-    {
-        std::vector<const MoneyCandidate*> ranked;
-        BuildSortedCandidates(now, ranked);
-        TryAutoLockPotGlobal(ranked, now);
-        TryAutoLockPlayerGlobal(now);
-    }
+    bool locked = TryAutoLockPotGlobal(cands, view.ranked->slots[RANK_CATEGORY_POT], now);
+    locked |= TryAutoLockPlayerGlobal(cands, view.ranked->slots[RANK_CATEGORY_PLAYER], now);
+    locked |= TryLockSeatArray(cands, *view.ranked, now);
+    if (locked || now >= gNextSessionCacheSaveAt)
+        SaveSessionCache(cands, *view.ranked, now);
 
     // ---- Auto payout ----
     if (gCfg.moneyPayoutEnable &&
@@ -3594,14 +7424,11 @@ static void MoneyTick(bool inPoker, DWORD now)
         DrawPanelLine(panel, "Poker Scanner");
     }
 
-    // Watch list (known globals)
-    if (!DrawWatchLine("Pot", GetEffectivePotGlobalIndex(), panel)) return;
-    if (!DrawWatchLine("Stk0", GetEffectivePlayerGlobalIndex(), panel)) return;
-    if (!DrawWatchLine("Stk1", gCfg.stackGlobal1, panel)) return;
-    if (!DrawWatchLine("Stk2", gCfg.stackGlobal2, panel)) return;
-    if (!DrawWatchLine("Stk3", gCfg.stackGlobal3, panel)) return;
-    if (!DrawWatchLine("Stk4", gCfg.stackGlobal4, panel)) return;
-    if (!DrawWatchLine("Stk5", gCfg.stackGlobal5, panel)) return;
+    // Watch list (Pot, Stk0-5, then the INI watches)
+    for (int id = 0; id < gWatches.Count(); id++)
+    {
+        if (!DrawWatchLine(id, panel, now)) return;
+    }
 
     if (gOcrMoney.mainPotCents > 0)
     {
@@ -3701,12 +7528,48 @@ static void MoneyTick(bool inPoker, DWORD now)
     }
 
     // Scanner status
-    _snprintf_s(buf, sizeof(buf), "Scanner idx=%d/%d cands=%d wraps=%d autoPot=%d autoPlr=%d",
-        gMoneyScanCursor, gCfg.moneyScanEnd,
-        (int)gMoneyCands.size(), gMoneyScanWrapCount, gAutoPotGlobal, gAutoPlayerGlobal);
+    if (scanPaused)
+        _snprintf_s(buf, sizeof(buf), "Scanner paused: seat array [%d +%d x%d] pot=%d, %d globals/frame",
+            gSeatArray.fit.base, gSeatArray.fit.stride, gSeatArray.fit.seats, gSeatArray.potIdx, (int)gSeatArray.readIdx.size());
+    else
+        _snprintf_s(buf, sizeof(buf), "Scanner idx=%d/%d cands=%d wraps=%d autoPot=%d autoPlr=%d",
+            view.cursor, gCfg.moneyScanEnd,
+            view.candidates, view.wraps, gAutoPotGlobal, gAutoPlayerGlobal);
+    if (!DrawPanelLine(panel, buf))
+        return;
+
+    _snprintf_s(buf, sizeof(buf), "Sched %d/%dus reads/s=%.0f frame=%.1fms wrap1=%lldms",
+        view.sched.lastStepUs, view.sched.lastBudgetUs, view.sched.readsPerSec,
+        gFrameClock.AvgFrameMs(), (long long)view.sched.firstWrapMs);
+    if (!DrawPanelLine(panel, buf))
+        return;
+
+    _snprintf_s(buf, sizeof(buf), "Rescan age lock=%ums hot=%d/%ums cold=%d/%ums",
+        view.tiers.maxAgeMs[RESCAN_TIER_LOCKED],
+        view.tiers.count[RESCAN_TIER_HOT], view.tiers.maxAgeMs[RESCAN_TIER_HOT],
+        view.tiers.count[RESCAN_TIER_COLD], view.tiers.maxAgeMs[RESCAN_TIER_COLD]);
+    if (!DrawPanelLine(panel, buf))
+        return;
+
+    _snprintf_s(buf, sizeof(buf), "Mem %.1fMB peak=%.1fMB cands=%.1fMB cap=%d evicted=%d",
+        (double)gMemLedger.Total() / (1024.0 * 1024.0), (double)gMemLedger.PeakTotal() / (1024.0 * 1024.0),
+        (double)gMemLedger.Bytes(MEM_CANDIDATES) / (1024.0 * 1024.0), gCfg.moneyCandidateCap, view.evicted);
     if (!DrawPanelLine(panel, buf))
         return;
 
+    if (gNarrow.Active())
+    {
+        std::vector<int> survivors;
+        gNarrow.AliveIndices(survivors, 1);
+        if (gNarrow.AliveCount() == 1)
+            _snprintf_s(buf, sizeof(buf), "Narrow %s: found idx=%d val=%d after %d steps",
+                NarrowTargetName(), survivors[0], gNarrow.LastValue(survivors[0]), gNarrow.Steps());
+        else
+            _snprintf_s(buf, sizeof(buf), "Narrow %s: alive=%d steps=%d", NarrowTargetName(), gNarrow.AliveCount(), gNarrow.Steps());
+        if (!DrawPanelLine(panel, buf))
+            return;
+    }
+
     _snprintf_s(buf, sizeof(buf), "BetRule=%s min=$%d step=$%d",
         gCfg.moneyBetStepFilterEnable ? "on" : "off",
         gCfg.moneyBetMinDollars, gCfg.moneyBetStepDollars);
@@ -3727,9 +7590,9 @@ static void MoneyTick(bool inPoker, DWORD now)
             return;
     }
 
-    // Top N candidates sorted by likely money behavior first.
-    std::vector<const MoneyCandidate*> sorted;
-    BuildSortedCandidates(now, sorted);
+    // Top N candidates per OCR category, best first (pot/NPC by rank score, player by stack score).
+    const MoneyCandidateStore& cs = cands;
+    const RankedSlots& ranked = *view.ranked;
 
     bool hasOcrAmounts = !gOcrMoney.amountsCents.empty();
     int groupCount = 0;
@@ -3744,14 +7607,12 @@ static void MoneyTick(bool inPoker, DWORD now)
 
     if (gOcrMoney.potCents > 0)
     {
-        for (int i = 0; i < (int)sorted.size(); i++)
+        for (int slot : ranked.slots[RANK_CATEGORY_POT])
         {
-            const MoneyCandidate* c = sorted[i];
-            if (c->ocrPotMatches <= 0)
-                continue;
+            size_t k = (size_t)slot;
             _snprintf_s(buf, sizeof(buf), "P%02d idx=%d v=%d($%.2f) pot=%d player=%d d=%+d step=%d/%d",
-                shownPot + 1, c->idx, c->last, (double)c->last / 100.0, c->ocrPotMatches, c->ocrPlayerMatches,
-                c->lastDelta, c->betStepMatches, c->betStepMismatches);
+                shownPot + 1, cs.idx[k], cs.last[k], (double)cs.last[k] / 100.0, cs.ocrPotMatches[k], cs.ocrPlayerMatches[k],
+                cs.lastDelta[k], cs.betStepMatches[k], cs.betStepMismatches[k]);
             if (!DrawPanelLine(panel, buf))
                 break;
             shownPot++;
@@ -3762,14 +7623,12 @@ static void MoneyTick(bool inPoker, DWORD now)
 
     if (gOcrMoney.playerCents > 0)
     {
-        for (int i = 0; i < (int)sorted.size(); i++)
+        for (int slot : ranked.slots[RANK_CATEGORY_PLAYER])
         {
-            const MoneyCandidate* c = sorted[i];
-            if (c->ocrPlayerMatches <= 0)
-                continue;
+            size_t k = (size_t)slot;
             _snprintf_s(buf, sizeof(buf), "U%02d idx=%d v=%d($%.2f) player=%d pot=%d d=%+d step=%d/%d",
-                shownPlayer + 1, c->idx, c->last, (double)c->last / 100.0, c->ocrPlayerMatches, c->ocrPotMatches,
-                c->lastDelta, c->betStepMatches, c->betStepMismatches);
+                shownPlayer + 1, cs.idx[k], cs.last[k], (double)cs.last[k] / 100.0, cs.ocrPlayerMatches[k], cs.ocrPotMatches[k],
+                cs.lastDelta[k], cs.betStepMatches[k], cs.betStepMismatches[k]);
             if (!DrawPanelLine(panel, buf))
                 break;
             shownPlayer++;
@@ -3780,17 +7639,11 @@ static void MoneyTick(bool inPoker, DWORD now)
 
     if (!gOcrMoney.npcAmountsCents.empty())
     {
-        for (int i = 0; i < (int)sorted.size(); i++)
+        for (int slot : ranked.slots[RANK_CATEGORY_NPC])
         {
-            const MoneyCandidate* c = sorted[i];
-            if (c->ocrNpcMatches <= 0)
-                continue;
-            if (c->ocrPotMatches > c->ocrNpcMatches * 2)
-                continue;
-            if (c->ocrPlayerMatches > c->ocrNpcMatches * 2)
-                continue;
+            size_t k = (size_t)slot;
             _snprintf_s(buf, sizeof(buf), "N%02d idx=%d v=%d($%.2f) npc=%d pot=%d player=%d",
-                shownNpc + 1, c->idx, c->last, (double)c->last / 100.0, c->ocrNpcMatches, c->ocrPotMatches, c->ocrPlayerMatches);
+                shownNpc + 1, cs.idx[k], cs.last[k], (double)cs.last[k] / 100.0, cs.ocrNpcMatches[k], cs.ocrPotMatches[k], cs.ocrPlayerMatches[k]);
             if (!DrawPanelLine(panel, buf))
                 break;
             shownNpc++;
@@ -3816,6 +7669,12 @@ static void InitPaths()
     strcat_s(gLogPath, MAX_PATH, "highstakes.log");
     strcpy_s(gIniPath, MAX_PATH, gGameDirPath);
     strcat_s(gIniPath, MAX_PATH, "highstakes.ini");
+    strcpy_s(gFaultMapPath, MAX_PATH, gGameDirPath);
+    strcat_s(gFaultMapPath, MAX_PATH, "highstakes_faultmap.txt");
+    strcpy_s(gHotspotsPath, MAX_PATH, gGameDirPath);
+    strcat_s(gHotspotsPath, MAX_PATH, "highstakes_hotspots.txt");
+    strcpy_s(gSessionCachePath, MAX_PATH, gGameDirPath);
+    strcat_s(gSessionCachePath, MAX_PATH, "highstakes_session.bin");
 
     char tempPath[MAX_PATH]{ 0 };
     DWORD tn = GetTempPathA(MAX_PATH, tempPath);
@@ -3826,11 +7685,6 @@ static void InitPaths()
         strcpy_s(gOcrBmpTopRightPath, MAX_PATH, tempPath);
         strcat_s(gOcrBmpTopRightPath, MAX_PATH, "highstakes_ocr_tr.bmp");
 
-        strcpy_s(gOcrOutBaseBottomLeftPath, MAX_PATH, tempPath);
-        strcat_s(gOcrOutBaseBottomLeftPath, MAX_PATH, "highstakes_ocr_bl");
-        strcpy_s(gOcrOutBaseTopRightPath, MAX_PATH, tempPath);
-        strcat_s(gOcrOutBaseTopRightPath, MAX_PATH, "highstakes_ocr_tr");
-
         strcpy_s(gOcrTxtBottomLeftPath, MAX_PATH, tempPath);
         strcat_s(gOcrTxtBottomLeftPath, MAX_PATH, "highstakes_ocr_bl.txt");
         strcpy_s(gOcrTxtTopRightPath, MAX_PATH, tempPath);
@@ -3843,11 +7697,6 @@ static void InitPaths()
         strcpy_s(gOcrBmpTopRightPath, MAX_PATH, gGameDirPath);
         strcat_s(gOcrBmpTopRightPath, MAX_PATH, "highstakes_ocr_tr.bmp");
 
-        strcpy_s(gOcrOutBaseBottomLeftPath, MAX_PATH, gGameDirPath);
-        strcat_s(gOcrOutBaseBottomLeftPath, MAX_PATH, "highstakes_ocr_bl");
-        strcpy_s(gOcrOutBaseTopRightPath, MAX_PATH, gGameDirPath);
-        strcat_s(gOcrOutBaseTopRightPath, MAX_PATH, "highstakes_ocr_tr");
-
         strcpy_s(gOcrTxtBottomLeftPath, MAX_PATH, gGameDirPath);
         strcat_s(gOcrTxtBottomLeftPath, MAX_PATH, "highstakes_ocr_bl.txt");
         strcpy_s(gOcrTxtTopRightPath, MAX_PATH, gGameDirPath);
@@ -3858,6 +7707,7 @@ static void InitPaths()
 static void Tick()
 {
     DWORD now = GetTickCount();
+    gFrameClock.OnFrame(QpcNowUs());
     Player plr = PLAYER::PLAYER_ID();
 
     // Frontend/loading guard: avoid running game-state logic before story is fully active.
@@ -3898,7 +7748,11 @@ static void Tick()
                 ShowLegacyHudMessage("~COLOR_GOLD~Mod Online", now, gCfg.msgDurationMs);
             else
                 PostHudToast("Poker table joined", HUD_TOAST_EVENT_ENTER_POKER, now);
-            ResetMoneyScan(now);
+            // The first table seeds the scan; later ones keep what the earlier ones learned.
+            if (gMoneyScanSeeded)
+                SoftResetMoneyScan(EPOCH_TABLE, now);
+            else
+                ResetMoneyScan(now);
         }
     }
 
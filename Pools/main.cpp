@@ -6,6 +6,8 @@
 
 #include "script.h"
 
+// forward declare (in highstakes.cpp)
+void HighStakesDetach();
 
 BOOL APIENTRY DllMain(HMODULE hInstance, DWORD reason, LPVOID lpReserved)
 {
@@ -18,6 +20,7 @@ BOOL APIENTRY DllMain(HMODULE hInstance, DWORD reason, LPVOID lpReserved)
     case DLL_PROCESS_DETACH:
         scriptUnregister(hInstance);
         keyboardHandlerUnregister(OnKeyboardMessage);
+        HighStakesDetach();
         break;
     }
     return TRUE;
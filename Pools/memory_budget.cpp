@@ -0,0 +1,88 @@
+#include "memory_budget.h"
+
+#include <algorithm>
+
+const char* MemorySubsystemName(int sub)
+{
+    switch (sub)
+    {
+    case MEM_CANDIDATES: return "cands";
+    case MEM_RANKING: return "rank";
+    case MEM_SERIES: return "series";
+    case MEM_RESCAN: return "rescan";
+    case MEM_FAULT_MAP: return "faults";
+    case MEM_SCAN_SNAPSHOTS: return "snaps";
+    case MEM_NARROWING: return "narrow";
+    case MEM_WATCHES: return "watch";
+    case MEM_RECORDER: return "rec";
+    default: return "?";
+    }
+}
+
+size_t MemoryUsage::Total() const
+{
+    size_t total = 0;
+    for (size_t b : bytes)
+        total += b;
+    return total;
+}
+
+void MemoryLedger::Set(int sub, size_t bytes)
+{
+    current.bytes[sub] = bytes;
+    peak.bytes[sub] = (std::max)(peak.bytes[sub], bytes);
+    peakTotal = (std::max)(peakTotal, current.Total());
+}
+
+void MemoryLedger::SetAll(const MemoryUsage& usage)
+{
+    for (int sub = 0; sub < MEM_SUBSYSTEM_COUNT; sub++)
+    {
+        current.bytes[sub] = usage.bytes[sub];
+        peak.bytes[sub] = (std::max)(peak.bytes[sub], usage.bytes[sub]);
+    }
+    peakTotal = (std::max)(peakTotal, current.Total());
+}
+
+float EvictionKeepScore(float rankScore, uint32_t idleMs, bool ocrCorrelated, const EvictionWeights& w)
+{
+    float idleMin = (float)idleMs / 60000.0f;
+    float score = rankScore - (std::min)(idleMin * w.idlePenaltyPerMin, w.idlePenaltyMax);
+    if (ocrCorrelated)
+        score += w.ocrBonus;
+    return score;
+}
+
+int CandidateEvictor::Update(int live, int cap)
+{
+    if (cap <= 0)
+    {
+        owed = 0;
+        return 0;
+    }
+    int low = cap - cap / 8;
+    if (owed > 0 || live > cap)
+        owed = (std::max)(0, live - low);
+    return owed;
+}
+
+void CandidateEvictor::SetThreshold(int slots, int visited)
+{
+    if (sample.empty() || slots <= 0 || owed <= 0)
+    {
+        threshold = 0.0f;
+        return;
+    }
+    // Owed slots take up owed * visited / slots of the sample. Ties at the threshold are evicted
+    // in cursor order.
+    size_t rank = (size_t)((double)owed * (double)visited / (double)slots);
+    rank = (std::min)(rank, sample.size() - 1);
+    std::nth_element(sample.begin(), sample.begin() + (ptrdiff_t)rank, sample.end());
+    threshold = sample[rank];
+}
+
+void CandidateEvictor::Clear()
+{
+    owed = 0;
+    threshold = 0.0f;
+}
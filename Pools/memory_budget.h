@@ -0,0 +1,117 @@
+/*
+  memory_budget.h
+  - Per-subsystem memory accounting and the candidate cap's eviction choice
+  - MemoryUsage is a plain array of byte counts (capacity, not size), one per
+    subsystem; MemoryLedger keeps the latest and peak figures for the log
+  - Eviction ranks candidates by a keep score: the rank score, a bonus for
+    any OCR correlation, minus a staleness penalty that grows with the time
+    since the candidate last changed or matched OCR. The lowest scores go
+    first; pinned slots (locked globals) never do. The choice is approximate and
+    incremental (a sampled threshold applied slice by slice), so no step pays
+    for scoring or selecting over the whole store
+  - bench/memory_budget_bench.cpp runs eviction rounds on a real store
+    against one exact pass
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum MemorySubsystem
+{
+    MEM_CANDIDATES = 0,    // candidate store, evicted set, eviction scratch
+    MEM_RANKING,           // top-K heaps and their exported slot lists
+    MEM_SERIES,            // step-correlation ring pool
+    MEM_RESCAN,            // rescan tiers
+    MEM_FAULT_MAP,         // fault map and the discovery read plan
+    MEM_SCAN_SNAPSHOTS,    // worker snapshot buffers
+    MEM_NARROWING,
+    MEM_WATCHES,
+    MEM_RECORDER,
+    MEM_SUBSYSTEM_COUNT
+};
+
+const char* MemorySubsystemName(int sub);
+
+struct MemoryUsage
+{
+    size_t bytes[MEM_SUBSYSTEM_COUNT] = {};
+
+    size_t Total() const;
+};
+
+class MemoryLedger
+{
+public:
+    void Set(int sub, size_t bytes);
+    void SetAll(const MemoryUsage& usage);
+
+    size_t Bytes(int sub) const { return current.bytes[sub]; }
+    size_t Peak(int sub) const { return peak.bytes[sub]; }
+    size_t Total() const { return current.Total(); }
+    size_t PeakTotal() const { return peakTotal; }
+
+private:
+    MemoryUsage current;
+    MemoryUsage peak;
+    size_t peakTotal = 0;
+};
+
+struct EvictionWeights
+{
+    float ocrBonus = 40.0f;          // any OCR match outweighs a long idle spell
+    float idlePenaltyPerMin = 2.0f;
+    float idlePenaltyMax = 30.0f;
+};
+
+// Higher = keep. idleMs = time since the candidate last changed or matched OCR.
+float EvictionKeepScore(float rankScore, uint32_t idleMs, bool ocrCorrelated, const EvictionWeights& w);
+
+// One cap enforcement spread over scan steps. A round opens when the store grows past the cap
+// and owes the excess down to 7/8 of it, so rounds do not start every step. Each step the caller
+// scores a bounded slice of slots and evicts those Evicts() accepts until nothing is owed. The
+// threshold is the keep score at the owed fraction of a strided sample; the caller re-samples
+// when its cursor wraps with evictions still owed.
+class CandidateEvictor
+{
+public:
+    static const int kSampleSlots = 2048;
+
+    // Opens a round when live > cap and recounts what an open round owes. Returns the owed count;
+    // 0 closes the round.
+    int Update(int live, int cap);
+    int Owed() const { return owed; }
+
+    // Sets the threshold from every (slots / kSampleSlots)-th slot. keepAt(slot, keep) returns
+    // false for slots the round cannot take (pinned, already queued).
+    template <class KeepAt>
+    void Sample(int slots, KeepAt&& keepAt)
+    {
+        sample.clear();
+        int stride = (std::max)(1, slots / kSampleSlots);
+        int visited = 0;
+        for (int slot = 0; slot < slots; slot += stride, visited++)
+        {
+            float keep = 0.0f;
+            if (keepAt(slot, keep))
+                sample.push_back(keep);
+        }
+        SetThreshold(slots, visited);
+    }
+    bool Evicts(float keep) const { return owed > 0 && keep <= threshold; }
+    void OnEvicted(int count) { owed = (std::max)(0, owed - count); }
+    void Clear();
+
+    float Threshold() const { return threshold; }
+    size_t MemoryBytes() const { return sample.capacity() * sizeof(float); }
+
+private:
+    void SetThreshold(int slots, int visited);
+
+    int owed = 0;
+    float threshold = 0.0f;
+    std::vector<float> sample;
+};
@@ -0,0 +1,177 @@
+#include "money_diff.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define MONEY_DIFF_X64 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__)
+#define MONEY_DIFF_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MONEY_DIFF_TARGET_AVX2
+#endif
+
+namespace
+{
+    // Emits every set bit of changedBits (relative to base) as a changed slot.
+    inline void EmitChanged(unsigned changedBits, int base, const int* prev, const int* cur, SnapshotDiff& out)
+    {
+        while (changedBits)
+        {
+#ifdef _MSC_VER
+            unsigned long bit;
+            _BitScanForward(&bit, changedBits);
+#else
+            unsigned bit = (unsigned)__builtin_ctz(changedBits);
+#endif
+            int slot = base + (int)bit;
+            out.slots.push_back(slot);
+            out.deltas.push_back((int)((uint32_t)cur[slot] - (uint32_t)prev[slot]));
+            changedBits &= changedBits - 1;
+        }
+    }
+
+    inline void MarkOutOfRange(unsigned rangeBits, int base, SnapshotDiff& out)
+    {
+        if (!rangeBits)
+            return;
+        // base is a multiple of the lane count (4 or 8), so the bits never straddle a word.
+        out.outOfRange[(size_t)base >> 6] |= (uint64_t)rangeBits << (base & 63);
+#ifdef _MSC_VER
+        out.outOfRangeCount += (int)__popcnt(rangeBits);
+#else
+        out.outOfRangeCount += __builtin_popcount(rangeBits);
+#endif
+    }
+
+    int DiffScalarTail(const int* prev, const int* cur, int start, int n, int valueMin, int valueMax, SnapshotDiff& out)
+    {
+        for (int s = start; s < n; s++)
+        {
+            int v = cur[s];
+            if (v != prev[s])
+            {
+                out.slots.push_back(s);
+                out.deltas.push_back((int)((uint32_t)v - (uint32_t)prev[s]));
+            }
+            if (v < valueMin || v > valueMax)
+            {
+                out.outOfRange[(size_t)s >> 6] |= 1ull << (s & 63);
+                out.outOfRangeCount++;
+            }
+        }
+        return (int)out.slots.size();
+    }
+
+#ifdef MONEY_DIFF_X64
+    int DiffSse2(const int* prev, const int* cur, int n, int valueMin, int valueMax, SnapshotDiff& out)
+    {
+        const __m128i vMin = _mm_set1_epi32(valueMin);
+        const __m128i vMax = _mm_set1_epi32(valueMax);
+        int s = 0;
+        for (; s + 4 <= n; s += 4)
+        {
+            __m128i p = _mm_loadu_si128((const __m128i*)(prev + s));
+            __m128i c = _mm_loadu_si128((const __m128i*)(cur + s));
+            unsigned same = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(p, c)));
+            __m128i outside = _mm_or_si128(_mm_cmplt_epi32(c, vMin), _mm_cmpgt_epi32(c, vMax));
+            unsigned range = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(outside));
+            EmitChanged(~same & 0xFu, s, prev, cur, out);
+            MarkOutOfRange(range, s, out);
+        }
+        return DiffScalarTail(prev, cur, s, n, valueMin, valueMax, out);
+    }
+
+    MONEY_DIFF_TARGET_AVX2
+    int DiffAvx2(const int* prev, const int* cur, int n, int valueMin, int valueMax, SnapshotDiff& out)
+    {
+        const __m256i vMin = _mm256_set1_epi32(valueMin);
+        const __m256i vMax = _mm256_set1_epi32(valueMax);
+        int s = 0;
+        for (; s + 8 <= n; s += 8)
+        {
+            __m256i p = _mm256_loadu_si256((const __m256i*)(prev + s));
+            __m256i c = _mm256_loadu_si256((const __m256i*)(cur + s));
+            unsigned same = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(p, c)));
+            __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(vMin, c), _mm256_cmpgt_epi32(c, vMax));
+            unsigned range = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(outside));
+            EmitChanged(~same & 0xFFu, s, prev, cur, out);
+            MarkOutOfRange(range, s, out);
+        }
+        return DiffScalarTail(prev, cur, s, n, valueMin, valueMax, out);
+    }
+
+    bool CpuHasAvx2()
+    {
+#ifdef _MSC_VER
+        int regs[4];
+        __cpuid(regs, 0);
+        if (regs[0] < 7)
+            return false;
+        __cpuid(regs, 1);
+        bool osxsave = (regs[2] & (1 << 27)) != 0;
+        bool avx = (regs[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx)
+            return false;
+        // OS must save the YMM state.
+        if ((_xgetbv(0) & 0x6) != 0x6)
+            return false;
+        __cpuidex(regs, 7, 0);
+        return (regs[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2") != 0;
+#endif
+    }
+#endif
+
+    enum DiffIsa { DIFF_ISA_UNKNOWN, DIFF_ISA_SCALAR, DIFF_ISA_SSE2, DIFF_ISA_AVX2 };
+
+    DiffIsa SelectIsa()
+    {
+        static DiffIsa isa = DIFF_ISA_UNKNOWN;
+        if (isa == DIFF_ISA_UNKNOWN)
+        {
+#ifdef MONEY_DIFF_X64
+            isa = CpuHasAvx2() ? DIFF_ISA_AVX2 : DIFF_ISA_SSE2;
+#else
+            isa = DIFF_ISA_SCALAR;
+#endif
+        }
+        return isa;
+    }
+}
+
+int DiffSnapshot(const int* prev, const int* cur, int n, int valueMin, int valueMax, SnapshotDiff& out)
+{
+    out.slots.clear();
+    out.deltas.clear();
+    out.outOfRangeCount = 0;
+    out.outOfRange.assign((size_t)((n + 63) >> 6), 0);
+    if (n <= 0)
+        return 0;
+
+    switch (SelectIsa())
+    {
+#ifdef MONEY_DIFF_X64
+    case DIFF_ISA_AVX2:
+        return DiffAvx2(prev, cur, n, valueMin, valueMax, out);
+    case DIFF_ISA_SSE2:
+        return DiffSse2(prev, cur, n, valueMin, valueMax, out);
+#endif
+    default:
+        return DiffScalarTail(prev, cur, 0, n, valueMin, valueMax, out);
+    }
+}
+
+const char* SnapshotDiffIsaName()
+{
+    switch (SelectIsa())
+    {
+    case DIFF_ISA_AVX2: return "avx2";
+    case DIFF_ISA_SSE2: return "sse2";
+    default: return "scalar";
+    }
+}
@@ -0,0 +1,34 @@
+/*
+  money_diff.h
+  - Snapshot diff for the money rescan
+  - Compares the previous read of a block of globals (packed int32) with a fresh
+    read and emits the changed slots, their deltas and an out-of-range mask
+  - AVX2 when the CPU has it, SSE2 otherwise (always present on x64)
+  - No bench of its own; bench/scanner_bench.cpp diffs every rescan with it
+    and prints which path ran
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct SnapshotDiff
+{
+    std::vector<int> slots;           // changed slots, ascending
+    std::vector<int> deltas;          // cur - prev, parallel to slots
+    std::vector<uint64_t> outOfRange; // bit per slot: cur < valueMin || cur > valueMax
+    int outOfRangeCount = 0;
+
+    bool OutOfRange(int slot) const
+    {
+        return ((outOfRange[(size_t)slot >> 6] >> (slot & 63)) & 1ull) != 0;
+    }
+};
+
+// Diffs n slots of prev against cur. Returns the number of changed slots.
+int DiffSnapshot(const int* prev, const int* cur, int n, int valueMin, int valueMax, SnapshotDiff& out);
+
+// "avx2", "sse2" or "scalar" - whichever DiffSnapshot dispatches to.
+const char* SnapshotDiffIsaName();
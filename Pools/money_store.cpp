@@ -0,0 +1,155 @@
+#include "money_store.h"
+
+#include <algorithm>
+
+int MoneyCandidateStore::Find(int globalIdx) const
+{
+    if (!Contains(globalIdx))
+        return -1;
+    auto it = std::lower_bound(idx.begin(), idx.end(), globalIdx);
+    if (it == idx.end() || *it != globalIdx)
+        return -1;
+    return (int)(it - idx.begin());
+}
+
+void MoneyCandidateStore::Clear()
+{
+    ForEachColumn([](auto& col, auto) { col.clear(); });
+    member.clear();
+}
+
+void MoneyCandidateStore::Reserve(int n)
+{
+    if (n <= 0)
+        return;
+    ForEachColumn([n](auto& col, auto) { col.reserve((size_t)n); });
+}
+
+void MoneyCandidateStore::SetMember(int globalIdx, bool on)
+{
+    if (globalIdx < 0)
+        return;
+    size_t word = (size_t)globalIdx >> 6;
+    if (word >= member.size())
+    {
+        if (!on)
+            return;
+        member.resize(word + 1, 0);
+    }
+    uint64_t bit = 1ull << (globalIdx & 63);
+    if (on)
+        member[word] |= bit;
+    else
+        member[word] &= ~bit;
+}
+
+void MoneyCandidateStore::InsertSorted(const std::vector<MoneyCandidate>& rows)
+{
+    if (rows.empty())
+        return;
+
+    // pos[r] = number of existing slots ordered before rows[r].
+    std::vector<size_t> pos;
+    pos.resize(rows.size());
+    {
+        size_t lo = 0;
+        for (size_t r = 0; r < rows.size(); r++)
+        {
+            lo = (size_t)(std::lower_bound(idx.begin() + (ptrdiff_t)lo, idx.end(), rows[r].idx) - idx.begin());
+            pos[r] = lo;
+        }
+    }
+
+    size_t oldN = idx.size();
+    size_t k = rows.size();
+    ForEachColumn([&](auto& col, auto field)
+    {
+        col.resize(oldN + k);
+        ptrdiff_t i = (ptrdiff_t)oldN - 1;
+        ptrdiff_t r = (ptrdiff_t)k - 1;
+        ptrdiff_t w = (ptrdiff_t)(oldN + k) - 1;
+        while (r >= 0)
+        {
+            if (i >= (ptrdiff_t)pos[(size_t)r])
+                col[(size_t)w--] = col[(size_t)i--];
+            else
+                col[(size_t)w--] = rows[(size_t)r--].*field;
+        }
+    });
+
+    for (const MoneyCandidate& row : rows)
+        SetMember(row.idx, true);
+}
+
+int MoneyCandidateStore::Compact(const std::vector<unsigned char>& dead)
+{
+    size_t n = idx.size();
+    size_t firstDead = 0;
+    while (firstDead < n && firstDead < dead.size() && !dead[firstDead])
+        firstDead++;
+    if (firstDead >= n || firstDead >= dead.size())
+        return 0;
+
+    for (size_t s = firstDead; s < n && s < dead.size(); s++)
+        if (dead[s])
+            SetMember(idx[s], false);
+
+    size_t kept = 0;
+    ForEachColumn([&](auto& col, auto)
+    {
+        // Branch-free: eviction leaves dead slots scattered, so a skip would mispredict often.
+        size_t w = firstDead;
+        size_t masked = (std::min)(n, dead.size());
+        for (size_t s = firstDead; s < masked; s++)
+        {
+            col[w] = col[s];
+            w += dead[s] ? 0 : 1;
+        }
+        for (size_t s = masked; s < n; s++)
+            col[w++] = col[s];
+        col.resize(w);
+        kept = w;
+    });
+    return (int)(n - kept);
+}
+
+MoneyCandidate MoneyCandidateStore::Row(int slot) const
+{
+    MoneyCandidate row;
+    const_cast<MoneyCandidateStore*>(this)->ForEachColumn([&](auto& col, auto field)
+    {
+        row.*field = col[(size_t)slot];
+    });
+    return row;
+}
+
+void MoneyCandidateStore::WriteRow(int slot, const MoneyCandidate& row)
+{
+    ForEachColumn([&](auto& col, auto field)
+    {
+        col[(size_t)slot] = row.*field;
+    });
+}
+
+void MoneyCandidateStore::Gather(const MoneyCandidateStore& src, const std::vector<int>& slots)
+{
+    for (int globalIdx : idx)
+        SetMember(globalIdx, false);
+    size_t n = slots.size();
+    ForEachColumn([n](auto& col, auto) { col.resize(n); });
+    for (size_t i = 0; i < n; i++)
+    {
+        WriteRow((int)i, src.Row(slots[i]));
+        SetMember(idx[i], true);
+    }
+}
+
+size_t MoneyCandidateStore::MemoryBytes() const
+{
+    size_t bytes = member.capacity() * sizeof(uint64_t);
+    const_cast<MoneyCandidateStore*>(this)->ForEachColumn([&](auto& col, auto)
+    {
+        bytes += col.capacity() * sizeof(col[0]);
+    });
+    return bytes;
+}
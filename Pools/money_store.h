@@ -0,0 +1,134 @@
+/*
+  money_store.h
+  - Flat candidate store for the money scanner
+  - Structure-of-arrays: one column per MoneyCandidate field, slots ordered by
+    ascending global index, plus a membership bitset over the global index space
+  - Owned by whichever thread runs MoneyScanStep; nothing here locks. Rescan
+    cost is in bench/money_store_bench.cpp, and the memory_budget and
+    scanner benches run on a real store
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One candidate row. Used to seed inserts and to copy a single slot in or out.
+struct MoneyCandidate
+{
+    int idx = -1;
+    int last = 0;
+    int lastDelta = 0;
+    int changes = 0;
+    int betStepMatches = 0;
+    int betStepMismatches = 0;
+    int ocrAnyMatches = 0;
+    int ocrPotMatches = 0;
+    int ocrPlayerMatches = 0;
+    int ocrNpcMatches = 0;
+    int lastOcrAnySampleId = -1;
+    int lastOcrPotSampleId = -1;
+    int lastOcrPlayerSampleId = -1;
+    int lastOcrNpcSampleId = -1;
+    uint32_t firstSeenMs = 0;
+    uint32_t lastSeenMs = 0;
+    uint32_t lastChangeMs = 0;
+    uint32_t lastOcrMatchMs = 0;
+    int series = -1;               // SeriesPool handle, -1 when untracked
+    uint32_t stepAligned = 0;      // packed per-OCR-field counters, see step_correlation.h
+    uint32_t stepMissed = 0;
+    uint32_t epoch = 0;            // CandidateEpochs::Stamp() the counters are current for
+};
+
+struct MoneyCandidateStore
+{
+    // Columns, all indexed by slot. idx is strictly ascending.
+    std::vector<int> idx;
+    std::vector<int> last;
+    std::vector<int> lastDelta;
+    std::vector<int> changes;
+    std::vector<int> betStepMatches;
+    std::vector<int> betStepMismatches;
+    std::vector<int> ocrAnyMatches;
+    std::vector<int> ocrPotMatches;
+    std::vector<int> ocrPlayerMatches;
+    std::vector<int> ocrNpcMatches;
+    std::vector<int> lastOcrAnySampleId;
+    std::vector<int> lastOcrPotSampleId;
+    std::vector<int> lastOcrPlayerSampleId;
+    std::vector<int> lastOcrNpcSampleId;
+    std::vector<uint32_t> firstSeenMs;
+    std::vector<uint32_t> lastSeenMs;
+    std::vector<uint32_t> lastChangeMs;
+    std::vector<uint32_t> lastOcrMatchMs;
+    std::vector<int> series;
+    std::vector<uint32_t> stepAligned;
+    std::vector<uint32_t> stepMissed;
+    std::vector<uint32_t> epoch;
+
+    // Bit i set <=> global index i has a slot.
+    std::vector<uint64_t> member;
+
+    int Size() const { return (int)idx.size(); }
+    bool Empty() const { return idx.empty(); }
+
+    bool Contains(int globalIdx) const
+    {
+        if (globalIdx < 0)
+            return false;
+        size_t word = (size_t)globalIdx >> 6;
+        return word < member.size() && ((member[word] >> (globalIdx & 63)) & 1ull) != 0;
+    }
+
+    // Slot holding globalIdx, or -1.
+    int Find(int globalIdx) const;
+
+    void Clear();
+    void Reserve(int n);
+
+    // Merges rows (ascending idx, none already present) in one backward pass.
+    void InsertSorted(const std::vector<MoneyCandidate>& rows);
+
+    // Drops every slot with dead[slot] != 0 in one compaction sweep. Returns removed count.
+    int Compact(const std::vector<unsigned char>& dead);
+
+    MoneyCandidate Row(int slot) const;
+    void WriteRow(int slot, const MoneyCandidate& row);
+
+    // Replaces the contents with src's rows at the given slots (ascending), keeping capacity.
+    void Gather(const MoneyCandidateStore& src, const std::vector<int>& slots);
+
+    size_t MemoryBytes() const;
+
+    // Calls f(column, &MoneyCandidate::field) for every column.
+    template <class F>
+    void ForEachColumn(F&& f)
+    {
+        f(idx, &MoneyCandidate::idx);
+        f(last, &MoneyCandidate::last);
+        f(lastDelta, &MoneyCandidate::lastDelta);
+        f(changes, &MoneyCandidate::changes);
+        f(betStepMatches, &MoneyCandidate::betStepMatches);
+        f(betStepMismatches, &MoneyCandidate::betStepMismatches);
+        f(ocrAnyMatches, &MoneyCandidate::ocrAnyMatches);
+        f(ocrPotMatches, &MoneyCandidate::ocrPotMatches);
+        f(ocrPlayerMatches, &MoneyCandidate::ocrPlayerMatches);
+        f(ocrNpcMatches, &MoneyCandidate::ocrNpcMatches);
+        f(lastOcrAnySampleId, &MoneyCandidate::lastOcrAnySampleId);
+        f(lastOcrPotSampleId, &MoneyCandidate::lastOcrPotSampleId);
+        f(lastOcrPlayerSampleId, &MoneyCandidate::lastOcrPlayerSampleId);
+        f(lastOcrNpcSampleId, &MoneyCandidate::lastOcrNpcSampleId);
+        f(firstSeenMs, &MoneyCandidate::firstSeenMs);
+        f(lastSeenMs, &MoneyCandidate::lastSeenMs);
+        f(lastChangeMs, &MoneyCandidate::lastChangeMs);
+        f(lastOcrMatchMs, &MoneyCandidate::lastOcrMatchMs);
+        f(series, &MoneyCandidate::series);
+        f(stepAligned, &MoneyCandidate::stepAligned);
+        f(stepMissed, &MoneyCandidate::stepMissed);
+        f(epoch, &MoneyCandidate::epoch);
+    }
+
+private:
+    void SetMember(int globalIdx, bool on);
+};
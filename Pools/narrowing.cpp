@@ -0,0 +1,155 @@
+#include "narrowing.h"
+
+#include <bit>
+
+namespace
+{
+    inline int64_t Abs64(int64_t v) { return (v < 0) ? -v : v; }
+
+    // v matches cents directly or as whole dollars.
+    inline bool NearCents(int64_t v, int64_t cents, int64_t tol)
+    {
+        return Abs64(v - cents) <= tol || Abs64(v * 100 - cents) <= tol;
+    }
+
+    // Predicate bits for the live bits of one word. Dense words are evaluated branch-free
+    // across all 64 slots; sparse ones bit by bit.
+    template <class Pred>
+    uint64_t WordMask(uint64_t live, int base, int limit, Pred pred)
+    {
+        uint64_t mask = 0;
+        if (std::popcount(live) > 16 && base + 64 <= limit)
+        {
+            for (int b = 0; b < 64; b++)
+                mask |= (uint64_t)pred(base + b) << b;
+            return mask & live;
+        }
+        while (live)
+        {
+            int b = std::countr_zero(live);
+            live &= live - 1;
+            if (pred(base + b))
+                mask |= 1ull << b;
+        }
+        return mask;
+    }
+}
+
+const char* NarrowPredicateName(NarrowPredicate pred)
+{
+    switch (pred)
+    {
+    case NARROW_CHANGED_BY: return "changed-by";
+    case NARROW_UNCHANGED: return "unchanged";
+    case NARROW_CHANGED: return "changed";
+    default: return "equals";
+    }
+}
+
+void NarrowingSearch::Begin(int rangeStart, int rangeCount, const int* values, const uint64_t* faultBits, int vmin, int vmax)
+{
+    active = true;
+    start = rangeStart;
+    count = (rangeCount > 0) ? rangeCount : 0;
+    steps = 0;
+    size_t words = (size_t)((count + 63) >> 6);
+    alive.assign(words, 0);
+    prev.assign(values, values + count);
+
+    aliveCount = 0;
+    for (size_t w = 0; w < words; w++)
+    {
+        int base = (int)(w << 6);
+        uint64_t all = (base + 64 <= count) ? ~0ull : ((1ull << (count - base)) - 1);
+        uint64_t live = all & ~(faultBits ? faultBits[w] : 0ull);
+        alive[w] = WordMask(live, base, count, [&](int k)
+        {
+            return values[k] >= vmin && values[k] <= vmax;
+        });
+        aliveCount += std::popcount(alive[w]);
+    }
+}
+
+void NarrowingSearch::End()
+{
+    active = false;
+    aliveCount = 0;
+    steps = 0;
+    alive.clear();
+    prev.clear();
+}
+
+template <class Pred>
+int NarrowingSearch::Intersect(const int* values, const uint64_t* faultBits, Pred pred)
+{
+    int n = 0;
+    for (size_t w = 0; w < alive.size(); w++)
+    {
+        uint64_t live = alive[w];
+        if (!live)
+            continue;
+        if (faultBits)
+            live &= ~faultBits[w];
+        int base = (int)(w << 6);
+        uint64_t keep = WordMask(live, base, count, pred);
+        alive[w] = keep;
+        n += std::popcount(keep);
+        for (uint64_t bits = keep; bits; bits &= bits - 1)
+        {
+            int k = base + std::countr_zero(bits);
+            prev[(size_t)k] = values[k];
+        }
+    }
+    return n;
+}
+
+int NarrowingSearch::Step(const NarrowStep& step, const int* values, const uint64_t* faultBits)
+{
+    if (!active)
+        return 0;
+
+    // One instantiation per predicate, so the per-slot loop carries no predicate switch.
+    const std::vector<int>& last = prev;
+    int64_t tol = step.toleranceCents;
+    switch (step.pred)
+    {
+    case NARROW_CHANGED_BY:
+    {
+        int64_t delta = step.deltaCents;
+        aliveCount = Intersect(values, faultBits, [&](int k)
+        {
+            return NearCents((int64_t)values[k] - last[(size_t)k], delta, tol);
+        });
+        break;
+    }
+    case NARROW_UNCHANGED:
+        aliveCount = Intersect(values, faultBits, [&](int k) { return values[k] == last[(size_t)k]; });
+        break;
+    case NARROW_CHANGED:
+        aliveCount = Intersect(values, faultBits, [&](int k) { return values[k] != last[(size_t)k]; });
+        break;
+    default:
+        aliveCount = Intersect(values, faultBits, [&](int k)
+        {
+            for (int i = 0; i < step.amountCount; i++)
+            {
+                if (step.amountsCents[i] > 0 && NearCents(values[k], step.amountsCents[i], tol))
+                    return true;
+            }
+            return false;
+        });
+        break;
+    }
+    steps++;
+    return aliveCount;
+}
+
+void NarrowingSearch::AliveIndices(std::vector<int>& out, int max) const
+{
+    out.clear();
+    for (size_t w = 0; w < alive.size() && (int)out.size() < max; w++)
+    {
+        for (uint64_t bits = alive[w]; bits && (int)out.size() < max; bits &= bits - 1)
+            out.push_back(start + (int)(w << 6) + std::countr_zero(bits));
+    }
+}
@@ -0,0 +1,74 @@
+/*
+  narrowing.h
+  - Cheat-Engine-style narrowing search over a dense global index range
+  - Begin() keeps every readable in-range slot alive; each Step() builds a
+    predicate bitset ("changed by the OCR delta", "unchanged", "changed",
+    "equals an OCR amount") from the previous and current values and ANDs it
+    into the alive set
+  - Only words with alive bits are evaluated, so steps get cheaper as the set
+    shrinks; a step over 100k slots is a 1.6k-word sweep
+  - Amounts are OCR cents; a value may be cents or whole dollars
+  - bench/narrowing_bench.cpp times a step and checks the alive set against
+    a brute-force filter
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum NarrowPredicate
+{
+    NARROW_CHANGED_BY = 0,  // cur - prev == deltaCents (+-tolerance)
+    NARROW_UNCHANGED = 1,
+    NARROW_CHANGED = 2,
+    NARROW_EQUALS = 3,      // cur == any of amountsCents (+-tolerance)
+};
+
+struct NarrowStep
+{
+    NarrowPredicate pred = NARROW_UNCHANGED;
+    int deltaCents = 0;
+    const int* amountsCents = nullptr;
+    int amountCount = 0;
+    int toleranceCents = 0;
+};
+
+struct NarrowingSearch
+{
+    // values/faultBits cover [start, start+count) in ReadGlobalRange layout.
+    void Begin(int start, int count, const int* values, const uint64_t* faultBits, int vmin, int vmax);
+    void End();
+
+    // Intersects the alive set with step. values only need to be fresh at alive slots.
+    // Returns the alive count.
+    int Step(const NarrowStep& step, const int* values, const uint64_t* faultBits);
+
+    bool Active() const { return active; }
+    int RangeStart() const { return start; }
+    int RangeCount() const { return count; }
+    int AliveCount() const { return aliveCount; }
+    int Steps() const { return steps; }
+    const std::vector<uint64_t>& Alive() const { return alive; }
+
+    // Up to max alive global indices, ascending.
+    void AliveIndices(std::vector<int>& out, int max) const;
+    // Value recorded for an alive global index at the last step.
+    int LastValue(int globalIdx) const { return prev[(size_t)(globalIdx - start)]; }
+    size_t MemoryBytes() const { return alive.capacity() * sizeof(uint64_t) + prev.capacity() * sizeof(int); }
+
+private:
+    template <class Pred>
+    int Intersect(const int* values, const uint64_t* faultBits, Pred pred);
+
+    bool active = false;
+    int start = 0;
+    int count = 0;
+    int aliveCount = 0;
+    int steps = 0;
+    std::vector<uint64_t> alive;
+    std::vector<int> prev;
+};
+
+const char* NarrowPredicateName(NarrowPredicate pred);
@@ -0,0 +1,171 @@
+#include "ocr_amount_index.h"
+
+#include <algorithm>
+
+namespace
+{
+    constexpr int kPotUnlessPlayer = 1 << 8;  // pot ref that also matches the player stack
+
+    int64_t FloorDiv(int64_t a, int64_t b)
+    {
+        int64_t q = a / b;
+        return (a % b != 0 && a < 0) ? q - 1 : q;
+    }
+
+    uint32_t HashBucket(int64_t bucket)
+    {
+        return (uint32_t)(((uint64_t)bucket * 0x9E3779B97F4A7C15ull) >> 32);
+    }
+
+    struct Pending
+    {
+        int64_t bucket;
+        int64_t amount;
+        int bits;
+    };
+}
+
+bool OcrAmountMatches(int value, int amountCents, int tolCents)
+{
+    if (amountCents <= 0)
+        return false;
+    long long tol = (std::max)(0, tolCents);
+    long long diffDirect = (long long)value - (long long)amountCents;
+    if ((diffDirect < 0 ? -diffDirect : diffDirect) <= tol)
+        return true;
+    long long diffDollar = (long long)value * 100ll - (long long)amountCents;
+    return (diffDollar < 0 ? -diffDollar : diffDollar) <= tol;
+}
+
+void OcrAmountIndex::Clear()
+{
+    entries.clear();
+    slots.clear();
+    mask = 0;
+    lo = 0;
+    hi = -1;
+}
+
+void OcrAmountIndex::Build(int tolCents, const std::vector<int>& amountsCents, int playerCents,
+    const int* potRefs, int potRefCount, const std::vector<int>& npcAmountsCents)
+{
+    Clear();
+    if (amountsCents.empty())
+        return;
+    tol = (std::max)(0, tolCents);
+    width = 2 * tol + 1;
+
+    std::vector<Pending> pending;  // once per OCR sample; not worth a scratch member
+    auto add = [&](int amount, int bits)
+    {
+        if (amount <= 0)
+            return;
+        int64_t a = amount;
+        int64_t b0 = FloorDiv(a - tol, width);
+        int64_t b1 = FloorDiv(a + tol, width);
+        pending.push_back({ b0, a, bits });
+        if (b1 != b0)
+            pending.push_back({ b1, a, bits });
+    };
+    for (int amount : amountsCents)
+        add(amount, OCR_MATCH_ANY);
+    if (playerCents > 0)
+        add(playerCents, OCR_MATCH_PLAYER);
+    for (int i = 0; i < potRefCount; i++)
+    {
+        bool nearPlayer = playerCents > 0 && OcrAmountMatches(potRefs[i], playerCents, tolCents);
+        add(potRefs[i], nearPlayer ? kPotUnlessPlayer : OCR_MATCH_POT);
+    }
+    for (int npc : npcAmountsCents)
+        add(npc, OCR_MATCH_NPC);
+    if (pending.empty())
+        return;
+
+    // One entry per (bucket, amount), fields merged.
+    std::sort(pending.begin(), pending.end(), [](const Pending& a, const Pending& b)
+    {
+        return a.bucket != b.bucket ? a.bucket < b.bucket : a.amount < b.amount;
+    });
+    size_t buckets = 0;
+    lo = pending.front().amount;
+    hi = lo;
+    for (size_t i = 0; i < pending.size(); i++)
+    {
+        const Pending& p = pending[i];
+        lo = (std::min)(lo, p.amount);
+        hi = (std::max)(hi, p.amount);
+        if (i > 0 && pending[i - 1].bucket == p.bucket && pending[i - 1].amount == p.amount)
+        {
+            entries.back().bits |= p.bits;
+            continue;
+        }
+        if (i == 0 || pending[i - 1].bucket != p.bucket)
+            buckets++;
+        entries.push_back({ p.amount, p.bits });
+    }
+    lo -= tol;
+    hi += tol;
+
+    size_t cap = 8;
+    while (cap < buckets * 2)
+        cap <<= 1;
+    slots.assign(cap, Slot{ 0, 0, 0 });
+    mask = (uint32_t)(cap - 1);
+
+    // entries and pending are both ordered by bucket; walk them together.
+    size_t e = 0;
+    size_t i = 0;
+    while (i < pending.size())
+    {
+        int64_t bucket = pending[i].bucket;
+        size_t first = e;
+        while (i < pending.size() && pending[i].bucket == bucket)
+        {
+            if (i == 0 || pending[i - 1].bucket != bucket || pending[i - 1].amount != pending[i].amount)
+                e++;
+            i++;
+        }
+        uint32_t h = HashBucket(bucket) & mask;
+        while (slots[h].count)
+            h = (h + 1) & mask;
+        slots[h] = { bucket, (uint32_t)first, (uint32_t)(e - first) };
+    }
+}
+
+int OcrAmountIndex::MatchCents(int64_t cents) const
+{
+    if (cents < lo || cents > hi)
+        return 0;
+    int64_t bucket = FloorDiv(cents, width);
+    for (uint32_t h = HashBucket(bucket) & mask; slots[h].count; h = (h + 1) & mask)
+    {
+        const Slot& s = slots[h];
+        if (s.bucket != bucket)
+            continue;
+        int bits = 0;
+        for (uint32_t k = s.first; k < s.first + s.count; k++)
+        {
+            int64_t d = cents - entries[k].amount;
+            if ((d < 0 ? -d : d) <= tol)
+                bits |= entries[k].bits;
+        }
+        return bits;
+    }
+    return 0;
+}
+
+int OcrAmountIndex::Match(int value) const
+{
+    if (entries.empty())
+        return 0;
+    int raw = MatchCents(value) | MatchCents((int64_t)value * 100);
+    int bits = raw & (OCR_MATCH_ANY | OCR_MATCH_PLAYER | OCR_MATCH_POT | OCR_MATCH_NPC);
+    if ((raw & kPotUnlessPlayer) && !(raw & OCR_MATCH_PLAYER))
+        bits |= OCR_MATCH_POT;
+    return bits;
+}
+
+size_t OcrAmountIndex::MemoryBytes() const
+{
+    return entries.capacity() * sizeof(Entry) + slots.capacity() * sizeof(Slot);
+}
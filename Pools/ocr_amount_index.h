@@ -0,0 +1,69 @@
+/*
+  ocr_amount_index.h
+  - Which OCR fields of one sample a global value matches, in O(1) per value
+  - Built once per OCR sample from the amount list, the player stack, the pot
+    refs and the NPC stacks. Every amount is entered in the tolerance buckets
+    (width 2 * tol + 1) that its +-tol window overlaps, at most two, so a
+    value probes exactly one bucket
+  - A value is probed twice, as cents and as dollars (value * 100), the two
+    readings CandidateMatchesObservedOcrAmount accepts
+  - Buckets live in an open-addressing table; values outside the span of all
+    windows are rejected before hashing, which is most of them
+  - Built once per OCR sample and read-only afterwards; every value's bits
+    agree with the old per-amount loop in bench/ocr_amount_index_bench.cpp
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum OcrMatchBits
+{
+    OCR_MATCH_ANY = 1 << 0,
+    OCR_MATCH_PLAYER = 1 << 1,
+    OCR_MATCH_POT = 1 << 2,
+    OCR_MATCH_NPC = 1 << 3
+};
+
+// |value - amount| <= tol with value read as cents or as dollars. amountCents <= 0 never matches.
+bool OcrAmountMatches(int value, int amountCents, int tolCents);
+
+class OcrAmountIndex
+{
+public:
+    void Clear();
+    // An empty amountsCents leaves the index empty: nothing matches. A pot ref that itself matches
+    // the player stack only counts for values that do not match the player stack too.
+    void Build(int tolCents, const std::vector<int>& amountsCents, int playerCents,
+        const int* potRefs, int potRefCount, const std::vector<int>& npcAmountsCents);
+
+    int Match(int value) const;  // OcrMatchBits
+
+    bool Empty() const { return entries.empty(); }
+    size_t MemoryBytes() const;
+
+private:
+    struct Entry
+    {
+        int64_t amount;
+        int bits;
+    };
+    struct Slot
+    {
+        int64_t bucket;
+        uint32_t first;  // into entries
+        uint32_t count;  // 0 = empty slot
+    };
+
+    int MatchCents(int64_t cents) const;
+
+    int64_t tol = 0;
+    int64_t width = 1;
+    int64_t lo = 0;  // smallest amount - tol
+    int64_t hi = -1; // largest amount + tol
+    std::vector<Entry> entries;  // grouped by bucket
+    std::vector<Slot> slots;
+    uint32_t mask = 0;
+};
@@ -0,0 +1,91 @@
+/*
+  ocr_backend.h
+  - One OCR cycle: the bottom-left and top-right HUD regions, captured on the
+    script thread, recognized somewhere else, polled for their text
+  - The plugin has three backends: tesseract.exe spawned once per cycle (the
+    original path, kept as the fallback), libtesseract kept initialized on
+    its own thread for the whole session, so a cycle costs the recognition
+    alone instead of two process launches and two model loads, and the
+    long-lived highstakes_ocr worker process (ocr_ipc.h), which keeps that
+    cost while leaving a tesseract crash outside the game
+  - Images are 24-bit BGR, top-down, rows padded to 4 bytes (what GetDIBits
+    returns); Submit may swap the pixel buffers out, so capture buffers
+    circulate instead of being reallocated every cycle
+  - Interface and image types only: the three backends live in
+    highstakes.cpp; the worker (tools/highstakes_ocr.cpp) and the OCR benches
+    include it for OcrImage and the results
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum OcrRoi
+{
+    OCR_ROI_BOTTOM_LEFT = 0,  // player list, blinds, turn prompts
+    OCR_ROI_TOP_RIGHT = 1,    // pot and card HUD
+    OCR_ROI_COUNT = 2
+};
+
+constexpr unsigned kOcrAllRois = (1u << OCR_ROI_COUNT) - 1;
+
+struct OcrImage
+{
+    std::vector<unsigned char> pixels;
+    int width = 0;
+    int height = 0;
+    int stride = 0;  // bytes per row
+
+    // Keeps the allocation when the size does not grow.
+    void Resize(int w, int h)
+    {
+        width = w;
+        height = h;
+        stride = (w * 3 + 3) & ~3;
+        pixels.resize((size_t)stride * (size_t)h);
+    }
+};
+
+struct OcrWord
+{
+    std::string text;
+    int x = 0;  // box within the region, pixels
+    int y = 0;
+    int w = 0;
+    int h = 0;
+    float conf = 0.0f;  // 0..100
+};
+
+struct OcrCycleResult
+{
+    std::string text[OCR_ROI_COUNT];
+    bool ok[OCR_ROI_COUNT] = {};  // false = no text for that region (not an empty read)
+    std::vector<OcrWord> words[OCR_ROI_COUNT];  // empty unless the backend reports boxes
+};
+
+enum OcrPollResult
+{
+    OCR_POLL_IDLE = 0,     // no cycle running
+    OCR_POLL_PENDING = 1,
+    OCR_POLL_DONE = 2,     // out is filled
+    OCR_POLL_FAILED = 3    // timed out or the backend broke; the cycle is over
+};
+
+class OcrBackend
+{
+public:
+    virtual ~OcrBackend() = default;
+
+    virtual const char* Name() const = 0;
+    // A cycle is running (or an abandoned one has not wound down yet): no Submit.
+    virtual bool Busy() const = 0;
+    // Starts a cycle over the regions in roiMask (bit per OcrRoi); the others come back with ok
+    // false and no text. rois always has OCR_ROI_COUNT entries. false = not started.
+    virtual bool Submit(OcrImage* rois, unsigned roiMask, uint32_t nowMs) = 0;
+    virtual OcrPollResult Poll(uint32_t nowMs, OcrCycleResult& out) = 0;
+    // Drops the running cycle; its result is never reported.
+    virtual void Cancel() = 0;
+};
@@ -0,0 +1,351 @@
+#include "ocr_ipc.h"
+
+#include <atomic>
+#include <cstring>
+#include <new>
+
+namespace
+{
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "slot states are shared across processes");
+
+    enum SlotState : uint32_t
+    {
+        SLOT_FREE = 0,
+        SLOT_FILLED = 1
+    };
+
+    struct RingHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t slotCount;
+        uint32_t reserved;
+        uint64_t slotBytes;
+        std::atomic<uint32_t> state[kOcrIpcMaxSlots];
+    };
+
+    struct RegionHeader
+    {
+        int32_t width;
+        int32_t height;
+        int32_t stride;
+        uint32_t offset;  // from the slot start
+    };
+
+    struct SlotHeader
+    {
+        uint32_t requestId;
+        int32_t psm;
+        RegionHeader roi[OCR_ROI_COUNT];
+    };
+
+    struct WireHeader
+    {
+        uint32_t magic;
+        uint16_t type;
+        uint16_t flags;
+        uint32_t requestId;
+        uint32_t payloadBytes;
+    };
+
+    constexpr size_t kAlign = 64;
+
+    size_t AlignUp(size_t n)
+    {
+        return (n + kAlign - 1) & ~(kAlign - 1);
+    }
+
+    size_t HeaderBytes()
+    {
+        return AlignUp(sizeof(RingHeader));
+    }
+
+    RingHeader* Header(unsigned char* base)
+    {
+        return reinterpret_cast<RingHeader*>(base);
+    }
+
+    void PutU32(std::string& out, uint32_t v)
+    {
+        out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+    }
+
+    void PutString(std::string& out, const std::string& s)
+    {
+        PutU32(out, (uint32_t)s.size());
+        out.append(s);
+    }
+
+    struct Reader
+    {
+        const std::string& src;
+        size_t pos = 0;
+        bool ok = true;
+
+        bool Take(void* dst, size_t n)
+        {
+            if (!ok || src.size() - pos < n)
+                return ok = false;
+            memcpy(dst, src.data() + pos, n);
+            pos += n;
+            return true;
+        }
+
+        uint32_t U32()
+        {
+            uint32_t v = 0;
+            Take(&v, sizeof(v));
+            return v;
+        }
+
+        std::string String()
+        {
+            uint32_t n = U32();
+            if (!ok || src.size() - pos < n)
+            {
+                ok = false;
+                return std::string();
+            }
+            std::string s = src.substr(pos, n);
+            pos += n;
+            return s;
+        }
+    };
+}
+
+size_t OcrIpcSlotBytesFor(const OcrImage* rois)
+{
+    size_t n = AlignUp(sizeof(SlotHeader));
+    for (int r = 0; r < OCR_ROI_COUNT; r++)
+        n += AlignUp((size_t)rois[r].stride * (size_t)rois[r].height);
+    return n;
+}
+
+size_t OcrIpcRingBytes(int slotCount, size_t slotBytes)
+{
+    return HeaderBytes() + (size_t)slotCount * AlignUp(slotBytes);
+}
+
+bool OcrIpcRing::Create(void* memory, size_t bytes, int slots)
+{
+    base = nullptr;
+    if (!memory || slots <= 0 || slots > kOcrIpcMaxSlots || bytes <= HeaderBytes())
+        return false;
+    size_t perSlot = ((bytes - HeaderBytes()) / (size_t)slots) & ~(kAlign - 1);
+    if (perSlot <= AlignUp(sizeof(SlotHeader)))
+        return false;
+
+    RingHeader* h = new (memory) RingHeader;
+    h->magic = kOcrIpcMagic;
+    h->version = kOcrIpcVersion;
+    h->slotCount = (uint32_t)slots;
+    h->reserved = 0;
+    h->slotBytes = perSlot;
+    for (auto& s : h->state)
+        s.store(SLOT_FREE, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    base = (unsigned char*)memory;
+    slotCount = slots;
+    slotBytes = perSlot;
+    return true;
+}
+
+bool OcrIpcRing::Attach(void* memory, size_t bytes)
+{
+    base = nullptr;
+    if (!memory || bytes < HeaderBytes())
+        return false;
+    const RingHeader* h = reinterpret_cast<const RingHeader*>(memory);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (h->magic != kOcrIpcMagic || h->version != kOcrIpcVersion)
+        return false;
+    if (h->slotCount == 0 || h->slotCount > (uint32_t)kOcrIpcMaxSlots || (h->slotBytes & (kAlign - 1)) != 0)
+        return false;
+    if (h->slotBytes > (bytes - HeaderBytes()) / h->slotCount)
+        return false;
+
+    base = (unsigned char*)memory;
+    slotCount = (int)h->slotCount;
+    slotBytes = (size_t)h->slotBytes;
+    return true;
+}
+
+int OcrIpcRing::FindFree() const
+{
+    if (!base)
+        return -1;
+    for (int i = 0; i < slotCount; i++)
+    {
+        if (Header(base)->state[i].load(std::memory_order_acquire) == SLOT_FREE)
+            return i;
+    }
+    return -1;
+}
+
+bool OcrIpcRing::Write(int slot, uint32_t requestId, int psm, const OcrImage* rois, unsigned roiMask)
+{
+    if (!base || slot < 0 || slot >= slotCount || OcrIpcSlotBytesFor(rois) > slotBytes)
+        return false;
+    if (Header(base)->state[slot].load(std::memory_order_acquire) != SLOT_FREE)
+        return false;
+
+    unsigned char* s = base + HeaderBytes() + (size_t)slot * slotBytes;
+    SlotHeader sh{};
+    sh.requestId = requestId;
+    sh.psm = psm;
+    size_t offset = AlignUp(sizeof(SlotHeader));
+    for (int r = 0; r < OCR_ROI_COUNT; r++)
+    {
+        const OcrImage& img = rois[r];
+        if (!(roiMask & (1u << r)))
+        {
+            sh.roi[r] = { 0, 0, 0, (uint32_t)offset };
+            continue;
+        }
+        size_t n = (size_t)img.stride * (size_t)img.height;
+        sh.roi[r] = { img.width, img.height, img.stride, (uint32_t)offset };
+        if (n)
+            memcpy(s + offset, img.pixels.data(), n);
+        offset += AlignUp(n);
+    }
+    memcpy(s, &sh, sizeof(sh));
+    Header(base)->state[slot].store(SLOT_FILLED, std::memory_order_release);
+    return true;
+}
+
+bool OcrIpcRing::Read(int slot, uint32_t& requestId, int& psm, OcrFrameView* rois) const
+{
+    if (!base || slot < 0 || slot >= slotCount)
+        return false;
+    if (Header(base)->state[slot].load(std::memory_order_acquire) != SLOT_FILLED)
+        return false;
+
+    unsigned char* s = base + HeaderBytes() + (size_t)slot * slotBytes;
+    SlotHeader sh;
+    memcpy(&sh, s, sizeof(sh));
+    for (int r = 0; r < OCR_ROI_COUNT; r++)
+    {
+        const RegionHeader& rh = sh.roi[r];
+        if (rh.width < 0 || rh.height < 0 || rh.stride < rh.width * 3)
+            return false;
+        if (rh.offset > slotBytes || (size_t)rh.stride * (size_t)rh.height > slotBytes - rh.offset)
+            return false;
+        rois[r] = { s + rh.offset, rh.width, rh.height, rh.stride };
+    }
+    requestId = sh.requestId;
+    psm = sh.psm;
+    return true;
+}
+
+void OcrIpcRing::Release(int slot)
+{
+    if (base && slot >= 0 && slot < slotCount)
+        Header(base)->state[slot].store(SLOT_FREE, std::memory_order_release);
+}
+
+void OcrIpcAppendMessage(std::string& out, int type, uint32_t requestId, const void* payload, size_t bytes)
+{
+    WireHeader h{ kOcrIpcMagic, (uint16_t)type, 0, requestId, (uint32_t)bytes };
+    out.append(reinterpret_cast<const char*>(&h), sizeof(h));
+    if (bytes)
+        out.append(reinterpret_cast<const char*>(payload), bytes);
+}
+
+void OcrIpcEncodeResult(const OcrCycleResult& result, std::string& payload)
+{
+    payload.clear();
+    for (int r = 0; r < OCR_ROI_COUNT; r++)
+    {
+        payload.push_back(result.ok[r] ? 1 : 0);
+        PutString(payload, result.text[r]);
+        PutU32(payload, (uint32_t)result.words[r].size());
+        for (const OcrWord& w : result.words[r])
+        {
+            int32_t box[4] = { w.x, w.y, w.w, w.h };
+            payload.append(reinterpret_cast<const char*>(box), sizeof(box));
+            payload.append(reinterpret_cast<const char*>(&w.conf), sizeof(w.conf));
+            PutString(payload, w.text);
+        }
+    }
+}
+
+bool OcrIpcDecodeResult(const std::string& payload, OcrCycleResult& out)
+{
+    Reader in{ payload };
+    for (int r = 0; r < OCR_ROI_COUNT; r++)
+    {
+        uint8_t ok = 0;
+        in.Take(&ok, 1);
+        out.ok[r] = ok != 0;
+        out.text[r] = in.String();
+        uint32_t count = in.U32();
+        // Every word takes at least 24 bytes; a larger count is garbage, not a reason to allocate.
+        if (!in.ok || count > (payload.size() - in.pos) / 24)
+            return false;
+        out.words[r].resize(count);
+        for (OcrWord& w : out.words[r])
+        {
+            int32_t box[4] = {};
+            in.Take(box, sizeof(box));
+            in.Take(&w.conf, sizeof(w.conf));
+            w.x = box[0];
+            w.y = box[1];
+            w.w = box[2];
+            w.h = box[3];
+            w.text = in.String();
+        }
+    }
+    return in.ok && in.pos == payload.size();
+}
+
+bool OcrIpcDecodeSubmit(const OcrIpcMessage& msg, uint32_t& slot)
+{
+    if (msg.type != OCR_IPC_SUBMIT || msg.payload.size() != sizeof(uint32_t))
+        return false;
+    memcpy(&slot, msg.payload.data(), sizeof(slot));
+    return true;
+}
+
+void OcrIpcDecoder::Reset()
+{
+    buf.clear();
+    head = 0;
+    broken = false;
+}
+
+void OcrIpcDecoder::Feed(const void* data, size_t bytes)
+{
+    if (head > 0 && head == buf.size())
+    {
+        buf.clear();
+        head = 0;
+    }
+    buf.append(reinterpret_cast<const char*>(data), bytes);
+}
+
+bool OcrIpcDecoder::Next(OcrIpcMessage& out)
+{
+    if (broken || buf.size() - head < sizeof(WireHeader))
+        return false;
+    WireHeader h;
+    memcpy(&h, buf.data() + head, sizeof(h));
+    if (h.magic != kOcrIpcMagic || h.payloadBytes > kOcrIpcMaxPayload)
+    {
+        broken = true;
+        return false;
+    }
+    if (buf.size() - head - sizeof(h) < h.payloadBytes)
+        return false;
+
+    out.type = h.type;
+    out.requestId = h.requestId;
+    out.payload.assign(buf, head + sizeof(h), h.payloadBytes);
+    head += sizeof(h) + h.payloadBytes;
+    if (head > 65536 && head * 2 > buf.size())
+    {
+        buf.erase(0, head);
+        head = 0;
+    }
+    return true;
+}
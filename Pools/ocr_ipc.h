@@ -0,0 +1,106 @@
+/*
+  ocr_ipc.h
+  - Protocol between the plugin and the highstakes_ocr worker process
+    (tools/highstakes_ocr.cpp), which keeps OCR out of the game process
+    without paying a process launch per cycle
+  - Frames travel through a shared-memory ring: a header, then fixed-size
+    slots, each holding one cycle's regions as captured (24-bit BGR rows).
+    A slot's state word says who owns it: the plugin fills a FREE slot and
+    publishes it FILLED, the worker sets it FREE again once both regions are
+    recognized. A result that arrives late still frees its slot
+  - Requests and results travel over a byte pipe as framed messages: HELLO
+    (worker -> plugin, recognizer name), SUBMIT (request id, slot), RESULT
+    (request id; per region ok, text and word boxes) and QUIT.
+    OcrIpcDecoder reassembles them from partial reads
+  - No Windows/ScriptHook dependencies: mapping the memory and moving the
+    bytes is up to the caller (shared with the worker and host-side benches)
+*/
+
+#pragma once
+
+#include "ocr_backend.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+constexpr uint32_t kOcrIpcMagic = 0x434F5348;  // "HSOC"
+constexpr uint32_t kOcrIpcVersion = 1;
+constexpr int kOcrIpcMaxSlots = 8;
+constexpr uint32_t kOcrIpcMaxPayload = 1u << 20;  // anything larger means the stream is out of step
+
+enum OcrIpcMessageType
+{
+    OCR_IPC_HELLO = 1,   // worker -> plugin; payload: recognizer name
+    OCR_IPC_SUBMIT = 2,  // plugin -> worker; payload: slot (u32)
+    OCR_IPC_RESULT = 3,  // worker -> plugin; payload: OcrIpcEncodeResult
+    OCR_IPC_QUIT = 4     // plugin -> worker
+};
+
+struct OcrIpcMessage
+{
+    int type = 0;
+    uint32_t requestId = 0;
+    std::string payload;
+};
+
+// One region inside a FILLED slot; pixels point into the shared memory.
+struct OcrFrameView
+{
+    unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    int stride = 0;
+};
+
+// Slot payload bytes these regions need.
+size_t OcrIpcSlotBytesFor(const OcrImage* rois);
+// Mapping size for slotCount slots of slotBytes each.
+size_t OcrIpcRingBytes(int slotCount, size_t slotBytes);
+
+class OcrIpcRing
+{
+public:
+    // Creator: lays the header over zeroed memory; every slot starts FREE. false = bad arguments.
+    bool Create(void* base, size_t bytes, int slotCount);
+    // The other side: checks magic, version and that the layout fits in bytes.
+    bool Attach(void* base, size_t bytes);
+
+    bool Valid() const { return base != nullptr; }
+    int SlotCount() const { return slotCount; }
+    size_t SlotCapacity() const { return slotBytes; }
+
+    int FindFree() const;  // -1 = every slot is in use
+    // Plugin: copies the regions in roiMask into a FREE slot (the others as 0x0) and publishes it.
+    // false = slot busy or too small.
+    bool Write(int slot, uint32_t requestId, int psm, const OcrImage* rois, unsigned roiMask);
+    // Worker: a FILLED slot's header and regions. false = not FILLED or a header that does not fit.
+    bool Read(int slot, uint32_t& requestId, int& psm, OcrFrameView* rois) const;
+    void Release(int slot);
+
+private:
+    unsigned char* base = nullptr;
+    int slotCount = 0;
+    size_t slotBytes = 0;
+};
+
+void OcrIpcAppendMessage(std::string& out, int type, uint32_t requestId, const void* payload, size_t bytes);
+void OcrIpcEncodeResult(const OcrCycleResult& result, std::string& payload);
+bool OcrIpcDecodeResult(const std::string& payload, OcrCycleResult& out);
+bool OcrIpcDecodeSubmit(const OcrIpcMessage& msg, uint32_t& slot);
+
+class OcrIpcDecoder
+{
+public:
+    void Reset();
+    void Feed(const void* data, size_t bytes);
+    // Next complete message. false = more bytes needed, or Broken().
+    bool Next(OcrIpcMessage& out);
+    // Bad magic or an oversized payload: the stream cannot be resynchronized.
+    bool Broken() const { return broken; }
+
+private:
+    std::string buf;
+    size_t head = 0;
+    bool broken = false;
+};
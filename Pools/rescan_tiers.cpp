@@ -0,0 +1,236 @@
+#include "rescan_tiers.h"
+
+#include <algorithm>
+
+namespace
+{
+    bool SortedContains(const std::vector<int>& v, int x)
+    {
+        return std::binary_search(v.begin(), v.end(), x);
+    }
+
+    // Slot of the first candidate with idx >= globalIdx (Size() when none).
+    int LowerSlot(const MoneyCandidateStore& s, int globalIdx)
+    {
+        return (int)(std::lower_bound(s.idx.begin(), s.idx.end(), globalIdx) - s.idx.begin());
+    }
+}
+
+void RescanTiers::Reset(uint32_t nowMs)
+{
+    locked.clear();
+    hot.clear();
+    hotCursor = 0;
+    coldCursorIdx = 0;
+    hotLapStartMs = nowMs;
+    coldLapStartMs = nowMs;
+    lastStepMs = nowMs;
+    windowStartMs = nowMs;
+    for (int t = 0; t < RESCAN_TIER_COUNT; t++)
+        windowMaxAge[t] = 0;
+    metrics = RescanTierMetrics{};
+}
+
+void RescanTiers::SetLocked(const std::vector<int>& globalIdx)
+{
+    locked.clear();
+    for (int idx : globalIdx)
+    {
+        if (idx >= 0)
+            locked.push_back(idx);
+    }
+    std::sort(locked.begin(), locked.end());
+    locked.erase(std::unique(locked.begin(), locked.end()), locked.end());
+}
+
+void RescanTiers::MarkHot(int globalIdx)
+{
+    auto it = std::lower_bound(hot.begin(), hot.end(), globalIdx);
+    if (it != hot.end() && *it == globalIdx)
+        return;
+    size_t pos = (size_t)(it - hot.begin());
+    hot.insert(it, globalIdx);
+    if (pos < hotCursor)
+        hotCursor++;  // keep pointing at the same entry
+}
+
+void RescanTiers::Forget(int globalIdx)
+{
+    auto it = std::lower_bound(hot.begin(), hot.end(), globalIdx);
+    if (it == hot.end() || *it != globalIdx)
+        return;
+    size_t pos = (size_t)(it - hot.begin());
+    hot.erase(it);
+    if (pos < hotCursor)
+        hotCursor--;
+    if (hotCursor >= hot.size())
+        hotCursor = 0;
+}
+
+bool RescanTiers::IsHot(int globalIdx) const
+{
+    return SortedContains(hot, globalIdx);
+}
+
+void RescanTiers::Roll(uint32_t nowMs)
+{
+    if (nowMs - windowStartMs < kReportMs)
+        return;
+    for (int t = 0; t < RESCAN_TIER_COUNT; t++)
+    {
+        metrics.maxAgeMs[t] = windowMaxAge[t];
+        windowMaxAge[t] = 0;
+    }
+    windowStartMs = nowMs;
+}
+
+void RescanTiers::Plan(const MoneyCandidateStore& s, const RescanBudget& budget, uint32_t nowMs,
+    std::vector<int>& outSlots, std::vector<uint8_t>& outTiers)
+{
+    outSlots.clear();
+    outTiers.clear();
+    for (int t = 0; t < RESCAN_TIER_COUNT; t++)
+    {
+        tierSlots[t].clear();
+        metrics.reads[t] = 0;
+    }
+    Roll(nowMs);
+    metrics.lapMs[RESCAN_TIER_LOCKED] = nowMs - lastStepMs;
+    lastStepMs = nowMs;
+
+    int n = s.Size();
+    if (n <= 0)
+    {
+        for (int t = 0; t < RESCAN_TIER_COUNT; t++)
+            metrics.count[t] = 0;
+        return;
+    }
+
+    // Tier 0: every locked global that is a candidate, regardless of budget.
+    for (int idx : locked)
+    {
+        int slot = s.Find(idx);
+        if (slot >= 0)
+            tierSlots[RESCAN_TIER_LOCKED].push_back(slot);
+    }
+    int lockedN = (int)tierSlots[RESCAN_TIER_LOCKED].size();
+    int hotN = 0;
+    for (int idx : hot)
+    {
+        if (s.Contains(idx) && !SortedContains(locked, idx))
+            hotN++;
+    }
+    int coldN = (std::max)(0, n - lockedN - hotN);
+    metrics.count[RESCAN_TIER_LOCKED] = lockedN;
+    metrics.count[RESCAN_TIER_HOT] = hotN;
+    metrics.count[RESCAN_TIER_COLD] = coldN;
+
+    // Cold reserve: enough per step for a full lap within coldMaxAgeMs, capped at half the rest.
+    int remaining = (std::max)(0, budget.maxReads - lockedN);
+    int coldReserve = 0;
+    metrics.coldClamped = false;
+    metrics.coldLapBoundMs = 0;
+    if (coldN > 0 && remaining > 0)
+    {
+        uint32_t maxAge = (std::max)(budget.coldMaxAgeMs, (uint32_t)1);
+        int64_t need = ((int64_t)coldN * budget.stepIntervalMs + maxAge - 1) / maxAge;
+        int cap = (std::max)(1, remaining / 2);
+        coldReserve = (int)(std::min)((std::max)(need, (int64_t)1), (int64_t)cap);
+        metrics.coldClamped = need > cap;
+        metrics.coldLapBoundMs = (uint32_t)(((int64_t)coldN * budget.stepIntervalMs + coldReserve - 1) / coldReserve);
+    }
+    int hotTake = (std::min)(hotN, remaining - coldReserve);
+    int coldTake = remaining - hotTake;
+
+    // Tier 1: round-robin over the hot list; entries that left the store are skipped.
+    std::vector<int>& hotSlots = tierSlots[RESCAN_TIER_HOT];
+    for (size_t visited = 0; (int)hotSlots.size() < hotTake && visited < hot.size(); visited++)
+    {
+        if (hotCursor >= hot.size())
+        {
+            hotCursor = 0;
+            metrics.lapMs[RESCAN_TIER_HOT] = nowMs - hotLapStartMs;
+            hotLapStartMs = nowMs;
+        }
+        int idx = hot[hotCursor++];
+        if (SortedContains(locked, idx))
+            continue;
+        int slot = s.Find(idx);
+        if (slot >= 0)
+            hotSlots.push_back(slot);
+    }
+    if (hotCursor >= hot.size() && !hot.empty())
+    {
+        hotCursor = 0;
+        metrics.lapMs[RESCAN_TIER_HOT] = nowMs - hotLapStartMs;
+        hotLapStartMs = nowMs;
+    }
+
+    // Tier 2: resume at the first candidate at or past the cursor index; at most one lap per step.
+    std::vector<int>& coldSlots = tierSlots[RESCAN_TIER_COLD];
+    // The walk is ascending, so hot/locked membership is a merge against both sorted lists.
+    int slot = LowerSlot(s, coldCursorIdx);
+    size_t hp = std::lower_bound(hot.begin(), hot.end(), coldCursorIdx) - hot.begin();
+    size_t lp = std::lower_bound(locked.begin(), locked.end(), coldCursorIdx) - locked.begin();
+    for (int visited = 0; (int)coldSlots.size() < coldTake && visited < n; visited++, slot++)
+    {
+        if (slot >= n)
+        {
+            slot = 0;
+            hp = 0;
+            lp = 0;
+            metrics.lapMs[RESCAN_TIER_COLD] = nowMs - coldLapStartMs;
+            coldLapStartMs = nowMs;
+        }
+        int idx = s.idx[(size_t)slot];
+        while (hp < hot.size() && hot[hp] < idx)
+            hp++;
+        while (lp < locked.size() && locked[lp] < idx)
+            lp++;
+        bool skip = (hp < hot.size() && hot[hp] == idx) || (lp < locked.size() && locked[lp] == idx);
+        if (!skip)
+            coldSlots.push_back(slot);
+    }
+    if (slot >= n)
+    {
+        slot = 0;
+        metrics.lapMs[RESCAN_TIER_COLD] = nowMs - coldLapStartMs;
+        coldLapStartMs = nowMs;
+    }
+    coldCursorIdx = s.idx[(size_t)slot];
+
+    // Each tier is ascending apart from one wrap; rotate it out and merge, so neighbouring
+    // candidates stay in one bulk read.
+    for (int t = 0; t < RESCAN_TIER_COUNT; t++)
+    {
+        std::vector<int>& v = tierSlots[t];
+        metrics.reads[t] = (int)v.size();
+        auto wrap = std::is_sorted_until(v.begin(), v.end());
+        if (wrap != v.end())
+            std::rotate(v.begin(), wrap, v.end());
+    }
+    size_t pos[RESCAN_TIER_COUNT] = {};
+    size_t total = tierSlots[0].size() + tierSlots[1].size() + tierSlots[2].size();
+    outSlots.reserve(total);
+    outTiers.reserve(total);
+    while (outSlots.size() < total)
+    {
+        int pick = -1;
+        for (int t = 0; t < RESCAN_TIER_COUNT; t++)
+        {
+            if (pos[t] < tierSlots[t].size() &&
+                (pick < 0 || tierSlots[t][pos[t]] < tierSlots[pick][pos[pick]]))
+                pick = t;
+        }
+        outSlots.push_back(tierSlots[pick][pos[pick]++]);
+        outTiers.push_back((uint8_t)pick);
+    }
+}
+
+size_t RescanTiers::MemoryBytes() const
+{
+    size_t bytes = (locked.capacity() + hot.capacity()) * sizeof(int);
+    for (const std::vector<int>& slots : tierSlots)
+        bytes += slots.capacity() * sizeof(int);
+    return bytes;
+}
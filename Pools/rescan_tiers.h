@@ -0,0 +1,96 @@
+/*
+  rescan_tiers.h
+  - Tiered round-robin rescan planner for the money candidate store
+  - Tier 0 (locked watch globals) is read every rescan step (not every frame:
+    steps run at the rescan interval, and the overlay's watches read those
+    globals themselves); tier 1 (OCR-correlated
+    candidates, kept as a sorted index list) round-robins at the step rate;
+    tier 2 (everything else) resumes a round-robin cursor keyed by global
+    index, so inserts and compaction never restart or starve it
+  - The cold share of each step is sized so a full cold lap fits the cold
+    max-age bound; hot takes what is left after that reserve. The reserve is
+    capped at half the step's reads, and metrics say when that cap broke the
+    bound
+  - Per tier: candidates, reads in the last step, worst read age and last lap
+  - bench/rescan_tiers_bench.cpp reports the worst read age per tier
+    against the old prefix rescan
+*/
+
+#pragma once
+
+#include "money_store.h"
+
+#include <cstdint>
+#include <vector>
+
+enum RescanTier
+{
+    RESCAN_TIER_LOCKED = 0,
+    RESCAN_TIER_HOT = 1,
+    RESCAN_TIER_COLD = 2,
+    RESCAN_TIER_COUNT = 3
+};
+
+struct RescanTierMetrics
+{
+    int count[RESCAN_TIER_COUNT] = {};
+    int reads[RESCAN_TIER_COUNT] = {};          // last step
+    uint32_t maxAgeMs[RESCAN_TIER_COUNT] = {};  // worst time between reads, last report window
+    uint32_t lapMs[RESCAN_TIER_COUNT] = {};     // last full pass over the tier
+    bool coldClamped = false;     // last step: the cold reserve was capped below what coldMaxAgeMs needs
+    uint32_t coldLapBoundMs = 0;  // last step: cold lap time at the reserved rate
+};
+
+struct RescanBudget
+{
+    int maxReads = 16384;          // per step, all tiers
+    uint32_t stepIntervalMs = 10;  // time between rescan steps
+    uint32_t coldMaxAgeMs = 2000;  // target for a full cold lap
+};
+
+class RescanTiers
+{
+public:
+    void Reset(uint32_t nowMs);
+
+    // Tier 0 global indices (any order; indices that are not candidates are ignored).
+    void SetLocked(const std::vector<int>& globalIdx);
+
+    // Tier 1 membership (idempotent). Call Forget before a candidate is compacted away.
+    void MarkHot(int globalIdx);
+    void Forget(int globalIdx);
+    bool IsHot(int globalIdx) const;
+    int HotCount() const { return (int)hot.size(); }
+
+    // Slots to read this step, ascending and unique, with the tier of each.
+    void Plan(const MoneyCandidateStore& s, const RescanBudget& budget, uint32_t nowMs,
+        std::vector<int>& outSlots, std::vector<uint8_t>& outTiers);
+
+    // Once per read slot, with the time since that slot's previous read.
+    void OnRead(int tier, uint32_t ageMs)
+    {
+        if (ageMs > windowMaxAge[tier])
+            windowMaxAge[tier] = ageMs;
+    }
+
+    // Latest completed report window (rolled every kReportMs).
+    const RescanTierMetrics& Metrics() const { return metrics; }
+    size_t MemoryBytes() const;
+
+    static const uint32_t kReportMs = 1000;
+
+private:
+    void Roll(uint32_t nowMs);
+
+    std::vector<int> locked;   // sorted global indices
+    std::vector<int> hot;      // sorted global indices
+    size_t hotCursor = 0;      // position in hot
+    int coldCursorIdx = 0;     // next global index for the cold walk
+    uint32_t hotLapStartMs = 0;
+    uint32_t coldLapStartMs = 0;
+    uint32_t lastStepMs = 0;
+    uint32_t windowStartMs = 0;
+    uint32_t windowMaxAge[RESCAN_TIER_COUNT] = {};
+    RescanTierMetrics metrics;
+    std::vector<int> tierSlots[RESCAN_TIER_COUNT];  // per-step scratch
+};
@@ -0,0 +1,126 @@
+#include "scan_scheduler.h"
+
+namespace
+{
+    const double kCostAlpha = 0.2;        // EWMA weight of the newest read-cost sample
+    const double kFrameAlpha = 0.05;      // EWMA weight of the newest frame time
+    const int64_t kRateWindowUs = 1000000;
+    const int kMinCostSampleReads = 64;   // smaller reads are dominated by timer overhead
+}
+
+void ScanScheduler::Reset(int64_t nowUs)
+{
+    // Learned costs survive a scan reset.
+    double cost = metrics.costNsPerRead;
+    double rescanCost = metrics.rescanNsPerCand;
+    double evictCost = metrics.evictNsPerCand;
+    metrics = ScanSchedulerMetrics{};
+    metrics.costNsPerRead = cost;
+    metrics.rescanNsPerCand = rescanCost;
+    metrics.evictNsPerCand = evictCost;
+    resetUs = nowUs;
+    windowStartUs = nowUs;
+    windowReads = 0;
+}
+
+static int CountForBudget(double costNs, int64_t budgetUs, int minCount, int maxCount)
+{
+    if (maxCount < minCount)
+        maxCount = minCount;
+    if (costNs <= 0.0)
+        return maxCount;  // first chunk measures the cost
+    double count = (double)budgetUs * 1000.0 / costNs;
+    if (count < (double)minCount)
+        return minCount;
+    if (count > (double)maxCount)
+        return maxCount;
+    return (int)count;
+}
+
+int ScanScheduler::ReadsForBudget(int64_t budgetUs, int minReads, int maxReads) const
+{
+    return CountForBudget(metrics.costNsPerRead, budgetUs, minReads, maxReads);
+}
+
+int ScanScheduler::RescansForBudget(int64_t budgetUs, int minCands, int maxCands) const
+{
+    return CountForBudget(metrics.rescanNsPerCand, budgetUs, minCands, maxCands);
+}
+
+int ScanScheduler::EvictScoresForBudget(int64_t budgetUs, int minCands, int maxCands) const
+{
+    return CountForBudget(metrics.evictNsPerCand, budgetUs, minCands, maxCands);
+}
+
+int64_t ScanScheduler::ExpectedRescanUs(int cands) const
+{
+    return (int64_t)((double)cands * metrics.rescanNsPerCand / 1000.0);
+}
+
+static void UpdateCost(double& cost, int n, int64_t elapsedUs)
+{
+    if (n < kMinCostSampleReads)
+        return;
+    double sample = (double)elapsedUs * 1000.0 / (double)n;
+    if (sample < 0.1)
+        sample = 0.1;  // sub-microsecond chunks read as 0us
+    cost = (cost <= 0.0) ? sample : cost + kCostAlpha * (sample - cost);
+}
+
+void ScanScheduler::OnReads(int reads, int64_t elapsedUs, int64_t nowUs)
+{
+    UpdateCost(metrics.costNsPerRead, reads, elapsedUs);
+    CountReads(reads, nowUs);
+}
+
+void ScanScheduler::OnRescan(int cands, int64_t elapsedUs, int64_t nowUs)
+{
+    UpdateCost(metrics.rescanNsPerCand, cands, elapsedUs);
+    CountReads(cands, nowUs);
+}
+
+void ScanScheduler::OnEvictScores(int cands, int64_t elapsedUs)
+{
+    UpdateCost(metrics.evictNsPerCand, cands, elapsedUs);
+}
+
+void ScanScheduler::CountReads(int reads, int64_t nowUs)
+{
+    windowReads += reads;
+    int64_t windowUs = nowUs - windowStartUs;
+    if (windowUs >= kRateWindowUs)
+    {
+        metrics.readsPerSec = (double)windowReads * 1000000.0 / (double)windowUs;
+        windowStartUs = nowUs;
+        windowReads = 0;
+    }
+}
+
+void ScanScheduler::OnStep(int64_t elapsedUs, int64_t budgetUs)
+{
+    metrics.lastStepUs = (int)elapsedUs;
+    metrics.lastBudgetUs = (int)budgetUs;
+}
+
+void ScanScheduler::OnWrap(int64_t nowUs)
+{
+    if (metrics.firstWrapMs < 0)
+        metrics.firstWrapMs = (nowUs - resetUs) / 1000;
+}
+
+void FrameClock::OnFrame(int64_t nowUs)
+{
+    if (prevUs != 0 && nowUs > prevUs)
+    {
+        lastFrameUs = (double)(nowUs - prevUs);
+        avgFrameUs = (avgFrameUs <= 0.0) ? lastFrameUs : avgFrameUs + kFrameAlpha * (lastFrameUs - avgFrameUs);
+    }
+    prevUs = nowUs;
+}
+
+int64_t FrameClock::ScaleBudget(int64_t budgetUs) const
+{
+    if (avgFrameUs > 0.0 && lastFrameUs > avgFrameUs * 2.0)
+        return budgetUs / 2;
+    return budgetUs;
+}
@@ -0,0 +1,73 @@
+/*
+  scan_scheduler.h
+  - Microsecond budgeting for the money scanner
+  - Learns the cost of a global read from measured bulk reads (EWMA) and sizes
+    the next chunk so a step stays inside its budget
+  - Tracks the script frame time between WAIT(0) calls and backs the budget off
+    on hitch frames
+  - Exposes reads/sec and time-to-first-wrap for tuning
+  - Timestamps are passed in (QPC microseconds in the plugin), so this has no
+    Windows/ScriptHook dependencies (shared with the host-side benchmarks)
+*/
+
+#pragma once
+
+#include <cstdint>
+
+struct ScanSchedulerMetrics
+{
+    double readsPerSec = 0.0;
+    double costNsPerRead = 0.0;  // EWMA over bulk reads; 0 until the first measurement
+    double rescanNsPerCand = 0.0; // EWMA over rescans (read + diff + correlation)
+    double evictNsPerCand = 0.0;  // EWMA over candidate-cap slices (keep score + threshold test)
+    int lastStepUs = 0;          // wall time of the last discovery step
+    int lastBudgetUs = 0;        // budget that step ran under
+    int64_t firstWrapMs = -1;    // reset -> first full wrap; -1 until it happens
+};
+
+struct ScanScheduler
+{
+    void Reset(int64_t nowUs);
+
+    // Reads that fit in budgetUs at the learned cost, clamped to [minReads, maxReads].
+    int ReadsForBudget(int64_t budgetUs, int minReads, int maxReads) const;
+    // Expected wall time of a rescan over cands candidates.
+    int64_t ExpectedRescanUs(int cands) const;
+    // Candidates a rescan can cover in budgetUs at the learned per-candidate cost, clamped to [minCands, maxCands].
+    int RescansForBudget(int64_t budgetUs, int minCands, int maxCands) const;
+    // Candidates a candidate-cap slice can score in budgetUs, clamped to [minCands, maxCands].
+    int EvictScoresForBudget(int64_t budgetUs, int minCands, int maxCands) const;
+
+    void OnReads(int reads, int64_t elapsedUs, int64_t nowUs);
+    void OnRescan(int cands, int64_t elapsedUs, int64_t nowUs);
+    void OnEvictScores(int cands, int64_t elapsedUs);
+    void OnStep(int64_t elapsedUs, int64_t budgetUs);
+    void OnWrap(int64_t nowUs);
+
+    const ScanSchedulerMetrics& Metrics() const { return metrics; }
+
+private:
+    void CountReads(int reads, int64_t nowUs);
+
+    ScanSchedulerMetrics metrics;
+    int64_t resetUs = 0;
+    int64_t windowStartUs = 0;
+    int64_t windowReads = 0;
+};
+
+// Script-thread frame clock. Call OnFrame once per WAIT(0).
+struct FrameClock
+{
+    void OnFrame(int64_t nowUs);
+
+    // budgetUs, halved when the last frame ran at more than twice the average.
+    int64_t ScaleBudget(int64_t budgetUs) const;
+
+    double AvgFrameMs() const { return avgFrameUs / 1000.0; }
+    double LastFrameMs() const { return lastFrameUs / 1000.0; }
+
+private:
+    int64_t prevUs = 0;
+    double avgFrameUs = 0.0;
+    double lastFrameUs = 0.0;
+};
@@ -0,0 +1,212 @@
+#include "seat_layout.h"
+
+#include <algorithm>
+
+namespace
+{
+    const int kMaxSeats = 32;        // memberMask width
+    const int kMaxPlacedWindows = 16; // windows tried for placement, best first
+
+    int EvidenceScore(const SeatEvidence& e)
+    {
+        return e.npcScore + e.playerScore + (e.matchesNpcNow ? 2 : 0) + (e.isPlayer ? 4 : 0);
+    }
+
+    bool LooksLikePlayer(const SeatEvidence& e)
+    {
+        return e.isPlayer || e.playerScore > e.npcScore;
+    }
+
+    // Run of evidence on one lattice that fits in `seats` consecutive positions.
+    struct Window
+    {
+        int members = 0;
+        int score = 0;
+        int span = 0;     // positions from the first to the last member
+        int stride = 0;
+        int first = -1;
+        int last = -1;
+    };
+
+    // More seats with evidence, then more evidence, then the denser run (a lattice at half the
+    // stride also holds every member, with empty seats between them), then the tighter stride.
+    bool BetterWindow(const Window& a, const Window& b)
+    {
+        if (a.members != b.members)
+            return a.members > b.members;
+        if (a.score != b.score)
+            return a.score > b.score;
+        if (a.span != b.span)
+            return a.span < b.span;
+        return a.stride < b.stride;
+    }
+
+    // Evidence that looks like the player anywhere a placement of the window may reach, on the
+    // lattice or not, plus on the lattice up to two array lengths past either end member (an
+    // array at twice the stride holds the same members with the other player further out).
+    int PlayerLikeNear(const std::vector<SeatEvidence>& evidence, const Window& w, int lo, int hi, int seats)
+    {
+        int farLo = w.last - (seats - 1) * w.stride * 2;
+        int farHi = w.first + (seats - 1) * w.stride * 2;
+        int n = 0;
+        for (const SeatEvidence& e : evidence)
+        {
+            if (!LooksLikePlayer(e))
+                continue;
+            bool reach = e.idx >= lo && e.idx <= hi;
+            bool lattice = e.idx >= farLo && e.idx <= farHi && (e.idx - w.first) % w.stride == 0;
+            n += (reach || lattice) ? 1 : 0;
+        }
+        return n;
+    }
+}
+
+SeatArrayFit InferSeatArray(const std::vector<SeatEvidence>& evidence, const SeatArrayParams& params,
+    const std::function<bool(int)>& plausibleEmptySeat)
+{
+    SeatArrayFit best;
+    int seats = (std::max)(2, (std::min)(params.seats, kMaxSeats));
+    int minSeats = (std::max)(2, (std::min)(params.minSeats, seats));
+    if ((int)evidence.size() < minSeats)
+        return best;
+
+    int knownPlayer = -1;
+    for (const SeatEvidence& e : evidence)
+    {
+        if (e.isPlayer)
+            knownPlayer = e.idx;
+    }
+
+    std::vector<const SeatEvidence*> items;
+    items.reserve(evidence.size());
+    for (const SeatEvidence& e : evidence)
+    {
+        if (e.idx >= 0)
+            items.push_back(&e);
+    }
+
+    std::vector<Window> windows;
+    for (int stride = 1; stride <= params.maxStride; stride++)
+    {
+        // Same residue mod stride = same lattice; within it, ascending index.
+        std::sort(items.begin(), items.end(), [stride](const SeatEvidence* a, const SeatEvidence* b)
+        {
+            int ra = a->idx % stride;
+            int rb = b->idx % stride;
+            return (ra != rb) ? (ra < rb) : (a->idx < b->idx);
+        });
+
+        for (size_t i = 0; i < items.size(); i++)
+        {
+            int residue = items[i]->idx % stride;
+            Window w;
+            w.stride = stride;
+            w.first = items[i]->idx;
+            w.last = w.first;
+            int playerSeats = 0;
+            bool hasKnownPlayer = false;
+            for (size_t j = i; j < items.size(); j++)
+            {
+                const SeatEvidence& e = *items[j];
+                if (e.idx % stride != residue || (e.idx - w.first) / stride >= seats)
+                    break;
+                w.members++;
+                w.score += EvidenceScore(e);
+                if (LooksLikePlayer(e))
+                    playerSeats++;
+                hasKnownPlayer |= e.idx == knownPlayer;
+                w.last = e.idx;
+            }
+            if (w.members < minSeats || playerSeats > 1)
+                continue;
+            if (knownPlayer >= 0 && !hasKnownPlayer)
+                continue;  // the table array holds the player's seat too
+            w.span = (w.last - w.first) / stride;
+            windows.push_back(w);
+        }
+    }
+    std::sort(windows.begin(), windows.end(), BetterWindow);
+    if ((int)windows.size() > kMaxPlacedWindows)
+        windows.resize((size_t)kMaxPlacedWindows);
+
+    // Place the best window that can be placed: every seat without evidence must look like a
+    // stack (or an empty seat). Any placement may reach [lo, hi]; a second player-like value in
+    // there means the window may have slid off the real array, so the fit is left to OCR.
+    // Evidence on every other seat reads the same at twice the stride; when a window with the
+    // same members and score at another stride places too, the stride is a guess and nothing
+    // is returned until more seats show evidence.
+    std::vector<const SeatEvidence*> byIdx;
+    const Window* placedWindow = nullptr;
+    for (const Window& w : windows)
+    {
+        if (placedWindow && (w.members != placedWindow->members || w.score != placedWindow->score))
+            break;
+        int slack = seats - 1 - w.span;
+        int lo = w.first - slack * w.stride;
+        int hi = w.last + slack * w.stride;
+        if (PlayerLikeNear(evidence, w, lo, hi, seats) > 1)
+            continue;
+        byIdx.clear();
+        for (const SeatEvidence& e : evidence)
+        {
+            if (e.idx >= lo && e.idx <= hi && (e.idx - w.first) % w.stride == 0)
+                byIdx.push_back(&e);
+        }
+        auto findAt = [&byIdx](int idx) -> const SeatEvidence*
+        {
+            for (const SeatEvidence* e : byIdx)
+            {
+                if (e->idx == idx)
+                    return e;
+            }
+            return nullptr;
+        };
+
+        int base = -1;
+        int placed = 0;
+        for (int shift = slack; shift >= 0; shift--)
+        {
+            int b = w.first - shift * w.stride;
+            if (b < 0)
+                continue;
+            bool ok = true;
+            for (int s = 0; s < seats && ok; s++)
+            {
+                int idx = b + s * w.stride;
+                if (!findAt(idx) && !plausibleEmptySeat(idx))
+                    ok = false;
+            }
+            if (!ok)
+                continue;
+            if (placed++ == 0)
+                base = b;  // lowest plausible base wins
+        }
+        if (placed == 0)
+            continue;
+        if (placedWindow)
+        {
+            if (w.stride != placedWindow->stride)
+                return SeatArrayFit();
+            continue;
+        }
+        placedWindow = &w;
+
+        best.found = true;
+        best.base = base;
+        best.stride = w.stride;
+        best.seats = seats;
+        best.score = w.score;
+        best.baseAmbiguous = placed > 1;
+        for (int s = 0; s < seats; s++)
+        {
+            const SeatEvidence* e = findAt(best.SeatIndex(s));
+            if (!e)
+                continue;
+            best.members++;
+            best.memberMask |= 1u << s;
+            if (LooksLikePlayer(*e))
+                best.playerSeat = s;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,57 @@
+/*
+  seat_layout.h
+  - Structural inference of the seat-stack array from ranked candidates
+  - Script arrays lay seats out at a constant stride, so candidates whose
+    values track NPC / player OCR amounts are bucketed by (stride, index mod
+    stride) and the best window of `seats` consecutive positions is scored
+  - Ties go to the denser run; a run that places equally well at another
+    stride, or with a second player-like value within reach, is not fitted
+  - When the found members do not span the whole window the base is
+    ambiguous; the caller's plausibility test on the empty seats decides
+  - Reads no memory itself: the caller's plausibility test is the only
+    look at the empty seats. bench/seat_layout_bench.cpp checks fits and
+    refusals on synthetic tables
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+struct SeatEvidence
+{
+    int idx = -1;              // global index
+    int value = 0;
+    int npcScore = 0;          // NPC OCR matches / aligned NPC steps
+    int playerScore = 0;       // player OCR matches / aligned player steps
+    bool matchesNpcNow = false; // current value equals a current OCR NPC amount
+    bool isPlayer = false;     // the locked player stack global
+};
+
+struct SeatArrayParams
+{
+    int seats = 6;
+    int maxStride = 64;
+    int minSeats = 3;          // seats with evidence, player included
+};
+
+struct SeatArrayFit
+{
+    bool found = false;
+    int base = -1;             // global index of seat 0
+    int stride = 0;
+    int seats = 0;
+    int members = 0;           // seats backed by evidence
+    uint32_t memberMask = 0;   // bit s: seat s backed by evidence
+    int playerSeat = -1;
+    int score = 0;
+    bool baseAmbiguous = false; // members did not span every seat
+
+    int SeatIndex(int seat) const { return base + seat * stride; }
+};
+
+// plausibleEmptySeat(globalIdx) is asked about seats without evidence when placing the window;
+// it should accept an empty (0) or in-range stack. Returns the best-scoring fit, or found=false.
+SeatArrayFit InferSeatArray(const std::vector<SeatEvidence>& evidence, const SeatArrayParams& params,
+    const std::function<bool(int)>& plausibleEmptySeat);
@@ -0,0 +1,151 @@
+#include "session_cache.h"
+
+#include <cstdio>
+
+namespace
+{
+    const uint32_t kMagic = 0x43535348;  // "HSSC"
+    const uint32_t kVersion = 1;
+    const int kFieldsPerEntry = 12;
+    const uint32_t kMaxEntries = 4096;
+
+    uint32_t Fnv1a(const char* data, size_t n)
+    {
+        uint32_t h = 2166136261u;
+        for (size_t i = 0; i < n; i++)
+        {
+            h ^= (unsigned char)data[i];
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    // Little-endian regardless of host, so a cache copied between machines still loads.
+    void Put32(std::string& out, uint32_t v)
+    {
+        for (int b = 0; b < 4; b++)
+            out.push_back((char)((v >> (8 * b)) & 0xFF));
+    }
+
+    bool Get32(const std::string& in, size_t& pos, uint32_t& v)
+    {
+        if (pos > in.size() || in.size() - pos < 4)
+            return false;
+        v = 0;
+        for (int b = 0; b < 4; b++)
+            v |= (uint32_t)(unsigned char)in[pos + (size_t)b] << (8 * b);
+        pos += 4;
+        return true;
+    }
+
+    template <class F>
+    void ForEachField(SessionCacheEntry& e, F&& f)
+    {
+        f(e.idx);
+        f(e.category);
+        f(e.flags);
+        f(e.last);
+        f(e.ageMs);
+        f(e.changes);
+        f(e.betStepMatches);
+        f(e.betStepMismatches);
+        f(e.ocrAnyMatches);
+        f(e.ocrPotMatches);
+        f(e.ocrPlayerMatches);
+        f(e.ocrNpcMatches);
+    }
+}
+
+std::string SerializeSessionCache(const SessionCacheKey& key, const std::vector<SessionCacheEntry>& entries)
+{
+    std::string out;
+    out.reserve(24 + key.build.size() + entries.size() * kFieldsPerEntry * 4);
+    Put32(out, kMagic);
+    Put32(out, kVersion);
+    Put32(out, (uint32_t)key.build.size());
+    out += key.build;
+    Put32(out, key.script);
+    Put32(out, (uint32_t)entries.size());
+    for (SessionCacheEntry e : entries)
+        ForEachField(e, [&](int32_t& v) { Put32(out, (uint32_t)v); });
+    Put32(out, Fnv1a(out.data(), out.size()));
+    return out;
+}
+
+bool DeserializeSessionCache(const std::string& bytes, const SessionCacheKey& key,
+    std::vector<SessionCacheEntry>& out, std::string& why)
+{
+    out.clear();
+    if (bytes.size() < 4)
+    {
+        why = "truncated";
+        return false;
+    }
+    size_t body = bytes.size() - 4;
+    size_t sumPos = body;
+    uint32_t sum = 0;
+    Get32(bytes, sumPos, sum);
+    if (Fnv1a(bytes.data(), body) != sum)
+    {
+        why = "checksum mismatch";
+        return false;
+    }
+
+    std::string in = bytes.substr(0, body);
+    size_t pos = 0;
+    uint32_t magic = 0, version = 0, buildLen = 0;
+    if (!Get32(in, pos, magic) || magic != kMagic)
+    {
+        why = "not a session cache";
+        return false;
+    }
+    if (!Get32(in, pos, version) || version != kVersion)
+    {
+        why = "unsupported version";
+        return false;
+    }
+    if (!Get32(in, pos, buildLen) || buildLen > in.size() - pos)
+    {
+        why = "truncated";
+        return false;
+    }
+    std::string build = in.substr(pos, buildLen);
+    pos += buildLen;
+    if (build != key.build)
+    {
+        why = "saved for build " + build;
+        return false;
+    }
+
+    uint32_t script = 0, count = 0;
+    if (!Get32(in, pos, script) || !Get32(in, pos, count))
+    {
+        why = "truncated";
+        return false;
+    }
+    if (script != key.script)
+    {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "saved for script %08X", script);
+        why = buf;
+        return false;
+    }
+    if (count > kMaxEntries || (size_t)count * kFieldsPerEntry * 4 != in.size() - pos)
+    {
+        why = "bad entry count";
+        return false;
+    }
+
+    std::vector<SessionCacheEntry> loaded((size_t)count);
+    for (SessionCacheEntry& e : loaded)
+    {
+        ForEachField(e, [&](int32_t& v)
+        {
+            uint32_t u = 0;
+            Get32(in, pos, u);
+            v = (int32_t)u;
+        });
+    }
+    out.swap(loaded);
+    return true;
+}
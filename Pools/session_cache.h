@@ -0,0 +1,50 @@
+/*
+  session_cache.h
+  - Warm-start cache of the best money candidates across table joins
+  - Each entry keeps a candidate's category, last value and match statistics,
+    plus whether it was the locked pot/player global
+  - Binary file: magic, version, game build key, poker script hash, entries,
+    FNV-1a checksum. A key mismatch or a damaged file loads nothing
+  - Entries are only hints: the plugin revalidates them against fresh OCR
+    samples before their statistics count toward an auto-lock
+  - Serialize / Deserialize work on byte strings; the file IO is the
+    caller's. No bench covers the format
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum SessionCacheFlags
+{
+    SESSION_CACHE_LOCKED = 1,  // was the auto-locked global for its category
+};
+
+struct SessionCacheEntry
+{
+    int32_t idx = -1;
+    int32_t category = 0;     // RankCategory
+    int32_t flags = 0;        // SessionCacheFlags
+    int32_t last = 0;
+    int32_t ageMs = 0;        // firstSeen -> save, so the change rate survives the restore
+    int32_t changes = 0;
+    int32_t betStepMatches = 0;
+    int32_t betStepMismatches = 0;
+    int32_t ocrAnyMatches = 0;
+    int32_t ocrPotMatches = 0;
+    int32_t ocrPlayerMatches = 0;
+    int32_t ocrNpcMatches = 0;
+};
+
+struct SessionCacheKey
+{
+    std::string build;        // game build (PE timestamp + image size)
+    uint32_t script = 0;      // hash of the poker script name
+};
+
+std::string SerializeSessionCache(const SessionCacheKey& key, const std::vector<SessionCacheEntry>& entries);
+// On key mismatch or a damaged file leaves out empty and fills why.
+bool DeserializeSessionCache(const std::string& bytes, const SessionCacheKey& key,
+    std::vector<SessionCacheEntry>& out, std::string& why);
@@ -0,0 +1,108 @@
+#include "step_correlation.h"
+
+namespace
+{
+    inline int64_t Abs64(int64_t v) { return (v < 0) ? -v : v; }
+
+    // v matches cents directly or as whole dollars.
+    inline bool NearCents(int64_t v, int64_t cents, int64_t tol)
+    {
+        return Abs64(v - cents) <= tol || Abs64(v * 100 - cents) <= tol;
+    }
+}
+
+void SeriesRing::Reset(uint32_t ms, int32_t value)
+{
+    startMs = ms;
+    startValue = value;
+    lastValue = value;
+    head = 0;
+    count = 0;
+    dropped = 0;
+}
+
+void SeriesRing::Push(uint32_t ms, int32_t value)
+{
+    SeriesEvent e;
+    e.ms = ms;
+    e.value = value;
+    e.delta = (int32_t)((int64_t)value - lastValue);
+    lastValue = value;
+    if (count < kSeriesCapacity)
+    {
+        events[(head + count) % kSeriesCapacity] = e;
+        count++;
+        return;
+    }
+    events[head] = e;
+    head = (uint8_t)((head + 1) % kSeriesCapacity);
+    dropped++;
+}
+
+void SeriesPool::Init(int capacity)
+{
+    if (capacity < 0)
+        capacity = 0;
+    if ((int)rings.size() != capacity)
+    {
+        rings.assign((size_t)capacity, SeriesRing{});
+        rings.shrink_to_fit();
+        freeList.reserve((size_t)capacity);
+    }
+    ReleaseAll();
+}
+
+void SeriesPool::ReleaseAll()
+{
+    freeList.clear();
+    // Handed out lowest handle first.
+    for (int h = (int)rings.size() - 1; h >= 0; h--)
+        freeList.push_back(h);
+}
+
+int SeriesPool::Acquire(uint32_t ms, int32_t value)
+{
+    if (freeList.empty())
+        return -1;
+    int h = freeList.back();
+    freeList.pop_back();
+    rings[(size_t)h].Reset(ms, value);
+    return h;
+}
+
+void SeriesPool::Release(int handle)
+{
+    if (handle >= 0 && handle < (int)rings.size())
+        freeList.push_back(handle);
+}
+
+size_t SeriesPool::MemoryBytes() const
+{
+    return rings.capacity() * sizeof(SeriesRing) + freeList.capacity() * sizeof(int);
+}
+
+StepOutcome SettleStep(const SeriesRing& cand, const SeriesEvent& ocr, StepMatch match, int lagMs, int toleranceCents)
+{
+    int64_t from = (int64_t)ocr.ms - lagMs;
+    int64_t to = (int64_t)ocr.ms + lagMs;
+    if ((int64_t)cand.CoveredFromMs() > from)
+        return STEP_UNCOVERED;
+
+    // Value held at the end of the window, for the no-step case.
+    int32_t heldValue = cand.dropped ? cand.At(0).value : cand.startValue;
+    for (int i = 0; i < cand.Count(); i++)
+    {
+        const SeriesEvent& e = cand.At(i);
+        if ((int64_t)e.ms > to)
+            break;
+        heldValue = e.value;
+        if ((int64_t)e.ms < from)
+            continue;
+        int64_t v = (match == STEP_MATCH_DELTA) ? e.delta : e.value;
+        if (NearCents(v, ocr.value, toleranceCents))
+            return STEP_ALIGNED;
+    }
+    if (match == STEP_MATCH_VALUE && NearCents(heldValue, ocr.value, toleranceCents))
+        return STEP_CONSISTENT;
+    return STEP_MISSED;
+}
@@ -0,0 +1,103 @@
+/*
+  step_correlation.h
+  - Time-series step correlation between candidate globals and OCR amounts
+  - A SeriesRing keeps the last kSeriesCapacity step events (time, new value,
+    delta) of one value; candidates draw rings from a SeriesPool allocated
+    once, so each tracked candidate costs a fixed sizeof(SeriesRing)
+  - SettleStep() decides, once an OCR step is older than the lag tolerance,
+    whether a candidate stepped with it (aligned), already held the value
+    (consistent), failed to (missed), or was not observed then (uncovered)
+  - Per-field outcome counters are packed 8 bits per lane into a uint32
+  - bench/step_correlation_bench.cpp times SettleStep and counts the OCR pot
+    steps each kind of candidate survives
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+constexpr int kSeriesCapacity = 16;
+
+struct SeriesEvent
+{
+    uint32_t ms = 0;
+    int32_t value = 0;  // value after the step
+    int32_t delta = 0;  // value - previous value
+};
+
+// Step events of one value, oldest first. Pushing into a full ring drops the oldest.
+struct SeriesRing
+{
+    SeriesEvent events[kSeriesCapacity];
+    uint32_t startMs = 0;    // tracking start; steps before it were not observed
+    int32_t startValue = 0;  // value at startMs
+    int32_t lastValue = 0;
+    uint8_t head = 0;        // slot of the oldest event
+    uint8_t count = 0;
+    uint32_t dropped = 0;    // events pushed out of a full ring
+
+    void Reset(uint32_t ms, int32_t value);
+    void Push(uint32_t ms, int32_t value);
+
+    int Count() const { return count; }
+    const SeriesEvent& At(int i) const { return events[(head + i) % kSeriesCapacity]; }
+    const SeriesEvent* Last() const { return count ? &At(count - 1) : nullptr; }
+
+    // Earliest time from which the ring still knows every step.
+    uint32_t CoveredFromMs() const { return dropped ? At(0).ms : startMs; }
+};
+
+// Fixed set of rings handed out by handle. Init allocates everything up front.
+class SeriesPool
+{
+public:
+    void Init(int capacity);
+    void ReleaseAll();
+
+    // -1 when every ring is in use.
+    int Acquire(uint32_t ms, int32_t value);
+    void Release(int handle);
+
+    SeriesRing& Ring(int handle) { return rings[(size_t)handle]; }
+    const SeriesRing& Ring(int handle) const { return rings[(size_t)handle]; }
+
+    int Capacity() const { return (int)rings.size(); }
+    int InUse() const { return (int)rings.size() - (int)freeList.size(); }
+    size_t MemoryBytes() const;
+
+private:
+    std::vector<SeriesRing> rings;
+    std::vector<int> freeList;
+};
+
+enum StepMatch
+{
+    STEP_MATCH_VALUE = 0,  // candidate stepped to the OCR amount
+    STEP_MATCH_DELTA = 1,  // candidate stepped by the OCR amount
+};
+
+enum StepOutcome
+{
+    STEP_UNCOVERED = 0,
+    STEP_CONSISTENT = 1,
+    STEP_ALIGNED = 2,
+    STEP_MISSED = 3,
+};
+
+// ocr is an OCR step at ocr.ms (its value is the amount read). A candidate step within lagMs
+// either side counts; amounts are cents and the candidate may hold cents or whole dollars.
+StepOutcome SettleStep(const SeriesRing& cand, const SeriesEvent& ocr, StepMatch match, int lagMs, int toleranceCents);
+
+// 8-bit saturating counters, one lane per OCR field.
+inline int PackedCount(uint32_t packed, int lane)
+{
+    return (int)((packed >> (lane * 8)) & 0xFFu);
+}
+
+inline void PackedIncrement(uint32_t& packed, int lane)
+{
+    if (PackedCount(packed, lane) < 0xFF)
+        packed += 1u << (lane * 8);
+}
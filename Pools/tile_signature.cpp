@@ -0,0 +1,176 @@
+#include "tile_signature.h"
+
+#include <algorithm>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define TILE_SIGNATURE_X64 1
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    constexpr int kCellBytes = kTileCellWidth * 3;  // one cell row of 24-bit pixels
+    constexpr int kCellsPerRow = kTileSize / kTileCellWidth;
+
+    inline uint32_t SumCellRow(const unsigned char* p)
+    {
+#ifdef TILE_SIGNATURE_X64
+        const __m128i zero = _mm_setzero_si128();
+        __m128i a = _mm_sad_epu8(_mm_loadu_si128((const __m128i*)p), zero);
+        __m128i b = _mm_sad_epu8(_mm_loadl_epi64((const __m128i*)(p + 16)), zero);
+        __m128i s = _mm_add_epi32(a, b);
+        return (uint32_t)_mm_cvtsi128_si32(s) + (uint32_t)_mm_extract_epi16(s, 4);
+#else
+        uint32_t s = 0;
+        for (int i = 0; i < kCellBytes; i++)
+            s += p[i];
+        return s;
+#endif
+    }
+
+    // Largest |a[i] - b[i]| over one tile's cells.
+    inline int MaxCellDelta(const uint8_t* a, const uint8_t* b)
+    {
+#ifdef TILE_SIGNATURE_X64
+        static_assert(kTileCellsPerTile == 32, "two SSE2 registers per tile");
+        __m128i x0 = _mm_loadu_si128((const __m128i*)a);
+        __m128i y0 = _mm_loadu_si128((const __m128i*)b);
+        __m128i x1 = _mm_loadu_si128((const __m128i*)(a + 16));
+        __m128i y1 = _mm_loadu_si128((const __m128i*)(b + 16));
+        __m128i d = _mm_max_epu8(
+            _mm_or_si128(_mm_subs_epu8(x0, y0), _mm_subs_epu8(y0, x0)),
+            _mm_or_si128(_mm_subs_epu8(x1, y1), _mm_subs_epu8(y1, x1)));
+        d = _mm_max_epu8(d, _mm_srli_si128(d, 8));
+        d = _mm_max_epu8(d, _mm_srli_si128(d, 4));
+        d = _mm_max_epu8(d, _mm_srli_si128(d, 2));
+        d = _mm_max_epu8(d, _mm_srli_si128(d, 1));
+        return _mm_cvtsi128_si32(d) & 0xFF;
+#else
+        int m = 0;
+        for (int i = 0; i < kTileCellsPerTile; i++)
+        {
+            int v = (int)a[i] - (int)b[i];
+            m = (std::max)(m, v < 0 ? -v : v);
+        }
+        return m;
+#endif
+    }
+}
+
+const char* TileSignatureIsaName()
+{
+#ifdef TILE_SIGNATURE_X64
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+void TileSignature::Clear()
+{
+    width = 0;
+    height = 0;
+    cols = 0;
+    rows = 0;
+    cells.clear();
+}
+
+void TileSignature::Compute(const unsigned char* pixels, int w, int h, int stride)
+{
+    Clear();
+    if (!pixels || w <= 0 || h <= 0)
+        return;
+    width = w;
+    height = h;
+    cols = (w + kTileSize - 1) / kTileSize;
+    rows = (h + kTileSize - 1) / kTileSize;
+    size_t n = (size_t)cols * (size_t)rows * kTileCellsPerTile;
+    sums.assign(n, 0);
+
+    int fullCells = w / kTileCellWidth;
+    int fullTiles = fullCells / kCellsPerRow;
+    int tailBytes = (w % kTileCellWidth) * 3;
+    static_assert(kTileCellHeight % kTileSampleRowStep == 0, "every cell starts on a sampled row");
+    for (int y = 0; y < h; y += kTileSampleRowStep)
+    {
+        const unsigned char* row = pixels + (size_t)y * (size_t)stride;
+        uint32_t* tileRow = sums.data() + (size_t)(y / kTileSize) * (size_t)cols * kTileCellsPerTile +
+            (size_t)((y % kTileSize) / kTileCellHeight) * kCellsPerRow;
+        uint32_t* tile = tileRow;
+        const unsigned char* p = row;
+        for (int tx = 0; tx < fullTiles; tx++, tile += kTileCellsPerTile, p += kCellsPerRow * kCellBytes)
+        {
+            for (int k = 0; k < kCellsPerRow; k++)
+                tile[k] += SumCellRow(p + k * kCellBytes);
+        }
+        for (int c = fullTiles * kCellsPerRow; c < fullCells; c++)
+            tileRow[(c / kCellsPerRow) * kTileCellsPerTile + (c % kCellsPerRow)] += SumCellRow(row + c * kCellBytes);
+        if (tailBytes)
+        {
+            uint32_t s = 0;
+            const unsigned char* p = row + fullCells * kCellBytes;
+            for (int i = 0; i < tailBytes; i++)
+                s += p[i];
+            tileRow[(fullCells / kCellsPerRow) * kTileCellsPerTile + (fullCells % kCellsPerRow)] += s;
+        }
+    }
+
+    // Means over the sampled rows; edge cells cover fewer pixels (or none).
+    constexpr uint32_t kFullCellBytes = kTileCellWidth * (kTileCellHeight / kTileSampleRowStep) * 3;
+    cells.resize(n);
+    for (int ty = 0; ty < rows; ty++)
+    {
+        for (int tx = 0; tx < cols; tx++)
+        {
+            size_t t = ((size_t)ty * (size_t)cols + (size_t)tx) * kTileCellsPerTile;
+            if ((tx + 1) * kTileSize <= w && (ty + 1) * kTileSize <= h)
+            {
+                for (int k = 0; k < kTileCellsPerTile; k++)
+                    cells[t + k] = (uint8_t)(sums[t + k] / kFullCellBytes);
+                continue;
+            }
+            for (int k = 0; k < kTileCellsPerTile; k++)
+            {
+                int x0 = tx * kTileSize + (k % kCellsPerRow) * kTileCellWidth;
+                int y0 = ty * kTileSize + (k / kCellsPerRow) * kTileCellHeight;
+                int cw = (std::min)(kTileCellWidth, w - x0);
+                int ch = ((std::min)(kTileCellHeight, h - y0) + kTileSampleRowStep - 1) / kTileSampleRowStep;
+                cells[t + k] = (cw > 0 && ch > 0) ? (uint8_t)(sums[t + k] / (uint32_t)(cw * ch * 3)) : 0;
+            }
+        }
+    }
+}
+
+void TileSignature::Compare(const TileSignature& ref, int noise, TileDiff& out) const
+{
+    out = TileDiff{};
+    out.tiles = cols * rows;
+    if (ref.width != width || ref.height != height || ref.Empty())
+    {
+        out.dirty = out.tiles;
+        out.maxDelta = 255;
+        out.firstDirtyRow = out.tiles ? 0 : -1;
+        out.lastDirtyRow = out.tiles ? rows - 1 : -1;
+        return;
+    }
+    for (int ty = 0; ty < rows; ty++)
+    {
+        for (int tx = 0; tx < cols; tx++)
+        {
+            size_t t = ((size_t)ty * (size_t)cols + (size_t)tx) * kTileCellsPerTile;
+            int d = MaxCellDelta(cells.data() + t, ref.cells.data() + t);
+            out.maxDelta = (std::max)(out.maxDelta, d);
+            if (d <= noise)
+                continue;
+            out.dirty++;
+            if (out.firstDirtyRow < 0)
+                out.firstDirtyRow = ty;
+            out.lastDirtyRow = ty;
+        }
+    }
+}
+
+size_t TileSignature::MemoryBytes() const
+{
+    return cells.capacity() + sums.capacity() * sizeof(uint32_t);
+}
@@ -0,0 +1,75 @@
+/*
+  tile_signature.h
+  - Change detection for the OCR regions: a capture is cut into 32x32 tiles
+    and every tile into 4x8 cells of 8x4 pixels (flat, since glyph changes
+    mostly move ink up or down); a cell's signature is the mean byte value
+    of its even pixel rows. Sampling every other row halves the cost (the
+    rows are what Compute spends its time on); a glyph edit spans several
+    rows, only a one-pixel horizontal line on an odd row goes unseen
+  - Two captures differ where some cell moved by more than a noise
+    threshold, so dithering and compression shimmer do not count while a
+    changed digit (dozens of pixels flipping between text and background)
+    does
+  - Comparing reports the dirty tiles and the span of tile rows (bands) they
+    fall in
+  - Cell sums use SSE2 on x64 (psadbw), scalar elsewhere
+  - bench/tile_signature_bench.cpp checks idle and changed frames at 1080p
+    and 4K zone sizes and times Compute + Compare
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+constexpr int kTileSize = 32;
+constexpr int kTileCellWidth = 8;
+constexpr int kTileCellHeight = 4;
+constexpr int kTileCellsPerTile = (kTileSize / kTileCellWidth) * (kTileSize / kTileCellHeight);
+constexpr int kTileSampleRowStep = 2;  // pixel rows read per cell: 0, 2
+
+struct TileDiff
+{
+    int tiles = 0;
+    int dirty = 0;
+    int maxDelta = 0;        // largest cell change in mean byte units; 255 = sizes differ
+    int firstDirtyRow = -1;  // tile rows; -1 = nothing dirty
+    int lastDirtyRow = -1;
+};
+
+class TileSignature
+{
+public:
+    // 24-bit pixels, rows of stride bytes. Keeps its allocations when the size does not grow.
+    void Compute(const unsigned char* pixels, int width, int height, int stride);
+    void Clear();
+    bool Empty() const { return cells.empty(); }
+    // Exchanges contents (and buffers), so promoting a signature does not copy or allocate.
+    void Swap(TileSignature& other)
+    {
+        std::swap(width, other.width);
+        std::swap(height, other.height);
+        std::swap(cols, other.cols);
+        std::swap(rows, other.rows);
+        cells.swap(other.cells);
+        sums.swap(other.sums);
+    }
+
+    // This capture against ref. A ref of another size (or an empty one) makes every tile dirty.
+    void Compare(const TileSignature& ref, int noise, TileDiff& out) const;
+
+    size_t MemoryBytes() const;
+
+private:
+    int width = 0;
+    int height = 0;
+    int cols = 0;
+    int rows = 0;
+    std::vector<uint8_t> cells;  // kTileCellsPerTile per tile, row-major tiles, row-major cells
+    std::vector<uint32_t> sums;  // scratch for Compute
+};
+
+// "sse2" or "scalar" - whichever Compute uses.
+const char* TileSignatureIsaName();
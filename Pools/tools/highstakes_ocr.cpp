@@ -0,0 +1,523 @@
+/*
+  highstakes_ocr.cpp
+  - The OCR worker process behind [OCR] Engine=2: started once by the plugin,
+    it maps the shared-memory ring named on its command line (ocr_ipc.h),
+    says HELLO, then answers every SUBMIT on stdin with a RESULT on stdout
+    until QUIT or until stdin closes (the game went away)
+  - A request's two regions are recognized concurrently, each on its own
+    thread with its own recognizer, so a cycle costs the slower region
+  - Recognizers: libtesseract when built with HIGHSTAKES_OCR_TESSERACT (text
+    plus word boxes from the result iterator), otherwise a stub that splits
+    ink into lines and words along blank rows and columns and names each
+    word by its size. The stub lets the protocol run headless
+    (bench/ocr_worker_bench.cpp)
+
+  Build (from Pools/):
+    Linux, stub:
+      g++ -std=c++20 -O2 -I. tools/highstakes_ocr.cpp ocr_ipc.cpp -o highstakes_ocr -pthread
+    Windows, libtesseract:
+      cl /std:c++20 /O2 /EHsc /I. /I<tesseract>\include /DHIGHSTAKES_OCR_TESSERACT
+         tools\highstakes_ocr.cpp ocr_ipc.cpp /link /LIBPATH:<tesseract>\lib tesseract55.lib
+
+  Usage:
+    highstakes_ocr --shm <name> --bytes <n> [--tessdata <dir>]
+    tessdata defaults to <exe dir>/tessdata when it holds eng.traineddata,
+    else TESSDATA_PREFIX
+*/
+
+#include "ocr_ipc.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef HIGHSTAKES_OCR_TESSERACT
+#include <tesseract/baseapi.h>
+#include <tesseract/resultiterator.h>
+#endif
+
+// ---------------- Platform ----------------
+
+static void* MapShared(const char* name, size_t bytes)
+{
+#ifdef _WIN32
+    HANDLE mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name);
+    if (!mapping)
+        return nullptr;
+    // The view keeps the mapping alive; the handle is not needed after this.
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+    CloseHandle(mapping);
+    return view;
+#else
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0)
+        return nullptr;
+    void* view = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    return view == MAP_FAILED ? nullptr : view;
+#endif
+}
+
+// Blocking; 0 = stdin closed.
+static size_t ReadInput(void* buf, size_t bytes)
+{
+#ifdef _WIN32
+    DWORD n = 0;
+    if (!ReadFile(GetStdHandle(STD_INPUT_HANDLE), buf, (DWORD)bytes, &n, nullptr))
+        return 0;
+    return n;
+#else
+    ssize_t n = read(0, buf, bytes);
+    return n > 0 ? (size_t)n : 0;
+#endif
+}
+
+static bool WriteOutput(const std::string& bytes)
+{
+    size_t done = 0;
+    while (done < bytes.size())
+    {
+#ifdef _WIN32
+        DWORD n = 0;
+        if (!WriteFile(GetStdHandle(STD_OUTPUT_HANDLE), bytes.data() + done, (DWORD)(bytes.size() - done), &n, nullptr) || n == 0)
+            return false;
+#else
+        ssize_t n = write(1, bytes.data() + done, bytes.size() - done);
+        if (n <= 0)
+            return false;
+#endif
+        done += (size_t)n;
+    }
+    return true;
+}
+
+static std::string ExeDirectory(const char* argv0)
+{
+#ifdef _WIN32
+    char path[MAX_PATH]{ 0 };
+    if (GetModuleFileNameA(nullptr, path, MAX_PATH))
+        argv0 = path;
+#endif
+    std::string p = argv0 ? argv0 : "";
+    size_t slash = p.find_last_of("\\/");
+    return slash == std::string::npos ? std::string() : p.substr(0, slash + 1);
+}
+
+static bool FileExists(const std::string& path)
+{
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f)
+        return false;
+    std::fclose(f);
+    return true;
+}
+
+// ---------------- Recognizers ----------------
+
+#ifdef HIGHSTAKES_OCR_TESSERACT
+
+class Recognizer
+{
+public:
+    bool Init(const std::string& tessdata)
+    {
+        return api.Init(tessdata.empty() ? nullptr : tessdata.c_str(), "eng") == 0;
+    }
+
+    static std::string Name()
+    {
+        return std::string("tesseract ") + tesseract::TessBaseAPI::Version();
+    }
+
+    bool Run(const OcrFrameView& f, int psm, std::string& text, std::vector<OcrWord>& words)
+    {
+        text.clear();
+        words.clear();
+        if (f.width <= 0 || f.height <= 0)
+            return false;
+        // Frames are BGR as captured; tesseract reads 3-byte pixels as RGB. The slot is ours until released.
+        for (int y = 0; y < f.height; y++)
+        {
+            unsigned char* row = f.pixels + (size_t)y * (size_t)f.stride;
+            for (int x = 0; x < f.width; x++)
+                std::swap(row[x * 3], row[x * 3 + 2]);
+        }
+        api.SetPageSegMode((tesseract::PageSegMode)psm);
+        api.SetImage(f.pixels, f.width, f.height, 3, f.stride);
+        api.SetSourceResolution(70);
+        if (api.Recognize(nullptr) != 0)
+            return false;
+
+        char* all = api.GetUTF8Text();
+        if (all)
+        {
+            text = all;
+            delete[] all;
+        }
+        tesseract::ResultIterator* it = api.GetIterator();
+        if (it)
+        {
+            do
+            {
+                char* w = it->GetUTF8Text(tesseract::RIL_WORD);
+                if (!w)
+                    continue;
+                int l = 0, t = 0, r = 0, b = 0;
+                it->BoundingBox(tesseract::RIL_WORD, &l, &t, &r, &b);
+                words.push_back({ w, l, t, r - l, b - t, it->Confidence(tesseract::RIL_WORD) });
+                delete[] w;
+            } while (it->Next(tesseract::RIL_WORD));
+            delete it;
+        }
+        return true;
+    }
+
+private:
+    tesseract::TessBaseAPI api;
+};
+
+#else
+
+// Ink = pixels whose luma is far from the region's corner (the background). Lines are runs of
+// rows with ink, words runs of inked columns within a line, split at gaps of a third of the
+// line height. Word text is "<w>x<h>".
+class Recognizer
+{
+public:
+    bool Init(const std::string&) { return true; }
+
+    static std::string Name() { return "stub"; }
+
+    bool Run(const OcrFrameView& f, int, std::string& text, std::vector<OcrWord>& words)
+    {
+        text.clear();
+        words.clear();
+        if (f.width <= 0 || f.height <= 0)
+            return false;
+
+        int bg = Luma(f, 0, 0);
+        ink.assign((size_t)f.width * (size_t)f.height, 0);
+        rows.assign((size_t)f.height, 0);
+        for (int y = 0; y < f.height; y++)
+        {
+            for (int x = 0; x < f.width; x++)
+            {
+                int d = Luma(f, x, y) - bg;
+                if (d > kInkDelta || d < -kInkDelta)
+                {
+                    ink[(size_t)y * (size_t)f.width + (size_t)x] = 1;
+                    rows[(size_t)y] = 1;
+                }
+            }
+        }
+
+        int y = 0;
+        while (y < f.height)
+        {
+            if (!rows[(size_t)y])
+            {
+                y++;
+                continue;
+            }
+            int top = y;
+            while (y < f.height && rows[(size_t)y])
+                y++;
+            LineWords(f, top, y, text, words);
+            text += '\n';
+        }
+        return true;
+    }
+
+private:
+    static constexpr int kInkDelta = 64;
+
+    static int Luma(const OcrFrameView& f, int x, int y)
+    {
+        const unsigned char* p = f.pixels + (size_t)y * (size_t)f.stride + (size_t)x * 3;
+        return (p[0] * 29 + p[1] * 150 + p[2] * 77) >> 8;
+    }
+
+    void LineWords(const OcrFrameView& f, int top, int bottom, std::string& text, std::vector<OcrWord>& words)
+    {
+        int gap = (std::max)(2, (bottom - top) / 3);
+        int x = 0;
+        bool first = true;
+        while (x < f.width)
+        {
+            if (!ColumnInked(f, x, top, bottom))
+            {
+                x++;
+                continue;
+            }
+            int left = x;
+            int blank = 0;
+            int right = x;
+            for (; x < f.width && blank < gap; x++)
+            {
+                if (ColumnInked(f, x, top, bottom))
+                {
+                    right = x;
+                    blank = 0;
+                }
+                else
+                {
+                    blank++;
+                }
+            }
+            // Tighten to the rows this word actually uses.
+            int wTop = bottom;
+            int wBottom = top;
+            for (int yy = top; yy < bottom; yy++)
+            {
+                for (int xx = left; xx <= right; xx++)
+                {
+                    if (ink[(size_t)yy * (size_t)f.width + (size_t)xx])
+                    {
+                        wTop = (std::min)(wTop, yy);
+                        wBottom = (std::max)(wBottom, yy + 1);
+                        break;
+                    }
+                }
+            }
+            OcrWord w;
+            w.x = left;
+            w.y = wTop;
+            w.w = right - left + 1;
+            w.h = wBottom - wTop;
+            w.conf = 100.0f;
+            w.text = std::to_string(w.w) + "x" + std::to_string(w.h);
+            if (!first)
+                text += ' ';
+            text += w.text;
+            first = false;
+            words.push_back(std::move(w));
+        }
+    }
+
+    bool ColumnInked(const OcrFrameView& f, int x, int top, int bottom) const
+    {
+        for (int y = top; y < bottom; y++)
+        {
+            if (ink[(size_t)y * (size_t)f.width + (size_t)x])
+                return true;
+        }
+        return false;
+    }
+
+    std::vector<unsigned char> ink;
+    std::vector<unsigned char> rows;
+};
+
+#endif
+
+// ---------------- Region threads ----------------
+
+// One per region: waits for a frame, recognizes it, signals done.
+class RegionWorker
+{
+public:
+    bool Start(const std::string& tessdata)
+    {
+        if (!recognizer.Init(tessdata))
+            return false;
+        thread = std::thread([this] { Loop(); });
+        return true;
+    }
+
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+        }
+        wake.notify_one();
+        if (thread.joinable())
+            thread.join();
+    }
+
+    void Post(const OcrFrameView& f, int p)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            frame = f;
+            psm = p;
+            job = true;
+            done = false;
+        }
+        wake.notify_one();
+    }
+
+    void Wait(bool& ok, std::string& text, std::vector<OcrWord>& words)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this] { return done; });
+        ok = resultOk;
+        text.swap(resultText);
+        words.swap(resultWords);
+    }
+
+private:
+    void Loop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            wake.wait(lock, [this] { return job || quit; });
+            if (quit)
+                return;
+            job = false;
+            OcrFrameView f = frame;
+            int p = psm;
+            lock.unlock();
+            bool ok = recognizer.Run(f, p, text, words);
+            lock.lock();
+            resultOk = ok;
+            resultText.swap(text);
+            resultWords.swap(words);
+            done = true;
+            finished.notify_one();
+        }
+    }
+
+    Recognizer recognizer;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    OcrFrameView frame;
+    int psm = 11;
+    bool job = false;
+    bool done = false;
+    bool quit = false;
+    bool resultOk = false;
+    std::string text;  // recognizer output, swapped into result*
+    std::vector<OcrWord> words;
+    std::string resultText;
+    std::vector<OcrWord> resultWords;
+};
+
+int main(int argc, char** argv)
+{
+    std::string shmName;
+    size_t shmBytes = 0;
+    std::string tessdata;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (!strcmp(argv[i], "--shm"))
+            shmName = argv[i + 1];
+        else if (!strcmp(argv[i], "--bytes"))
+            shmBytes = (size_t)strtoull(argv[i + 1], nullptr, 10);
+        else if (!strcmp(argv[i], "--tessdata"))
+            tessdata = argv[i + 1];
+    }
+    if (shmName.empty() || shmBytes == 0)
+    {
+        fprintf(stderr, "usage: highstakes_ocr --shm <name> --bytes <n> [--tessdata <dir>]\n");
+        return 2;
+    }
+    if (tessdata.empty())
+    {
+        std::string local = ExeDirectory(argv[0]) + "tessdata";
+        if (FileExists(local + "/eng.traineddata"))
+            tessdata = local;
+    }
+
+    void* view = MapShared(shmName.c_str(), shmBytes);
+    OcrIpcRing ring;
+    if (!view || !ring.Attach(view, shmBytes))
+    {
+        fprintf(stderr, "highstakes_ocr: cannot map ring '%s' (%zu bytes)\n", shmName.c_str(), shmBytes);
+        return 3;
+    }
+
+    RegionWorker regions[OCR_ROI_COUNT];
+    for (RegionWorker& r : regions)
+    {
+        if (!r.Start(tessdata))
+        {
+            fprintf(stderr, "highstakes_ocr: recognizer init failed (tessdata='%s')\n", tessdata.c_str());
+            return 4;
+        }
+    }
+
+    std::string out;
+    std::string name = Recognizer::Name();
+    OcrIpcAppendMessage(out, OCR_IPC_HELLO, 0, name.data(), name.size());
+    bool alive = WriteOutput(out);
+
+    OcrIpcDecoder decoder;
+    OcrIpcMessage msg;
+    OcrCycleResult result;
+    std::string payload;
+    char buf[4096];
+    while (alive)
+    {
+        size_t n = ReadInput(buf, sizeof(buf));
+        if (n == 0)
+            break;
+        decoder.Feed(buf, n);
+        while (alive && decoder.Next(msg))
+        {
+            if (msg.type == OCR_IPC_QUIT)
+            {
+                alive = false;
+                break;
+            }
+            uint32_t slot = 0;
+            if (!OcrIpcDecodeSubmit(msg, slot))
+                continue;
+
+            uint32_t slotRequest = 0;
+            int psm = 11;
+            OcrFrameView frames[OCR_ROI_COUNT];
+            bool readable = ring.Read((int)slot, slotRequest, psm, frames) && slotRequest == msg.requestId;
+            for (int r = 0; r < OCR_ROI_COUNT; r++)
+            {
+                result.ok[r] = false;
+                result.text[r].clear();
+                result.words[r].clear();
+            }
+            if (readable)
+            {
+                for (int r = 0; r < OCR_ROI_COUNT; r++)
+                    regions[r].Post(frames[r], psm);
+                for (int r = 0; r < OCR_ROI_COUNT; r++)
+                    regions[r].Wait(result.ok[r], result.text[r], result.words[r]);
+            }
+            // The submit hands the slot over whatever it holds: a slot that cannot be read or
+            // carries another request id is released too, or the plugin would run out of slots.
+            ring.Release((int)slot);
+
+            OcrIpcEncodeResult(result, payload);
+            out.clear();
+            OcrIpcAppendMessage(out, OCR_IPC_RESULT, msg.requestId, payload.data(), payload.size());
+            alive = WriteOutput(out);
+        }
+        if (decoder.Broken())
+        {
+            fprintf(stderr, "highstakes_ocr: request stream out of step\n");
+            break;
+        }
+    }
+
+    for (RegionWorker& r : regions)
+        r.Stop();
+    return 0;
+}
@@ -0,0 +1,210 @@
+/*
+  trace_dump.cpp
+  - Command-line decoder for highstakes_rec_*.bin recordings (trace_recorder.h)
+  - Prints CSV "tick_ms,channel,value" for a tick range, optionally limited to
+    some channels. With the .idx next to the recording the first block is found
+    by binary search; without it the block headers are walked from the start
+  - Ticks are GetTickCount() milliseconds; --relative prints them from the
+    recording start instead
+
+  Build (from Pools/):
+    g++ -std=c++20 -O2 -I. tools/trace_dump.cpp trace_recorder.cpp -o trace_dump
+
+  Usage:
+    trace_dump <recording.bin> [--from ms] [--to ms] [--channel name[,name...]] [--relative] [--blocks]
+*/
+
+#if !defined(_WIN32) && !defined(_FILE_OFFSET_BITS)
+#define _FILE_OFFSET_BITS 64  // 64-bit off_t for fseeko on 32-bit hosts
+#endif
+
+#include "trace_recorder.h"
+
+#include <stdio.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static bool ReadFileBytes(const std::string& path, std::vector<uint8_t>& out)
+{
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f)
+        return false;
+    out.clear();
+    uint8_t chunk[65536];
+    size_t n = 0;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0)
+        out.insert(out.end(), chunk, chunk + n);
+    std::fclose(f);
+    return true;
+}
+
+// Recordings can pass 2 GB, past what fseek's long offset reaches on Windows.
+static bool SeekTo(FILE* f, uint64_t offset)
+{
+#if defined(_WIN32)
+    return _fseeki64(f, (long long)offset, SEEK_SET) == 0;
+#else
+    return fseeko(f, (off_t)offset, SEEK_SET) == 0;
+#endif
+}
+
+// Rebuilds the index by walking block headers (recording without its .idx, or a torn one).
+static void ScanBlocks(FILE* f, std::vector<TraceIndexEntry>& index)
+{
+    index.clear();
+    uint64_t offset = kTraceFileHeaderBytes;
+    std::vector<uint8_t> payload;
+    while (true)
+    {
+        uint8_t hb[kTraceBlockHeaderBytes];
+        TraceBlockHeader h;
+        if (!SeekTo(f, offset) || std::fread(hb, 1, sizeof(hb), f) != sizeof(hb) ||
+            !ParseTraceBlockHeader(hb, sizeof(hb), h))
+            break;
+        payload.resize(h.payloadBytes);
+        if (std::fread(payload.data(), 1, payload.size(), f) != payload.size())
+            break;
+        TraceIndexEntry e;
+        e.offset = offset;
+        e.firstTick = h.baseTick;
+        e.lastTick = h.baseTick;
+        std::vector<std::string> names;
+        DecodeTraceBlock(h, payload.data(), names, [&e](const TraceSample& s) { e.lastTick = s.tick; });
+        index.push_back(e);
+        offset += kTraceBlockHeaderBytes + h.payloadBytes;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: %s <recording.bin> [--from ms] [--to ms] [--channel a,b] [--relative] [--blocks]\n", argv[0]);
+        return 2;
+    }
+    std::string path = argv[1];
+    uint32_t from = 0;
+    uint32_t to = 0xFFFFFFFFu;
+    bool relative = false;
+    bool listBlocks = false;
+    std::vector<std::string> only;
+    for (int i = 2; i < argc; i++)
+    {
+        std::string a = argv[i];
+        if (a == "--from" && i + 1 < argc)
+            from = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        else if (a == "--to" && i + 1 < argc)
+            to = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        else if (a == "--relative")
+            relative = true;
+        else if (a == "--blocks")
+            listBlocks = true;
+        else if (a == "--channel" && i + 1 < argc)
+        {
+            std::string list = argv[++i];
+            size_t start = 0;
+            while (start <= list.size())
+            {
+                size_t comma = list.find(',', start);
+                if (comma == std::string::npos)
+                    comma = list.size();
+                if (comma > start)
+                    only.push_back(list.substr(start, comma - start));
+                start = comma + 1;
+            }
+        }
+        else
+        {
+            std::fprintf(stderr, "unknown argument '%s'\n", a.c_str());
+            return 2;
+        }
+    }
+
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f)
+    {
+        std::fprintf(stderr, "cannot open '%s'\n", path.c_str());
+        return 1;
+    }
+    uint8_t fh[kTraceFileHeaderBytes];
+    uint32_t startTick = 0;
+    if (std::fread(fh, 1, sizeof(fh), f) != sizeof(fh) || !ParseTraceFileHeader(fh, sizeof(fh), startTick))
+    {
+        std::fprintf(stderr, "'%s' is not a recording\n", path.c_str());
+        std::fclose(f);
+        return 1;
+    }
+    if (relative)
+    {
+        from += startTick;
+        to = (to == 0xFFFFFFFFu) ? to : to + startTick;
+    }
+
+    std::vector<TraceIndexEntry> index;
+    std::vector<uint8_t> idxBytes;
+    std::string idxPath = path.substr(0, path.rfind('.')) + ".idx";
+    if (!ReadFileBytes(idxPath, idxBytes) || !ParseTraceIndex(idxBytes.data(), idxBytes.size(), index) || index.empty())
+    {
+        std::fprintf(stderr, "no usable index at '%s', scanning blocks\n", idxPath.c_str());
+        ScanBlocks(f, index);
+    }
+
+    if (listBlocks)
+    {
+        std::printf("block,offset,first_tick,last_tick\n");
+        for (size_t b = 0; b < index.size(); b++)
+        {
+            std::printf("%zu,%llu,%u,%u\n", b, (unsigned long long)index[b].offset,
+                index[b].firstTick - (relative ? startTick : 0), index[b].lastTick - (relative ? startTick : 0));
+        }
+        std::fclose(f);
+        return 0;
+    }
+
+    std::printf("tick_ms,channel,value\n");
+    std::vector<uint8_t> payload;
+    std::vector<std::string> names;
+    size_t rows = 0;
+    for (size_t b = FindTraceBlock(index, from); b < index.size() && index[b].firstTick <= to; b++)
+    {
+        uint8_t hb[kTraceBlockHeaderBytes];
+        TraceBlockHeader h;
+        if (!SeekTo(f, index[b].offset) || std::fread(hb, 1, sizeof(hb), f) != sizeof(hb) ||
+            !ParseTraceBlockHeader(hb, sizeof(hb), h))
+        {
+            std::fprintf(stderr, "bad block header at offset %llu\n", (unsigned long long)index[b].offset);
+            break;
+        }
+        payload.resize(h.payloadBytes);
+        if (std::fread(payload.data(), 1, payload.size(), f) != payload.size())
+        {
+            std::fprintf(stderr, "truncated block at offset %llu\n", (unsigned long long)index[b].offset);
+            break;
+        }
+        bool ok = DecodeTraceBlock(h, payload.data(), names, [&](const TraceSample& s)
+        {
+            if (s.tick < from || s.tick > to)
+                return;
+            const std::string& name = names[(size_t)s.id];
+            if (!only.empty())
+            {
+                bool wanted = false;
+                for (const std::string& o : only)
+                    wanted |= o == name;
+                if (!wanted)
+                    return;
+            }
+            std::printf("%u,%s,%d\n", s.tick - (relative ? startTick : 0),
+                name.empty() ? std::to_string(s.id).c_str() : name.c_str(), s.value);
+            rows++;
+        });
+        if (!ok)
+            std::fprintf(stderr, "corrupt payload in block %zu\n", b);
+    }
+    std::fclose(f);
+    std::fprintf(stderr, "%zu rows from %zu indexed blocks\n", rows, index.size());
+    return 0;
+}
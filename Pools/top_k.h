@@ -0,0 +1,108 @@
+/*
+  top_k.h
+  - Bounded best-K set for candidate ranking
+  - Min-heap ordered so the weakest member sits at the root: offering a key
+    costs O(log K), membership lookups are a linear scan of K entries
+  - A member whose key gets worse while the heap is full cannot be fixed up
+    locally (an outsider may now beat it); Offer/Remove report that so the
+    caller can rebuild from the full candidate set
+  - Header-only; bench/top_k_bench.cpp checks it against a full sort after
+    every operation
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+struct RankKey
+{
+    float score = 0.0f;
+    int tie[5] = { 0, 0, 0, 0, 0 };  // compared in order, larger ranks first
+    int idx = -1;                    // global index, smaller ranks first
+};
+
+// True if a ranks strictly ahead of b.
+inline bool RankAhead(const RankKey& a, const RankKey& b)
+{
+    if (a.score != b.score)
+        return a.score > b.score;
+    for (int t = 0; t < 5; t++)
+    {
+        if (a.tie[t] != b.tie[t])
+            return a.tie[t] > b.tie[t];
+    }
+    return a.idx < b.idx;
+}
+
+struct TopKHeap
+{
+    void Reset(int k)
+    {
+        capacity = (k > 0) ? k : 1;
+        heap.clear();
+        heap.reserve((size_t)capacity);
+    }
+
+    bool Full() const { return (int)heap.size() >= capacity; }
+
+    int Find(int idx) const
+    {
+        for (size_t i = 0; i < heap.size(); i++)
+        {
+            if (heap[i].idx == idx)
+                return (int)i;
+        }
+        return -1;
+    }
+
+    // Inserts or updates key. Returns false if the result may be wrong and needs a rebuild.
+    bool Offer(const RankKey& key)
+    {
+        int at = Find(key.idx);
+        if (at >= 0)
+        {
+            bool worse = RankAhead(heap[(size_t)at], key);
+            heap[(size_t)at] = key;
+            std::make_heap(heap.begin(), heap.end(), RankAhead);
+            return !(worse && Full());
+        }
+        if (!Full())
+        {
+            heap.push_back(key);
+            std::push_heap(heap.begin(), heap.end(), RankAhead);
+            return true;
+        }
+        if (RankAhead(key, heap.front()))
+        {
+            std::pop_heap(heap.begin(), heap.end(), RankAhead);
+            heap.back() = key;
+            std::push_heap(heap.begin(), heap.end(), RankAhead);
+        }
+        return true;
+    }
+
+    // Drops idx. Returns false if it was a member of a full heap (an outsider may move up).
+    bool Remove(int idx)
+    {
+        int at = Find(idx);
+        if (at < 0)
+            return true;
+        bool wasFull = Full();
+        heap.erase(heap.begin() + at);
+        std::make_heap(heap.begin(), heap.end(), RankAhead);
+        return !wasFull;
+    }
+
+    size_t MemoryBytes() const { return heap.capacity() * sizeof(RankKey); }
+
+    // Members best-first.
+    void Sorted(std::vector<RankKey>& out) const
+    {
+        out.assign(heap.begin(), heap.end());
+        std::sort(out.begin(), out.end(), RankAhead);
+    }
+
+    int capacity = 1;
+    std::vector<RankKey> heap;
+};
@@ -0,0 +1,341 @@
+#include "trace_recorder.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    const size_t kMaxVarint = 5;
+    const size_t kMaxRecordBytes = 3 * kMaxVarint;  // id, tick delta, value delta
+    const size_t kMaxNameBytes = 64;
+
+    inline void PutU16(uint8_t* p, uint16_t v)
+    {
+        p[0] = (uint8_t)v;
+        p[1] = (uint8_t)(v >> 8);
+    }
+
+    inline void PutU32(uint8_t* p, uint32_t v)
+    {
+        for (int i = 0; i < 4; i++)
+            p[i] = (uint8_t)(v >> (8 * i));
+    }
+
+    inline void PutU64(uint8_t* p, uint64_t v)
+    {
+        for (int i = 0; i < 8; i++)
+            p[i] = (uint8_t)(v >> (8 * i));
+    }
+
+    inline uint32_t GetU32(const uint8_t* p)
+    {
+        return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+
+    inline uint64_t GetU64(const uint8_t* p)
+    {
+        return (uint64_t)GetU32(p) | ((uint64_t)GetU32(p + 4) << 32);
+    }
+
+    inline size_t PutVarint(uint8_t* p, uint32_t v)
+    {
+        size_t n = 0;
+        while (v >= 0x80)
+        {
+            p[n++] = (uint8_t)(v | 0x80);
+            v >>= 7;
+        }
+        p[n++] = (uint8_t)v;
+        return n;
+    }
+
+    inline bool GetVarint(const uint8_t*& p, const uint8_t* end, uint32_t& v)
+    {
+        v = 0;
+        for (int shift = 0; shift < 35 && p < end; shift += 7)
+        {
+            uint8_t b = *p++;
+            v |= (uint32_t)(b & 0x7F) << shift;
+            if (!(b & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    inline uint32_t ZigZag(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+    inline int32_t UnZigZag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+}
+
+void WriteTraceFileHeader(uint8_t out[kTraceFileHeaderBytes], uint32_t startTick)
+{
+    std::memset(out, 0, kTraceFileHeaderBytes);
+    PutU32(out, kTraceFileMagic);
+    PutU16(out + 4, kTraceVersion);
+    PutU32(out + 8, startTick);
+}
+
+void WriteTraceIndexHeader(uint8_t out[kTraceIndexHeaderBytes])
+{
+    std::memset(out, 0, kTraceIndexHeaderBytes);
+    PutU32(out, kTraceIndexMagic);
+    PutU16(out + 4, kTraceVersion);
+}
+
+void WriteTraceIndexEntry(uint8_t out[kTraceIndexEntryBytes], const TraceIndexEntry& e)
+{
+    PutU64(out, e.offset);
+    PutU32(out + 8, e.firstTick);
+    PutU32(out + 12, e.lastTick);
+}
+
+void TraceWriter::Open(uint64_t fileOffset, int maxChannels, size_t blockBytes, BlockSink blockSink)
+{
+    sink = std::move(blockSink);
+    offset = fileOffset;
+    int channels = (std::max)(1, maxChannels);
+    // Room for every channel definition plus a useful number of samples.
+    size_t minBytes = kTraceBlockHeaderBytes + (size_t)channels * (2 * kMaxVarint + kMaxNameBytes) + 64 * kMaxRecordBytes;
+    buf.assign((std::max)(blockBytes, minBytes), 0);
+    sealed.assign(buf.size(), 0);
+    sealedBytes = 0;
+    last.assign((size_t)channels, 0);
+    names.assign((size_t)channels, std::string());
+    for (std::string& name : names)
+        name.reserve(kMaxNameBytes);
+    used = 0;
+    inBlock = false;
+    samples = 0;
+    blocks = 0;
+    inlineWrites = 0;
+    open = true;
+}
+
+void TraceWriter::Close()
+{
+    if (!open)
+        return;
+    Flush();
+    open = false;
+    sink = nullptr;
+}
+
+size_t TraceWriter::DefineBytes(int id) const
+{
+    return 1 + 2 * kMaxVarint + names[(size_t)id].size();
+}
+
+void TraceWriter::PutDefine(int id)
+{
+    const std::string& name = names[(size_t)id];
+    uint8_t* p = buf.data() + used;
+    size_t n = 0;
+    p[n++] = 0;  // tag 0 = channel definition
+    n += PutVarint(p + n, (uint32_t)id);
+    n += PutVarint(p + n, (uint32_t)name.size());
+    std::memcpy(p + n, name.data(), name.size());
+    used += n + name.size();
+}
+
+bool TraceWriter::DefineChannel(int id, const std::string& name)
+{
+    if (!open || id < 0 || id >= (int)names.size())
+        return false;
+    std::string& slot = names[(size_t)id];
+    slot.assign(name, 0, (std::min)(name.size(), kMaxNameBytes));
+    if (inBlock)
+    {
+        if (used + DefineBytes(id) > buf.size())
+            SealBlock();  // the next block starts with every definition
+        else
+            PutDefine(id);
+    }
+    return true;
+}
+
+void TraceWriter::StartBlock(uint32_t tick)
+{
+    used = kTraceBlockHeaderBytes;
+    baseTick = tick;
+    lastTick = tick;
+    blockRecords = 0;
+    std::fill(last.begin(), last.end(), 0);
+    for (int id = 0; id < (int)names.size(); id++)
+    {
+        if (!names[(size_t)id].empty())
+            PutDefine(id);
+    }
+    inBlock = true;
+}
+
+void TraceWriter::Record(uint32_t tick, int id, int32_t value)
+{
+    if (!open || id < 0 || id >= (int)last.size())
+        return;
+    if (inBlock && used + kMaxRecordBytes > buf.size())
+        SealBlock();
+    if (!inBlock)
+        StartBlock(tick);
+    if ((int32_t)(tick - lastTick) < 0)
+        tick = lastTick;
+
+    uint8_t* p = buf.data() + used;
+    size_t n = PutVarint(p, (uint32_t)id + 1);
+    n += PutVarint(p + n, tick - lastTick);
+    n += PutVarint(p + n, ZigZag((int32_t)((uint32_t)value - (uint32_t)last[(size_t)id])));
+    used += n;
+    last[(size_t)id] = value;
+    lastTick = tick;
+    blockRecords++;
+    samples++;
+}
+
+// Finishes the current block and parks it in the sealed buffer; file offsets are assigned here,
+// so blocks keep their order whichever path writes them.
+void TraceWriter::SealBlock()
+{
+    if (!inBlock)
+        return;
+    if (blockRecords == 0)
+    {
+        inBlock = false;
+        used = 0;
+        return;
+    }
+    if (sealedBytes > 0)
+    {
+        WriteSealed();  // both buffers full between flushes
+        inlineWrites++;
+    }
+    uint8_t* h = buf.data();
+    PutU32(h, kTraceBlockMagic);
+    PutU32(h + 4, (uint32_t)(used - kTraceBlockHeaderBytes));
+    PutU32(h + 8, baseTick);
+    PutU32(h + 12, blockRecords);
+
+    sealedEntry.offset = offset;
+    sealedEntry.firstTick = baseTick;
+    sealedEntry.lastTick = lastTick;
+    buf.swap(sealed);
+    sealedBytes = used;
+    offset += used;
+    blocks++;
+    inBlock = false;
+    used = 0;
+}
+
+void TraceWriter::WriteSealed()
+{
+    if (sealedBytes == 0)
+        return;
+    if (sink)
+        sink(sealed.data(), sealedBytes, sealedEntry);
+    sealedBytes = 0;
+}
+
+void TraceWriter::Flush()
+{
+    if (!open)
+        return;
+    WriteSealed();
+    SealBlock();
+    WriteSealed();
+}
+
+size_t TraceWriter::MemoryBytes() const
+{
+    size_t bytes = buf.capacity() + sealed.capacity() + last.capacity() * sizeof(int32_t) + names.capacity() * sizeof(std::string);
+    for (const std::string& name : names)
+        bytes += name.capacity();
+    return bytes;
+}
+
+bool ParseTraceFileHeader(const uint8_t* data, size_t n, uint32_t& startTick)
+{
+    if (n < kTraceFileHeaderBytes || GetU32(data) != kTraceFileMagic)
+        return false;
+    startTick = GetU32(data + 8);
+    return true;
+}
+
+bool ParseTraceBlockHeader(const uint8_t* data, size_t n, TraceBlockHeader& out)
+{
+    if (n < kTraceBlockHeaderBytes || GetU32(data) != kTraceBlockMagic)
+        return false;
+    out.payloadBytes = GetU32(data + 4);
+    out.baseTick = GetU32(data + 8);
+    out.records = GetU32(data + 12);
+    return true;
+}
+
+bool ParseTraceIndex(const uint8_t* data, size_t n, std::vector<TraceIndexEntry>& out)
+{
+    out.clear();
+    if (n < kTraceIndexHeaderBytes || GetU32(data) != kTraceIndexMagic)
+        return false;
+    for (size_t pos = kTraceIndexHeaderBytes; pos + kTraceIndexEntryBytes <= n; pos += kTraceIndexEntryBytes)
+    {
+        TraceIndexEntry e;
+        e.offset = GetU64(data + pos);
+        e.firstTick = GetU32(data + pos + 8);
+        e.lastTick = GetU32(data + pos + 12);
+        out.push_back(e);
+    }
+    return true;
+}
+
+size_t FindTraceBlock(const std::vector<TraceIndexEntry>& index, uint32_t fromTick)
+{
+    // Blocks are in tick order; the first one that ends at or after fromTick.
+    auto it = std::lower_bound(index.begin(), index.end(), fromTick,
+        [](const TraceIndexEntry& e, uint32_t tick) { return e.lastTick < tick; });
+    return (size_t)(it - index.begin());
+}
+
+bool DecodeTraceBlock(const TraceBlockHeader& h, const uint8_t* payload, std::vector<std::string>& names,
+    const std::function<void(const TraceSample&)>& onSample)
+{
+    const uint8_t* p = payload;
+    const uint8_t* end = payload + h.payloadBytes;
+    std::vector<int32_t> last(names.size(), 0);
+    uint32_t tick = h.baseTick;
+    while (p < end)
+    {
+        uint32_t tag = 0;
+        if (!GetVarint(p, end, tag))
+            return false;
+        if (tag == 0)
+        {
+            uint32_t id = 0;
+            uint32_t len = 0;
+            if (!GetVarint(p, end, id) || !GetVarint(p, end, len) || len > (uint32_t)(end - p) || id > 65535)
+                return false;
+            if (id >= names.size())
+            {
+                names.resize(id + 1);
+                last.resize(id + 1, 0);
+            }
+            names[id].assign((const char*)p, len);
+            p += len;
+            continue;
+        }
+
+        uint32_t id = tag - 1;
+        uint32_t dt = 0;
+        uint32_t dv = 0;
+        if (!GetVarint(p, end, dt) || !GetVarint(p, end, dv))
+            return false;
+        if (id >= last.size())
+        {
+            names.resize(id + 1);
+            last.resize(id + 1, 0);
+        }
+        tick += dt;
+        last[id] = (int32_t)((uint32_t)last[id] + (uint32_t)UnZigZag(dv));
+        TraceSample s;
+        s.tick = tick;
+        s.id = (int)id;
+        s.value = last[id];
+        onSample(s);
+    }
+    return true;
+}
@@ -0,0 +1,127 @@
+/*
+  trace_recorder.h
+  - Compact binary time series of (tick, channel, value) samples
+  - Samples are packed into self-contained blocks: a fixed header with the
+    absolute first tick, then varint records holding the tick delta and the
+    zigzag value delta against the channel's previous sample in the block.
+    Every block repeats the channel names, so any block decodes on its own
+  - Each finished block yields an index entry (file offset, tick range); the
+    index file is a flat array of them, so a seek is one binary search
+  - TraceWriter encodes into two block buffers sized at Open(). When one
+    fills, Record() seals it and carries on in the other; the sealed block
+    reaches the caller's sink (which does the IO) at the next Flush(), so the
+    hot path neither allocates nor writes. Only if both fill between flushes
+    does Record() hand the older one to the sink itself
+  - bench/trace_recorder_bench.cpp round-trips and times a recording;
+    tools/trace_dump.cpp decodes files off-line
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+constexpr uint32_t kTraceFileMagic = 0x43525348;   // "HSRC"
+constexpr uint32_t kTraceIndexMagic = 0x49525348;  // "HSRI"
+constexpr uint32_t kTraceBlockMagic = 0x4B4C4248;  // "HBLK"
+constexpr uint16_t kTraceVersion = 1;
+constexpr size_t kTraceFileHeaderBytes = 16;
+constexpr size_t kTraceIndexHeaderBytes = 8;
+constexpr size_t kTraceBlockHeaderBytes = 16;
+constexpr size_t kTraceIndexEntryBytes = 16;
+
+struct TraceIndexEntry
+{
+    uint64_t offset = 0;       // block header position in the trace file
+    uint32_t firstTick = 0;
+    uint32_t lastTick = 0;
+};
+
+struct TraceBlockHeader
+{
+    uint32_t payloadBytes = 0;
+    uint32_t baseTick = 0;
+    uint32_t records = 0;      // samples, channel definitions excluded
+};
+
+// File and index headers, written once when the files are created.
+void WriteTraceFileHeader(uint8_t out[kTraceFileHeaderBytes], uint32_t startTick);
+void WriteTraceIndexHeader(uint8_t out[kTraceIndexHeaderBytes]);
+void WriteTraceIndexEntry(uint8_t out[kTraceIndexEntryBytes], const TraceIndexEntry& e);
+
+class TraceWriter
+{
+public:
+    // block = header + payload; the sink must consume it before returning.
+    using BlockSink = std::function<void(const uint8_t* block, size_t bytes, const TraceIndexEntry& entry)>;
+
+    // offset = current trace file size (after its header). Reserves both block buffers up front.
+    void Open(uint64_t offset, int maxChannels, size_t blockBytes, BlockSink sink);
+    void Close();  // flushes
+    bool IsOpen() const { return open; }
+
+    // Not for the hot path (copies the name). Redefining an id renames it.
+    bool DefineChannel(int id, const std::string& name);
+
+    // Hot path. Samples must come in tick order; a tick going backwards is clamped.
+    void Record(uint32_t tick, int id, int32_t value);
+
+    // Hands the sealed block, then the current one (if it holds samples), to the sink.
+    void Flush();
+
+    uint64_t Samples() const { return samples; }
+    uint64_t BytesWritten() const { return offset; }
+    int Blocks() const { return blocks; }
+    int InlineWrites() const { return inlineWrites; }  // blocks Record() had to hand over itself
+    size_t MemoryBytes() const;
+
+private:
+    void StartBlock(uint32_t tick);
+    void SealBlock();
+    void WriteSealed();
+    void PutDefine(int id);
+    size_t DefineBytes(int id) const;
+
+    bool open = false;
+    BlockSink sink;
+    std::vector<uint8_t> buf;       // block being filled: header + payload, capacity fixed at Open
+    size_t used = 0;
+    std::vector<uint8_t> sealed;    // full block waiting for Flush(), same capacity
+    size_t sealedBytes = 0;         // 0 = none waiting
+    TraceIndexEntry sealedEntry;
+    std::vector<int32_t> last;      // per channel, reset every block
+    std::vector<std::string> names; // empty = undefined
+    bool inBlock = false;
+    uint32_t baseTick = 0;
+    uint32_t lastTick = 0;
+    uint32_t blockRecords = 0;
+    uint64_t offset = 0;
+    uint64_t samples = 0;
+    int blocks = 0;
+    int inlineWrites = 0;
+};
+
+// ---- Decoding (the CLI decoder and the benchmarks) ----
+
+bool ParseTraceFileHeader(const uint8_t* data, size_t n, uint32_t& startTick);
+bool ParseTraceBlockHeader(const uint8_t* data, size_t n, TraceBlockHeader& out);
+
+// Index file bytes -> entries. false if the header is wrong; a torn last entry is dropped.
+bool ParseTraceIndex(const uint8_t* data, size_t n, std::vector<TraceIndexEntry>& out);
+
+// First entry whose block can hold ticks >= fromTick.
+size_t FindTraceBlock(const std::vector<TraceIndexEntry>& index, uint32_t fromTick);
+
+struct TraceSample
+{
+    uint32_t tick = 0;
+    int id = 0;
+    int32_t value = 0;
+};
+
+// Decodes one block payload. names grows to cover every channel the block defines.
+bool DecodeTraceBlock(const TraceBlockHeader& h, const uint8_t* payload, std::vector<std::string>& names,
+    const std::function<void(const TraceSample&)>& onSample);
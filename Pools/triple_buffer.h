@@ -0,0 +1,48 @@
+/*
+  triple_buffer.h
+  - Lock-free single-producer/single-consumer triple buffer
+  - The producer fills its back slot and swaps it into the middle; the consumer
+    swaps the middle out only when something newer was published, so neither
+    side ever waits and the consumer always sees a complete value
+  - Exactly one producing and one consuming thread (the scan worker and the
+    script thread); a second one on either side breaks the swaps. No bench
+    covers it
+*/
+
+#pragma once
+
+#include <atomic>
+
+template <class T>
+struct TripleBuffer
+{
+    // Producer: fill Back(), then Publish(). Back() may hold a stale value, so overwrite it fully.
+    T& Back() { return slots[back]; }
+
+    void Publish()
+    {
+        int prev = middle.exchange(back | kFreshBit, std::memory_order_acq_rel);
+        back = prev & kIndexMask;
+    }
+
+    // Consumer: returns true if Front() now holds a newer value than before.
+    bool Consume()
+    {
+        if ((middle.load(std::memory_order_acquire) & kFreshBit) == 0)
+            return false;
+        int prev = middle.exchange(front, std::memory_order_acq_rel);
+        front = prev & kIndexMask;
+        return true;
+    }
+
+    const T& Front() const { return slots[front]; }
+
+private:
+    static constexpr int kIndexMask = 3;
+    static constexpr int kFreshBit = 4;
+
+    T slots[3];
+    int back = 0;                  // producer-owned
+    std::atomic<int> middle{ 1 };  // shared: slot index | kFreshBit
+    int front = 2;                 // consumer-owned
+};
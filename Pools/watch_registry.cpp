@@ -0,0 +1,240 @@
+#include "watch_registry.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+namespace
+{
+    std::string Trim(const std::string& s)
+    {
+        size_t b = 0;
+        size_t e = s.size();
+        while (b < e && std::isspace((unsigned char)s[b]))
+            b++;
+        while (e > b && std::isspace((unsigned char)s[e - 1]))
+            e--;
+        return s.substr(b, e - b);
+    }
+
+    bool ParseNonNegative(const std::string& s, long& out)
+    {
+        if (s.empty())
+            return false;
+        char* end = nullptr;
+        out = std::strtol(s.c_str(), &end, 10);
+        return end && *end == '\0' && out >= 0;
+    }
+}
+
+bool ParseWatchSpec(const std::string& text, WatchSpec& out)
+{
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while (true)
+    {
+        size_t comma = text.find(',', start);
+        fields.push_back(Trim(text.substr(start, (comma == std::string::npos) ? std::string::npos : comma - start)));
+        if (comma == std::string::npos)
+            break;
+        start = comma + 1;
+    }
+    if (fields.size() < 2 || fields.size() > 4 || fields[0].empty())
+        return false;
+
+    WatchSpec spec = out;
+    spec.name = fields[0];
+    long v = 0;
+    if (!ParseNonNegative(fields[1], v))
+        return false;
+    spec.idx = (int)v;
+    if (fields.size() >= 3)
+    {
+        if (!ParseNonNegative(fields[2], v))
+            return false;
+        spec.periodMs = (uint32_t)v;
+    }
+    if (fields.size() >= 4)
+    {
+        std::string unit = fields[3];
+        std::transform(unit.begin(), unit.end(), unit.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+        if (unit == "raw")
+            spec.unit = WATCH_UNIT_RAW;
+        else if (unit == "cents")
+            spec.unit = WATCH_UNIT_CENTS;
+        else if (unit == "dollars")
+            spec.unit = WATCH_UNIT_DOLLARS;
+        else
+            return false;
+    }
+    out = spec;
+    return true;
+}
+
+const char* WatchUnitName(WatchUnit unit)
+{
+    switch (unit)
+    {
+    case WATCH_UNIT_RAW: return "raw";
+    case WATCH_UNIT_CENTS: return "cents";
+    case WATCH_UNIT_DOLLARS: return "dollars";
+    default: return "?";
+    }
+}
+
+void WatchRegistry::Clear()
+{
+    watches.clear();
+    subs.clear();
+    dueIds.clear();
+    dueIdx.clear();
+}
+
+int WatchRegistry::Add(const WatchSpec& spec)
+{
+    Watch w;
+    w.spec = spec;
+    w.ring.resize((size_t)(std::max)(1, spec.history));
+    watches.push_back(std::move(w));
+    return (int)watches.size() - 1;
+}
+
+int WatchRegistry::Find(const std::string& name) const
+{
+    for (size_t i = 0; i < watches.size(); i++)
+    {
+        if (watches[i].spec.name == name)
+            return (int)i;
+    }
+    return -1;
+}
+
+void WatchRegistry::Bind(int id, int idx)
+{
+    Watch& w = watches[(size_t)id];
+    if (w.spec.idx == idx)
+        return;
+    w.spec.idx = idx;
+    w.nextDueMs = 0;
+    w.valid = false;
+    w.ok = false;
+    w.head = 0;
+    w.count = 0;
+}
+
+int WatchRegistry::Subscribe(int id, Callback cb)
+{
+    Subscription s;
+    s.handle = nextHandle++;
+    s.id = id;
+    s.cb = std::move(cb);
+    subs.push_back(std::move(s));
+    return subs.back().handle;
+}
+
+void WatchRegistry::Unsubscribe(int handle)
+{
+    subs.erase(std::remove_if(subs.begin(), subs.end(),
+        [handle](const Subscription& s) { return s.handle == handle; }), subs.end());
+}
+
+const std::vector<int>& WatchRegistry::Due(uint32_t nowMs)
+{
+    dueIds.clear();
+    dueIdx.clear();
+    for (size_t i = 0; i < watches.size(); i++)
+    {
+        Watch& w = watches[i];
+        if (w.spec.idx < 0 || (w.nextDueMs != 0 && (int32_t)(nowMs - w.nextDueMs) < 0))
+            continue;
+        w.nextDueMs = (std::max)(nowMs + w.spec.periodMs, (uint32_t)1);  // 0 = due now
+        dueIds.push_back((int)i);
+        dueIdx.push_back(w.spec.idx);
+    }
+    return dueIdx;
+}
+
+int32_t WatchRegistry::Transform(WatchUnit unit, int raw)
+{
+    if (unit == WATCH_UNIT_DOLLARS)
+        return (int32_t)((int64_t)raw * 100);
+    return raw;
+}
+
+void WatchRegistry::Record(Watch& w, uint32_t ms, int32_t value)
+{
+    int cap = (int)w.ring.size();
+    WatchSample& slot = w.ring[(size_t)((w.head + w.count) % cap)];
+    slot.ms = ms;
+    slot.value = value;
+    if (w.count < cap)
+        w.count++;
+    else
+        w.head = (w.head + 1) % cap;
+}
+
+void WatchRegistry::Apply(uint32_t nowMs, const int* raw, const unsigned char* ok)
+{
+    reads += dueIds.size();
+    for (size_t i = 0; i < dueIds.size(); i++)
+    {
+        int id = dueIds[i];
+        Watch& w = watches[(size_t)id];
+        w.ok = ok[i] != 0;
+        if (!w.ok)
+            continue;
+        int32_t value = Transform(w.spec.unit, raw[i]);
+        if (w.valid && value == w.value)
+            continue;
+
+        WatchChange change;
+        change.id = id;
+        change.spec = &w.spec;
+        change.first = !w.valid;
+        change.prev = w.value;
+        change.value = value;
+        change.ms = nowMs;
+        w.valid = true;
+        w.value = value;
+        Record(w, nowMs, value);
+        for (const Subscription& s : subs)
+        {
+            if (s.id < 0 || s.id == id)
+                s.cb(change);
+        }
+    }
+}
+
+void WatchRegistry::MarkStale()
+{
+    for (Watch& w : watches)
+        w.ok = false;
+}
+
+bool WatchRegistry::Value(int id, int32_t& out, bool* fresh) const
+{
+    if (id < 0 || id >= (int)watches.size())
+        return false;
+    const Watch& w = watches[(size_t)id];
+    if (fresh)
+        *fresh = w.ok;
+    if (!w.valid)
+        return false;
+    out = w.value;
+    return true;
+}
+
+const WatchSample& WatchRegistry::HistoryAt(int id, int i) const
+{
+    const Watch& w = watches[(size_t)id];
+    return w.ring[(size_t)((w.head + i) % (int)w.ring.size())];
+}
+
+size_t WatchRegistry::MemoryBytes() const
+{
+    size_t bytes = watches.capacity() * sizeof(Watch) + subs.capacity() * sizeof(Subscription) +
+        (dueIds.capacity() + dueIdx.capacity()) * sizeof(int);
+    for (const Watch& w : watches)
+        bytes += w.ring.capacity() * sizeof(WatchSample) + w.spec.name.capacity();
+    return bytes;
+}
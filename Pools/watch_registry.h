@@ -0,0 +1,122 @@
+/*
+  watch_registry.h
+  - Registry of named watchpoints over script globals
+  - Each watch has its own sampling period, a unit transform (raw, cents, or
+    whole dollars scaled to cents), a ring of its last value changes, and
+    change subscribers (per watch or for every watch)
+  - The registry never reads memory itself: Due() lists the indices to read
+    this frame, the caller reads them in one batch and passes the results to
+    Apply(), which updates values and fires the callbacks
+  - Callbacks run inside Apply(), on the caller's thread (the script
+    thread in the plugin); bench/watch_registry_bench.cpp checks it against
+    a reference model frame by frame
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+enum WatchUnit
+{
+    WATCH_UNIT_RAW = 0,      // plain integer, shown as is
+    WATCH_UNIT_CENTS = 1,    // money stored in cents
+    WATCH_UNIT_DOLLARS = 2   // money stored in whole dollars; values are reported in cents
+};
+
+struct WatchSpec
+{
+    std::string name;
+    int idx = -1;              // global index, -1 = unbound (never read)
+    uint32_t periodMs = 0;     // 0 = every Due() call
+    WatchUnit unit = WATCH_UNIT_CENTS;
+    int history = 32;          // value changes kept
+};
+
+struct WatchSample
+{
+    uint32_t ms = 0;
+    int32_t value = 0;         // after the unit transform
+};
+
+struct WatchChange
+{
+    int id = -1;
+    const WatchSpec* spec = nullptr;
+    bool first = false;        // first good read since Add/Bind; prev is meaningless
+    int32_t prev = 0;
+    int32_t value = 0;
+    uint32_t ms = 0;
+};
+
+// "name,index[,periodMs[,unit]]" with unit raw|cents|dollars. Returns false on a malformed line.
+bool ParseWatchSpec(const std::string& text, WatchSpec& out);
+const char* WatchUnitName(WatchUnit unit);
+
+class WatchRegistry
+{
+public:
+    using Callback = std::function<void(const WatchChange&)>;
+
+    void Clear();
+
+    // Returns the watch id (ids are dense, in Add order).
+    int Add(const WatchSpec& spec);
+    int Find(const std::string& name) const;
+    int Count() const { return (int)watches.size(); }
+    const WatchSpec& Spec(int id) const { return watches[(size_t)id].spec; }
+
+    // Points a watch at another global (an auto-locked pot, say). Drops its value and history.
+    void Bind(int id, int idx);
+
+    // id = -1 subscribes to every watch. Callbacks run inside Apply(), in subscription order.
+    int Subscribe(int id, Callback cb);
+    void Unsubscribe(int handle);
+
+    // Global indices due at nowMs (bound watches only). Pass their values to Apply() in this order.
+    const std::vector<int>& Due(uint32_t nowMs);
+    void Apply(uint32_t nowMs, const int* raw, const unsigned char* ok);
+
+    // Clears every fresh flag, for when watches stop being read; values and history stay.
+    void MarkStale();
+
+    // Last good value; fresh = the latest read of it succeeded.
+    bool Value(int id, int32_t& out, bool* fresh = nullptr) const;
+    int HistoryCount(int id) const { return watches[(size_t)id].count; }
+    const WatchSample& HistoryAt(int id, int i) const;  // 0 = oldest
+
+    uint64_t Reads() const { return reads; }
+    size_t MemoryBytes() const;
+
+private:
+    struct Watch
+    {
+        WatchSpec spec;
+        uint32_t nextDueMs = 0;
+        bool valid = false;
+        bool ok = false;
+        int32_t value = 0;
+        std::vector<WatchSample> ring;
+        int head = 0;
+        int count = 0;
+    };
+
+    struct Subscription
+    {
+        int handle = 0;
+        int id = -1;
+        Callback cb;
+    };
+
+    static int32_t Transform(WatchUnit unit, int raw);
+    void Record(Watch& w, uint32_t ms, int32_t value);
+
+    std::vector<Watch> watches;
+    std::vector<Subscription> subs;
+    std::vector<int> dueIds;
+    std::vector<int> dueIdx;
+    int nextHandle = 1;
+    uint64_t reads = 0;
+};